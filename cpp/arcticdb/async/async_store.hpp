@@ -17,6 +17,10 @@
 #include <arcticdb/stream/stream_utils.hpp>
 #include <arcticdb/processing/clause.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
 namespace arcticdb::async {
 
 std::pair<VariantKey, std::optional<Segment>> lookup_match_in_dedup_map(
@@ -69,7 +73,7 @@ public:
 
         return async::submit_cpu_task(EncodeAtomTask{
             key_type, version_id, stream_id, start_index, end_index, current_timestamp(),
-            std::move(segment), codec_, encoding_version_
+            std::move(segment), codec(), encoding_version_
         })
             .via(&async::io_executor())
             .thenValue(WriteSegmentTask{library_});
@@ -91,7 +95,7 @@ public:
 
         return async::submit_cpu_task(EncodeAtomTask{
             key_type, version_id, stream_id, start_index, end_index, creation_ts,
-            std::move(segment), codec_, encoding_version_
+            std::move(segment), codec(), encoding_version_
         })
             .via(&async::io_executor())
             .thenValue(WriteSegmentTask{library_});
@@ -107,7 +111,7 @@ public:
         SegmentInMemory &&segment) override {
         util::check(is_ref_key_class(key_type), "Expected ref key type got  {}", key_type);
         return async::submit_cpu_task(EncodeRefTask{
-            key_type, stream_id, std::move(segment), codec_, encoding_version_
+            key_type, stream_id, std::move(segment), codec(), encoding_version_
         })
             .via(&async::io_executor())
             .thenValue(WriteSegmentTask{library_});
@@ -128,7 +132,7 @@ public:
 
         auto encoded = EncodeAtomTask{
             key_type, version_id, stream_id, start_index, end_index, current_timestamp(),
-            std::move(segment), codec_, encoding_version_
+            std::move(segment), codec(), encoding_version_
         }();
         return WriteSegmentTask{library_}(std::move(encoded));
     }
@@ -142,7 +146,7 @@ public:
         const StreamId &stream_id,
         SegmentInMemory &&segment) override {
         util::check(is_ref_key_class(key_type), "Expected ref key type got  {}", key_type);
-        auto encoded = EncodeRefTask{key_type, stream_id, std::move(segment), codec_, encoding_version_}();
+        auto encoded = EncodeRefTask{key_type, stream_id, std::move(segment), codec(), encoding_version_}();
         return WriteSegmentTask{library_}(std::move(encoded));
     }
 
@@ -164,7 +168,7 @@ public:
                     segment.descriptor().id());
 
         return async::submit_cpu_task(EncodeSegmentTask{
-            key, std::move(segment), codec_, encoding_version_
+            key, std::move(segment), codec(), encoding_version_
         })
             .via(&async::io_executor())
             .thenValue(UpdateSegmentTask{library_, opts});
@@ -280,21 +284,44 @@ public:
             std::vector<std::pair<entity::VariantKey, ReadContinuation>> &&keys_and_continuations,
             const BatchReadArgs &args) override {
         util::check(!keys_and_continuations.empty(), "Unexpected empty keys/continuation vector in batch_read_compressed");
-        return folly::collect(folly::window(std::move(keys_and_continuations), [this] (auto&& key_and_continuation) {
+        if (library_->batch_size() > 1) {
+            storage::ReadKeyOpts opts;
+            opts.profile_stage_ = args.profile_stage_;
+            return folly::collect(read_in_groups(std::move(keys_and_continuations), opts, args.batch_size_)).via(&async::io_executor());
+        }
+
+        return folly::collect(folly::window(std::move(keys_and_continuations), [this, profile_stage=args.profile_stage_] (auto&& key_and_continuation) {
             auto [key, continuation] = std::forward<decltype(key_and_continuation)>(key_and_continuation);
-            return read_and_continue(key, library_, storage::ReadKeyOpts{}, std::move(continuation));
+            storage::ReadKeyOpts opts;
+            opts.profile_stage_ = profile_stage;
+            return read_and_continue(key, library_, opts, std::move(continuation));
         }, args.batch_size_)).via(&async::io_executor());
     }
 
     std::vector<folly::Future<pipelines::SegmentAndSlice>> batch_read_uncompressed(
             std::vector<pipelines::RangesAndKey>&& ranges_and_keys,
-            std::shared_ptr<std::unordered_set<std::string>> columns_to_decode) override {
+            std::shared_ptr<std::unordered_set<std::string>> columns_to_decode,
+            std::shared_ptr<ProfileStage> profile) override {
+        storage::ReadKeyOpts opts;
+        opts.profile_stage_ = profile_child(profile, "storage_read");
+        auto decode_stage = profile_child(profile, "decode");
+        const auto window_size = async::TaskScheduler::instance()->io_thread_count() * 2;
+        if (library_->batch_size() > 1) {
+            std::vector<std::pair<VariantKey, DecodeSliceTask>> keys_and_continuations;
+            keys_and_continuations.reserve(ranges_and_keys.size());
+            for (auto& ranges_and_key : ranges_and_keys) {
+                auto key = ranges_and_key.key_;
+                keys_and_continuations.emplace_back(std::move(key), DecodeSliceTask{std::move(ranges_and_key), columns_to_decode, decode_stage});
+            }
+            return read_in_groups(std::move(keys_and_continuations), opts, window_size);
+        }
+
         return folly::window(
             std::move(ranges_and_keys),
-            [this, columns_to_decode](auto&& ranges_and_key) {
+            [this, columns_to_decode, opts, decode_stage](auto&& ranges_and_key) {
                 const auto key = ranges_and_key.key_;
-                return read_and_continue(key, library_, storage::ReadKeyOpts{}, DecodeSliceTask{std::move(ranges_and_key), columns_to_decode});
-            }, async::TaskScheduler::instance()->io_thread_count() * 2);
+                return read_and_continue(key, library_, opts, DecodeSliceTask{std::move(ranges_and_key), columns_to_decode, decode_stage});
+            }, window_size);
     }
 
     std::vector<folly::Future<bool>> batch_key_exists(
@@ -322,10 +349,13 @@ public:
                 EncodeAtomTask(std::move(key),
                                ClockType::nanos_since_epoch(),
                                std::move(seg),
-                               codec_,
+                               codec(),
                                encoding_version_));
         }, write_count);
 
+        if (const auto batch_size = library_->batch_size(); batch_size > 1)
+            return write_in_groups(std::move(encode_futs), de_dup_map, batch_size);
+
         for (folly::Future<storage::KeySegmentPair>& encode_fut : encode_futs) {
             futs.emplace_back(
                 std::move(encode_fut).thenValue([de_dup_map](auto &&ks) -> std::pair<VariantKey, std::optional<Segment>> {
@@ -350,7 +380,91 @@ public:
         library_->set_failure_sim(cfg);
     }
 
+    void set_codec_opts(const arcticdb::proto::encoding::VariantCodec& codec) override {
+        std::atomic_store(&codec_, std::make_shared<arcticdb::proto::encoding::VariantCodec>(codec));
+    }
+
 private:
+    // The codec can be swapped while writes are in flight, each write keeps the options it started with
+    std::shared_ptr<arcticdb::proto::encoding::VariantCodec> codec() const {
+        return std::atomic_load(&codec_);
+    }
+
+    // For storages that can fetch many keys in one request: reads the keys in groups of the storage's batch size, with
+    // about window_size keys but at least one group in flight, and continues each key on its own once its group is read
+    template<typename Continuation>
+    auto read_in_groups(
+            std::vector<std::pair<VariantKey, Continuation>>&& keys_and_continuations,
+            const storage::ReadKeyOpts& opts,
+            size_t window_size) {
+        using ResultType = std::invoke_result_t<Continuation&, storage::KeySegmentPair&&>;
+        const auto batch_size = library_->batch_size();
+        std::vector<folly::Future<ResultType>> futures;
+        futures.reserve(keys_and_continuations.size());
+        std::vector<ReadCompressedBatchTask> tasks;
+        for (size_t start = 0; start < keys_and_continuations.size(); start += batch_size) {
+            const auto end = std::min(start + batch_size, keys_and_continuations.size());
+            std::vector<VariantKey> keys;
+            std::vector<folly::Promise<storage::KeySegmentPair>> promises(end - start);
+            keys.reserve(end - start);
+            for (size_t i = start; i < end; ++i) {
+                auto& [key, continuation] = keys_and_continuations[i];
+                keys.emplace_back(std::move(key));
+                futures.emplace_back(promises[i - start].getSemiFuture()
+                    .via(&async::cpu_executor())
+                    .thenValue([continuation = std::move(continuation)](storage::KeySegmentPair&& key_seg) mutable {
+                        return continuation(std::move(key_seg));
+                    }));
+            }
+            tasks.emplace_back(std::move(keys), std::move(promises), library_, opts);
+        }
+
+        // Each task fulfils the futures of its own keys, so the futures of the window itself are not needed
+        folly::window(std::move(tasks), [](auto&& task) {
+            return async::submit_io_task(std::forward<decltype(task)>(task));
+        }, std::max<size_t>(1, window_size / batch_size));
+        return futures;
+    }
+
+    // Writes the encoded segments that are not duplicates with one storage write per group of batch_size segments
+    folly::Future<std::vector<VariantKey>> write_in_groups(
+            std::vector<folly::Future<storage::KeySegmentPair>>&& encode_futs,
+            const std::shared_ptr<DeDupMap>& de_dup_map,
+            size_t batch_size) {
+        std::vector<folly::Future<std::vector<VariantKey>>> group_futs;
+        for (size_t start = 0; start < encode_futs.size(); start += batch_size) {
+            const auto end = std::min(start + batch_size, encode_futs.size());
+            std::vector<folly::Future<storage::KeySegmentPair>> group(
+                std::make_move_iterator(encode_futs.begin() + start),
+                std::make_move_iterator(encode_futs.begin() + end));
+            group_futs.emplace_back(folly::collect(std::move(group)).via(&async::io_executor())
+                .thenValue([de_dup_map, lib = library_](std::vector<storage::KeySegmentPair>&& key_segs) {
+                    std::vector<VariantKey> keys;
+                    keys.reserve(key_segs.size());
+                    std::vector<storage::KeySegmentPair> to_write;
+                    for (auto& key_seg : key_segs) {
+                        auto [key, segment] = lookup_match_in_dedup_map(de_dup_map, std::move(key_seg));
+                        if (segment)
+                            to_write.emplace_back(VariantKey{key}, std::move(*segment));
+
+                        keys.emplace_back(std::move(key));
+                    }
+                    if (!to_write.empty())
+                        lib->write(Composite<storage::KeySegmentPair>(std::move(to_write)));
+
+                    return keys;
+                }));
+        }
+
+        return folly::collect(group_futs).via(&async::io_executor()).thenValue([](std::vector<std::vector<VariantKey>>&& groups) {
+            std::vector<VariantKey> keys;
+            for (auto& group : groups)
+                std::move(group.begin(), group.end(), std::back_inserter(keys));
+
+            return keys;
+        });
+    }
+
     std::shared_ptr<storage::Library> library_;
     std::shared_ptr<arcticdb::proto::encoding::VariantCodec> codec_;
     const EncodingVersion encoding_version_;
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/read_profile.hpp>
 
 namespace arcticdb {
 struct BatchReadArgs {
@@ -33,5 +34,7 @@ struct BatchReadArgs {
 
     size_t batch_size_;
     Scheduler scheduler_;
+    // When set, each read in the batch is recorded against this stage
+    std::shared_ptr<ProfileStage> profile_stage_;
 };
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/async/parallel_for.hpp>
+#include <arcticdb/async/task_scheduler.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+namespace arcticdb::async {
+
+namespace {
+
+// Shared with the helpers submitted to the pool, which can outlive the call if they start after all the work is done
+struct ParallelForState {
+    explicit ParallelForState(size_t count) :
+        count_(count),
+        remaining_(count) {
+    }
+
+    // Returns false once there is nothing left to take. func is only used after an index has been taken, while the
+    // caller is still waiting for it.
+    bool run_next(const std::function<void(size_t)>& func) {
+        const auto index = next_.fetch_add(1, std::memory_order_relaxed);
+        if(index >= count_)
+            return false;
+
+        if(!failed_.load(std::memory_order_relaxed)) {
+            try {
+                func(index);
+            } catch(...) {
+                std::lock_guard lock{mutex_};
+                if(!exception_)
+                    exception_ = std::current_exception();
+                failed_.store(true, std::memory_order_relaxed);
+            }
+        }
+        if(remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard lock{mutex_};
+            done_.notify_all();
+        }
+        return true;
+    }
+
+    void wait() {
+        std::unique_lock lock{mutex_};
+        done_.wait(lock, [this] { return remaining_.load(std::memory_order_acquire) == 0; });
+        if(exception_)
+            std::rethrow_exception(exception_);
+    }
+
+    const size_t count_;
+    std::atomic<size_t> next_{0};
+    std::atomic<size_t> remaining_;
+    std::atomic<bool> failed_{false};
+    std::mutex mutex_;
+    std::condition_variable done_;
+    std::exception_ptr exception_;
+};
+
+} // namespace
+
+void parallel_for(size_t count, const std::function<void(size_t)>& func) {
+    if(count == 0)
+        return;
+
+    auto state = std::make_shared<ParallelForState>(count);
+    const auto helpers = std::min(count, TaskScheduler::instance()->cpu_thread_count()) - 1;
+    for(size_t i = 0; i < helpers; ++i) {
+        cpu_executor().add([state, &func] {
+            while(state->run_next(func)) {
+            }
+        });
+    }
+    while(state->run_next(func)) {
+    }
+    state->wait();
+}
+
+} // namespace arcticdb::async
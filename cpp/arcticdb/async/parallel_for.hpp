@@ -0,0 +1,25 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace arcticdb::async {
+
+/*
+ * Calls func(i) for every i in [0, count), spread over the CPU pool and the calling thread, and returns when all the
+ * calls have finished. The first exception thrown by func is rethrown once the others have finished.
+ *
+ * The calling thread takes indices from the same queue as the pool, and only waits for calls that have already
+ * started on other threads. It is therefore safe to call from a task that is itself running on a busy CPU pool: the
+ * work is done on the calling thread if no other thread is free.
+ */
+void parallel_for(size_t count, const std::function<void(size_t)>& func);
+
+} // namespace arcticdb::async
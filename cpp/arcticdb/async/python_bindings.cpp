@@ -9,6 +9,10 @@
 #include <arcticdb/async/python_bindings.hpp>
 #include <arcticdb/async/task_scheduler.hpp>
 
+#include <pybind11/stl.h>
+
+#include <map>
+
 namespace py = pybind11;
 
 namespace arcticdb::async {
@@ -23,6 +27,32 @@ void register_bindings(py::module &m) {
         }), "Number of threads used to execute tasks");
 
     async.def("print_scheduler_stats", &print_scheduler_stats);
+
+    py::enum_<TaskPriority>(async, "TaskPriority")
+        .value("INTERACTIVE", TaskPriority::INTERACTIVE)
+        .value("BATCH", TaskPriority::BATCH)
+        .value("BACKGROUND", TaskPriority::BACKGROUND);
+
+    async.def("set_task_priority", &set_current_task_priority,
+              "Set the scheduler lane used by operations started from the calling thread");
+    async.def("get_task_priority", &current_task_priority);
+
+    py::class_<LaneStats>(async, "LaneStats")
+        .def_readonly("queue_depth", &LaneStats::queue_depth_)
+        .def_readonly("tasks_run", &LaneStats::tasks_run_)
+        .def_readonly("total_wait_ns", &LaneStats::total_wait_ns_)
+        .def_readonly("max_wait_ns", &LaneStats::max_wait_ns_);
+
+    async.def("get_lane_stats", []() {
+        std::map<std::string, std::map<std::string, LaneStats>> stats;
+        for(auto lanes : {&TaskScheduler::instance()->cpu_lanes(), &TaskScheduler::instance()->io_lanes()}) {
+            for(size_t i = 0; i < num_task_priorities; ++i) {
+                const auto priority = TaskPriority(i);
+                stats[lanes->name()][std::string{task_priority_name(priority)}] = lanes->stats(priority);
+            }
+        }
+        return stats;
+    }, "Queue depth and wait times of each scheduler lane, keyed by pool then lane");
 }
 
 } // namespace arcticdb::async
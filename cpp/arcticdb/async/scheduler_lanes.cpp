@@ -0,0 +1,176 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/async/scheduler_lanes.hpp>
+#include <arcticdb/log/log.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <limits>
+
+namespace arcticdb::async {
+
+namespace {
+
+thread_local TaskPriority thread_task_priority = TaskPriority::INTERACTIVE;
+thread_local uint64_t thread_task_operation = 0;
+
+std::atomic<uint64_t> next_task_operation{1};
+
+// Strides are inversely proportional to weight, scaled so integer division keeps the ratios
+constexpr uint64_t stride_scale = 1 << 20;
+
+void update_max(std::atomic<uint64_t>& max, uint64_t value) {
+    auto current = max.load(std::memory_order_relaxed);
+    while(value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+// Decrements the count if it is non-zero, returning whether it did
+bool try_decrement(std::atomic<uint64_t>& count) {
+    auto current = count.load(std::memory_order_acquire);
+    while(current > 0) {
+        if(count.compare_exchange_weak(current, current - 1, std::memory_order_acq_rel, std::memory_order_acquire))
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TaskPriority current_task_priority() {
+    return thread_task_priority;
+}
+
+void set_current_task_priority(TaskPriority priority) {
+    thread_task_priority = priority;
+}
+
+ScopedTaskPriority::ScopedTaskPriority(TaskPriority priority) :
+    previous_(thread_task_priority) {
+    thread_task_priority = std::max(previous_, priority);
+}
+
+ScopedTaskPriority::~ScopedTaskPriority() {
+    thread_task_priority = previous_;
+}
+
+uint64_t current_task_operation() {
+    return thread_task_operation;
+}
+
+ScopedTaskOperation::ScopedTaskOperation() :
+    previous_(thread_task_operation) {
+    if(previous_ == 0)
+        thread_task_operation = next_task_operation.fetch_add(1, std::memory_order_relaxed);
+}
+
+ScopedTaskOperation::~ScopedTaskOperation() {
+    thread_task_operation = previous_;
+}
+
+LanedExecutor::LanedExecutor(folly::Executor& executor, std::string name, const LaneWeights& weights) :
+    executor_(executor),
+    name_(std::move(name)) {
+    for(size_t i = 0; i < num_task_priorities; ++i) {
+        util::check(weights[i] > 0, "Scheduler lane {} in {} must have a non-zero weight", task_priority_name(TaskPriority(i)), name_);
+        lanes_[i].stride_ = stride_scale / weights[i];
+    }
+}
+
+void LanedExecutor::add(folly::Func func) {
+    add(std::move(func), current_task_priority());
+}
+
+void LanedExecutor::add(folly::Func func, TaskPriority priority) {
+    auto& lane = lanes_[static_cast<size_t>(priority)];
+    const auto operation = thread_task_operation;
+    auto& operation_queue = lane.operations_[operation % operation_queues_per_lane];
+    operation_queue.queue_.enqueue(QueuedTask{std::move(func), priority, operation, std::chrono::steady_clock::now()});
+    operation_queue.depth_.fetch_add(1, std::memory_order_acq_rel);
+    if(lane.depth_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        // Don't let a lane bank credit while it has nothing to run
+        update_max(lane.pass_, virtual_time_.load(std::memory_order_relaxed));
+    }
+    executor_.add([this] { run_next(); });
+}
+
+void LanedExecutor::run_next() {
+    // A lane's depth is the number of its tasks that no worker has claimed yet. It is raised after the task is
+    // enqueued and before its token is posted, so while this token is unclaimed some lane has a task to claim. A
+    // claim can only fail because another worker claimed the same task first, so the loop below never waits, it
+    // just picks again.
+    Lane* lane = nullptr;
+    while(lane == nullptr) {
+        Lane* candidate = nullptr;
+        auto min_pass = std::numeric_limits<uint64_t>::max();
+        for(auto& l : lanes_) {
+            if(l.depth_.load(std::memory_order_acquire) == 0)
+                continue;
+
+            if(const auto pass = l.pass_.load(std::memory_order_relaxed); pass < min_pass) {
+                min_pass = pass;
+                candidate = &l;
+            }
+        }
+        if(candidate != nullptr && try_decrement(candidate->depth_))
+            lane = candidate;
+    }
+    // The operation queue has at least as many enqueued tasks as claims on it, so this only waits, if at all, for a
+    // concurrent enqueue to finish publishing its task
+    QueuedTask task;
+    claim_operation_queue(*lane).queue_.dequeue(task);
+    const auto pass = lane->pass_.fetch_add(lane->stride_, std::memory_order_relaxed);
+    update_max(virtual_time_, pass);
+
+    const auto wait_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - task.enqueued_).count());
+    lane->tasks_run_.fetch_add(1, std::memory_order_relaxed);
+    lane->total_wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+    update_max(lane->max_wait_ns_, wait_ns);
+
+    const auto previous_priority = thread_task_priority;
+    const auto previous_operation = thread_task_operation;
+    thread_task_priority = task.priority_;
+    thread_task_operation = task.operation_;
+    try {
+        task.func_();
+    } catch(...) {
+        thread_task_priority = previous_priority;
+        thread_task_operation = previous_operation;
+        throw;
+    }
+    thread_task_priority = previous_priority;
+    thread_task_operation = previous_operation;
+}
+
+LanedExecutor::OperationQueue& LanedExecutor::claim_operation_queue(Lane& lane) {
+    // An operation queue's depth is raised before its lane's, and a worker claims the lane before the operation
+    // queue, so a worker holding a claim on the lane always has an operation queue left to claim from. The search
+    // starts one past the queue served last, so the lane takes turns between the operations with tasks queued.
+    while(true) {
+        const auto start = lane.next_operation_.load(std::memory_order_relaxed);
+        for(size_t i = 0; i < operation_queues_per_lane; ++i) {
+            const auto index = (start + i) % operation_queues_per_lane;
+            if(try_decrement(lane.operations_[index].depth_)) {
+                lane.next_operation_.store(index + 1, std::memory_order_relaxed);
+                return lane.operations_[index];
+            }
+        }
+    }
+}
+
+LaneStats LanedExecutor::stats(TaskPriority priority) const {
+    const auto& lane = lanes_[static_cast<size_t>(priority)];
+    return {
+        lane.depth_.load(std::memory_order_relaxed),
+        lane.tasks_run_.load(std::memory_order_relaxed),
+        lane.total_wait_ns_.load(std::memory_order_relaxed),
+        lane.max_wait_ns_.load(std::memory_order_relaxed)
+    };
+}
+
+} // namespace arcticdb::async
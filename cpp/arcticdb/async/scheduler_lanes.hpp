@@ -0,0 +1,151 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/util/constructors.hpp>
+
+#include <folly/Executor.h>
+#include <folly/concurrency/UnboundedQueue.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace arcticdb::async {
+
+/*
+ * The lane a task is scheduled in. Tasks inherit the priority of the thread that submits them, and the worker
+ * running a task takes on its priority, so continuations and nested submissions stay in the lane of the top-level
+ * operation that started them.
+ */
+enum class TaskPriority : uint8_t {
+    INTERACTIVE = 0,
+    BATCH = 1,
+    BACKGROUND = 2
+};
+
+constexpr size_t num_task_priorities = 3;
+
+inline std::string_view task_priority_name(TaskPriority priority) {
+    switch(priority) {
+    case TaskPriority::INTERACTIVE: return "interactive";
+    case TaskPriority::BATCH: return "batch";
+    case TaskPriority::BACKGROUND: return "background";
+    default: return "unknown";
+    }
+}
+
+TaskPriority current_task_priority();
+
+void set_current_task_priority(TaskPriority priority);
+
+// Lowers the priority of the current thread for the lifetime of the object. It never raises it, so an operation
+// that marks itself as batch work stays in the background lane if its caller asked for that.
+class ScopedTaskPriority {
+public:
+    explicit ScopedTaskPriority(TaskPriority priority);
+    ~ScopedTaskPriority();
+    ARCTICDB_NO_MOVE_OR_COPY(ScopedTaskPriority)
+
+private:
+    TaskPriority previous_;
+};
+
+// The top-level operation the current thread is working for, or zero if it is not in one
+uint64_t current_task_operation();
+
+// Starts a new top-level operation on the current thread for the lifetime of the object, unless the thread is already
+// working for one, in which case nested work stays part of it. Like the priority, the operation is carried by every
+// task the thread submits, and taken on by the worker that runs it.
+class ScopedTaskOperation {
+public:
+    ScopedTaskOperation();
+    ~ScopedTaskOperation();
+    ARCTICDB_NO_MOVE_OR_COPY(ScopedTaskOperation)
+
+private:
+    uint64_t previous_;
+};
+
+struct LaneStats {
+    uint64_t queue_depth_ = 0;
+    uint64_t tasks_run_ = 0;
+    uint64_t total_wait_ns_ = 0;
+    uint64_t max_wait_ns_ = 0;
+};
+
+using LaneWeights = std::array<uint32_t, num_task_priorities>;
+
+/*
+ * Sits in front of a thread pool and shares it between the priority lanes by weight, using stride scheduling: a
+ * lane that has had less than its share of the pool so far goes first. Each task added to a lane adds a token to
+ * the pool, and a worker picking up a token runs the next task from whichever lane is owed the most, so a burst of
+ * batch work queued ahead of an interactive read does not make the read wait behind all of it.
+ *
+ * Within a lane, tasks are queued by the operation that submitted them, and the lane takes turns between the
+ * operations that have tasks queued, so two reads in the same lane share it rather than the later one waiting for
+ * the earlier to finish. Operations are spread over a fixed number of queues per lane by id, so only operations that
+ * land on the same queue share a turn.
+ *
+ * Submission only touches lock-free queues and atomics.
+ */
+class LanedExecutor : public folly::Executor {
+public:
+    LanedExecutor(folly::Executor& executor, std::string name, const LaneWeights& weights);
+    ARCTICDB_NO_MOVE_OR_COPY(LanedExecutor)
+
+    void add(folly::Func func) override;
+
+    void add(folly::Func func, TaskPriority priority);
+
+    [[nodiscard]] LaneStats stats(TaskPriority priority) const;
+
+    [[nodiscard]] const std::string& name() const { return name_; }
+
+    static constexpr size_t operation_queues_per_lane = 8;
+
+private:
+    struct QueuedTask {
+        folly::Func func_;
+        TaskPriority priority_ = TaskPriority::INTERACTIVE;
+        uint64_t operation_ = 0;
+        std::chrono::steady_clock::time_point enqueued_;
+    };
+
+    struct OperationQueue {
+        folly::UMPMCQueue<QueuedTask, false> queue_;
+        // Tasks in the queue that no worker has claimed yet
+        std::atomic<uint64_t> depth_{0};
+    };
+
+    struct Lane {
+        std::array<OperationQueue, operation_queues_per_lane> operations_;
+        // The operation queue to look at first for the next task, one past the last served
+        std::atomic<size_t> next_operation_{0};
+        std::atomic<uint64_t> depth_{0};
+        std::atomic<uint64_t> pass_{0};
+        uint64_t stride_ = 1;
+        std::atomic<uint64_t> tasks_run_{0};
+        std::atomic<uint64_t> total_wait_ns_{0};
+        std::atomic<uint64_t> max_wait_ns_{0};
+    };
+
+    void run_next();
+
+    static OperationQueue& claim_operation_queue(Lane& lane);
+
+    folly::Executor& executor_;
+    std::string name_;
+    std::array<Lane, num_task_priorities> lanes_;
+    // The pass of the last lane served, so a lane that has been idle starts level with the others
+    std::atomic<uint64_t> virtual_time_{0};
+};
+
+} // namespace arcticdb::async
@@ -65,6 +65,16 @@ void print_scheduler_stats() {
     auto io_stats = TaskScheduler::instance()->io_exec().getPoolStats();
     log::schedule().info("IO: Threads: {}\tIdle: {}\tActive: {}\tPending: {}\tTotal: {}\tMaxIdleTime: {}",
         io_stats.threadCount, io_stats.idleThreadCount, io_stats.activeThreadCount, io_stats.pendingTaskCount, io_stats.totalTaskCount, io_stats.maxIdleTime.count());
+
+    for(auto lanes : {&TaskScheduler::instance()->cpu_lanes(), &TaskScheduler::instance()->io_lanes()}) {
+        for(size_t i = 0; i < num_task_priorities; ++i) {
+            const auto priority = TaskPriority(i);
+            const auto stats = lanes->stats(priority);
+            log::schedule().info("{} {} lane: Queued: {}\tRun: {}\tMeanWaitNs: {}\tMaxWaitNs: {}",
+                lanes->name(), task_priority_name(priority), stats.queue_depth_, stats.tasks_run_,
+                stats.tasks_run_ == 0 ? 0 : stats.total_wait_ns_ / stats.tasks_run_, stats.max_wait_ns_);
+        }
+    }
 }
 
 } // namespace arcticdb
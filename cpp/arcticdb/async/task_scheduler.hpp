@@ -14,11 +14,13 @@
 #include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/util/home_directory.hpp>
 #include <arcticdb/async/base_task.hpp>
+#include <arcticdb/async/scheduler_lanes.hpp>
 #include <arcticdb/entity/performance_tracing.hpp>
 
 #include <folly/executors/FutureExecutor.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
 
 #include <thread>
 #include <algorithm>
@@ -137,7 +139,8 @@ inline auto get_default_num_cpus() {
  * amortize costs wherever possible
  * 2/ Worker thread Affinity - would better locality improve throughput by keeping hot structure in
  * hot cachelines and not jumping from one thread to the next (assuming thread/core affinity in hw too) ?
- * 3/ Priority: How to assign priorities to task in order to treat the most pressing first.
+ * 3/ Priority: lanes (see LanedExecutor) share the pools between interactive, batch and background work, and
+ * each lane takes turns between the top-level operations queued in it.
  * 4/ Throttling: (similar to priority) how to absorb work spikes and apply memory backpressure
  */
 
@@ -145,6 +148,14 @@ inline int64_t default_io_thread_count(uint64_t cpu_count) {
     return std::min(int64_t(100L), static_cast<int64_t>(static_cast<double>(cpu_count) * 1.5));
 }
 
+inline LaneWeights default_lane_weights() {
+    return {
+        static_cast<uint32_t>(ConfigsMap::instance()->get_int("Scheduler.InteractiveWeight", 16)),
+        static_cast<uint32_t>(ConfigsMap::instance()->get_int("Scheduler.BatchWeight", 4)),
+        static_cast<uint32_t>(ConfigsMap::instance()->get_int("Scheduler.BackgroundWeight", 1))
+    };
+}
+
 class TaskScheduler {
   public:
     using CPUSchedulerType = folly::FutureExecutor<folly::CPUThreadPoolExecutor>;
@@ -154,20 +165,24 @@ class TaskScheduler {
         cpu_thread_count_(cpu_thread_count ? *cpu_thread_count : ConfigsMap::instance()->get_int("VersionStore.NumCPUThreads", get_default_num_cpus())),
         io_thread_count_(io_thread_count ? *io_thread_count : ConfigsMap::instance()->get_int("VersionStore.NumIOThreads", std::min(100, (int) (cpu_thread_count_ * 1.5)))),
         cpu_exec_(cpu_thread_count_, std::make_shared<InstrumentedNamedFactory>("CPUPool")) ,
-        io_exec_(io_thread_count_,  std::make_shared<InstrumentedNamedFactory>("IOPool")){
+        io_exec_(io_thread_count_,  std::make_shared<InstrumentedNamedFactory>("IOPool")),
+        cpu_lanes_(cpu_exec_, "CPU", default_lane_weights()),
+        io_lanes_(io_exec_, "IO", default_lane_weights()) {
         util::check(cpu_thread_count_ > 0 && io_thread_count_ > 0, "Zero IO or CPU threads: {} {}", io_thread_count_, cpu_thread_count_);
         ARCTICDB_RUNTIME_DEBUG(log::schedule(), "Task scheduler created with {:d} {:d}", cpu_thread_count_, io_thread_count_);
     }
 
-    ~TaskScheduler() = default;
+    ~TaskScheduler() {
+        // The lanes are destroyed before the pools, so drain the pools first: every token they run refers to a lane
+        join();
+    }
 
     template<class Task>
     auto submit_cpu_task(Task &&t) {
         auto task = std::forward<decltype(t)>(t);
         static_assert(std::is_base_of_v<BaseTask, std::decay_t<Task>>, "Only supports Task derived from BaseTask");
         ARCTICDB_DEBUG(log::schedule(), "{} Submitting CPU task {}: {} of {}", uintptr_t(this), typeid(task).name(), cpu_exec_.getTaskQueueSize(), cpu_exec_.kDefaultMaxQueueSize);
-        std::lock_guard lock{cpu_mutex_};
-        return cpu_exec_.addFuture(std::move(task));
+        return folly::via(folly::getKeepAliveToken(cpu_lanes_), std::move(task));
     }
 
     template<class Task>
@@ -175,8 +190,7 @@ class TaskScheduler {
         auto task = std::forward<decltype(t)>(t);
         static_assert(std::is_base_of_v<BaseTask, std::decay_t<Task>>, "Only support Tasks derived from BaseTask");
         ARCTICDB_DEBUG(log::schedule(), "{} Submitting IO task {}: {}", uintptr_t(this), typeid(task).name(), io_exec_.getPendingTaskCount());
-        std::lock_guard lock{io_mutex_};
-        return io_exec_.addFuture(std::move(task));
+        return folly::via(folly::getKeepAliveToken(io_lanes_), std::move(task));
     }
 
     static std::shared_ptr<TaskSchedulerPtrWrapper> instance_;
@@ -227,6 +241,15 @@ class TaskScheduler {
         return io_exec_;
     }
 
+    // Executors that schedule onto the pools through the priority lanes, use these for continuations
+    LanedExecutor& cpu_lanes() {
+        return cpu_lanes_;
+    }
+
+    LanedExecutor& io_lanes() {
+        return io_lanes_;
+    }
+
     void re_init() {
         ARCTICDB_RUNTIME_DEBUG(log::schedule(), "Reinitializing task scheduler: {} {}", cpu_thread_count_, io_thread_count_);
         ARCTICDB_RUNTIME_DEBUG(log::schedule(), "IO exec num threads: {}", io_exec_.numActiveThreads());
@@ -252,17 +275,18 @@ private:
     size_t io_thread_count_;
     SchedulerWrapper<CPUSchedulerType> cpu_exec_;
     SchedulerWrapper<IOSchedulerType> io_exec_;
-    std::mutex cpu_mutex_;
-    std::mutex io_mutex_;
+    // Declared after the pools, which they refer to
+    LanedExecutor cpu_lanes_;
+    LanedExecutor io_lanes_;
 };
 
 
 inline auto& cpu_executor() {
-    return TaskScheduler::instance()->cpu_exec();
+    return TaskScheduler::instance()->cpu_lanes();
 }
 
 inline auto& io_executor() {
-    return TaskScheduler::instance()->io_exec();
+    return TaskScheduler::instance()->io_lanes();
 }
 
 template <typename Task>
@@ -48,6 +48,10 @@ namespace arcticdb::async {
         ARCTICDB_TRACE(log::codec(), "Creating segment");
         SegmentInMemory segment_in_memory(std::move(descriptor));
         decode_into_memory_segment(seg, hdr, segment_in_memory, desc);
+        if (profile_stage_) {
+            profile_stage_->add("bytes_decompressed", segment_in_memory.num_bytes());
+            profile_stage_->add("rows", segment_in_memory.row_count());
+        }
         return pipelines::SegmentAndSlice(std::move(ranges_and_key_), std::move(segment_in_memory));
     }
 
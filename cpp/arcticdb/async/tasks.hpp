@@ -22,8 +22,12 @@
 #include <arcticdb/pipeline/frame_slice.hpp>
 #include <arcticdb/processing/processing_unit.hpp>
 #include <arcticdb/util/constructors.hpp>
+#include <arcticdb/util/read_profile.hpp>
+
+#include <folly/futures/Promise.h>
 
 #include <type_traits>
+#include <unordered_map>
 
 namespace arcticdb::async {
 
@@ -216,7 +220,78 @@ struct ReadCompressedTask : BaseTask {
 
     KeySegmentContinuation<ContinuationType> operator()() {
         ARCTICDB_SAMPLE(ReadCompressed, 0)
-        return KeySegmentContinuation<decltype(continuation_)>{read_dispatch(key_, lib_, opts_), std::move(continuation_)};
+        auto key_segment_pair = [this]() {
+            ScopedProfileTimer profile_timer(opts_.profile_stage_);
+            return read_dispatch(key_, lib_, opts_);
+        }();
+        profile_add(opts_.profile_stage_, "bytes_fetched", key_segment_pair.segment().total_segment_size());
+        return KeySegmentContinuation<decltype(continuation_)>{std::move(key_segment_pair), std::move(continuation_)};
+    }
+};
+
+// Reads all the keys with a single storage read and fulfils each key's promise with its segment, or with the
+// exception of the read if the segment did not arrive
+struct ReadCompressedBatchTask : BaseTask {
+    std::vector<entity::VariantKey> keys_;
+    std::vector<folly::Promise<storage::KeySegmentPair>> promises_;
+    std::shared_ptr<storage::Library> lib_;
+    storage::ReadKeyOpts opts_;
+
+    ReadCompressedBatchTask(
+        std::vector<entity::VariantKey>&& keys,
+        std::vector<folly::Promise<storage::KeySegmentPair>>&& promises,
+        std::shared_ptr<storage::Library> lib,
+        storage::ReadKeyOpts opts)
+        : keys_(std::move(keys)),
+        promises_(std::move(promises)),
+        lib_(std::move(lib)),
+        opts_(opts) {
+        util::check(!keys_.empty(), "ReadCompressedBatch task created with no keys");
+        util::check(keys_.size() == promises_.size(), "Mismatched keys and promises in ReadCompressedBatch task: {} != {}",
+                    keys_.size(), promises_.size());
+        ARCTICDB_DEBUG(log::storage(), "Creating read compressed batch task for {} keys", keys_.size());
+    }
+
+    ARCTICDB_MOVE_ONLY_DEFAULT(ReadCompressedBatchTask)
+
+    folly::Unit operator()() {
+        ARCTICDB_SAMPLE(ReadCompressedBatch, 0)
+        std::unordered_map<entity::VariantKey, std::vector<size_t>> positions;
+        for (size_t i = 0; i < keys_.size(); ++i)
+            positions[keys_[i]].push_back(i);
+
+        auto visitor = [this, &positions](const entity::VariantKey& key, Segment&& segment) {
+            auto it = positions.find(key);
+            if (it == positions.end())
+                return;
+
+            profile_add(opts_.profile_stage_, "bytes_fetched", segment.total_segment_size());
+            const auto& indexes = it->second;
+            for (size_t i = 1; i < indexes.size(); ++i)
+                promises_[indexes[i]].setValue(storage::KeySegmentPair{entity::VariantKey{key}, Segment{segment}});
+
+            promises_[indexes.front()].setValue(storage::KeySegmentPair{entity::VariantKey{key}, std::move(segment)});
+            positions.erase(it);
+        };
+
+        folly::exception_wrapper failure;
+        try {
+            ScopedProfileTimer profile_timer(opts_.profile_stage_);
+            lib_->read(Composite<entity::VariantKey>(std::vector<entity::VariantKey>(keys_)), visitor, opts_);
+        } catch (...) {
+            failure = folly::exception_wrapper{std::current_exception()};
+        }
+
+        for (size_t i = 0; i < promises_.size(); ++i) {
+            if (promises_[i].isFulfilled())
+                continue;
+
+            if (failure)
+                promises_[i].setException(failure);
+            else
+                promises_[i].setException(storage::KeyNotFoundException{Composite<entity::VariantKey>{entity::VariantKey{keys_[i]}}});
+        }
+        return folly::Unit{};
     }
 };
 
@@ -317,16 +392,20 @@ struct DecodeSliceTask : BaseTask {
 
     pipelines::RangesAndKey ranges_and_key_;
     std::shared_ptr<std::unordered_set<std::string>> columns_to_decode_;
+    std::shared_ptr<ProfileStage> profile_stage_;
 
     explicit DecodeSliceTask(
             pipelines::RangesAndKey&& ranges_and_key,
-            std::shared_ptr<std::unordered_set<std::string>> columns_to_decode):
+            std::shared_ptr<std::unordered_set<std::string>> columns_to_decode,
+            std::shared_ptr<ProfileStage> profile_stage = nullptr):
             ranges_and_key_(std::move(ranges_and_key)),
-            columns_to_decode_(columns_to_decode) {
+            columns_to_decode_(columns_to_decode),
+            profile_stage_(std::move(profile_stage)) {
     }
 
     pipelines::SegmentAndSlice operator()(storage::KeySegmentPair&& key_segment_pair) {
         ARCTICDB_SAMPLE(DecodeSliceTask, 0)
+        ScopedProfileTimer profile_timer(profile_stage_);
         return decode_into_slice(std::move(key_segment_pair));
     }
 
@@ -377,19 +456,27 @@ struct SegmentFunctionTask : BaseTask {
 struct MemSegmentProcessingTask : BaseTask {
     std::vector<std::shared_ptr<Clause>> clauses_;
     Composite<EntityIds> entity_ids_;
+    // One per clause when the read is being profiled, otherwise empty
+    std::vector<std::shared_ptr<ProfileStage>> profile_stages_;
 
     explicit MemSegmentProcessingTask(
            std::vector<std::shared_ptr<Clause>> clauses,
-           Composite<EntityIds>&& entity_ids) :
+           Composite<EntityIds>&& entity_ids,
+           std::vector<std::shared_ptr<ProfileStage>> profile_stages = {}) :
         clauses_(std::move(clauses)),
-        entity_ids_(std::move(entity_ids)) {
+        entity_ids_(std::move(entity_ids)),
+        profile_stages_(std::move(profile_stages)) {
     }
 
     ARCTICDB_MOVE_ONLY_DEFAULT(MemSegmentProcessingTask)
 
     Composite<EntityIds> operator()() {
-        for(const auto& clause : clauses_) {
-            entity_ids_ = clause->process(std::move(entity_ids_));
+        for(size_t idx = 0; idx < clauses_.size(); ++idx) {
+            const auto& clause = clauses_[idx];
+            {
+                ScopedProfileStage profile_stage(idx < profile_stages_.size() ? profile_stages_[idx] : nullptr);
+                entity_ids_ = clause->process(std::move(entity_ids_));
+            }
 
             if(clause->clause_info().requires_repartition_)
                 break;
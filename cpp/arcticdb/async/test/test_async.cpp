@@ -17,7 +17,11 @@
 #include <fmt/format.h>
 #include <google/protobuf/text_format.h>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace ac = arcticdb;
@@ -95,6 +99,45 @@ TEST(Async, DeDupTest) {
     ASSERT_EQ(2, to_atom(keys[1]).version_id());
 }
 
+TEST(Async, ReadCompressedBatchFulfilsEachKey) {
+    as::EnvironmentName environment_name{"research"};
+    as::StorageName storage_name("lmdb_local");
+    as::LibraryPath library_path{"a", "b"};
+
+    auto env_config = arcticdb::get_test_environment_config(library_path, storage_name, environment_name);
+    auto config_resolver = as::create_in_memory_resolver(env_config);
+    as::LibraryIndex library_index{environment_name, config_resolver};
+
+    as::UserAuth au{"abc"};
+    auto lib = library_index.get_library(library_path, as::OpenMode::WRITE, au);
+    auto codec_opt = std::make_shared<arcticdb::proto::encoding::VariantCodec>();
+    auto write_key = [&lib, &codec_opt](ac::VersionId version_id) {
+        aa::EncodeAtomTask enc{
+            ac::entity::KeyType::TABLE_DATA, version_id, 123, 456, 457, 999, ac::SegmentInMemory(), codec_opt, ac::EncodingVersion::V2
+        };
+        return aa::WriteSegmentTask{lib}(enc());
+    };
+
+    auto first = write_key(1);
+    auto second = write_key(2);
+    auto missing = ac::entity::atom_key_builder().gen_id(3).start_index(456).end_index(457).creation_ts(999)
+            .build(123, ac::entity::KeyType::TABLE_DATA);
+
+    // The first key is asked for twice and each of its promises gets a segment of its own
+    std::vector<ac::entity::VariantKey> keys{first, second, first, missing};
+    std::vector<folly::Promise<as::KeySegmentPair>> promises(keys.size());
+    std::vector<folly::SemiFuture<as::KeySegmentPair>> futures;
+    for (auto& promise : promises)
+        futures.emplace_back(promise.getSemiFuture());
+
+    aa::ReadCompressedBatchTask{std::move(keys), std::move(promises), lib, as::ReadKeyOpts{}}();
+
+    ASSERT_EQ(to_atom(std::move(futures[0]).get().variant_key()), to_atom(first));
+    ASSERT_EQ(to_atom(std::move(futures[1]).get().variant_key()), to_atom(second));
+    ASSERT_EQ(to_atom(std::move(futures[2]).get().variant_key()), to_atom(first));
+    ASSERT_THROW(std::move(futures[3]).get(), as::KeyNotFoundException);
+}
+
 struct DummyTask : arcticdb::async::BaseTask {
     folly::Future<int> operator()() {
         using namespace arcticdb;
@@ -220,4 +263,112 @@ TEST(Async, DynamicSizing) {
     auto f2 = multiplex(std::move(f1));
     p.setValue(5);
     auto v = std::move(f2).get();
-}
\ No newline at end of file
+}
+
+TEST(Async, LanesServeInteractiveAheadOfQueuedBatchWork) {
+    using namespace arcticdb::async;
+    folly::CPUThreadPoolExecutor pool{1};
+    LanedExecutor lanes{pool, "test", {16, 4, 1}};
+
+    // Hold the only worker so everything below is queued before anything runs
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    pool.add([released] { released.wait(); });
+
+    std::mutex order_mutex;
+    std::vector<TaskPriority> order;
+    auto record = [&order_mutex, &order] {
+        std::lock_guard lock{order_mutex};
+        order.emplace_back(current_task_priority());
+    };
+    for (auto i = 0; i < 20; ++i)
+        lanes.add(record, TaskPriority::BATCH);
+    lanes.add(record, TaskPriority::BACKGROUND);
+    lanes.add(record, TaskPriority::INTERACTIVE);
+    ASSERT_EQ(lanes.stats(TaskPriority::BATCH).queue_depth_, 20u);
+
+    release.set_value();
+    pool.join();
+
+    ASSERT_EQ(order.size(), 22u);
+    // The interactive task was submitted last but is served within the first couple of tasks, and the background
+    // lane still gets a turn before the batch lane has drained
+    auto position = [&order](TaskPriority priority) {
+        return std::distance(order.begin(), std::find(order.begin(), order.end(), priority));
+    };
+    ASSERT_LE(position(TaskPriority::INTERACTIVE), 1);
+    ASSERT_LT(position(TaskPriority::BACKGROUND), 21);
+
+    const auto batch_stats = lanes.stats(TaskPriority::BATCH);
+    ASSERT_EQ(batch_stats.queue_depth_, 0u);
+    ASSERT_EQ(batch_stats.tasks_run_, 20u);
+    ASSERT_GE(batch_stats.max_wait_ns_, batch_stats.total_wait_ns_ / batch_stats.tasks_run_);
+}
+
+TEST(Async, LanesTakeTurnsBetweenOperations) {
+    using namespace arcticdb::async;
+    folly::CPUThreadPoolExecutor pool{1};
+    LanedExecutor lanes{pool, "test", {16, 4, 1}};
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    pool.add([released] { released.wait(); });
+
+    std::mutex order_mutex;
+    std::vector<uint64_t> order;
+    auto record = [&order_mutex, &order] {
+        std::lock_guard lock{order_mutex};
+        order.emplace_back(current_task_operation());
+    };
+    // Two reads in the same lane, the second submitted only once the first has queued all of its tasks
+    constexpr size_t tasks_per_operation = 10;
+    std::vector<uint64_t> operations;
+    for (auto i = 0; i < 2; ++i) {
+        ScopedTaskOperation operation;
+        operations.emplace_back(current_task_operation());
+        {
+            // Nested work stays part of the operation it was started from
+            ScopedTaskOperation nested;
+            ASSERT_EQ(current_task_operation(), operations.back());
+        }
+        for (size_t task = 0; task < tasks_per_operation; ++task)
+            lanes.add(record, TaskPriority::INTERACTIVE);
+    }
+    ASSERT_EQ(current_task_operation(), 0u);
+    ASSERT_NE(operations[0], operations[1]);
+
+    release.set_value();
+    pool.join();
+
+    // Each task ran as part of the operation that submitted it, and the two operations were served in turn
+    ASSERT_EQ(order.size(), 2 * tasks_per_operation);
+    ASSERT_EQ(static_cast<size_t>(std::count(order.begin(), order.end(), operations[0])), tasks_per_operation);
+    ASSERT_EQ(static_cast<size_t>(std::count(order.begin(), order.end(), operations[1])), tasks_per_operation);
+    for (size_t i = 1; i < order.size(); ++i)
+        ASSERT_NE(order[i], order[i - 1]);
+}
+
+TEST(Async, LanesRunEveryTaskOnceUnderContention) {
+    using namespace arcticdb::async;
+    folly::CPUThreadPoolExecutor pool{8};
+    LanedExecutor lanes{pool, "test", {16, 4, 1}};
+
+    constexpr size_t tasks_per_thread = 5000;
+    std::atomic<size_t> run_count{0};
+    std::vector<std::thread> submitters;
+    for (size_t t = 0; t < num_task_priorities; ++t) {
+        submitters.emplace_back([&lanes, &run_count, t] {
+            for (size_t i = 0; i < tasks_per_thread; ++i)
+                lanes.add([&run_count] { run_count.fetch_add(1); }, TaskPriority(t));
+        });
+    }
+    for (auto& submitter : submitters)
+        submitter.join();
+    pool.join();
+
+    ASSERT_EQ(run_count.load(), num_task_priorities * tasks_per_thread);
+    for (size_t t = 0; t < num_task_priorities; ++t) {
+        ASSERT_EQ(lanes.stats(TaskPriority(t)).tasks_run_, tasks_per_thread);
+        ASSERT_EQ(lanes.stats(TaskPriority(t)).queue_depth_, 0u);
+    }
+}
@@ -0,0 +1,130 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/codec/adaptive_codec.hpp>
+#include <arcticdb/codec/lz4.hpp>
+#include <arcticdb/codec/zstd.hpp>
+#include <arcticdb/log/log.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace arcticdb::codec {
+
+namespace {
+
+constexpr size_t default_sample_bytes = 64 * 1024;
+constexpr double default_min_gain = 0.05;
+constexpr size_t sample_slices = 4;
+constexpr int default_zstd_levels[] = {1, 3};
+
+// The sample is copied into a buffer that is reused by the thread, as is the buffer it is trial-compressed into
+std::vector<uint8_t>& sample_buffer() {
+    thread_local std::vector<uint8_t> buffer;
+    return buffer;
+}
+
+std::vector<uint8_t>& trial_buffer() {
+    thread_local std::vector<uint8_t> buffer;
+    return buffer;
+}
+
+const uint8_t* take_sample(const uint8_t* data, size_t bytes, size_t element_size, size_t sample_bytes, size_t& taken) {
+    if(bytes <= sample_bytes) {
+        taken = bytes;
+        return data;
+    }
+
+    const auto elements = bytes / element_size;
+    const auto slice_elements = std::max<size_t>(sample_bytes / (sample_slices * element_size), 1);
+    const auto stride = elements / sample_slices;
+    auto& buffer = sample_buffer();
+    buffer.resize(sample_slices * slice_elements * element_size);
+    taken = 0;
+    for(size_t slice = 0; slice < sample_slices; ++slice) {
+        const auto start = std::min(slice * stride, elements - slice_elements);
+        const auto slice_bytes = slice_elements * element_size;
+        std::memcpy(buffer.data() + taken, data + start * element_size, slice_bytes);
+        taken += slice_bytes;
+    }
+    return buffer.data();
+}
+
+size_t lz4_compressed_size(const uint8_t* sample, size_t bytes) {
+    auto& out = trial_buffer();
+    out.resize(detail::Lz4BlockEncoder::max_compressed_size(bytes));
+    const auto compressed = LZ4_compress_fast_extState(
+        detail::lz4_compression_state(),
+        reinterpret_cast<const char*>(sample),
+        reinterpret_cast<char*>(out.data()),
+        int(bytes),
+        int(out.size()),
+        1);
+    util::check(compressed > 0, "Lz4 trial compression of {} bytes failed", bytes);
+    return size_t(compressed);
+}
+
+size_t zstd_compressed_size(const uint8_t* sample, size_t bytes, int level) {
+    auto& out = trial_buffer();
+    out.resize(detail::ZstdBlockEncoder::max_compressed_size(bytes));
+    const auto compressed = ZSTD_compressCCtx(detail::zstd_compression_context(), out.data(), out.size(), sample, bytes, level);
+    util::check(!ZSTD_isError(compressed), "Zstd trial compression failed: {}", ZSTD_getErrorName(compressed));
+    return compressed;
+}
+
+} // namespace
+
+arcticdb::proto::encoding::VariantCodec choose_block_codec(
+    const arcticdb::proto::encoding::VariantCodec::Adaptive& opts,
+    const uint8_t* data,
+    size_t bytes,
+    size_t element_size) {
+    arcticdb::proto::encoding::VariantCodec chosen;
+    chosen.mutable_passthrough();
+    if(bytes == 0)
+        return chosen;
+
+    const auto sample_bytes = opts.sample_bytes() != 0 ? size_t(opts.sample_bytes()) : default_sample_bytes;
+    size_t taken;
+    const auto* sample = take_sample(data, bytes, element_size, sample_bytes, taken);
+
+    // Candidates are tried fastest to decode first, and a slower one has to beat the best so far by min_gain
+    const auto min_gain = opts.min_gain() != 0 ? static_cast<double>(opts.min_gain()) : default_min_gain;
+    const auto required_gain = min_gain * static_cast<double>(taken);
+    auto best_size = static_cast<double>(taken);
+    auto consider = [&](size_t size, auto&& set_codec) {
+        if(static_cast<double>(size) + required_gain < best_size) {
+            best_size = static_cast<double>(size);
+            set_codec();
+        }
+    };
+
+    consider(lz4_compressed_size(sample, taken), [&chosen] {
+        chosen.mutable_lz4()->set_acceleration(1);
+    });
+
+    auto consider_zstd = [&](int level) {
+        consider(zstd_compressed_size(sample, taken, level), [&chosen, level] {
+            chosen.mutable_zstd()->set_level(level);
+        });
+    };
+    if(opts.zstd_levels().empty()) {
+        for(auto level : default_zstd_levels)
+            consider_zstd(level);
+    } else {
+        for(auto level : opts.zstd_levels())
+            consider_zstd(level);
+    }
+
+    ARCTICDB_TRACE(log::codec(), "Chose codec {} for block of {} bytes from a {} byte sample compressed to {}",
+                   chosen.ShortDebugString(), bytes, taken, best_size);
+    return chosen;
+}
+
+} // namespace arcticdb::codec
@@ -0,0 +1,28 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/entity/protobufs.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace arcticdb::codec {
+
+/*
+ * Picks the codec for a block of an adaptive column by trial-compressing a sample of it with each candidate. The
+ * sample is taken from a few places spread through the block, each a whole number of elements, so that runs and
+ * deltas between neighbouring values are kept. Returns passthrough for an empty block.
+ */
+arcticdb::proto::encoding::VariantCodec choose_block_codec(
+    const arcticdb::proto::encoding::VariantCodec::Adaptive& opts,
+    const uint8_t* data,
+    size_t bytes,
+    size_t element_size);
+
+} // namespace arcticdb::codec
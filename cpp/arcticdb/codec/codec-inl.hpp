@@ -38,6 +38,7 @@ void decode_block(const BlockType &block, const std::uint8_t *input, T *output)
         std::uint32_t encoder_version = block.encoder_version();
         switch (block.codec().codec_case()) {
             case arcticdb::proto::encoding::VariantCodec::kZstd:
+            case arcticdb::proto::encoding::VariantCodec::kZstdDictionary:
                 arcticdb::detail::ZstdDecoder::decode_block<T>(encoder_version,
                                                      input,
                                                      size_to_decode,
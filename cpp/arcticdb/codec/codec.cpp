@@ -10,6 +10,7 @@
 #include <arcticdb/codec/default_codecs.hpp>
 #include <arcticdb/codec/encoded_field.hpp>
 #include <arcticdb/codec/encoded_field_collection.hpp>
+#include <arcticdb/async/parallel_for.hpp>
 
 
 #include <string>
@@ -54,6 +55,12 @@ Segment encode_dispatch(
     }
 }
 
+bool use_parallel_columns(size_t num_columns, size_t bytes) {
+    return num_columns > 1
+        && ConfigsMap::instance()->get_int("Codec.ParallelColumns", 1) != 0
+        && bytes >= static_cast<size_t>(ConfigsMap::instance()->get_int("Codec.ParallelColumnsMinBytes", 4 << 20));
+}
+
 namespace {
 class MetaBuffer {
   public:
@@ -309,6 +316,44 @@ void decode_string_pool( const arcticdb::proto::encoding::SegmentHeader& hdr,
     }
 }
 
+// Each field starts where the one before it ends, so where every field starts is known from the sizes in the header
+// before any are decoded. The fields are then decoded into their columns concurrently. Returns the end of the fields.
+template<typename FieldAt, typename FieldNameAt>
+const uint8_t* decode_fields_in_parallel(
+    size_t fields_size,
+    FieldAt&& field_at,
+    FieldNameAt&& field_name_at,
+    size_t magic_size,
+    const uint8_t* data,
+    const uint8_t* end,
+    SegmentInMemory& res,
+    EncodingVersion encoding_version) {
+    struct FieldToDecode {
+        size_t field_index_;
+        position_t column_index_;
+        const uint8_t* data_;
+        size_t bytes_;
+    };
+
+    std::vector<FieldToDecode> to_decode;
+    for (std::size_t i = 0; i < fields_size; ++i) {
+        util::check(data!=end, "Reached end of input block with {} fields to decode", fields_size-i);
+        const auto bytes = encoding_sizes::field_compressed_size(field_at(i)) + magic_size;
+        if(auto col_index = res.column_index(field_name_at(i)))
+            to_decode.push_back(FieldToDecode{i, static_cast<position_t>(*col_index), data, bytes});
+
+        data += bytes;
+    }
+
+    async::parallel_for(to_decode.size(), [&](size_t n) {
+        const auto& field = to_decode[n];
+        auto& col = res.column(field.column_index_);
+        const auto bytes = decode_field(res.field(field.column_index_).type(), field_at(field.field_index_), field.data_, col, col.opt_sparse_map(), encoding_version);
+        util::check(bytes == field.bytes_, "Decoded {} bytes for field {} which should have {}", bytes, field.field_index_, field.bytes_);
+    });
+    return data;
+}
+
 void decode_v2(const Segment& segment,
            arcticdb::proto::encoding::SegmentHeader& hdr,
            SegmentInMemory& res,
@@ -341,19 +386,31 @@ void decode_v2(const Segment& segment,
         const auto seg_row_count = fields_size ? ssize_t(encoded_fields.at(0).ndarray().items_count()) : 0L;
         res.init_column_map();
 
-        for (std::size_t i = 0; i < static_cast<size_t>(fields_size); ++i) {
-            const auto& encoded_field = encoded_fields.at(i);
-            //log::version().debug("{}", dump_bytes(begin, (data - begin) + encoding_sizes::field_compressed_size(*encoded_field), 100u));
-            const auto& field_name = desc.fields(i).name();
-            util::check(data!=end, "Reached end of input block with {} fields to decode", fields_size-i);
-            if(auto col_index = res.column_index(field_name)) {
-                auto& col = res.column(static_cast<position_t>(*col_index));
-                data += decode_field(res.field(*col_index).type(), encoded_field, data, col, col.opt_sparse_map(), to_encoding_version(hdr.encoding_version()));
-            } else {
-                data += encoding_sizes::field_compressed_size(encoded_field) + sizeof(ColumnMagic);
+        if(use_parallel_columns(fields_size, segment.buffer().bytes())) {
+            data = decode_fields_in_parallel(
+                fields_size,
+                [&encoded_fields](size_t i) -> const EncodedField& { return encoded_fields.at(i); },
+                [&desc](size_t i) -> decltype(auto) { return desc.fields(i).name(); },
+                sizeof(ColumnMagic),
+                data,
+                end,
+                res,
+                to_encoding_version(hdr.encoding_version()));
+        } else {
+            for (std::size_t i = 0; i < static_cast<size_t>(fields_size); ++i) {
+                const auto& encoded_field = encoded_fields.at(i);
+                //log::version().debug("{}", dump_bytes(begin, (data - begin) + encoding_sizes::field_compressed_size(*encoded_field), 100u));
+                const auto& field_name = desc.fields(i).name();
+                util::check(data!=end, "Reached end of input block with {} fields to decode", fields_size-i);
+                if(auto col_index = res.column_index(field_name)) {
+                    auto& col = res.column(static_cast<position_t>(*col_index));
+                    data += decode_field(res.field(*col_index).type(), encoded_field, data, col, col.opt_sparse_map(), to_encoding_version(hdr.encoding_version()));
+                } else {
+                    data += encoding_sizes::field_compressed_size(encoded_field) + sizeof(ColumnMagic);
+                }
+
+                ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", i, data-begin);
             }
-
-            ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", i, data-begin);
         }
 
         util::check_magic<StringPoolMagic>(data);
@@ -383,17 +440,29 @@ void decode_v1(const Segment& segment,
         const auto seg_row_count = fields_size ? ssize_t(hdr.fields(0).ndarray().items_count()) : 0LL;
         res.init_column_map();
 
-        for (std::size_t i = 0; i < static_cast<size_t>(fields_size); ++i) {
-            const auto& field = hdr.fields(static_cast<int>(i));
-            const auto& field_name = desc.fields(static_cast<int>(i)).name();
-            util::check(data!=end, "Reached end of input block with {} fields to decode", fields_size-i);
-            if(auto col_index = res.column_index(field_name)) {
-                auto& col = res.column(static_cast<position_t>(*col_index));
-                data += decode_field(res.field(*col_index).type(), field, data, col, col.opt_sparse_map(), to_encoding_version(hdr.encoding_version()));
-            } else
-                data += encoding_sizes::field_compressed_size(field);
-
-            ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", i, data-begin);
+        if(use_parallel_columns(static_cast<size_t>(fields_size), segment.buffer().bytes())) {
+            data = decode_fields_in_parallel(
+                static_cast<size_t>(fields_size),
+                [&hdr](size_t i) -> const arcticdb::proto::encoding::EncodedField& { return hdr.fields(static_cast<int>(i)); },
+                [&desc](size_t i) -> decltype(auto) { return desc.fields(static_cast<int>(i)).name(); },
+                0u,
+                data,
+                end,
+                res,
+                to_encoding_version(hdr.encoding_version()));
+        } else {
+            for (std::size_t i = 0; i < static_cast<size_t>(fields_size); ++i) {
+                const auto& field = hdr.fields(static_cast<int>(i));
+                const auto& field_name = desc.fields(static_cast<int>(i)).name();
+                util::check(data!=end, "Reached end of input block with {} fields to decode", fields_size-i);
+                if(auto col_index = res.column_index(field_name)) {
+                    auto& col = res.column(static_cast<position_t>(*col_index));
+                    data += decode_field(res.field(*col_index).type(), field, data, col, col.opt_sparse_map(), to_encoding_version(hdr.encoding_version()));
+                } else
+                    data += encoding_sizes::field_compressed_size(field);
+
+                ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", i, data-begin);
+            }
         }
 
         decode_string_pool(hdr, data, begin, end, res);
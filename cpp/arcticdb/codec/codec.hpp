@@ -28,6 +28,10 @@ Buffer decode_encoded_fields(
 
 SegmentInMemory decode_segment(Segment&& segment);
 
+// Whether the columns of a segment are encoded or decoded concurrently rather than one at a time. bytes is the size of
+// the segment, which must be large enough for splitting it up to outweigh the cost of handing columns to other threads.
+bool use_parallel_columns(size_t num_columns, size_t bytes);
+
 void decode_into_memory_segment(
     const Segment& segment,
     arcticdb::proto::encoding::SegmentHeader& hdr,
@@ -14,8 +14,11 @@
 #include <arcticdb/entity/protobufs.hpp>
 #include <arcticdb/column_store/memory_segment.hpp>
 #include <arcticdb/codec/default_codecs.hpp>
+#include <arcticdb/async/parallel_for.hpp>
 
 #include <cstddef>
+#include <cstring>
+#include <vector>
 
 namespace arcticdb {
 
@@ -210,4 +213,46 @@ namespace arcticdb {
             ARCTICDB_TRACE(log::codec(), "Encoded string pool to position {}", pos);
         }
     }
+
+    /// @brief Encodes the columns of the segment concurrently. Each column is written to its own region of the output
+    /// buffer, sized by its max_compressed_size plus column_overhead, then the regions are moved down to follow one
+    /// another. The output is the same as encoding the columns one after another from pos.
+    /// @param encode_column Called as encode_column(column_index, column_data, column_pos) from any thread, where
+    /// column_pos is the start of the column's region and is advanced past the bytes written
+    template<typename EncodingPolicyType, typename EncodeColumn>
+    void encode_columns_in_parallel(
+        const SegmentInMemory& in_mem_seg,
+        const arcticdb::proto::encoding::VariantCodec& codec_opts,
+        size_t column_overhead,
+        Buffer& out_buffer,
+        std::ptrdiff_t& pos,
+        EncodeColumn&& encode_column
+    ) {
+        const auto num_columns = in_mem_seg.num_columns();
+        std::vector<std::ptrdiff_t> region_starts(num_columns + 1);
+        region_starts[0] = pos;
+        for (std::size_t column_index = 0; column_index < num_columns; ++column_index) {
+            auto column_data = in_mem_seg.column_data(column_index);
+            const auto [_, required] = EncodingPolicyType::ColumnEncoder::max_compressed_size(codec_opts, column_data);
+            region_starts[column_index + 1] = region_starts[column_index] + static_cast<std::ptrdiff_t>(required + column_overhead);
+        }
+
+        std::vector<std::ptrdiff_t> region_ends(num_columns);
+        async::parallel_for(num_columns, [&](size_t column_index) {
+            auto column_data = in_mem_seg.column_data(column_index);
+            auto column_pos = region_starts[column_index];
+            encode_column(column_index, column_data, column_pos);
+            util::check(column_pos <= region_starts[column_index + 1],
+                "Column {} overflowed its encoding region: {} > {}", column_index, column_pos, region_starts[column_index + 1]);
+            region_ends[column_index] = column_pos;
+        });
+
+        for (std::size_t column_index = 0; column_index < num_columns; ++column_index) {
+            const auto bytes = region_ends[column_index] - region_starts[column_index];
+            if (region_starts[column_index] != pos)
+                std::memmove(out_buffer.data() + pos, out_buffer.data() + region_starts[column_index], bytes);
+
+            pos += bytes;
+        }
+    }
 }
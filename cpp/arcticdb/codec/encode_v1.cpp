@@ -4,6 +4,7 @@
  *
  * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
  */
+#include <arcticdb/codec/codec.hpp>
 #include <arcticdb/codec/encode_common.hpp>
 #include <arcticdb/codec/typed_block_encoder_impl.hpp>
 #include <arcticdb/column_store/memory_segment.hpp>
@@ -130,11 +131,25 @@ namespace arcticdb {
 
         if(in_mem_seg.row_count() > 0) {
             ARCTICDB_TRACE(log::codec(), "Encoding fields");
-            for (std::size_t column_index = 0; column_index < in_mem_seg.num_columns(); ++column_index) {
-                auto column_data = in_mem_seg.column_data(column_index);
-                auto *encoded_field = segment_header->mutable_fields()->Add();
-                encoder.encode(codec_opts, column_data, encoded_field, *out_buffer, pos);
-                ARCTICDB_TRACE(log::codec(), "Encoded column {}: ({}) to position {}", column_index, in_mem_seg.descriptor().fields(column_index).name(), pos);
+            if (use_parallel_columns(in_mem_seg.num_columns(), uncompressed_size)) {
+                // The header is not safe to add to concurrently, so the fields are added before encoding
+                std::vector<arcticdb::proto::encoding::EncodedField*> encoded_fields;
+                encoded_fields.reserve(in_mem_seg.num_columns());
+                for (std::size_t column_index = 0; column_index < in_mem_seg.num_columns(); ++column_index)
+                    encoded_fields.push_back(segment_header->mutable_fields()->Add());
+
+                encode_columns_in_parallel<EncodingPolicyV1>(in_mem_seg, codec_opts, 0u, *out_buffer, pos,
+                    [&](size_t column_index, ColumnData& column_data, std::ptrdiff_t& column_pos) {
+                        encoder.encode(codec_opts, column_data, encoded_fields[column_index], *out_buffer, column_pos);
+                    });
+                ARCTICDB_TRACE(log::codec(), "Encoded {} columns in parallel to position {}", in_mem_seg.num_columns(), pos);
+            } else {
+                for (std::size_t column_index = 0; column_index < in_mem_seg.num_columns(); ++column_index) {
+                    auto column_data = in_mem_seg.column_data(column_index);
+                    auto *encoded_field = segment_header->mutable_fields()->Add();
+                    encoder.encode(codec_opts, column_data, encoded_field, *out_buffer, pos);
+                    ARCTICDB_TRACE(log::codec(), "Encoded column {}: ({}) to position {}", column_index, in_mem_seg.descriptor().fields(column_index).name(), pos);
+                }
             }
             encode_string_pool<EncodingPolicyV1>(in_mem_seg, *segment_header, codec_opts, *out_buffer, pos);
         }
@@ -6,6 +6,7 @@
  */
 
 #include <arcticdb/codec/encoded_field.hpp>
+#include <arcticdb/codec/codec.hpp>
 #include <arcticdb/codec/encode_common.hpp>
 #include <arcticdb/codec/typed_block_encoder_impl.hpp>
 #include <arcticdb/codec/magic_words.hpp>
@@ -279,6 +280,50 @@ namespace arcticdb {
         ARCTICDB_TRACE(log::codec(), "Encoded encoded blocks to position {}", pos);
     }
 
+    /// @brief Encodes the columns concurrently, with the same output as encoding them in order. Each column's
+    /// EncodedField is built in a slot of the encoded fields buffer sized by calc_column_blocks_size, and the slots are
+    /// moved down to follow one another afterwards in the same way as the column data.
+    static void encode_fields_in_parallel(
+        const SegmentInMemory& in_mem_seg,
+        const arcticdb::proto::encoding::VariantCodec& codec_opts,
+        Buffer& out_buffer,
+        std::ptrdiff_t& pos,
+        ChunkedBuffer& encoded_fields_buffer
+    ) {
+        const auto num_columns = in_mem_seg.num_columns();
+        std::vector<size_t> field_slots(num_columns + 1);
+        for (std::size_t column_index = 0; column_index < num_columns; ++column_index)
+            field_slots[column_index + 1] = field_slots[column_index] + calc_column_blocks_size(in_mem_seg.column(position_t(column_index)));
+
+        util::check(field_slots[num_columns] <= encoded_fields_buffer.bytes(),
+            "Encoded field buffer overflow {} > {}",
+            field_slots[num_columns],
+            encoded_fields_buffer.bytes());
+
+        std::vector<EncodedField*> column_fields(num_columns);
+        encode_columns_in_parallel<EncodingPolicyV2>(in_mem_seg, codec_opts, sizeof(ColumnMagic), out_buffer, pos,
+            [&](size_t column_index, ColumnData& column_data, std::ptrdiff_t& column_pos) {
+                write_magic<ColumnMagic>(out_buffer, column_pos);
+                auto column_field = new(encoded_fields_buffer.data() + field_slots[column_index]) EncodedField;
+                ColumnEncoderV2::encode(codec_opts, column_data, column_field, out_buffer, column_pos);
+                util::check(encoded_field_bytes(*column_field) <= field_slots[column_index + 1] - field_slots[column_index],
+                    "Encoded field overflowed its slot for column {}", column_index);
+                column_fields[column_index] = column_field;
+            });
+
+        size_t encoded_field_pos = 0u;
+        for (std::size_t column_index = 0; column_index < num_columns; ++column_index) {
+            const auto bytes = encoded_field_bytes(*column_fields[column_index]);
+            if (field_slots[column_index] != encoded_field_pos)
+                std::memmove(encoded_fields_buffer.data() + encoded_field_pos, column_fields[column_index], bytes);
+
+            encoded_field_pos += bytes;
+        }
+        // Leave what is past the last field as it would be had the fields been encoded in place
+        std::memset(encoded_fields_buffer.data() + encoded_field_pos, 0, encoded_fields_buffer.bytes() - encoded_field_pos);
+        ARCTICDB_TRACE(log::codec(), "Encoded {} columns in parallel to position {}", num_columns, pos);
+    }
+
     [[nodiscard]] Segment encode_v2(SegmentInMemory&& s, const arcticdb::proto::encoding::VariantCodec &codec_opts) {
         ARCTICDB_SAMPLE(EncodeSegment, 0)
 
@@ -310,18 +355,22 @@ namespace arcticdb {
         ColumnEncoderV2 encoder;
         if(in_mem_seg.row_count() > 0) {
             ARCTICDB_TRACE(log::codec(), "Encoding fields");
-            for (std::size_t column_index = 0; column_index < in_mem_seg.num_columns(); ++column_index) {
-                write_magic<ColumnMagic>(*out_buffer, pos);
-                auto column_field = new(encoded_fields_buffer.data() + encoded_field_pos) EncodedField;
-                ARCTICDB_TRACE(log::codec(),"Beginning encoding of column {}: ({}) to position {}", column_index, in_mem_seg.descriptor().field(column_index).name(), pos);
-                auto column_data = in_mem_seg.column_data(column_index);
-                encoder.encode(codec_opts, column_data, column_field, *out_buffer, pos);
-                ARCTICDB_TRACE(log::codec(), "Encoded column {}: ({}) to position {}", column_index, in_mem_seg.descriptor().field(column_index).name(), pos);
-                encoded_field_pos += encoded_field_bytes(*column_field);
-                util::check(encoded_field_pos <= encoded_fields_buffer.bytes(),
-                    "Encoded field buffer overflow {} > {}",
-                    encoded_field_pos,
-                    encoded_fields_buffer.bytes());
+            if (use_parallel_columns(in_mem_seg.num_columns(), uncompressed_size)) {
+                encode_fields_in_parallel(in_mem_seg, codec_opts, *out_buffer, pos, encoded_fields_buffer);
+            } else {
+                for (std::size_t column_index = 0; column_index < in_mem_seg.num_columns(); ++column_index) {
+                    write_magic<ColumnMagic>(*out_buffer, pos);
+                    auto column_field = new(encoded_fields_buffer.data() + encoded_field_pos) EncodedField;
+                    ARCTICDB_TRACE(log::codec(),"Beginning encoding of column {}: ({}) to position {}", column_index, in_mem_seg.descriptor().field(column_index).name(), pos);
+                    auto column_data = in_mem_seg.column_data(column_index);
+                    encoder.encode(codec_opts, column_data, column_field, *out_buffer, pos);
+                    ARCTICDB_TRACE(log::codec(), "Encoded column {}: ({}) to position {}", column_index, in_mem_seg.descriptor().field(column_index).name(), pos);
+                    encoded_field_pos += encoded_field_bytes(*column_field);
+                    util::check(encoded_field_pos <= encoded_fields_buffer.bytes(),
+                        "Encoded field buffer overflow {} > {}",
+                        encoded_field_pos,
+                        encoded_fields_buffer.bytes());
+                }
             }
             auto field_here ARCTICDB_UNUSED = reinterpret_cast<EncodedField*>(encoded_fields_buffer.data());
             write_magic<StringPoolMagic>(*out_buffer, pos);
@@ -31,7 +31,8 @@ enum class Codec : uint16_t {
     Zstd,
     TurboPfor,
     Lz4,
-    Passthrough
+    Passthrough,
+    ZstdDictionary
 };
 
 struct ZstdCodec {
@@ -81,14 +82,29 @@ struct Lz4Codec {
 
     void MergeFrom(const arcticdb::proto::encoding::VariantCodec::Lz4& lz4) {
         acceleration_ = lz4.acceleration();
+        hc_level_ = static_cast<int16_t>(lz4.hc_level());
     }
 
     int32_t acceleration_ = 1;
-    int16_t padding_ = 0;
+    int16_t hc_level_ = 0;
 };
 
 static_assert(sizeof(Lz4Codec) == encoding_size);
 
+struct ZstdDictionaryCodec {
+    static constexpr Codec type_ = Codec::ZstdDictionary;
+
+    void MergeFrom(const arcticdb::proto::encoding::VariantCodec::Zstd &zstd) {
+        dictionary_id_ = zstd.dictionary_id();
+        level_ = static_cast<int16_t>(zstd.level());
+    }
+
+    uint32_t dictionary_id_ = 0;
+    int16_t level_ = 0;
+};
+
+static_assert(sizeof(ZstdDictionaryCodec) == encoding_size);
+
 struct PassthroughCodec {
     static constexpr Codec type_ = Codec::Passthrough;
 
@@ -135,12 +151,19 @@ struct BlockCodec {
         return pass;
     }
 
+    ZstdDictionaryCodec *mutable_zstd_dictionary() {
+        codec_ = Codec::ZstdDictionary;
+        auto zstd = new(data()) ZstdDictionaryCodec{};
+        return zstd;
+    }
+
     arcticdb::proto::encoding::VariantCodec::CodecCase codec_case() const {
         switch (codec_) {
-        case Codec::Zstd:return arcticdb::proto::encoding::VariantCodec::kLz4;
+        case Codec::Zstd:return arcticdb::proto::encoding::VariantCodec::kZstd;
         case Codec::Lz4:return arcticdb::proto::encoding::VariantCodec::kLz4;
         case Codec::TurboPfor:return arcticdb::proto::encoding::VariantCodec::kTp4;
         case Codec::Passthrough:return arcticdb::proto::encoding::VariantCodec::kPassthrough;
+        case Codec::ZstdDictionary:return arcticdb::proto::encoding::VariantCodec::kZstdDictionary;
         default:util::raise_rte("Unknown codec");
         }
     }
@@ -15,10 +15,24 @@
 #include <arcticdb/util/dump_bytes.hpp>
 
 #include <lz4.h>
+#include <lz4hc.h>
+#include <algorithm>
+#include <memory>
 #include <type_traits>
 
 namespace arcticdb::detail {
 
+// Compression state is reused across the blocks encoded by a thread rather than being set up for each block
+inline void* lz4_compression_state() {
+    thread_local std::unique_ptr<char[]> state{new char[LZ4_sizeofState()]};
+    return state.get();
+}
+
+inline void* lz4hc_compression_state() {
+    thread_local std::unique_ptr<char[]> state{new char[LZ4_sizeofStateHC()]};
+    return state.get();
+}
+
 struct Lz4BlockEncoder {
 
     using Opts = arcticdb::proto::encoding::VariantCodec::Lz4;
@@ -42,11 +56,24 @@ struct Lz4BlockEncoder {
             std::size_t out_capacity,
             std::ptrdiff_t &pos,
             CodecType& out_codec) {
-        int compressed_bytes = LZ4_compress_default(
-            reinterpret_cast<const char *>(in),
-            reinterpret_cast<char *>(out),
-            int(block_utils.bytes_),
-            int(out_capacity));
+        int compressed_bytes;
+        if(opts.hc_level() > 0) {
+            compressed_bytes = LZ4_compress_HC_extStateHC(
+                lz4hc_compression_state(),
+                reinterpret_cast<const char *>(in),
+                reinterpret_cast<char *>(out),
+                int(block_utils.bytes_),
+                int(out_capacity),
+                opts.hc_level());
+        } else {
+            compressed_bytes = LZ4_compress_fast_extState(
+                lz4_compression_state(),
+                reinterpret_cast<const char *>(in),
+                reinterpret_cast<char *>(out),
+                int(block_utils.bytes_),
+                int(out_capacity),
+                std::max(opts.acceleration(), 1));
+        }
 
         // Compressed bytes equal to 0 means error unless there is nothing to compress.
         util::check_arg(compressed_bytes > 0 || (compressed_bytes == 0 && block_utils.bytes_ == 0),
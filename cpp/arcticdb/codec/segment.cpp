@@ -229,7 +229,8 @@ std::pair<uint8_t*, size_t> Segment::try_internal_write(std::shared_ptr<Buffer>&
         return std::make_pair(base_ptr, total_segment_size(hdr_size));
     }
     else {
-        tmp = std::make_shared<Buffer>();
+        // The temp buffer only lives until the storage write has been sent, so it is taken from the pool at its full size
+        tmp = BufferPool::instance()->allocate(total_segment_size(hdr_size));
         ARCTICDB_DEBUG(log::storage(), "Header doesn't fit in internal buffer, needed {} bytes but had {}, writing to temp buffer at {:x}", hdr_size, std::get<std::shared_ptr<Buffer>>(buffer_)->preamble_bytes(), uintptr_t(tmp->data()));
         tmp->ensure(total_segment_size(hdr_size));
         write_to(tmp->preamble(), hdr_size);
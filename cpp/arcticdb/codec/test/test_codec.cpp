@@ -14,9 +14,17 @@
 #include <arcticdb/stream/row_builder.hpp>
 #include <arcticdb/stream/aggregator.hpp>
 #include <arcticdb/codec/typed_block_encoder_impl.hpp>
+#include <arcticdb/codec/zstd_dictionary.hpp>
+#include <arcticdb/codec/zstd.hpp>
+#include <arcticdb/codec/adaptive_codec.hpp>
+#include <arcticdb/util/configs_map.hpp>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstring>
+#include <random>
+
 namespace arcticdb {
     struct ColumnEncoderV1 {
         static std::pair<size_t, size_t> max_compressed_size(
@@ -390,6 +398,28 @@ class SegmentStringEncodingTest : public testing::Test{};
 
 TYPED_TEST_SUITE(SegmentStringEncodingTest, EncoginVersions);
 
+TEST(Segment, WritesThroughTempBufferWhenHeaderDoesNotFit) {
+    auto s = get_standard_timeseries_segment("temp_buffer_write", 100);
+    arcticdb::proto::encoding::VariantCodec opt;
+    opt.mutable_lz4()->set_acceleration(1);
+    Segment encoded = encode_dispatch(s.clone(), opt, EncodingVersion::V1);
+    std::shared_ptr<Buffer> encoded_tmp;
+    auto [encoded_dst, encoded_size] = encoded.try_internal_write(encoded_tmp, encoded.segment_header_bytes_size());
+
+    // A segment copied out of storage has no space ahead of its data for the header, so it is written via a temp buffer
+    auto copied = Segment::from_bytes(encoded_dst, encoded_size, true);
+    std::shared_ptr<Buffer> tmp;
+    auto [dst, write_size] = copied.try_internal_write(tmp, copied.segment_header_bytes_size());
+    ASSERT_TRUE(tmp);
+    ASSERT_EQ(dst, tmp->preamble());
+    ASSERT_EQ(write_size, encoded_size);
+
+    SegmentInMemory res = decode_segment(Segment::from_bytes(dst, write_size, true));
+    ASSERT_EQ(res.row_count(), s.row_count());
+    for (auto row = 0u; row < s.row_count(); ++row)
+        ASSERT_EQ(res.scalar_at<uint64_t>(row, 2), s.scalar_at<uint64_t>(row, 2));
+}
+
 TYPED_TEST(SegmentStringEncodingTest, EncodeSingleString) {
     const auto tsd = create_tsd<DataTypeTag<DataType::ASCII_DYNAMIC64>, Dimension::Dim0>("thing", 1);
     SegmentInMemory s(StreamDescriptor{tsd});
@@ -437,6 +467,146 @@ TYPED_TEST(SegmentStringEncodingTest, EncodeStringsBasic) {
     ASSERT_EQ(std::string("baggy"), res.string_at(1, 3));
 }
 
+template<typename EncodingVersionConstant>
+class SegmentCodecOptionsTest : public testing::Test {
+protected:
+    static void check_round_trip(const arcticdb::proto::encoding::VariantCodec& opt) {
+        constexpr size_t num_rows = 2000;
+        auto s = get_standard_timeseries_segment("codec_options", num_rows);
+        Segment seg = encode_dispatch(s.clone(), opt, EncodingVersionConstant::value);
+        SegmentInMemory res = decode_segment(std::move(seg));
+        ASSERT_EQ(res.row_count(), num_rows);
+        for(size_t i = 0; i < num_rows; ++i) {
+            ASSERT_EQ(res.scalar_at<timestamp>(i, 0), s.scalar_at<timestamp>(i, 0));
+            ASSERT_EQ(res.scalar_at<int8_t>(i, 1), s.scalar_at<int8_t>(i, 1));
+            ASSERT_EQ(res.scalar_at<uint64_t>(i, 2), s.scalar_at<uint64_t>(i, 2));
+            ASSERT_EQ(res.string_at(i, 3), s.string_at(i, 3));
+        }
+    }
+};
+
+TYPED_TEST_SUITE(SegmentCodecOptionsTest, EncoginVersions);
+
+TYPED_TEST(SegmentCodecOptionsTest, Lz4Acceleration) {
+    arcticdb::proto::encoding::VariantCodec opt;
+    opt.mutable_lz4()->set_acceleration(8);
+    TestFixture::check_round_trip(opt);
+}
+
+TYPED_TEST(SegmentCodecOptionsTest, Lz4HighCompression) {
+    arcticdb::proto::encoding::VariantCodec opt;
+    opt.mutable_lz4()->set_hc_level(9);
+    TestFixture::check_round_trip(opt);
+}
+
+TYPED_TEST(SegmentCodecOptionsTest, Zstd) {
+    arcticdb::proto::encoding::VariantCodec opt;
+    opt.mutable_zstd()->set_level(3);
+    TestFixture::check_round_trip(opt);
+}
+
+TYPED_TEST(SegmentCodecOptionsTest, ZstdWithDictionary) {
+    std::vector<std::vector<uint8_t>> samples;
+    for(size_t i = 0; i < 2000; ++i) {
+        const auto sample = fmt::format("{{\"symbol\": \"sym_{}\", \"price\": {}, \"string_{}\"}}", i % 50, i * 7, i);
+        samples.emplace_back(sample.begin(), sample.end());
+    }
+    auto data = codec::train_zstd_dictionary(samples, 4096);
+    ASSERT_FALSE(data.empty());
+    const auto dictionary = codec::ZstdDictionaryRegistry::instance().add(std::move(data));
+    ASSERT_EQ(codec::ZstdDictionaryRegistry::instance().find(dictionary->id()), dictionary);
+
+    arcticdb::proto::encoding::VariantCodec opt;
+    auto* zstd = opt.mutable_zstd();
+    zstd->set_level(3);
+    for(auto data_type : {DataType::NANOSECONDS_UTC64, DataType::INT8, DataType::UINT64, string_pool_descriptor().type().data_type()})
+        (*zstd->mutable_dictionaries())[static_cast<uint32_t>(data_type)] = dictionary->id();
+
+    TestFixture::check_round_trip(opt);
+}
+
+TEST(ZstdDictionary, MissingDictionaryIsADecodeError) {
+    std::vector<std::vector<uint8_t>> samples;
+    for(size_t i = 0; i < 2000; ++i) {
+        const auto sample = fmt::format("{{\"unregistered_{}\": {}}}", i % 30, i * 13);
+        samples.emplace_back(sample.begin(), sample.end());
+    }
+    // Trained but never registered, as if the dictionary keys had not been loaded
+    auto data = codec::train_zstd_dictionary(samples, 4096);
+    ASSERT_FALSE(data.empty());
+    ASSERT_EQ(codec::ZstdDictionaryRegistry::instance().find(ZSTD_getDictID_fromDict(data.data(), data.size())), nullptr);
+
+    const auto& input = samples.front();
+    std::vector<uint8_t> compressed(ZSTD_compressBound(input.size()));
+    auto* context = ZSTD_createCCtx();
+    const auto compressed_bytes = ZSTD_compress_usingDict(context, compressed.data(), compressed.size(), input.data(), input.size(),
+                                                          data.data(), data.size(), 3);
+    ZSTD_freeCCtx(context);
+    ASSERT_FALSE(ZSTD_isError(compressed_bytes));
+
+    std::vector<uint8_t> output(input.size());
+    ASSERT_THROW(detail::ZstdDecoder::decode_block<uint8_t>(1, compressed.data(), compressed_bytes, output.data(), output.size()),
+                 CodecException);
+}
+
+TYPED_TEST(SegmentCodecOptionsTest, Adaptive) {
+    arcticdb::proto::encoding::VariantCodec opt;
+    opt.mutable_adaptive()->set_min_gain(0.05f);
+    TestFixture::check_round_trip(opt);
+}
+
+TYPED_TEST(SegmentCodecOptionsTest, ParallelColumns) {
+    arcticdb::proto::encoding::VariantCodec opt;
+    opt.mutable_lz4()->set_acceleration(1);
+    auto s = get_standard_timeseries_segment("parallel_columns", 2000);
+    ScopedConfig min_bytes("Codec.ParallelColumnsMinBytes", 0);
+    Segment serial = [&] {
+        ScopedConfig parallel("Codec.ParallelColumns", 0);
+        return encode_dispatch(s.clone(), opt, TypeParam::value);
+    }();
+    Segment parallel = encode_dispatch(s.clone(), opt, TypeParam::value);
+    ASSERT_EQ(parallel.buffer().bytes(), serial.buffer().bytes());
+    ASSERT_EQ(std::memcmp(parallel.buffer().data(), serial.buffer().data(), serial.buffer().bytes()), 0);
+
+    TestFixture::check_round_trip(opt);
+}
+
+TEST(AdaptiveCodec, ChoosesByCompressibility) {
+    arcticdb::proto::encoding::VariantCodec::Adaptive opts;
+    opts.set_min_gain(0.05f);
+    constexpr size_t num_values = 100'000;
+
+    std::vector<uint64_t> constant(num_values, 42);
+    auto codec = codec::choose_block_codec(opts, reinterpret_cast<const uint8_t*>(constant.data()), constant.size() * sizeof(uint64_t), sizeof(uint64_t));
+    ASSERT_NE(codec.codec_case(), arcticdb::proto::encoding::VariantCodec::kPassthrough);
+
+    std::vector<uint64_t> random(num_values);
+    std::mt19937_64 gen{42};
+    std::generate(random.begin(), random.end(), gen);
+    codec = codec::choose_block_codec(opts, reinterpret_cast<const uint8_t*>(random.data()), random.size() * sizeof(uint64_t), sizeof(uint64_t));
+    ASSERT_EQ(codec.codec_case(), arcticdb::proto::encoding::VariantCodec::kPassthrough);
+
+    codec = codec::choose_block_codec(opts, nullptr, 0, sizeof(uint64_t));
+    ASSERT_EQ(codec.codec_case(), arcticdb::proto::encoding::VariantCodec::kPassthrough);
+}
+
+TEST(AdaptiveCodec, DefaultMinGainPrefersFasterDecoding) {
+    constexpr size_t num_values = 100'000;
+    std::vector<uint64_t> constant(num_values, 42);
+    const auto* data = reinterpret_cast<const uint8_t*>(constant.data());
+    const auto bytes = constant.size() * sizeof(uint64_t);
+
+    // zstd shrinks the sample further than lz4, but by far less than 5% of it, so lz4 is kept for its decoding speed
+    arcticdb::proto::encoding::VariantCodec::Adaptive opts;
+    ASSERT_EQ(codec::choose_block_codec(opts, data, bytes, sizeof(uint64_t)).codec_case(),
+              arcticdb::proto::encoding::VariantCodec::kLz4);
+
+    // Any gain at all is enough to pick the smallest output when min_gain is set that low
+    opts.set_min_gain(1e-6f);
+    ASSERT_EQ(codec::choose_block_codec(opts, data, bytes, sizeof(uint64_t)).codec_case(),
+              arcticdb::proto::encoding::VariantCodec::kZstd);
+}
+
 using namespace arcticdb;
 namespace as = arcticdb::stream;
 
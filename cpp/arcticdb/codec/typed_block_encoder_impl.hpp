@@ -2,9 +2,11 @@
 #include <arcticdb/codec/passthrough.hpp>
 #include <arcticdb/codec/zstd.hpp>
 #include <arcticdb/codec/lz4.hpp>
+#include <arcticdb/codec/adaptive_codec.hpp>
 #include <arcticdb/codec/encoded_field.hpp>
 #include <arcticdb/util/buffer.hpp>
 
+#include <algorithm>
 #include <type_traits>
 
 namespace arcticdb {
@@ -19,6 +21,13 @@ namespace arcticdb {
             const arcticdb::proto::encoding::VariantCodec& codec_opts,
             const TypedBlock<TD>& typed_block
         ) {
+            if(codec_opts.codec_case() == arcticdb::proto::encoding::VariantCodec::kAdaptive) {
+                // Space is reserved for whichever codec is chosen when the block is encoded
+                return std::max({
+                    ZstdEncoder::max_compressed_size(typed_block),
+                    Lz4Encoder::max_compressed_size(typed_block),
+                    PassthroughEncoder::max_compressed_size(typed_block)});
+            }
             return visit_encoder(codec_opts, [&](auto encoder_tag) {
                 return decltype(encoder_tag)::Encoder::max_compressed_size(typed_block);
             });
@@ -42,8 +51,10 @@ namespace arcticdb {
         ) {
             static_assert(encoder_version == EncodingVersion::V1,
                 "Encoding of both shapes and values at the same time is allowed only in V1 encoding");
-            visit_encoder(codec_opts, [&](auto encoder_tag) {
-                decltype(encoder_tag)::Encoder::encode(get_opts(codec_opts, encoder_tag),
+            arcticdb::proto::encoding::VariantCodec chosen;
+            const auto& block_opts = block_codec(codec_opts, typed_block, chosen);
+            visit_encoder(block_opts, [&](auto encoder_tag) {
+                decltype(encoder_tag)::Encoder::encode(get_opts(block_opts, encoder_tag),
                     typed_block,
                     field,
                     out,
@@ -67,8 +78,10 @@ namespace arcticdb {
                 return;
             }
             auto* values_encoded_block = ndarray->add_values();
-            visit_encoder(codec_opts, [&](auto encoder_tag) {
-                decltype(encoder_tag)::Encoder::encode(get_opts(codec_opts, encoder_tag),
+            arcticdb::proto::encoding::VariantCodec chosen;
+            const auto& block_opts = block_codec(codec_opts, typed_block, chosen);
+            visit_encoder(block_opts, [&](auto encoder_tag) {
+                decltype(encoder_tag)::Encoder::encode(get_opts(block_opts, encoder_tag),
                     typed_block,
                     out,
                     pos,
@@ -94,8 +107,10 @@ namespace arcticdb {
             }
             auto* ndarray = field.mutable_ndarray();
             auto* shapes_encoded_block = ndarray->add_shapes();
-            visit_encoder(codec_opts, [&](auto encoder_tag) {
-                decltype(encoder_tag)::Encoder::encode(get_opts(codec_opts, encoder_tag),
+            arcticdb::proto::encoding::VariantCodec chosen;
+            const auto& block_opts = block_codec(codec_opts, typed_block, chosen);
+            visit_encoder(block_opts, [&](auto encoder_tag) {
+                decltype(encoder_tag)::Encoder::encode(get_opts(block_opts, encoder_tag),
                     typed_block,
                     out,
                     pos,
@@ -120,6 +135,22 @@ namespace arcticdb {
             using Encoder = EncoderT;
         };
 
+        /// Returns the options to encode the block with, which are codec_opts unless they are adaptive, in which case
+        /// the codec chosen for this block is written to chosen and returned
+        template<typename BlockType>
+        static const arcticdb::proto::encoding::VariantCodec& block_codec(
+            const arcticdb::proto::encoding::VariantCodec& codec_opts,
+            const BlockType& block,
+            arcticdb::proto::encoding::VariantCodec& chosen
+        ) {
+            if(codec_opts.codec_case() != arcticdb::proto::encoding::VariantCodec::kAdaptive)
+                return codec_opts;
+
+            using RawType = std::remove_const_t<std::remove_pointer_t<decltype(block.data())>>;
+            chosen = codec::choose_block_codec(codec_opts.adaptive(), reinterpret_cast<const uint8_t*>(block.data()), block.nbytes(), sizeof(RawType));
+            return chosen;
+        }
+
         template<typename FunctorT>
         static auto visit_encoder(const arcticdb::proto::encoding::VariantCodec& codec_opts, FunctorT&& f) {
             switch (codec_opts.codec_case()) {
@@ -139,7 +170,15 @@ namespace arcticdb {
         }
 
         static auto get_opts(const arcticdb::proto::encoding::VariantCodec& codec_opts, EncoderTag<ZstdEncoder>) {
-            return codec_opts.zstd();
+            auto opts = codec_opts.zstd();
+            if(!opts.dictionaries().empty()) {
+                // Only the dictionary for this column's type is used, and is the one recorded against the block
+                const auto& dictionaries = opts.dictionaries();
+                const auto it = dictionaries.find(static_cast<uint32_t>(TD::DataTypeTag::data_type));
+                opts.set_dictionary_id(it != dictionaries.end() ? it->second : 0);
+                opts.clear_dictionaries();
+            }
+            return opts;
         }
 
         static auto get_opts(const arcticdb::proto::encoding::VariantCodec& codec_opts, EncoderTag<PassthroughEncoder>) {
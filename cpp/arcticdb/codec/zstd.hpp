@@ -8,6 +8,7 @@
 #pragma once
 
 #include <arcticdb/codec/segment.hpp>
+#include <arcticdb/codec/zstd_dictionary.hpp>
 #include <arcticdb/entity/performance_tracing.hpp>
 #include <arcticdb/stream/protobuf_mappings.hpp>
 #include <arcticdb/storage/common.hpp>
@@ -16,8 +17,22 @@
 
 #include <zstd.h>
 
+#include <memory>
+
 namespace arcticdb::detail {
 
+// Contexts hold the compressor's working memory, so are reused across the blocks encoded by a thread rather than
+// being allocated for each block
+inline ZSTD_CCtx* zstd_compression_context() {
+    thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    return context.get();
+}
+
+inline ZSTD_DCtx* zstd_decompression_context() {
+    thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    return context.get();
+}
+
 struct ZstdBlockEncoder {
 
     using Opts = arcticdb::proto::encoding::VariantCodec::Zstd;
@@ -41,10 +56,22 @@ struct ZstdBlockEncoder {
             std::size_t out_capacity,
             std::ptrdiff_t &pos,
             CodecType& out_codec) {
-        std::size_t compressed_bytes = ZSTD_compress(out, out_capacity, in, block_utils.bytes_, opts.level());
+        std::size_t compressed_bytes;
+        if(opts.dictionary_id() != 0) {
+            const auto dictionary = codec::ZstdDictionaryRegistry::instance().find(opts.dictionary_id());
+            util::check(dictionary != nullptr, "Zstd dictionary {} has not been loaded", opts.dictionary_id());
+            compressed_bytes = ZSTD_compress_usingCDict(zstd_compression_context(), out, out_capacity, in, block_utils.bytes_,
+                                                        dictionary->cdict(opts.level()));
+        } else {
+            compressed_bytes = ZSTD_compressCCtx(zstd_compression_context(), out, out_capacity, in, block_utils.bytes_, opts.level());
+        }
+        util::check(!ZSTD_isError(compressed_bytes), "Zstd compression failed: {}", ZSTD_getErrorName(compressed_bytes));
         hasher(in, block_utils.count_);
         pos += compressed_bytes;
-        out_codec.mutable_zstd()->MergeFrom(opts);
+        if(opts.dictionary_id() != 0)
+            out_codec.mutable_zstd_dictionary()->MergeFrom(opts);
+        else
+            out_codec.mutable_zstd()->MergeFrom(opts);
         return compressed_bytes;
     }
 };
@@ -68,7 +95,20 @@ struct ZstdDecoder {
         const std::size_t decomp_size = ZSTD_getFrameContentSize(in, in_bytes);
         codec::check<ErrorCode::E_DECODE_ERROR>(decomp_size == out_bytes, "expected out_bytes == zstd deduced bytes, actual {} != {}",
                         out_bytes, decomp_size);
-        std::size_t real_decomp = ZSTD_decompress(t_out, out_bytes, in, in_bytes);
+        std::size_t real_decomp;
+        // The dictionary id is in the frame header, so blocks can be decoded whatever the codec options say
+        if(const auto dictionary_id = ZSTD_getDictID_fromFrame(in, in_bytes); dictionary_id != 0) {
+            const auto dictionary = codec::ZstdDictionaryRegistry::instance().find(dictionary_id);
+            codec::check<ErrorCode::E_DECODE_ERROR>(dictionary != nullptr,
+                            "Block was compressed with zstd dictionary {}, which has not been loaded. The dictionaries are loaded "
+                            "when a library with codec_dictionaries set in its write options is opened, so this library's "
+                            "configuration may have been changed since the data was written", dictionary_id);
+            real_decomp = ZSTD_decompress_usingDDict(zstd_decompression_context(), t_out, out_bytes, in, in_bytes, dictionary->ddict());
+        } else {
+            real_decomp = ZSTD_decompressDCtx(zstd_decompression_context(), t_out, out_bytes, in, in_bytes);
+        }
+        codec::check<ErrorCode::E_DECODE_ERROR>(!ZSTD_isError(real_decomp), "Zstd decompression failed: {}",
+                        ZSTD_getErrorName(real_decomp));
         codec::check<ErrorCode::E_DECODE_ERROR>(real_decomp == out_bytes, "expected out_bytes == zstd decompressed bytes, actual {} != {}",
                         out_bytes, real_decomp);
     }
@@ -0,0 +1,88 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/codec/zstd_dictionary.hpp>
+#include <arcticdb/log/log.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <zdict.h>
+
+namespace arcticdb::codec {
+
+ZstdDictionary::ZstdDictionary(std::vector<uint8_t>&& data) :
+    data_(std::move(data)),
+    id_(ZDICT_getDictID(data_.data(), data_.size())) {
+    util::check(id_ != 0, "Zstd dictionary of {} bytes does not have a dictionary id", data_.size());
+    ddict_ = ZSTD_createDDict(data_.data(), data_.size());
+    util::check(ddict_ != nullptr, "Failed to create zstd decompression dictionary {}", id_);
+}
+
+ZstdDictionary::~ZstdDictionary() {
+    for(auto& [level, cdict] : cdicts_)
+        ZSTD_freeCDict(cdict);
+
+    ZSTD_freeDDict(ddict_);
+}
+
+const ZSTD_CDict* ZstdDictionary::cdict(int level) const {
+    std::lock_guard lock{mutex_};
+    auto it = cdicts_.find(level);
+    if(it == cdicts_.end()) {
+        auto cdict = ZSTD_createCDict(data_.data(), data_.size(), level);
+        util::check(cdict != nullptr, "Failed to create zstd compression dictionary {} at level {}", id_, level);
+        it = cdicts_.try_emplace(level, cdict).first;
+    }
+    return it->second;
+}
+
+ZstdDictionaryRegistry& ZstdDictionaryRegistry::instance() {
+    static ZstdDictionaryRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<ZstdDictionary> ZstdDictionaryRegistry::add(std::vector<uint8_t>&& data) {
+    auto dictionary = std::make_shared<ZstdDictionary>(std::move(data));
+    std::unique_lock lock{mutex_};
+    auto [it, inserted] = dictionaries_.try_emplace(dictionary->id(), dictionary);
+    if(!inserted)
+        util::check(it->second->data() == dictionary->data(), "Two different zstd dictionaries have id {}", dictionary->id());
+
+    return it->second;
+}
+
+std::shared_ptr<ZstdDictionary> ZstdDictionaryRegistry::find(uint32_t id) const {
+    std::shared_lock lock{mutex_};
+    const auto it = dictionaries_.find(id);
+    return it != dictionaries_.end() ? it->second : nullptr;
+}
+
+std::vector<uint8_t> train_zstd_dictionary(const std::vector<std::vector<uint8_t>>& samples, size_t capacity) {
+    std::vector<uint8_t> samples_buffer;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for(const auto& sample : samples) {
+        samples_buffer.insert(samples_buffer.end(), sample.begin(), sample.end());
+        sample_sizes.push_back(sample.size());
+    }
+
+    std::vector<uint8_t> dictionary(capacity);
+    const auto dictionary_size = ZDICT_trainFromBuffer(
+        dictionary.data(),
+        dictionary.size(),
+        samples_buffer.data(),
+        sample_sizes.data(),
+        static_cast<unsigned>(sample_sizes.size()));
+
+    if(ZDICT_isError(dictionary_size)) {
+        log::codec().info("Not training a zstd dictionary from {} samples: {}", samples.size(), ZDICT_getErrorName(dictionary_size));
+        return {};
+    }
+    dictionary.resize(dictionary_size);
+    return dictionary;
+}
+
+} // namespace arcticdb::codec
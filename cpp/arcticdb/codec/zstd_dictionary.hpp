@@ -0,0 +1,70 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/util/constructors.hpp>
+
+#include <zstd.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace arcticdb::codec {
+
+/*
+ * A zstd dictionary trained on the blocks of one column type. zstd writes the dictionary id into the header of every
+ * frame compressed with it, which is how the decoder finds the dictionary again.
+ */
+class ZstdDictionary {
+public:
+    explicit ZstdDictionary(std::vector<uint8_t>&& data);
+    ~ZstdDictionary();
+    ARCTICDB_NO_MOVE_OR_COPY(ZstdDictionary)
+
+    [[nodiscard]] uint32_t id() const { return id_; }
+
+    [[nodiscard]] const std::vector<uint8_t>& data() const { return data_; }
+
+    // The compression level is fixed when the dictionary is digested, so there is one per level, created on first use
+    [[nodiscard]] const ZSTD_CDict* cdict(int level) const;
+
+    [[nodiscard]] const ZSTD_DDict* ddict() const { return ddict_; }
+
+private:
+    std::vector<uint8_t> data_;
+    uint32_t id_;
+    ZSTD_DDict* ddict_ = nullptr;
+    mutable std::mutex mutex_;
+    mutable std::unordered_map<int, ZSTD_CDict*> cdicts_;
+};
+
+/*
+ * The dictionaries loaded in this process, by id. Dictionaries are loaded from a library when it is opened, and are
+ * kept for the lifetime of the process as blocks that use them can be read at any time afterwards.
+ */
+class ZstdDictionaryRegistry {
+public:
+    static ZstdDictionaryRegistry& instance();
+
+    std::shared_ptr<ZstdDictionary> add(std::vector<uint8_t>&& data);
+
+    [[nodiscard]] std::shared_ptr<ZstdDictionary> find(uint32_t id) const;
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<uint32_t, std::shared_ptr<ZstdDictionary>> dictionaries_;
+};
+
+// Returns an empty vector if there are too few samples to train a dictionary of the requested size
+std::vector<uint8_t> train_zstd_dictionary(const std::vector<std::vector<uint8_t>>& samples, size_t capacity);
+
+} // namespace arcticdb::codec
@@ -148,6 +148,38 @@ void SegmentInMemoryImpl::drop_column(std::string_view name) {
     column_map_->erase(name);
 }
 
+namespace {
+
+// Rewrites offsets into the input string pool as offsets into the output pool. All the strings a column needs
+// that have not been seen in a previous column are added to the output pool in one batch.
+template<typename RawType>
+void remap_to_output_string_pool(
+        RawType* begin,
+        RawType* end,
+        const StringPool& input_string_pool,
+        StringPool& output_string_pool,
+        robin_hood::unordered_flat_map<StringPool::offset_t, StringPool::offset_t>& input_to_output_offsets) {
+    std::vector<StringPool::offset_t> new_offsets;
+    std::vector<std::string_view> new_strings;
+    for (auto ptr = begin; ptr != end; ++ptr) {
+        if (auto [it, inserted] = input_to_output_offsets.try_emplace(StringPool::offset_t(*ptr), 0); inserted) {
+            new_offsets.emplace_back(*ptr);
+            new_strings.emplace_back(input_string_pool.get_const_view(*ptr));
+        }
+    }
+
+    // The input to output map already deduplicates, so there is no need for the output pool to as well
+    std::vector<StringPool::offset_t> output_offsets(new_strings.size());
+    output_string_pool.get_batch(new_strings.data(), new_strings.size(), output_offsets.data(), false);
+    for (size_t i = 0; i < new_offsets.size(); ++i)
+        input_to_output_offsets[new_offsets[i]] = output_offsets[i];
+
+    for (auto ptr = begin; ptr != end; ++ptr)
+        *ptr = input_to_output_offsets.at(StringPool::offset_t(*ptr));
+}
+
+} // namespace
+
 std::shared_ptr<SegmentInMemoryImpl> SegmentInMemoryImpl::filter(const util::BitSet& filter_bitset,
                                                    bool filter_down_stringpool,
                                                    bool validate) const {
@@ -225,21 +257,8 @@ std::shared_ptr<SegmentInMemoryImpl> SegmentInMemoryImpl::filter(const util::Bit
                         }
                         auto offset = sparse_map.value().rank(*bitset_iter, *sparse_idx) - row_count_so_far - 1;
                         auto value = *(input_ptr + offset);
-                        if constexpr(is_sequence_type(DataTypeTag::data_type)) {
-                            if (filter_down_stringpool) {
-                                if (auto it = input_to_output_offsets.find(value);
-                                        it != input_to_output_offsets.end()) {
-                                    *output_ptr = it->second;
-                                } else {
-                                    auto str = string_pool_->get_const_view(value);
-                                    auto output_string_pool_offset = output_string_pool->get(str, false).offset();
-                                    *output_ptr = output_string_pool_offset;
-                                    input_to_output_offsets.insert(robin_hood::pair(StringPool::offset_t(value), std::move(output_string_pool_offset)));
-                                }
-                            } else {
-                                *output_ptr = value;
-                            }
-                        } else if constexpr(is_numeric_type(DataTypeTag::data_type) || is_bool_type(DataTypeTag::data_type)){
+                        if constexpr(is_sequence_type(DataTypeTag::data_type) || is_numeric_type(DataTypeTag::data_type) || is_bool_type(DataTypeTag::data_type)) {
+                            // String offsets are remapped into the output pool after the column has been filtered
                             *output_ptr = value;
                         } else if constexpr(is_empty_type(DataTypeTag::data_type)) {
                             internal::raise<ErrorCode::E_ASSERTION_FAILURE>("Unexpected block in empty type column in SegmentInMemoryImpl::filter");
@@ -259,21 +278,8 @@ std::shared_ptr<SegmentInMemoryImpl> SegmentInMemoryImpl::filter(const util::Bit
                             break;
 
                         auto value = *(input_ptr + offset);
-                        if constexpr(is_sequence_type(DataTypeTag::data_type)) {
-                            if (filter_down_stringpool) {
-                                if (auto it = input_to_output_offsets.find(value);
-                                        it != input_to_output_offsets.end()) {
-                                    *output_ptr = it->second;
-                                } else {
-                                    auto str = string_pool_->get_const_view(value);
-                                    auto output_string_pool_offset = output_string_pool->get(str, false).offset();
-                                    *output_ptr = output_string_pool_offset;
-                                    input_to_output_offsets.insert(robin_hood::pair(StringPool::offset_t(value), std::move(output_string_pool_offset)));
-                                }
-                            } else {
-                                *output_ptr = value;
-                            }
-                        } else if constexpr(is_numeric_type(DataTypeTag::data_type) || is_bool_type(DataTypeTag::data_type)){
+                        if constexpr(is_sequence_type(DataTypeTag::data_type) || is_numeric_type(DataTypeTag::data_type) || is_bool_type(DataTypeTag::data_type)) {
+                            // String offsets are remapped into the output pool after the column has been filtered
                             *output_ptr = value;
                         } else if constexpr(is_empty_type(DataTypeTag::data_type)) {
                             internal::raise<ErrorCode::E_ASSERTION_FAILURE>("Unexpected block in empty type column in SegmentInMemoryImpl::filter");
@@ -289,6 +295,13 @@ std::shared_ptr<SegmentInMemoryImpl> SegmentInMemoryImpl::filter(const util::Bit
             }
             if (sparse_map && validate)
                 check_output_bitset(output_col.opt_sparse_map().value(), filter_bitset, sparse_map.value());
+
+            if constexpr(is_sequence_type(DataTypeTag::data_type)) {
+                if (filter_down_stringpool) {
+                    const auto output_begin = reinterpret_cast<RawType*>(output_col.ptr());
+                    remap_to_output_string_pool(output_begin, output_ptr, *string_pool_, *output_string_pool, input_to_output_offsets);
+                }
+            }
         });
     }
     if (num_values != 0)
@@ -550,7 +563,7 @@ std::vector<std::shared_ptr<SegmentInMemoryImpl>> SegmentInMemoryImpl::split(siz
 }
 
 size_t SegmentInMemoryImpl::num_blocks() const {
-    return std::accumulate(std::begin(columns_), std::end(columns_), 0, [] (size_t n, const auto& col) {
+    return std::accumulate(std::begin(columns_), std::end(columns_), size_t{0}, [] (size_t n, const auto& col) {
         return n + col->num_blocks();
     });
 }
@@ -561,7 +574,7 @@ std::optional<Column::StringArrayData> SegmentInMemoryImpl::string_array_at(posi
 }
 
 size_t SegmentInMemoryImpl::num_bytes() const {
-    return std::accumulate(std::begin(columns_), std::end(columns_), 0, [] (size_t n, const auto& col) {
+    return std::accumulate(std::begin(columns_), std::end(columns_), size_t{0}, [] (size_t n, const auto& col) {
         return n + col->bytes();
     });
 }
@@ -17,7 +17,7 @@
 #include <arcticdb/util/configs_map.hpp>
 
 namespace arcticdb {
-robin_hood::unordered_set<StringPool::offset_t> unique_values_for_string_column(const Column &column) {
+inline robin_hood::unordered_set<StringPool::offset_t> unique_values_for_string_column(const Column &column) {
     auto column_data = column.data();
     return column_data.type().visit_tag([&](auto type_desc_tag) -> robin_hood::unordered_set<StringPool::offset_t> {
         using TDT = decltype(type_desc_tag);
@@ -54,6 +54,46 @@ OffsetString StringPool::get(const char *data, size_t size, bool deduplicate) {
     return str;
 }
 
+void StringPool::get_batch(const std::string_view* strings, size_t count, offset_t* out, bool deduplicate) {
+    if (!deduplicate) {
+        block_.insert(strings, count, out);
+        return;
+    }
+
+    // Resolve the strings already in the pool, and find the distinct new ones. Strings are often pointers into
+    // Python objects or Arrow buffers scattered around the heap, so fetch the ones we are about to hash early.
+    constexpr size_t prefetch_distance = 8;
+    std::vector<std::string_view> new_strings;
+    robin_hood::unordered_flat_map<std::string_view, size_t> new_string_indices;
+    std::vector<std::pair<size_t, size_t>> pending_outputs;
+    for (size_t i = 0; i < count; ++i) {
+        if (i + prefetch_distance < count)
+            ARCTICDB_PREFETCH(strings[i + prefetch_distance].data());
+
+        if (auto it = map_.find(strings[i]); it != map_.end()) {
+            out[i] = it->second;
+            continue;
+        }
+        auto [it, inserted] = new_string_indices.try_emplace(strings[i], new_strings.size());
+        if (inserted)
+            new_strings.emplace_back(strings[i]);
+
+        pending_outputs.emplace_back(i, it->second);
+    }
+
+    if (new_strings.empty())
+        return;
+
+    std::vector<offset_t> positions(new_strings.size());
+    block_.insert(new_strings.data(), new_strings.size(), positions.data());
+    map_.reserve(map_.size() + new_strings.size());
+    for (auto position : positions)
+        map_.insert(robin_hood::pair(block_.at(position), position));
+
+    for (const auto& [out_pos, new_string_pos] : pending_outputs)
+        out[out_pos] = positions[new_string_pos];
+}
+
 std::string_view StringPool::get_view(offset_t o) {
     return block_.at(o);
 }
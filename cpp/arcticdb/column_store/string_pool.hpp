@@ -13,6 +13,7 @@
 #include <arcticdb/util/cursored_buffer.hpp>
 #include <arcticdb/column_store/chunked_buffer.hpp>
 #include <arcticdb/column_store/column_data.hpp>
+#include <arcticdb/util/preprocess.hpp>
 
 #include <string_view>
 #include <unordered_map>
@@ -100,6 +101,34 @@ class StringBlock {
         return data_.cursor_pos() - bytes_required;
     }
 
+    // Inserts count strings, writing the position of each to positions. Space is reserved for as many strings as
+    // fit in a block at a time, rather than growing the buffer and moving the cursor once per string.
+    void insert(const std::string_view* strings, size_t count, position_t* positions) {
+        size_t start = 0;
+        while (start < count) {
+            auto bytes_required = StringHead::calc_size(strings[start].size());
+            auto end = start + 1;
+            for (; end < count; ++end) {
+                const auto next_bytes = StringHead::calc_size(strings[end].size());
+                if (bytes_required + next_bytes > ChunkedBuffer::block_size)
+                    break;
+                bytes_required += next_bytes;
+            }
+            auto ptr = data_.ensure_aligned_bytes(bytes_required);
+            // Aligning may have padded the previous block, so positions are counted back from the end
+            auto pos = static_cast<position_t>(data_.buffer().bytes() - bytes_required);
+            for (auto i = start; i < end; ++i) {
+                reinterpret_cast<StringHead*>(ptr)->copy(strings[i].data(), strings[i].size());
+                positions[i] = pos;
+                const auto string_bytes = StringHead::calc_size(strings[i].size());
+                ptr += string_bytes;
+                pos += static_cast<position_t>(string_bytes);
+            }
+            data_.commit();
+            start = end;
+        }
+    }
+
     std::string_view at(position_t pos) {
         auto head(head_at(pos));
         return {head->data(), head->size()};
@@ -225,6 +254,10 @@ class StringPool {
 
     OffsetString get(std::string_view s, bool deduplicate = true);
 
+    // Equivalent to calling get() on each string and writing the offsets to out, but the map is grown once and the
+    // strings that are not already in the pool are copied into it together
+    void get_batch(const std::string_view* strings, size_t count, offset_t* out, bool deduplicate = true);
+
     const ChunkedBuffer &data() const {
         return block_.buffer();
     }
@@ -13,6 +13,9 @@
 #include <arcticdb/stream/index.hpp>
 #include <arcticdb/storage/test/in_memory_store.hpp>
 #include <arcticdb/pipeline/index_writer.hpp>
+#include <arcticdb/pipeline/index_utils.hpp>
+
+#include <atomic>
 
 namespace arcticdb {
 using namespace arcticdb::pipelines;
@@ -255,4 +258,61 @@ TEST(IndexFilter, StaticMulticolumnFilterColumns) {
     ASSERT_EQ(pipeline_context->slice_and_keys_[4].key_, slice_and_keys[16].key_);
     ASSERT_EQ(pipeline_context->slice_and_keys_[5].key_, slice_and_keys[92].key_);
     ASSERT_EQ(pipeline_context->slice_and_keys_[9].key_, slice_and_keys[96].key_);
-}
\ No newline at end of file
+}
+
+namespace {
+
+// Counts the reads of the leaves of multi-level indexes
+class LeafCountingStore : public arcticdb::InMemoryStore {
+public:
+    std::pair<arcticdb::VariantKey, arcticdb::SegmentInMemory> read_sync(const arcticdb::VariantKey& key, arcticdb::storage::ReadKeyOpts opts) override {
+        if(arcticdb::variant_key_type(key) == arcticdb::KeyType::TABLE_INDEX_LEAF)
+            ++leaves_read_;
+        return InMemoryStore::read_sync(key, opts);
+    }
+
+    std::atomic<size_t> leaves_read_ = 0;
+};
+
+}
+
+TEST(IndexFilter, MultiLevelReadsOnlyIntersectingLeaves) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    const auto stream_id = StreamId{"thing"};
+    const auto version_id = VersionId{0};
+
+    // Ten row slices of ten rows each, with two in each leaf
+    auto [metadata, slice_and_keys] = get_sample_slice_and_key(stream_id, version_id);
+    auto store = std::make_shared<LeafCountingStore>();
+    auto key = index::write_index<stream::TimeseriesIndex>(
+        std::move(metadata), std::vector<SliceAndKey>{slice_and_keys}, IndexPartialKey{stream_id, version_id}, store, 2).get();
+    ASSERT_EQ(store->leaves_read_, 0);
+
+    auto read_root = [&store, &key]() {
+        index::IndexSegmentReader root{store->read_sync(key, storage::ReadKeyOpts{}).second};
+        EXPECT_TRUE(root.is_multi_level());
+        EXPECT_EQ(root.size(), 5);
+        return root;
+    };
+
+    auto by_index = index::expand_multi_level_index(read_root(), store, IndexRange{25, 45});
+    ASSERT_EQ(store->leaves_read_, 2);
+    ASSERT_EQ(by_index.leaves().size(), 5);
+    ASSERT_EQ(by_index.size(), 4);
+    ASSERT_EQ(by_index.row(0).key_, slice_and_keys[2].key_);
+
+    store->leaves_read_ = 0;
+    auto by_row = index::expand_multi_level_index(read_root(), store, RowRange{55, 61});
+    ASSERT_EQ(store->leaves_read_, 2);
+    ASSERT_EQ(by_row.row(0).key_, slice_and_keys[4].key_);
+    ASSERT_EQ(by_row.size(), 4);
+    ASSERT_EQ(by_row.row(3).key_, slice_and_keys[7].key_);
+
+    store->leaves_read_ = 0;
+    auto all = index::expand_multi_level_index(read_root(), store);
+    ASSERT_EQ(store->leaves_read_, 5);
+    ASSERT_EQ(all.size(), slice_and_keys.size());
+    ASSERT_FALSE(all.is_multi_level());
+}
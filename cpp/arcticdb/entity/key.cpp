@@ -42,6 +42,7 @@ KeyData get_key_data(KeyType key_type) {
     STRING_REF(KeyType::VERSION_REF, vref, 'r')
     STRING_KEY(KeyType::TABLE_DATA, tdata, 'd')
     STRING_KEY(KeyType::TABLE_INDEX, tindex, 'i')
+    STRING_KEY(KeyType::TABLE_INDEX_LEAF, tleaf, 'e')
     STRING_KEY(KeyType::VERSION, ver, 'V')
     STRING_KEY(KeyType::VERSION_JOURNAL, vj, 'v')
     STRING_KEY(KeyType::SNAPSHOT, snap, 's')
@@ -49,6 +50,7 @@ KeyData get_key_data(KeyType key_type) {
     STRING_KEY(KeyType::TOMBSTONE_ALL, tall, 'q')
     STRING_KEY(KeyType::TOMBSTONE, tomb, 'x')
     STRING_REF(KeyType::LIBRARY_CONFIG, cref, 'C')
+    STRING_REF(KeyType::CODEC_DICTIONARY, cdict, 'k')
     STRING_KEY(KeyType::COLUMN_STATS, cstats, 'S')
     STRING_REF(KeyType::SNAPSHOT_REF, tref, 't')
     // Less important
@@ -178,6 +178,16 @@ enum class KeyType : int {
      * Contains column stats about the index key with the same stream ID and version number
      */
     COLUMN_STATS = 25,
+    /*
+     * Compression dictionaries trained on the data in the library, one per column type
+     */
+    CODEC_DICTIONARY = 26,
+    /*
+     * A leaf of a multi-level index. The TABLE_INDEX key of a version can point to these instead of TABLE_DATA keys,
+     * each of which contains TABLE_DATA keys like a TABLE_INDEX key does. Having its own type keeps leaves out of the
+     * version and symbol scans over TABLE_INDEX keys.
+     */
+    TABLE_INDEX_LEAF = 27,
     UNDEFINED
 };
 
@@ -186,7 +196,9 @@ inline std::vector<KeyType> key_types_write_precedence() {
     // they just exist inside version keys
     return {
         KeyType::LIBRARY_CONFIG,
+        KeyType::CODEC_DICTIONARY,
         KeyType::TABLE_DATA,
+        KeyType::TABLE_INDEX_LEAF,
         KeyType::TABLE_INDEX,
         KeyType::MULTI_KEY,
         KeyType::VERSION,
@@ -13,6 +13,8 @@
 
 // for std::accumulate
 #include <numeric>
+#include <optional>
+#include <string_view>
 
 #include <pybind11/numpy.h>
 
@@ -24,6 +26,39 @@ inline ssize_t calc_elements(const shape_t* shape, ssize_t ndim) {
     return std::accumulate(shape, shape + ndim, ssize_t(1), std::multiplies<ssize_t>());
 }
 
+/*
+ * Set on string tensors imported through the Arrow C Data Interface rather than from numpy. The tensor's data
+ * pointer refers to the offsets buffer, which holds offsets into a separate character buffer rather than PyObject
+ * pointers, and missing values are described by an LSB-ordered validity bitmap rather than by None.
+ */
+struct ArrowBuffers {
+    // Null when every row is valid
+    const uint8_t* validity_ = nullptr;
+    // Offset in rows into the validity and string offsets buffers, as Arrow slices share their parent's buffers
+    int64_t offset_ = 0;
+    const void* string_offsets_ = nullptr;
+    const char* string_data_ = nullptr;
+    bool large_offsets_ = false;
+
+    [[nodiscard]] bool is_valid(int64_t row) const {
+        const auto pos = offset_ + row;
+        return validity_ == nullptr || ((validity_[pos >> 3] >> (pos & 7)) & 1);
+    }
+
+    [[nodiscard]] std::string_view string_at(int64_t row) const {
+        const auto pos = offset_ + row;
+        int64_t begin, end;
+        if(large_offsets_) {
+            begin = static_cast<const int64_t*>(string_offsets_)[pos];
+            end = static_cast<const int64_t*>(string_offsets_)[pos + 1];
+        } else {
+            begin = static_cast<const int32_t*>(string_offsets_)[pos];
+            end = static_cast<const int32_t*>(string_offsets_)[pos + 1];
+        }
+        return {string_data_ + begin, static_cast<size_t>(end - begin)};
+    }
+};
+
 /*
  * A wrapper around a 1D or 2D tensor that provides a more convenient interface for accessing the data
  * in the tensor. This is used to pass data between the Python and C++ layers.
@@ -77,7 +112,8 @@ struct NativeTensor {
     dt_(other.dt_),
     elsize_(other.elsize_),
     ptr(other.ptr),
-    expanded_dim_(other.expanded_dim_){
+    expanded_dim_(other.expanded_dim_),
+    arrow_(other.arrow_){
         for (ssize_t i = 0; i < std::min(MaxDimensions, ndim_); ++i)
             shapes_[i] = other.shapes_[i];
 
@@ -94,6 +130,7 @@ struct NativeTensor {
         swap(left.elsize_, right.elsize_);
         swap(left.ptr, right.ptr);
         swap(left.expanded_dim_, right.expanded_dim_);
+        swap(left.arrow_, right.arrow_);
         for(ssize_t i = 0; i < MaxDimensions; ++i) {
             swap(left.shapes_[i], right.shapes_[i]);
             swap(left.strides_[i], right.strides_[i]);
@@ -117,6 +154,8 @@ struct NativeTensor {
     [[nodiscard]] const void* data() const { magic_.check(); return ptr; }
     [[nodiscard]] auto extent(ssize_t dim) const { return shapes_[dim] * strides_[dim]; }
     [[nodiscard]] auto expanded_dim() const { return expanded_dim_; }
+    [[nodiscard]] const std::optional<ArrowBuffers>& arrow() const { return arrow_; }
+    void set_arrow(const ArrowBuffers& arrow) { arrow_ = arrow; }
     template<typename T>
     const T *ptr_cast(size_t pos) const {
         const bool dimension_condition = ndim() == 1;
@@ -153,6 +192,7 @@ struct NativeTensor {
     /// API providing the strides and shapes arrays, expanded_dim is what ArcticDB thinks of the tensor and using it
     /// can lead to out of bounds reads from strides and shapes.
     int expanded_dim_;
+    std::optional<ArrowBuffers> arrow_;
 };
 
 template <ssize_t> ssize_t byte_offset_impl(const stride_t* ) { return 0; }
@@ -0,0 +1,76 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/*
+ * The Arrow C Data Interface, https://arrow.apache.org/docs/format/CDataInterface.html
+ *
+ * These definitions are an ABI contract and are copied verbatim from the specification, which is why they
+ * live in the global namespace and are guarded by the same macro as Arrow's own abi.h. This lets us exchange
+ * columns with pyarrow, polars, duckdb etc. without linking against any Arrow library.
+ */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace arcticdb {
+
+// Arrow validity bitmaps are LSB-ordered, one bit per row, set when the row is valid
+inline bool arrow_bit_is_set(const uint8_t* bitmap, int64_t pos) {
+    return (bitmap[pos >> 3] >> (pos & 7)) & 1;
+}
+
+inline void arrow_set_bit(uint8_t* bitmap, int64_t pos) {
+    bitmap[pos >> 3] |= static_cast<uint8_t>(1u << (pos & 7));
+}
+
+inline int64_t arrow_bitmap_bytes(int64_t length) {
+    return (length + 7) / 8;
+}
+
+} // namespace arcticdb
@@ -0,0 +1,260 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/pipeline/arrow_input_frame.hpp>
+#include <arcticdb/column_store/chunked_buffer.hpp>
+#include <arcticdb/entity/performance_tracing.hpp>
+#include <arcticdb/util/preconditions.hpp>
+#include <arcticdb/util/constructors.hpp>
+
+#include <cmath>
+#include <limits>
+#include <string_view>
+
+namespace arcticdb::pipelines {
+
+namespace {
+
+// Owns the imported structs, and any buffers we had to convert because Arrow's layout differs from ours
+struct ArrowInputHolder {
+    ArrowArray array_{};
+    ArrowSchema schema_{};
+    std::vector<ChunkedBuffer> converted_;
+
+    ArrowInputHolder(ArrowArray* array, ArrowSchema* schema) :
+        array_(*array),
+        schema_(*schema) {
+        // Moving a C Data Interface struct is a bitwise copy that marks the source as released
+        array->release = nullptr;
+        schema->release = nullptr;
+    }
+
+    ARCTICDB_NO_MOVE_OR_COPY(ArrowInputHolder)
+
+    ~ArrowInputHolder() {
+        if(array_.release != nullptr)
+            array_.release(&array_);
+        if(schema_.release != nullptr)
+            schema_.release(&schema_);
+    }
+};
+
+struct ArrowColumnType {
+    DataType data_type_;
+    bool is_string_ = false;
+    bool large_offsets_ = false;
+};
+
+ArrowColumnType arrow_format_to_type(std::string_view format, std::string_view name) {
+    if(format.size() == 1) {
+        switch(format[0]) {
+        case 'c': return {DataType::INT8};
+        case 'C': return {DataType::UINT8};
+        case 's': return {DataType::INT16};
+        case 'S': return {DataType::UINT16};
+        case 'i': return {DataType::INT32};
+        case 'I': return {DataType::UINT32};
+        case 'l': return {DataType::INT64};
+        case 'L': return {DataType::UINT64};
+        case 'f': return {DataType::FLOAT32};
+        case 'g': return {DataType::FLOAT64};
+        case 'b': return {DataType::BOOL8};
+        case 'n': return {DataType::EMPTYVAL};
+        case 'u': return {DataType::UTF_DYNAMIC64, true, false};
+        case 'U': return {DataType::UTF_DYNAMIC64, true, true};
+        case 'z': return {DataType::ASCII_DYNAMIC64, true, false};
+        case 'Z': return {DataType::ASCII_DYNAMIC64, true, true};
+        default: break;
+        }
+    } else if(format.substr(0, 4) == "tsn:") {
+        // Timezones are carried in the normalization metadata, as they are for pandas input
+        return {DataType::NANOSECONDS_UTC64};
+    }
+    normalization::raise<ErrorCode::E_UNIMPLEMENTED_INPUT_TYPE>(
+        "Arrow column '{}' has unsupported format '{}'", name, format);
+}
+
+// Counts the nulls in rows [offset, offset + length) of a column, as null_count covers the whole of the child array
+// and may be -1, meaning it was not computed
+int64_t arrow_null_count(const ArrowArray& child, int64_t offset, int64_t length) {
+    if(child.null_count == 0 || child.n_buffers == 0 || child.buffers[0] == nullptr)
+        return 0;
+
+    const auto validity = static_cast<const uint8_t*>(child.buffers[0]);
+    int64_t null_count = 0;
+    for(int64_t i = 0; i < length; ++i)
+        null_count += !arrow_bit_is_set(validity, offset + i);
+
+    return null_count;
+}
+
+// Replaces the nulls of a floating point column with NaN, which is how pandas input represents them
+template<typename RawType>
+const void* arrow_floats_with_nan(const ArrowArray& child, int64_t offset, int64_t length, ArrowInputHolder& holder) {
+    auto& converted = holder.converted_.emplace_back(ChunkedBuffer::presized(length * sizeof(RawType)));
+    const auto validity = static_cast<const uint8_t*>(child.buffers[0]);
+    const auto values = static_cast<const RawType*>(child.buffers[1]) + offset;
+    auto out = reinterpret_cast<RawType*>(converted.data());
+    for(int64_t i = 0; i < length; ++i)
+        out[i] = arrow_bit_is_set(validity, offset + i) ? values[i] : std::numeric_limits<RawType>::quiet_NaN();
+
+    return out;
+}
+
+NativeTensor arrow_column_to_tensor(
+    const ArrowArray& child,
+    const ArrowSchema& child_schema,
+    int64_t parent_offset,
+    int64_t length,
+    ArrowInputHolder& holder) {
+    const std::string_view name = child_schema.name != nullptr ? child_schema.name : "";
+    const auto type = arrow_format_to_type(child_schema.format, name);
+    const auto offset = parent_offset + child.offset;
+    normalization::check<ErrorCode::E_UNIMPLEMENTED_INPUT_TYPE>(child.dictionary == nullptr,
+        "Dictionary encoded Arrow column '{}' is not supported", name);
+    util::check(child.length >= parent_offset + length, "Arrow column '{}' has {} rows, expected at least {}",
+        name, child.length, parent_offset + length);
+
+    const auto null_count = type.data_type_ == DataType::EMPTYVAL ? 0 : arrow_null_count(child, offset, length);
+    const bool is_float = type.data_type_ == DataType::FLOAT32 || type.data_type_ == DataType::FLOAT64;
+    // Other types have no missing value that reads back as such, so rather than writing a placeholder we reject them
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(null_count == 0 || type.is_string_ || is_float,
+        "Arrow column '{}' of type {} contains {} nulls, only string and floating point columns can contain nulls",
+        name, type.data_type_, null_count);
+
+    ArrowBuffers arrow;
+    arrow.offset_ = offset;
+    arrow.validity_ = null_count != 0 && type.is_string_ ? static_cast<const uint8_t*>(child.buffers[0]) : nullptr;
+
+    const shape_t shape = length;
+    const void* data = nullptr;
+    stride_t elsize = 0;
+    if(type.is_string_) {
+        arrow.string_offsets_ = child.buffers[1];
+        arrow.string_data_ = static_cast<const char*>(child.buffers[2]);
+        arrow.large_offsets_ = type.large_offsets_;
+        // The tensor is never dereferenced for Arrow strings, aggregator_set_data reads through ArrowBuffers
+        elsize = type.large_offsets_ ? sizeof(int64_t) : sizeof(int32_t);
+        data = child.buffers[1];
+    } else if(type.data_type_ == DataType::BOOL8 && length > 0) {
+        // Arrow packs booleans into bits, we store a byte per value
+        auto& unpacked = holder.converted_.emplace_back(ChunkedBuffer::presized(length));
+        auto values = static_cast<const uint8_t*>(child.buffers[1]);
+        auto out = unpacked.data();
+        for(int64_t i = 0; i < length; ++i)
+            out[i] = static_cast<uint8_t>(arrow_bit_is_set(values, offset + i));
+
+        elsize = sizeof(uint8_t);
+        data = out;
+    } else if(type.data_type_ == DataType::BOOL8) {
+        elsize = sizeof(uint8_t);
+    } else if(is_float && null_count != 0) {
+        elsize = static_cast<stride_t>(get_type_size(type.data_type_));
+        data = type.data_type_ == DataType::FLOAT32 ?
+            arrow_floats_with_nan<float>(child, offset, length, holder) :
+            arrow_floats_with_nan<double>(child, offset, length, holder);
+    } else if(type.data_type_ != DataType::EMPTYVAL) {
+        elsize = static_cast<stride_t>(get_type_size(type.data_type_));
+        data = static_cast<const uint8_t*>(child.buffers[1]) + offset * elsize;
+    }
+
+    const stride_t stride = elsize;
+    const int64_t nbytes = data != nullptr ? length * elsize : 0;
+    NativeTensor tensor{nbytes, 1, &stride, &shape, type.data_type_, elsize, data, 1};
+    if(type.is_string_)
+        tensor.set_arrow(arrow);
+
+    return tensor;
+}
+
+SortedValue index_sortedness(const NativeTensor& index_tensor) {
+    const auto num_rows = index_tensor.shape(0);
+    auto values = index_tensor.ptr_cast<timestamp>(0);
+    bool ascending = true;
+    bool descending = true;
+    for(ssize_t i = 1; i < num_rows && (ascending || descending); ++i) {
+        ascending &= values[i - 1] <= values[i];
+        descending &= values[i - 1] >= values[i];
+    }
+    if(ascending)
+        return SortedValue::ASCENDING;
+
+    return descending ? SortedValue::DESCENDING : SortedValue::UNSORTED;
+}
+
+// The metadata the pandas normalizer writes for a DataFrame with the same index, so the symbol reads back as one
+void set_dataframe_norm_meta(InputTensorFrame& frame, const ArrowSchema& index_schema, bool timestamp_index, bool fake_index_name) {
+    auto index = frame.norm_meta.mutable_df()->mutable_common()->mutable_index();
+    if(timestamp_index) {
+        index->set_is_not_range_index(true);
+        index->set_fake_name(fake_index_name);
+        // The timezone, if there is one, follows the "tsn:" prefix of the format
+        const std::string_view format{index_schema.format};
+        if(format.size() > 4)
+            index->set_tz(std::string{format.substr(4)});
+    } else {
+        index->set_start(0);
+        index->set_step(1);
+    }
+}
+
+} // namespace
+
+InputTensorFrame arrow_to_frame(const StreamId& stream_id, ArrowArray* array, ArrowSchema* schema) {
+    ARCTICDB_SUBSAMPLE_DEFAULT(ArrowToFrame)
+    util::check(array != nullptr && schema != nullptr, "Null Arrow array or schema passed to arrow_to_frame");
+    util::check(array->release != nullptr && schema->release != nullptr, "Arrow array or schema has already been released");
+    auto holder = std::make_shared<ArrowInputHolder>(array, schema);
+    const auto& arrow_array = holder->array_;
+    const auto& arrow_schema = holder->schema_;
+
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(std::string_view{arrow_schema.format} == "+s",
+        "Expected an Arrow struct array (record batch), got format '{}'", arrow_schema.format);
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(arrow_array.null_count == 0,
+        "Arrow record batch cannot contain null rows");
+    util::check(arrow_array.n_children == arrow_schema.n_children,
+        "Arrow array has {} columns but its schema has {}", arrow_array.n_children, arrow_schema.n_children);
+
+    InputTensorFrame res;
+    res.desc.set_id(stream_id);
+    res.num_rows = arrow_array.length;
+
+    int64_t first_field = 0;
+    if(arrow_schema.n_children > 0 && std::string_view{arrow_schema.children[0]->format}.substr(0, 4) == "tsn:") {
+        auto index_tensor = arrow_column_to_tensor(
+            *arrow_array.children[0], *arrow_schema.children[0], arrow_array.offset, arrow_array.length, *holder);
+        const bool fake_index_name = arrow_schema.children[0]->name == nullptr || *arrow_schema.children[0]->name == '\0';
+        const std::string index_column_name = fake_index_name ? "index" : arrow_schema.children[0]->name;
+        res.desc.set_index_field_count(1);
+        res.desc.set_index_type(IndexDescriptor::TIMESTAMP);
+        res.desc.add_scalar_field(index_tensor.data_type(), index_column_name);
+        res.index = stream::TimeseriesIndex(index_column_name);
+        res.set_sorted(index_sortedness(index_tensor));
+        res.index_tensor = std::move(index_tensor);
+        set_dataframe_norm_meta(res, *arrow_schema.children[0], true, fake_index_name);
+        first_field = 1;
+    } else {
+        res.index = stream::RowCountIndex();
+        res.desc.set_index_type(IndexDescriptor::ROWCOUNT);
+        res.set_sorted(SortedValue::UNKNOWN);
+        set_dataframe_norm_meta(res, arrow_schema, false, false);
+    }
+
+    for(auto i = first_field; i < arrow_schema.n_children; ++i) {
+        const auto& child_schema = *arrow_schema.children[i];
+        auto tensor = arrow_column_to_tensor(*arrow_array.children[i], child_schema, arrow_array.offset, arrow_array.length, *holder);
+        res.desc.add_field(scalar_field(tensor.data_type(), child_schema.name != nullptr ? child_schema.name : ""));
+        res.field_tensors.push_back(std::move(tensor));
+    }
+
+    res.input_data_owner = std::move(holder);
+    ARCTICDB_DEBUG(log::version(), "Received Arrow frame with descriptor {}", res.desc);
+    res.set_index_range();
+    return res;
+}
+
+} // namespace arcticdb::pipelines
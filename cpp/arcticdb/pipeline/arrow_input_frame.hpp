@@ -0,0 +1,27 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/pipeline/arrow_c_data.hpp>
+#include <arcticdb/pipeline/input_tensor_frame.hpp>
+
+namespace arcticdb::pipelines {
+
+/*
+ * Builds an InputTensorFrame from a struct array (i.e. a record batch) exported through the Arrow C Data
+ * Interface, taking ownership of it: both structs are moved from and released when the frame is destroyed.
+ *
+ * Numeric columns are not copied, the tensors point straight at the Arrow values buffers. Strings are interned
+ * directly from the Arrow offsets and data buffers, so writing the frame never needs the GIL, and their nulls are
+ * written as missing strings. Nulls in floating point columns become NaN, as they would from pandas, and nulls in
+ * any other column are rejected. If the first column has a timestamp type it becomes the index, otherwise the frame
+ * gets a row count index. The normalization metadata is that of the equivalent pandas DataFrame.
+ */
+InputTensorFrame arrow_to_frame(const StreamId& stream_id, ArrowArray* array, ArrowSchema* schema);
+
+} // namespace arcticdb::pipelines
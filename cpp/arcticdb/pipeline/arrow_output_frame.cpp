@@ -0,0 +1,310 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/pipeline/arrow_output_frame.hpp>
+#include <arcticdb/pipeline/string_pool_utils.hpp>
+#include <arcticdb/entity/performance_tracing.hpp>
+#include <arcticdb/util/offset_string.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <cstring>
+
+namespace arcticdb::pipelines {
+
+namespace {
+
+struct ArrowArrayPrivateData {
+    // Keeps the decoded buffers alive for as long as the consumer holds columns that point at them
+    SegmentInMemory frame_;
+    std::shared_ptr<BufferHolder> buffers_;
+    std::vector<ChunkedBuffer> owned_buffers_;
+    std::vector<const void*> buffer_ptrs_;
+    std::vector<std::unique_ptr<ArrowArray>> children_;
+    std::vector<ArrowArray*> child_ptrs_;
+};
+
+struct ArrowSchemaPrivateData {
+    std::string format_;
+    std::string name_;
+    std::vector<std::unique_ptr<ArrowSchema>> children_;
+    std::vector<ArrowSchema*> child_ptrs_;
+};
+
+void release_array(ArrowArray* array) {
+    if(array->release == nullptr)
+        return;
+
+    auto data = static_cast<ArrowArrayPrivateData*>(array->private_data);
+    for(auto child : data->child_ptrs_) {
+        if(child->release != nullptr)
+            child->release(child);
+    }
+    delete data;
+    array->release = nullptr;
+}
+
+void release_schema(ArrowSchema* schema) {
+    if(schema->release == nullptr)
+        return;
+
+    auto data = static_cast<ArrowSchemaPrivateData*>(schema->private_data);
+    for(auto child : data->child_ptrs_) {
+        if(child->release != nullptr)
+            child->release(child);
+    }
+    delete data;
+    schema->release = nullptr;
+}
+
+void populate_array(ArrowArray* array, ArrowArrayPrivateData* data, int64_t length, int64_t null_count) {
+    for(auto& child : data->children_)
+        data->child_ptrs_.emplace_back(child.get());
+
+    array->length = length;
+    array->null_count = null_count;
+    array->offset = 0;
+    array->n_buffers = static_cast<int64_t>(data->buffer_ptrs_.size());
+    array->n_children = static_cast<int64_t>(data->child_ptrs_.size());
+    array->buffers = data->buffer_ptrs_.empty() ? nullptr : data->buffer_ptrs_.data();
+    array->children = data->child_ptrs_.empty() ? nullptr : data->child_ptrs_.data();
+    array->dictionary = nullptr;
+    array->release = &release_array;
+    array->private_data = data;
+}
+
+void populate_schema(ArrowSchema* schema, std::unique_ptr<ArrowSchemaPrivateData> data, int64_t flags) {
+    for(auto& child : data->children_)
+        data->child_ptrs_.emplace_back(child.get());
+
+    schema->format = data->format_.c_str();
+    schema->name = data->name_.c_str();
+    schema->metadata = nullptr;
+    schema->flags = flags;
+    schema->n_children = static_cast<int64_t>(data->child_ptrs_.size());
+    schema->children = data->child_ptrs_.empty() ? nullptr : data->child_ptrs_.data();
+    schema->dictionary = nullptr;
+    schema->release = &release_schema;
+    schema->private_data = data.release();
+}
+
+std::string arrow_format(const Column& column, size_t row_count) {
+    const auto data_type = column.type().data_type();
+    switch(data_type) {
+    case DataType::UINT8: return "C";
+    case DataType::UINT16: return "S";
+    case DataType::UINT32: return "I";
+    case DataType::UINT64: return "L";
+    case DataType::INT8: return "c";
+    case DataType::INT16: return "s";
+    case DataType::INT32: return "i";
+    case DataType::INT64: return "l";
+    case DataType::FLOAT32: return "f";
+    case DataType::FLOAT64: return "g";
+    case DataType::BOOL8: return "b";
+    case DataType::NANOSECONDS_UTC64: return "tsn:";
+    case DataType::UTF_DYNAMIC64: return "U";
+    case DataType::ASCII_DYNAMIC64: return "Z";
+    case DataType::ASCII_FIXED64: return fmt::format("w:{}", row_count == 0 ? 0 : column.bytes() / row_count);
+    case DataType::EMPTYVAL: return "n";
+    default:
+        schema::raise<ErrorCode::E_UNSUPPORTED_COLUMN_TYPE>("Column type {} cannot be exported to Arrow", data_type);
+    }
+}
+
+// Owned buffers are only referred to by pointer, as ChunkedBuffer keeps its blocks on the heap they remain
+// valid as the vector grows
+uint8_t* allocate_owned(ArrowArrayPrivateData& data, size_t bytes) {
+    auto& buffer = data.owned_buffers_.emplace_back(ChunkedBuffer::presized(std::max(bytes, size_t(1))));
+    std::memset(buffer.data(), 0, buffer.bytes());
+    return buffer.data();
+}
+
+// Copies the physical (i.e. present) values of a possibly multi-block column into contiguous memory
+void copy_physical_values(const Column& column, uint8_t* dest) {
+    for(const auto* block : column.data().buffer().blocks()) {
+        std::memcpy(dest, block->data(), block->bytes());
+        dest += block->bytes();
+    }
+}
+
+// Returns a pointer to row_count * type_size bytes of values in logical row order, copying only if the
+// column is sparse or spread over several blocks. Also sets the validity bitmap from the sparse map.
+const uint8_t* dense_values(
+        const Column& column,
+        size_t type_size,
+        int64_t row_count,
+        ArrowArrayPrivateData& data,
+        const uint8_t*& validity,
+        int64_t& null_count) {
+    const auto& buffer = column.data().buffer();
+    const bool sparse = column.is_sparse();
+    const auto physical_rows = static_cast<int64_t>(column.row_count());
+    if(!sparse && physical_rows >= row_count && buffer.num_blocks() == 1)
+        return buffer.data();
+
+    auto values = allocate_owned(data, row_count * type_size);
+    if(!sparse && physical_rows >= row_count) {
+        copy_physical_values(column, values);
+        return values;
+    }
+
+    auto physical = ChunkedBuffer::presized(std::max(column.bytes(), size_t(1)));
+    copy_physical_values(column, physical.data());
+    auto bitmap = allocate_owned(data, arrow_bitmap_bytes(row_count));
+    int64_t set_count = 0;
+    if(sparse) {
+        auto en = column.sparse_map().first();
+        for(size_t physical_row = 0; en.valid() && static_cast<int64_t>(*en) < row_count; ++en, ++physical_row) {
+            std::memcpy(values + *en * type_size, physical.data() + physical_row * type_size, type_size);
+            arrow_set_bit(bitmap, *en);
+            ++set_count;
+        }
+    } else {
+        // Dense but short, the trailing rows are missing
+        std::memcpy(values, physical.data(), physical_rows * type_size);
+        for(int64_t row = 0; row < physical_rows; ++row)
+            arrow_set_bit(bitmap, row);
+        set_count = physical_rows;
+    }
+    validity = bitmap;
+    null_count = row_count - set_count;
+    return values;
+}
+
+void export_bool_column(const Column& column, int64_t row_count, ArrowArrayPrivateData& data, int64_t& null_count) {
+    const uint8_t* validity = nullptr;
+    auto values = dense_values(column, sizeof(bool), row_count, data, validity, null_count);
+    auto packed = allocate_owned(data, arrow_bitmap_bytes(row_count));
+    for(int64_t row = 0; row < row_count; ++row) {
+        if(values[row] != 0)
+            arrow_set_bit(packed, row);
+    }
+    data.buffer_ptrs_ = {validity, packed};
+}
+
+void export_string_column(
+        const Column& column,
+        const StringPool& string_pool,
+        int64_t row_count,
+        ArrowArrayPrivateData& data,
+        int64_t& null_count) {
+    util::check(!column.is_inflated(),
+                "Cannot export a string column that has already been converted to Python objects, read with OutputFormat.ARROW");
+    const uint8_t* sparse_validity = nullptr;
+    int64_t sparse_null_count = 0;
+    auto offsets = reinterpret_cast<const StringPool::offset_t*>(
+        dense_values(column, sizeof(StringPool::offset_t), row_count, data, sparse_validity, sparse_null_count));
+
+    size_t total_bytes = 0;
+    for(int64_t row = 0; row < row_count; ++row) {
+        const bool present = sparse_validity == nullptr || arrow_bit_is_set(sparse_validity, row);
+        if(present && is_a_string(offsets[row]))
+            total_bytes += get_string_from_pool(offsets[row], string_pool).size();
+    }
+
+    // The pool may hold strings not referenced by this column, so the data buffer is built rather than shared
+    auto bitmap = allocate_owned(data, arrow_bitmap_bytes(row_count));
+    auto offsets_out = reinterpret_cast<int64_t*>(allocate_owned(data, (row_count + 1) * sizeof(int64_t)));
+    auto data_out = allocate_owned(data, total_bytes);
+    int64_t pos = 0;
+    null_count = 0;
+    for(int64_t row = 0; row < row_count; ++row) {
+        offsets_out[row] = pos;
+        const bool present = sparse_validity == nullptr || arrow_bit_is_set(sparse_validity, row);
+        if(present && is_a_string(offsets[row])) {
+            const auto sv = get_string_from_pool(offsets[row], string_pool);
+            std::memcpy(data_out + pos, sv.data(), sv.size());
+            pos += static_cast<int64_t>(sv.size());
+            arrow_set_bit(bitmap, row);
+        } else {
+            ++null_count;
+        }
+    }
+    offsets_out[row_count] = pos;
+    data.buffer_ptrs_ = {null_count == 0 ? nullptr : bitmap, offsets_out, data_out};
+}
+
+} // namespace
+
+ArrowOutputFrame::ArrowOutputFrame(SegmentInMemory frame, std::shared_ptr<BufferHolder> buffers) :
+    frame_(std::move(frame)),
+    buffers_(std::move(buffers)) {
+}
+
+std::vector<std::string> ArrowOutputFrame::names() const {
+    std::vector<std::string> output;
+    output.reserve(frame_.num_columns());
+    for(const auto& field : frame_.descriptor().fields())
+        output.emplace_back(field.name());
+
+    return output;
+}
+
+void ArrowOutputFrame::export_column(size_t col_pos, ArrowArray* out_array, ArrowSchema* out_schema) const {
+    ARCTICDB_SAMPLE_DEFAULT(ArrowExportColumn)
+    const auto& field = frame_.field(col_pos);
+    const auto& column = frame_.column(static_cast<position_t>(col_pos));
+    const auto row_count = static_cast<int64_t>(frame_.row_count());
+    util::check(field.type().dimension() == Dimension::Dim0, "Only scalar columns can be exported to Arrow, got {}", field);
+
+    auto schema_data = std::make_unique<ArrowSchemaPrivateData>();
+    schema_data->format_ = arrow_format(column, frame_.row_count());
+    schema_data->name_ = std::string{field.name()};
+
+    auto data = std::make_unique<ArrowArrayPrivateData>();
+    data->frame_ = frame_;
+    data->buffers_ = buffers_;
+    int64_t null_count = 0;
+    const auto data_type = column.type().data_type();
+    if(is_empty_type(data_type)) {
+        null_count = row_count;
+    } else if(is_bool_type(data_type)) {
+        export_bool_column(column, row_count, *data, null_count);
+    } else if(is_dynamic_string_type(data_type)) {
+        export_string_column(column, frame_.const_string_pool(), row_count, *data, null_count);
+    } else if(is_fixed_string_type(data_type)) {
+        util::check(column.is_inflated() && column.data().buffer().num_blocks() == 1, "Fixed-width string column {} is not contiguous", field);
+        data->buffer_ptrs_ = {nullptr, column.data().buffer().data()};
+    } else {
+        const uint8_t* validity = nullptr;
+        auto values = dense_values(column, get_type_size(data_type), row_count, *data, validity, null_count);
+        data->buffer_ptrs_ = {validity, values};
+    }
+
+    populate_array(out_array, data.release(), row_count, null_count);
+    populate_schema(out_schema, std::move(schema_data), ARROW_FLAG_NULLABLE);
+}
+
+void ArrowOutputFrame::export_frame(ArrowArray* out_array, ArrowSchema* out_schema) const {
+    ARCTICDB_SAMPLE_DEFAULT(ArrowExportFrame)
+    auto schema_data = std::make_unique<ArrowSchemaPrivateData>();
+    schema_data->format_ = "+s";
+    auto data = std::make_unique<ArrowArrayPrivateData>();
+    data->frame_ = frame_;
+    data->buffer_ptrs_ = {nullptr};
+
+    try {
+        for(size_t col = 0; col < frame_.num_columns(); ++col) {
+            auto& child_array = data->children_.emplace_back(std::make_unique<ArrowArray>());
+            auto& child_schema = schema_data->children_.emplace_back(std::make_unique<ArrowSchema>());
+            child_array->release = nullptr;
+            child_schema->release = nullptr;
+            export_column(col, child_array.get(), child_schema.get());
+        }
+    } catch(...) {
+        for(auto& child : data->children_)
+            release_array(child.get());
+        for(auto& child : schema_data->children_)
+            release_schema(child.get());
+        throw;
+    }
+
+    populate_array(out_array, data.release(), static_cast<int64_t>(frame_.row_count()), 0);
+    populate_schema(out_schema, std::move(schema_data), 0);
+}
+
+} // namespace arcticdb::pipelines
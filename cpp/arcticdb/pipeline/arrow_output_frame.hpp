@@ -0,0 +1,50 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/pipeline/arrow_c_data.hpp>
+#include <arcticdb/column_store/memory_segment.hpp>
+#include <arcticdb/util/buffer_holder.hpp>
+#include <arcticdb/util/constructors.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arcticdb::pipelines {
+
+/*
+ * Exports the columns of a SegmentInMemory through the Arrow C Data Interface.
+ *
+ * Contiguous, dense numeric columns are exported without copying: the exported ArrowArray points at the
+ * decoded buffer and keeps the segment alive until the consumer calls release(). Sparse columns are expanded
+ * and their sparse map becomes the validity bitmap. Dynamic string columns must still hold string pool
+ * offsets (i.e. the read was done with OutputFormat::ARROW so no Python objects were created), and are
+ * exported as large_utf8 (or large_binary for ASCII) offsets and data buffers built from the pool.
+ */
+class ArrowOutputFrame {
+public:
+    explicit ArrowOutputFrame(SegmentInMemory frame, std::shared_ptr<BufferHolder> buffers = {});
+
+    ARCTICDB_MOVE_ONLY_DEFAULT(ArrowOutputFrame)
+
+    // Exports the whole frame as a struct array, which is how record batches are represented in the C Data Interface
+    void export_frame(ArrowArray* out_array, ArrowSchema* out_schema) const;
+
+    void export_column(size_t col_pos, ArrowArray* out_array, ArrowSchema* out_schema) const;
+
+    [[nodiscard]] size_t num_columns() const { return frame_.num_columns(); }
+
+    [[nodiscard]] std::vector<std::string> names() const;
+
+private:
+    SegmentInMemory frame_;
+    std::shared_ptr<BufferHolder> buffers_;
+};
+
+} // namespace arcticdb::pipelines
@@ -8,6 +8,7 @@
 #include <third_party/semimap/semimap.h>
 
 #include <charconv>
+#include <cmath>
 
 namespace arcticdb {
 
@@ -207,6 +208,19 @@ robin_hood::unordered_flat_set<std::string> ColumnStats::segment_column_names()
     return res;
 }
 
+std::unordered_map<std::string, std::pair<std::string, std::string>> ColumnStats::minmax_column_names() const {
+    internal::check<ErrorCode::E_ASSERTION_FAILURE>(version_.has_value(), "Cannot construct column stat column names without specified versions");
+    std::unordered_map<std::string, std::pair<std::string, std::string>> res;
+    for (const auto& [column, column_stat_types]: column_stats_) {
+        if (column_stat_types.count(ColumnStatType::MINMAX) != 0) {
+            res.try_emplace(column,
+                            to_segment_column_name(column, ColumnStatTypeInternal::MIN, version_),
+                            to_segment_column_name(column, ColumnStatTypeInternal::MAX, version_));
+        }
+    }
+    return res;
+}
+
 std::unordered_map<std::string, std::unordered_set<std::string>> ColumnStats::to_map() const {
     std::unordered_map<std::string, std::unordered_set<std::string>> res;
     for (const auto& [column, types]: column_stats_) {
@@ -291,4 +305,170 @@ std::pair<std::string, ColumnStatType> ColumnStats::from_segment_column_name(
     }
 }
 
-}
\ No newline at end of file
+namespace {
+
+// The smallest and largest value of each column with stats over one row slice. Values are compared as doubles, see
+// comparison_may_match
+using ColumnBounds = std::unordered_map<std::string, std::pair<double, double>>;
+
+std::optional<double> numeric_scalar_at(const Column& column, size_t row) {
+    std::optional<double> res;
+    details::visit_type(column.type().data_type(), [&column, row, &res](auto column_desc_tag) {
+        using ColumnTagType = std::decay_t<decltype(column_desc_tag)>;
+        if constexpr (is_numeric_type(ColumnTagType::data_type)) {
+            if (auto value = column.scalar_at<typename ColumnTagType::raw_type>(static_cast<position_t>(row)); value.has_value())
+                res = static_cast<double>(*value);
+        }
+    });
+    return res.has_value() && std::isnan(*res) ? std::nullopt : res;
+}
+
+std::optional<double> numeric_value(const Value& value) {
+    std::optional<double> res;
+    details::visit_type(value.data_type_, [&value, &res](auto value_desc_tag) {
+        using ValueTagType = std::decay_t<decltype(value_desc_tag)>;
+        if constexpr (is_numeric_type(ValueTagType::data_type))
+            res = static_cast<double>(value.get<typename ValueTagType::raw_type>());
+    });
+    return res.has_value() && std::isnan(*res) ? std::nullopt : res;
+}
+
+// Flips a comparison so that the column is on the left
+OperationType with_column_on_left(OperationType operation) {
+    switch (operation) {
+        case OperationType::LT: return OperationType::GT;
+        case OperationType::LE: return OperationType::GE;
+        case OperationType::GT: return OperationType::LT;
+        case OperationType::GE: return OperationType::LE;
+        default: return operation;
+    }
+}
+
+// The filter may compare the column and the value in a wider type than double, where values that are equal as doubles
+// can differ, so strict comparisons are only ruled out as though they were not strict and NE is never ruled out
+bool comparison_may_match(OperationType operation, const std::pair<double, double>& bounds, double value) {
+    const auto& [min, max] = bounds;
+    switch (operation) {
+        case OperationType::EQ: return min <= value && value <= max;
+        case OperationType::LT:
+        case OperationType::LE: return min <= value;
+        case OperationType::GT:
+        case OperationType::GE: return max >= value;
+        default: return true;
+    }
+}
+
+bool may_match(const ExpressionContext& expression_context, const VariantNode& node, const ColumnBounds& bounds) {
+    const auto* expression_name = std::get_if<ExpressionName>(&node);
+    if (expression_name == nullptr)
+        return true;
+
+    const auto expression_node = expression_context.expression_nodes_.get_value(expression_name->value);
+    const auto operation = expression_node->operation_type_;
+    switch (operation) {
+        case OperationType::AND:
+            return may_match(expression_context, expression_node->left_, bounds) &&
+                   may_match(expression_context, expression_node->right_, bounds);
+        case OperationType::OR:
+            return may_match(expression_context, expression_node->left_, bounds) ||
+                   may_match(expression_context, expression_node->right_, bounds);
+        case OperationType::EQ:
+        case OperationType::LT:
+        case OperationType::LE:
+        case OperationType::GT:
+        case OperationType::GE: {
+            const auto* column_name = std::get_if<ColumnName>(&expression_node->left_);
+            const auto* value_name = std::get_if<ValueName>(&expression_node->right_);
+            auto column_operation = operation;
+            if (column_name == nullptr || value_name == nullptr) {
+                column_name = std::get_if<ColumnName>(&expression_node->right_);
+                value_name = std::get_if<ValueName>(&expression_node->left_);
+                column_operation = with_column_on_left(operation);
+            }
+            if (column_name == nullptr || value_name == nullptr)
+                return true;
+
+            const auto column_bounds = bounds.find(column_name->value);
+            if (column_bounds == bounds.end())
+                return true;
+
+            const auto value = numeric_value(*expression_context.values_.get_value(value_name->value));
+            return !value.has_value() || comparison_may_match(column_operation, column_bounds->second, *value);
+        }
+        default:
+            return true;
+    }
+}
+
+} // namespace
+
+size_t prune_with_column_stats(
+    const SegmentInMemory& column_stats_segment,
+    const ExpressionContext& expression_context,
+    std::vector<pipelines::SliceAndKey>& slice_and_keys) {
+    const auto& start_index_column = column_stats_segment.column(0);
+    const auto& end_index_column = column_stats_segment.column(1);
+    std::vector<std::tuple<std::string, const Column*, const Column*>> minmax_columns;
+    for (const auto& [column, names]: ColumnStats{column_stats_segment.fields()}.minmax_column_names()) {
+        const auto min_position = column_stats_segment.column_index(names.first);
+        const auto max_position = column_stats_segment.column_index(names.second);
+        if (min_position.has_value() && max_position.has_value()) {
+            minmax_columns.emplace_back(column,
+                                        &column_stats_segment.column(static_cast<position_t>(*min_position)),
+                                        &column_stats_segment.column(static_cast<position_t>(*max_position)));
+        }
+    }
+    if (minmax_columns.empty())
+        return 0;
+
+    // Row slices are identified by the start and end index of their data keys. Slices that share both are rare, but
+    // their bounds are combined so that each is only ruled out if all of them could be.
+    std::map<std::pair<timestamp, timestamp>, ColumnBounds> bounds_by_row_slice;
+    for (size_t row = 0; row < column_stats_segment.row_count(); ++row) {
+        const auto start_index = start_index_column.scalar_at<timestamp>(static_cast<position_t>(row));
+        const auto end_index = end_index_column.scalar_at<timestamp>(static_cast<position_t>(row));
+        if (!start_index.has_value() || !end_index.has_value())
+            continue;
+
+        ColumnBounds row_bounds;
+        for (const auto& [column, min_column, max_column]: minmax_columns) {
+            const auto min = numeric_scalar_at(*min_column, row);
+            const auto max = numeric_scalar_at(*max_column, row);
+            if (min.has_value() && max.has_value())
+                row_bounds.try_emplace(column, *min, *max);
+        }
+        auto [it, inserted] = bounds_by_row_slice.try_emplace(std::make_pair(*start_index, *end_index), std::move(row_bounds));
+        if (!inserted) {
+            auto& existing = it->second;
+            for (auto column_bounds = existing.begin(); column_bounds != existing.end();) {
+                if (auto other = row_bounds.find(column_bounds->first); other == row_bounds.end()) {
+                    column_bounds = existing.erase(column_bounds);
+                } else {
+                    column_bounds->second.first = std::min(column_bounds->second.first, other->second.first);
+                    column_bounds->second.second = std::max(column_bounds->second.second, other->second.second);
+                    ++column_bounds;
+                }
+            }
+        }
+    }
+
+    std::map<std::pair<timestamp, timestamp>, bool> may_match_by_row_slice;
+    const auto before = slice_and_keys.size();
+    slice_and_keys.erase(std::remove_if(slice_and_keys.begin(), slice_and_keys.end(), [&](const pipelines::SliceAndKey& slice_and_key) {
+        const auto start_index = slice_and_key.key().start_index();
+        const auto end_index = slice_and_key.key().end_index();
+        if (!std::holds_alternative<NumericIndex>(start_index) || !std::holds_alternative<NumericIndex>(end_index))
+            return false;
+
+        const auto row_slice = std::make_pair(std::get<NumericIndex>(start_index), std::get<NumericIndex>(end_index));
+        auto [cached, inserted] = may_match_by_row_slice.try_emplace(row_slice, true);
+        if (inserted) {
+            if (auto bounds = bounds_by_row_slice.find(row_slice); bounds != bounds_by_row_slice.end())
+                cached->second = may_match(expression_context, expression_context.root_node_name_, bounds->second);
+        }
+        return !cached->second;
+    }), slice_and_keys.end());
+    return before - slice_and_keys.size();
+}
+
+}
@@ -32,6 +32,8 @@ public:
 
     void drop(const ColumnStats& to_drop, bool warn_if_missing=true);
     robin_hood::unordered_flat_set<std::string> segment_column_names() const;
+    // Maps each column with MINMAX stats to the names of its min and max columns in the column stats segment
+    std::unordered_map<std::string, std::pair<std::string, std::string>> minmax_column_names() const;
 
     std::unordered_map<std::string, std::unordered_set<std::string>> to_map() const;
     std::optional<Clause> clause() const;
@@ -48,4 +50,15 @@ private:
 
 };
 
+/*
+ * Removes from slice_and_keys the row slices that the MINMAX stats in column_stats_segment show cannot hold a row
+ * satisfying the filter expression, so that they are never fetched. Only comparisons between a column and a numeric
+ * value, combined with AND and OR, can rule a slice out; any other expression, and any slice or column without stats,
+ * is assumed to match. Returns the number of slices removed.
+ */
+size_t prune_with_column_stats(
+    const SegmentInMemory& column_stats_segment,
+    const ExpressionContext& expression_context,
+    std::vector<pipelines::SliceAndKey>& slice_and_keys);
+
 }
\ No newline at end of file
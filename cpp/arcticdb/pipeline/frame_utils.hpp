@@ -92,6 +92,18 @@ RawType* flatten_tensor(
 }
 
 
+// Interns the strings for a column slice in one batch, writing the offset of each to its row in out_ptr
+inline void set_string_offsets(
+    StringPool& string_pool,
+    const std::vector<std::string_view>& strings,
+    const std::vector<size_t>& string_rows,
+    StringPool::offset_t* out_ptr) {
+    std::vector<StringPool::offset_t> offsets(strings.size());
+    string_pool.get_batch(strings.data(), strings.size(), offsets.data());
+    for (size_t i = 0; i < offsets.size(); ++i)
+        out_ptr[string_rows[i]] = offsets[i];
+}
+
 template<typename Aggregator>
 std::optional<convert::StringEncodingError> aggregator_set_data(
     const TypeDescriptor& type_desc,
@@ -127,6 +139,26 @@ std::optional<convert::StringEncodingError> aggregator_set_data(
                 for (size_t s = 0; s < rows_to_write; ++s, char_data += str_stride) {
                     agg.set_string_at(col, s, char_data, str_len);
                 }
+            } else if (tensor.arrow()) {
+                // Arrow strings are already UTF-8 (or raw bytes), so they go straight into the pool without the GIL
+                const auto& arrow = *tensor.arrow();
+                auto& column = agg.segment().column(col);
+                column.allocate_data(rows_to_write * sizeof(StringPool::offset_t));
+                auto out_ptr = reinterpret_cast<StringPool::offset_t*>(column.buffer().data());
+                std::vector<std::string_view> strings;
+                std::vector<size_t> string_rows;
+                strings.reserve(rows_to_write);
+                string_rows.reserve(rows_to_write);
+                for (size_t s = 0; s < rows_to_write; ++s) {
+                    const auto pos = static_cast<int64_t>(row + s);
+                    if (arrow.is_valid(pos)) {
+                        strings.emplace_back(arrow.string_at(pos));
+                        string_rows.emplace_back(s);
+                    } else {
+                        out_ptr[s] = not_a_string();
+                    }
+                }
+                set_string_offsets(agg.segment().string_pool(), strings, string_rows, out_ptr);
             } else {
                 auto data = const_cast<void *>(tensor.data());
                 auto ptr_data = reinterpret_cast<PyObject **>(data);
@@ -141,15 +173,23 @@ std::optional<convert::StringEncodingError> aggregator_set_data(
                 // If such a string is encountered in a column, then the GIL will be held until that whole column has
                 // been processed, on the assumption that if a column has one such string it will probably have many.
                 std::optional<ScopedGILLock> scoped_gil_lock;
+                // The strings are interned in one batch once the column has been scanned, so the wrappers (which may
+                // own a temporary UTF-8 encoding) are kept until then. Declared after the GIL lock so they are
+                // released while it is still held.
+                std::vector<convert::PyStringWrapper> wrappers;
+                std::vector<std::string_view> strings;
+                std::vector<size_t> string_rows;
+                wrappers.reserve(rows_to_write);
+                strings.reserve(rows_to_write);
+                string_rows.reserve(rows_to_write);
                 auto& column = agg.segment().column(col);
                 column.allocate_data(rows_to_write * sizeof(StringPool::offset_t));
                 auto out_ptr = reinterpret_cast<StringPool::offset_t*>(column.buffer().data());
-                auto& string_pool = agg.segment().string_pool();
                 for (size_t s = 0; s < rows_to_write; ++s, ++ptr_data) {
                     if (*ptr_data == none.ptr()) {
-                        *out_ptr++ = not_a_string();
+                        out_ptr[s] = not_a_string();
                     } else if(is_py_nan(*ptr_data)){
-                        *out_ptr++ = nan_placeholder();
+                        out_ptr[s] = nan_placeholder();
                     } else {
                         if constexpr (is_utf_type(slice_value_type(dt))) {
                             wrapper_or_error = convert::py_unicode_to_buffer(*ptr_data, scoped_gil_lock);
@@ -158,9 +198,9 @@ std::optional<convert::StringEncodingError> aggregator_set_data(
                         }
                         // Cannot use util::variant_match as only one of the branches would have a return type
                         if (std::holds_alternative<convert::PyStringWrapper>(wrapper_or_error)) {
-                            convert::PyStringWrapper wrapper(std::move(std::get<convert::PyStringWrapper>(wrapper_or_error)));
-                            const auto offset = string_pool.get(wrapper.buffer_, wrapper.length_);
-                            *out_ptr++ = offset.offset();
+                            auto& wrapper = wrappers.emplace_back(std::move(std::get<convert::PyStringWrapper>(wrapper_or_error)));
+                            strings.emplace_back(wrapper.buffer_, wrapper.length_);
+                            string_rows.emplace_back(s);
                         } else if (std::holds_alternative<convert::StringEncodingError>(wrapper_or_error)) {
                             auto error = std::get<convert::StringEncodingError>(wrapper_or_error);
                             error.row_index_in_slice_ = s;
@@ -170,6 +210,7 @@ std::optional<convert::StringEncodingError> aggregator_set_data(
                         }
                     }
                 }
+                set_string_offsets(agg.segment().string_pool(), strings, string_rows, out_ptr);
             }
         } else if constexpr ((is_numeric_type(dt) || is_bool_type(dt)) && tag.dimension() == Dimension::Dim0) {
             auto ptr = tensor.template ptr_cast<RawType>(row);
@@ -11,6 +11,7 @@
 #include <arcticdb/pipeline/index_segment_reader.hpp>
 #include <arcticdb/pipeline/slicing.hpp>
 #include <arcticdb/pipeline/index_fields.hpp>
+#include <arcticdb/pipeline/index_utils.hpp>
 #include <arcticdb/pipeline/query.hpp>
 
 using namespace arcticdb::entity;
@@ -21,7 +22,7 @@ namespace arcticdb::pipelines::index {
 
 IndexSegmentReader get_index_reader(const AtomKey &prev_index, const std::shared_ptr<Store> &store) {
     auto [key, seg] = store->read_sync(prev_index);
-    return index::IndexSegmentReader{std::move(seg)};
+    return expand_multi_level_index(index::IndexSegmentReader{std::move(seg)}, store);
 }
 
 IndexSegmentReader::IndexSegmentReader(SegmentInMemory&& s) : seg_(std::move(s)) {
@@ -51,13 +52,19 @@ bool IndexSegmentReader::empty() const {
 IndexRange get_index_segment_range(
     const AtomKey& prev_index,
     const std::shared_ptr<Store>& store) {
-    auto isr = get_index_reader(prev_index, store);
+    // The first and last rows of the root of a multi-level index span the same range as those of its leaves
+    auto [key, seg] = store->read_sync(prev_index);
+    index::IndexSegmentReader isr{std::move(seg)};
     return IndexRange{
         isr.begin()->key().start_index(),
         isr.last()->key().end_index()
     };
 }
 
+bool IndexSegmentReader::is_multi_level() const {
+    return size() != 0 && key_type_from_segment<Fields>(seg_, 0) == KeyType::TABLE_INDEX_LEAF;
+}
+
 bool IndexSegmentReader::bucketize_dynamic() const {
     return tsd().proto().has_column_groups() && tsd().proto().column_groups().enabled();
 }
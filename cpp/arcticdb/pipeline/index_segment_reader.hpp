@@ -39,6 +39,7 @@ struct IndexSegmentReader {
 
         swap(left.seg_, right.seg_);
         swap(left.tsd_, right.tsd_);
+        swap(left.leaves_, right.leaves_);
     }
 
     ARCTICDB_MOVE_ONLY_DEFAULT(IndexSegmentReader)
@@ -65,6 +66,18 @@ struct IndexSegmentReader {
 
     bool bucketize_dynamic() const;
 
+    // True for the root of a multi-level index, whose rows are the keys of leaf index segments rather than data keys
+    bool is_multi_level() const;
+
+    // The rows of the root for an index that has been expanded from a multi-level one, and empty otherwise
+    const std::vector<SliceAndKey>& leaves() const {
+        return leaves_;
+    }
+
+    void set_leaves(std::vector<SliceAndKey>&& leaves) {
+        leaves_ = std::move(leaves);
+    }
+
     SortedValue get_sorted() const {
         return sorted_value_from_proto(tsd().proto().stream_descriptor().sorted());
     }
@@ -90,6 +103,7 @@ private:
 #endif
     SegmentInMemory seg_;
     TimeseriesDescriptor tsd_;
+    std::vector<SliceAndKey> leaves_;
 };
 
 struct IndexSegmentIterator {
@@ -10,16 +10,108 @@
 #include <arcticdb/pipeline/index_writer.hpp>
 #include <arcticdb/pipeline/frame_utils.hpp>
 
+#include <algorithm>
+
 namespace arcticdb::pipelines::index {
 
+namespace {
+
+// Leaves hold whole row slices, so every column slice of a row slice is in the same leaf
+std::vector<std::vector<SliceAndKey>> split_into_leaves(std::vector<SliceAndKey>&& slice_and_keys, size_t leaf_size) {
+    std::sort(std::begin(slice_and_keys), std::end(slice_and_keys), [](const SliceAndKey& left, const SliceAndKey& right) {
+        return std::tie(left.slice_.row_range.first, left.slice_.col_range.first) <
+            std::tie(right.slice_.row_range.first, right.slice_.col_range.first);
+    });
+
+    std::vector<std::vector<SliceAndKey>> leaves;
+    for(size_t i = 0; i < slice_and_keys.size();) {
+        auto& leaf = leaves.emplace_back();
+        while(i < slice_and_keys.size() &&
+            (leaf.size() < leaf_size || slice_and_keys[i].slice_.row_range.first == leaf.back().slice_.row_range.first)) {
+            leaf.emplace_back(std::move(slice_and_keys[i++]));
+        }
+        std::sort(std::begin(leaf), std::end(leaf));
+    }
+    return leaves;
+}
+
+FrameSlice leaf_slice(const std::vector<SliceAndKey>& leaf) {
+    ColRange col_range{leaf.front().slice_.col_range};
+    RowRange row_range{leaf.front().slice_.row_range};
+    for(const auto& slice_and_key : leaf) {
+        const auto& slice = slice_and_key.slice_;
+        col_range = ColRange{std::min(col_range.first, slice.col_range.first), std::max(col_range.second, slice.col_range.second)};
+        row_range = RowRange{std::min(row_range.first, slice.row_range.first), std::max(row_range.second, slice.row_range.second)};
+    }
+    return FrameSlice{col_range, row_range};
+}
+
+template <class IndexType>
+folly::Future<entity::AtomKey> write_multi_level_index(
+    TimeseriesDescriptor&& metadata,
+    std::vector<SliceAndKey>&& slice_and_keys,
+    const IndexPartialKey& partial_key,
+    const std::shared_ptr<stream::StreamSink>& sink,
+    std::vector<SliceAndKey>&& kept_leaves,
+    size_t leaf_size) {
+    std::vector<FrameSlice> leaf_slices;
+    std::vector<folly::Future<entity::AtomKey>> leaf_keys;
+    for(const auto& leaf : split_into_leaves(std::move(slice_and_keys), leaf_size)) {
+        IndexWriter<IndexType> writer(sink, partial_key, metadata.clone(), KeyType::TABLE_INDEX_LEAF);
+        for(const auto& slice_and_key : leaf)
+            writer.add(slice_and_key.key(), slice_and_key.slice_);
+
+        leaf_slices.emplace_back(leaf_slice(leaf));
+        leaf_keys.emplace_back(writer.commit());
+    }
+    ARCTICDB_DEBUG(log::version(), "Writing multi-level index for {} with {} new and {} existing leaves",
+                   partial_key.id, leaf_keys.size(), kept_leaves.size());
+
+    return folly::collect(std::move(leaf_keys)).via(&async::cpu_executor()).thenValue(
+        [metadata = std::move(metadata), leaf_slices = std::move(leaf_slices), kept_leaves = std::move(kept_leaves), partial_key, sink](auto&& keys) mutable {
+        IndexWriter<IndexType> writer(sink, partial_key, std::move(metadata));
+        for(const auto& leaf : kept_leaves)
+            writer.add(leaf.key(), leaf.slice_);
+
+        for(size_t i = 0; i < keys.size(); ++i)
+            writer.add(keys[i], leaf_slices[i]);
+
+        return writer.commit();
+    });
+}
+
+bool leaf_in_range(const SliceAndKey& leaf, const std::variant<std::monostate, IndexRange, RowRange>& range) {
+    return util::variant_match(range,
+        [](const std::monostate&) {
+            return true;
+        },
+        [&leaf](const IndexRange& index_range) {
+            return !index_range.specified_ ||
+                (leaf.key().start_index() <= index_range.end_ && index_range.start_ <= leaf.key().end_index());
+        },
+        [&leaf](const RowRange& row_range) {
+            return leaf.slice_.row_range.first < row_range.second && row_range.first < leaf.slice_.row_range.second;
+        });
+}
+
+} // namespace
+
 template <class IndexType>
 folly::Future<entity::AtomKey> write_index(
     TimeseriesDescriptor &&metadata,
     std::vector<SliceAndKey> &&sk,
     const IndexPartialKey &partial_key,
-    const std::shared_ptr<stream::StreamSink> &sink
+    const std::shared_ptr<stream::StreamSink> &sink,
+    size_t index_leaf_size,
+    std::vector<SliceAndKey>&& kept_leaves
     ) {
     auto slice_and_keys = std::move(sk);
+    const auto bucketize_columns = metadata.proto().has_column_groups() && metadata.proto().column_groups().enabled();
+    // Bucketized indexes are always single-level, as a leaf spans several buckets
+    if(!bucketize_columns && index_leaf_size != 0 && (!kept_leaves.empty() || slice_and_keys.size() > index_leaf_size))
+        return write_multi_level_index<IndexType>(std::move(metadata), std::move(slice_and_keys), partial_key, sink, std::move(kept_leaves), index_leaf_size);
+
+    util::check(kept_leaves.empty(), "Cannot keep the leaves of a multi-level index when writing a single-level index");
     IndexWriter<IndexType> writer(sink, partial_key, std::move(metadata));
     for (const auto &slice_and_key : slice_and_keys) {
         writer.add(slice_and_key.key(), slice_and_key.slice_);
@@ -32,11 +124,13 @@ folly::Future<entity::AtomKey> write_index(
     TimeseriesDescriptor &&metadata,
     std::vector<SliceAndKey> &&sk,
     const IndexPartialKey &partial_key,
-    const std::shared_ptr<stream::StreamSink> &sink
+    const std::shared_ptr<stream::StreamSink> &sink,
+    size_t index_leaf_size,
+    std::vector<SliceAndKey>&& kept_leaves
     ) {
     return util::variant_match(index, [&] (auto idx) {
         using IndexType = decltype(idx);
-        return write_index<IndexType>(std::move(metadata), std::move(sk), partial_key, sink);
+        return write_index<IndexType>(std::move(metadata), std::move(sk), partial_key, sink, index_leaf_size, std::move(kept_leaves));
     });
 }
 
@@ -44,12 +138,14 @@ folly::Future<entity::AtomKey> write_index(
     InputTensorFrame&& frame,
     std::vector<SliceAndKey> &&slice_and_keys,
     const IndexPartialKey &partial_key,
-    const std::shared_ptr<stream::StreamSink> &sink
+    const std::shared_ptr<stream::StreamSink> &sink,
+    size_t index_leaf_size,
+    std::vector<SliceAndKey>&& kept_leaves
     ) {
     auto offset = frame.offset;
     auto index = stream::index_type_from_descriptor(frame.desc);
     auto timeseries_desc = index_descriptor_from_frame(std::move(frame), offset);
-    return write_index(index, std::move(timeseries_desc), std::move(slice_and_keys), partial_key, sink);
+    return write_index(index, std::move(timeseries_desc), std::move(slice_and_keys), partial_key, sink, index_leaf_size, std::move(kept_leaves));
 }
 
 folly::Future<entity::AtomKey> write_index(
@@ -65,11 +161,49 @@ folly::Future<entity::AtomKey> write_index(
     });
 }
 
+IndexSegmentReader expand_multi_level_index(
+    IndexSegmentReader&& reader,
+    const std::shared_ptr<Store>& store,
+    const std::variant<std::monostate, IndexRange, RowRange>& range) {
+    if(!reader.is_multi_level())
+        return std::move(reader);
+
+    std::vector<SliceAndKey> leaves;
+    std::copy(std::cbegin(reader), std::cend(reader), std::back_inserter(leaves));
+    std::vector<folly::Future<std::pair<entity::VariantKey, SegmentInMemory>>> leaf_segments;
+    for(const auto& leaf : leaves) {
+        if(leaf_in_range(leaf, range))
+            leaf_segments.emplace_back(store->read(leaf.key()));
+    }
+    ARCTICDB_DEBUG(log::version(), "Reading {} of the {} leaves of a multi-level index", leaf_segments.size(), leaves.size());
+
+    std::vector<SliceAndKey> slice_and_keys;
+    for(auto& [_, leaf_segment] : folly::collect(std::move(leaf_segments)).get()) {
+        IndexSegmentReader leaf_reader{std::move(leaf_segment)};
+        std::copy(std::cbegin(leaf_reader), std::cend(leaf_reader), std::back_inserter(slice_and_keys));
+    }
+    std::sort(std::begin(slice_and_keys), std::end(slice_and_keys));
+
+    const auto& last_leaf = leaves.back().key();
+    auto segment = util::variant_match(stream::index_type_from_descriptor(reader.tsd().as_stream_descriptor()), [&] (auto idx) {
+        using IndexType = decltype(idx);
+        IndexWriter<IndexType> writer(nullptr, IndexPartialKey{last_leaf.id(), last_leaf.version_id()}, reader.tsd().clone());
+        for(const auto& slice_and_key : slice_and_keys)
+            writer.add(slice_and_key.key(), slice_and_key.slice_);
+
+        return writer.commit_in_memory();
+    });
+
+    IndexSegmentReader expanded{std::move(segment)};
+    expanded.set_leaves(std::move(leaves));
+    return expanded;
+}
+
 std::pair<index::IndexSegmentReader, std::vector<SliceAndKey>> read_index_to_vector(
     const std::shared_ptr<Store> &store,
     const AtomKey &index_key) {
     auto [_, index_seg] = store->read_sync(index_key);
-    index::IndexSegmentReader index_segment_reader(std::move(index_seg));
+    auto index_segment_reader = expand_multi_level_index(index::IndexSegmentReader{std::move(index_seg)}, store);
     std::vector<SliceAndKey> slice_and_keys;
     for (const auto& row : index_segment_reader)
         slice_and_keys.push_back(row);
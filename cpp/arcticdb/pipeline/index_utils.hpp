@@ -12,9 +12,12 @@
 #include <arcticdb/entity/versioned_item.hpp>
 #include <arcticdb/pipeline/pipeline_common.hpp>
 #include <arcticdb/entity/variant_key.hpp>
+#include <arcticdb/entity/index_range.hpp>
 
 #include <folly/futures/Future.h>
 
+#include <variant>
+
 namespace arcticdb {
 namespace stream {
 struct StreamSink;
@@ -86,19 +89,29 @@ IndexValue index_end_from_segment(const SegmentType &seg, size_t row_id) {
     return index_value_from_segment(seg, row_id, FieldType::end_index);
 }
 
+/*
+ * When index_leaf_size is set and there are more data keys than that, the index is written as a root segment whose
+ * rows are TABLE_INDEX_LEAF keys, each an ordinary index over a run of whole row slices, along with the rows, columns
+ * and index range that the leaf covers. kept_leaves are rows of an existing root to carry over unchanged, in which
+ * case slice_and_keys only need to cover the rows after them.
+ */
 template<class IndexType>
 folly::Future<entity::AtomKey> write_index(
     TimeseriesDescriptor&& metadata,
     std::vector<SliceAndKey>&& slice_and_keys,
     const IndexPartialKey& partial_key,
-    const std::shared_ptr<stream::StreamSink>& sink);
+    const std::shared_ptr<stream::StreamSink>& sink,
+    size_t index_leaf_size = 0,
+    std::vector<SliceAndKey>&& kept_leaves = {});
 
 folly::Future<entity::AtomKey> write_index(
     const stream::Index& index,
     TimeseriesDescriptor &&metadata,
     std::vector<SliceAndKey> &&sk,
     const IndexPartialKey &partial_key,
-    const std::shared_ptr<stream::StreamSink> &sink);
+    const std::shared_ptr<stream::StreamSink> &sink,
+    size_t index_leaf_size = 0,
+    std::vector<SliceAndKey>&& kept_leaves = {});
 
 folly::Future<entity::AtomKey> write_index(
     InputTensorFrame&& frame,
@@ -111,9 +124,21 @@ folly::Future<entity::AtomKey> write_index(
     InputTensorFrame&& frame,
     std::vector<SliceAndKey> &&slice_and_keys,
     const IndexPartialKey &partial_key,
-    const std::shared_ptr<stream::StreamSink> &sink
+    const std::shared_ptr<stream::StreamSink> &sink,
+    size_t index_leaf_size = 0,
+    std::vector<SliceAndKey>&& kept_leaves = {}
     );
 
+/*
+ * Returns the reader unchanged unless it is the root of a multi-level index, in which case the leaves that may hold
+ * rows within range are read and combined into a single-level index with the root's descriptor. The rows of the root
+ * are kept in the result's leaves().
+ */
+IndexSegmentReader expand_multi_level_index(
+    IndexSegmentReader&& reader,
+    const std::shared_ptr<Store>& store,
+    const std::variant<std::monostate, IndexRange, RowRange>& range = std::monostate{});
+
 inline folly::Future<VersionedItem> index_and_version(
     const stream::Index& index,
     const std::shared_ptr<stream::StreamSink>& store,
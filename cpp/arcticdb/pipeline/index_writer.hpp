@@ -106,6 +106,14 @@ public:
         return std::move(key_being_committed_);
     }
 
+    // For a writer constructed without a sink, returns the index segment rather than writing it
+    SegmentInMemory commit_in_memory() {
+        util::check(!sink_, "Cannot take the index segment from a writer that has a sink");
+        agg_.commit();
+        util::check(in_memory_segment_.has_value(), "Index writer did not produce a segment");
+        return std::move(*in_memory_segment_);
+    }
+
 private:
     IndexValue segment_start(const SegmentInMemory &segment) const {
         return Index::start_value_for_keys_segment(segment);
@@ -117,6 +125,10 @@ private:
 
     void on_segment(SegmentInMemory &&s) {
         auto seg = std::move(s);
+        if(!sink_) {
+            in_memory_segment_ = std::move(seg);
+            return;
+        }
         auto key_type = key_type_.value_or(get_key_type_for_index_stream(partial_key_.id));
         key_being_committed_ = sink_->write(
             key_type, partial_key_.version_id, partial_key_.id,
@@ -134,6 +146,7 @@ private:
     std::optional<std::size_t> current_col_ = std::nullopt;
     std::optional<std::size_t> current_row_ = std::nullopt;
     std::optional<KeyType> key_type_ = std::nullopt;
+    std::optional<SegmentInMemory> in_memory_segment_ = std::nullopt;
 };
 
 
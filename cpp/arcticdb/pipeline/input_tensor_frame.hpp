@@ -14,6 +14,8 @@
 #include <arcticdb/entity/types.hpp>
 #include <arcticdb/util/flatten_utils.hpp>
 
+#include <memory>
+
 namespace arcticdb::pipelines {
 
 using namespace arcticdb::entity;
@@ -39,6 +41,8 @@ struct InputTensorFrame {
     ssize_t num_rows = 0;
     mutable ssize_t offset = 0;
     mutable bool bucketize_dynamic = 0;
+    // Keeps alive memory the tensors point into when it is not owned by Python, e.g. an imported Arrow array
+    std::shared_ptr<void> input_data_owner;
 
     void set_offset(ssize_t off) const {
         offset = off;
@@ -0,0 +1,188 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#ifdef ARCTICDB_USING_CONDA
+    #include <robin_hood.h>
+#else
+    #include <arcticdb/util/third_party/robin_hood.hpp>
+#endif
+
+namespace arcticdb {
+
+/*
+ * The representations a ValueSet chooses between for the members of an isin/isnotin list, once converted to the type
+ * they are compared with a column in. They derive from MembershipRepresentation so that the membership operators can
+ * take any of them, and binary_membership instantiates its probe loop once per representation, so that contains is
+ * inlined into it rather than dispatched per row.
+ */
+template<typename Derived, typename T>
+struct MembershipRepresentation {
+    using value_type = T;
+
+    [[nodiscard]] const Derived& derived() const {
+        return static_cast<const Derived&>(*this);
+    }
+};
+
+// Sorted, deduplicated members, searched without data-dependent branches. Used for small sets, where the whole array
+// stays in cache, and for all floating point sets.
+template<typename T>
+class SortedMembers : public MembershipRepresentation<SortedMembers<T>, T> {
+public:
+    // values must be sorted and unique, without NaNs
+    explicit SortedMembers(std::vector<T>&& values) :
+        values_(std::move(values)) {
+    }
+
+    [[nodiscard]] bool contains(T value) const {
+        if (values_.empty())
+            return false;
+
+        // A lower bound whose loop runs a fixed number of times for a given size, with the comparison compiled to a
+        // conditional move, so that probes never stall on a mispredicted branch
+        const T* base = values_.data();
+        size_t length = values_.size();
+        while (length > 1) {
+            const size_t half = length / 2;
+            base = base[half - 1] < value ? base + half : base;
+            length -= half;
+        }
+        return *base == value;
+    }
+
+private:
+    std::vector<T> values_;
+};
+
+// One bit per value between the smallest and largest members. Used for integer sets dense enough that the bitmap is
+// no bigger than the sorted array would be.
+template<typename T>
+class BitmapMembers : public MembershipRepresentation<BitmapMembers<T>, T> {
+    static_assert(std::is_integral_v<T>, "BitmapMembers only supports integers");
+    using UnsignedType = std::make_unsigned_t<T>;
+
+public:
+    // values must be sorted, unique and not empty
+    explicit BitmapMembers(const std::vector<T>& values) :
+        min_(values.front()),
+        range_(static_cast<uint64_t>(static_cast<UnsignedType>(static_cast<UnsignedType>(values.back()) - static_cast<UnsignedType>(values.front()))) + 1),
+        bits_((range_ + 63) / 64) {
+        for (auto value: values) {
+            const auto offset = offset_of(value);
+            bits_[offset >> 6] |= uint64_t(1) << (offset & 63);
+        }
+    }
+
+    [[nodiscard]] bool contains(T value) const {
+        // Values below the minimum wrap around to large offsets, so one comparison checks both bounds
+        const auto offset = offset_of(value);
+        return offset < range_ && ((bits_[offset >> 6] >> (offset & 63)) & 1) != 0;
+    }
+
+private:
+    [[nodiscard]] uint64_t offset_of(T value) const {
+        return static_cast<uint64_t>(static_cast<UnsignedType>(static_cast<UnsignedType>(value) - static_cast<UnsignedType>(min_)));
+    }
+
+    T min_;
+    uint64_t range_;
+    std::vector<uint64_t> bits_;
+};
+
+// An open-addressing hash set behind a blocked bloom filter, used for large sparse integer sets. Each member sets three
+// bits in a single 64-bit block of the filter, so rejecting a value not in the set, the common case when filtering,
+// costs one cache line rather than a probe of the hash table.
+template<typename T>
+class HashMembers : public MembershipRepresentation<HashMembers<T>, T> {
+    static_assert(std::is_integral_v<T>, "HashMembers only supports integers");
+
+public:
+    explicit HashMembers(const std::vector<T>& values) {
+        set_.reserve(values.size());
+        // About 16 bits of filter per member
+        size_t blocks = 1;
+        while (blocks * 4 < values.size())
+            blocks *= 2;
+        bloom_.resize(blocks);
+        block_mask_ = blocks - 1;
+        for (auto value: values) {
+            set_.insert(value);
+            const auto hash = hash_of(value);
+            bloom_[hash & block_mask_] |= bloom_bits(hash);
+        }
+    }
+
+    [[nodiscard]] bool contains(T value) const {
+        const auto hash = hash_of(value);
+        const auto bits = bloom_bits(hash);
+        if ((bloom_[hash & block_mask_] & bits) != bits)
+            return false;
+
+        return set_.contains(value);
+    }
+
+private:
+    [[nodiscard]] static uint64_t hash_of(T value) {
+        return robin_hood::hash_int(static_cast<uint64_t>(value));
+    }
+
+    // The block is chosen by the low bits of the hash, and the bits within it by the high ones
+    [[nodiscard]] static uint64_t bloom_bits(uint64_t hash) {
+        return (uint64_t(1) << ((hash >> 40) & 63)) | (uint64_t(1) << ((hash >> 46) & 63)) | (uint64_t(1) << ((hash >> 52) & 63));
+    }
+
+    robin_hood::unordered_flat_set<T> set_;
+    std::vector<uint64_t> bloom_;
+    uint64_t block_mask_;
+};
+
+template<typename T>
+using MembershipSet = std::conditional_t<
+        std::is_integral_v<T>,
+        std::variant<SortedMembers<T>, BitmapMembers<T>, HashMembers<T>>,
+        std::variant<SortedMembers<T>>>;
+
+// Sets no bigger than this are searched as a sorted array
+constexpr size_t MAX_SORTED_MEMBERS = 256;
+// Bitmaps are used while they take no more than this many bits per member, i.e. no more than a sorted array of 64-bit
+// members would, and never above an absolute size
+constexpr uint64_t MAX_BITMAP_BITS_PER_MEMBER = 64;
+constexpr uint64_t MAX_BITMAP_BITS = uint64_t(1) << 27;
+
+// Floating point sets are always sorted arrays, as hashing would tell 0.0 from -0.0. NaNs are dropped, as nothing is
+// equal to them.
+template<typename T>
+MembershipSet<T> make_membership_set(std::vector<T>&& values) {
+    if constexpr (std::is_floating_point_v<T>) {
+        values.erase(std::remove_if(values.begin(), values.end(), [](T value) { return std::isnan(value); }), values.end());
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    if constexpr (std::is_integral_v<T>) {
+        if (!values.empty()) {
+            using UnsignedType = std::make_unsigned_t<T>;
+            const auto span = static_cast<uint64_t>(static_cast<UnsignedType>(static_cast<UnsignedType>(values.back()) - static_cast<UnsignedType>(values.front())));
+            if (span < MAX_BITMAP_BITS && span < MAX_BITMAP_BITS_PER_MEMBER * values.size())
+                return BitmapMembers<T>(values);
+        }
+        if (values.size() > MAX_SORTED_MEMBERS)
+            return HashMembers<T>(values);
+    }
+    return SortedMembers<T>(std::move(values));
+}
+
+} // namespace arcticdb
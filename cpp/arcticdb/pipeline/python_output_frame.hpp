@@ -8,6 +8,7 @@
 #pragma once
 
 #include <arcticdb/pipeline/frame_data_wrapper.hpp>
+#include <arcticdb/pipeline/arrow_output_frame.hpp>
 #include <arcticdb/util/buffer_holder.hpp>
 
 namespace arcticdb::pipelines {
@@ -30,6 +31,8 @@ struct ARCTICDB_VISIBILITY_HIDDEN PythonOutputFrame {
 
     SegmentInMemory frame() { return frame_; }
 
+    ArrowOutputFrame arrow() const { return ArrowOutputFrame{frame_, buffers_}; }
+
 private:
     std::shared_ptr<FrameDataWrapper> initialize_array(py::object &ref);
     py::array array_at(std::size_t col_pos, py::object &anchor);
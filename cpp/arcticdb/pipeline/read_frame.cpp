@@ -15,6 +15,7 @@
 #include <arcticdb/pipeline/frame_utils.hpp>
 #include <arcticdb/pipeline/frame_slice_map.hpp>
 #include <arcticdb/async/task_scheduler.hpp>
+#include <arcticdb/async/parallel_for.hpp>
 #include <arcticdb/util/encoding_conversion.hpp>
 #include <arcticdb/util/type_handler.hpp>
 #include <arcticdb/entity/type_utils.hpp>
@@ -314,6 +315,17 @@ void advance_skipped_cols(
     }
 }
 
+// The fields of a segment are found one after another, then decoded once all their positions are known, at which
+// point they can be decoded concurrently as each is written to a different part of the frame
+void run_field_decodes(const std::vector<std::function<void()>>& decodes, size_t segment_bytes) {
+    if(use_parallel_columns(decodes.size(), segment_bytes)) {
+        async::parallel_for(decodes.size(), [&decodes](size_t i) { decodes[i](); });
+    } else {
+        for(const auto& decode : decodes)
+            decode();
+    }
+}
+
 template<typename IteratorType>
 bool remaining_fields_empty(IteratorType it, const PipelineContextRow& context) {
     while(it.has_next()) {
@@ -357,6 +369,7 @@ void decode_into_frame_static(
         if(it.invalid())
             return;
 
+        std::vector<std::function<void()>> decodes;
         while (it.has_next()) {
             advance_skipped_cols(data, static_cast<ssize_t>(it.prev_col_offset()), it.source_col(), it.first_slice_col_offset(), index_fieldcount, fields, hdr);
             if(has_magic_nums)
@@ -375,8 +388,11 @@ void decode_into_frame_static(
                         it.dest_col(),
                         m.frame_field_descriptor_.name());
             util::check(data != end || remaining_fields_empty(it, context), "Reached end of input block with {} fields to decode", it.remaining_fields());
-            decode_or_expand(data, buffer.data() + m.offset_bytes_, encoded_field, m.source_type_desc_,  m.dest_bytes_, buffers, encoding_version);
-            ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", field_name, data - begin);
+            decodes.emplace_back([field_data = data, dest = buffer.data() + m.offset_bytes_, encoded_field, type_desc = m.source_type_desc_, dest_bytes = m.dest_bytes_, &buffers, encoding_version] () mutable {
+                decode_or_expand(field_data, dest, encoded_field, type_desc, dest_bytes, buffers, encoding_version);
+            });
+            advance_field_size(encoded_field, data, has_magic_nums);
+            ARCTICDB_TRACE(log::codec(), "Found column {} ending at position {}", field_name, data - begin);
 
             it.advance();
 
@@ -394,6 +410,7 @@ void decode_into_frame_static(
                     util::check_magic_in_place<ColumnMagic>(data);
             }
         }
+        run_field_decodes(decodes, seg.buffer().bytes());
 
         decode_string_pool(hdr, data, begin, end, context);
     }
@@ -424,6 +441,7 @@ void decode_into_frame_dynamic(
         decode_index_field(frame, index_field, data, begin, end, context, encdoing_version);
 
         auto field_count = context.slice_and_key().slice_.col_range.diff() + index_fieldcount;
+        std::vector<std::function<void()>> decodes;
         for (auto field_col = index_fieldcount; field_col < field_count; ++field_col) {
             auto field_name = context.descriptor().fields(field_col).name();
             auto encoded_field = fields.at(field_col);
@@ -440,14 +458,15 @@ void decode_into_frame_dynamic(
                 util::check(static_cast<bool>(has_valid_type_promotion(m.source_type_desc_, m.dest_type_desc_)), "Can't promote type {} to type {} in field {}",
                             m.source_type_desc_, m.dest_type_desc_, m.frame_field_descriptor_.name());
 
-                    m.dest_type_desc_.visit_tag([&buffer, &m, &data, encoded_field, buffers, encdoing_version] (auto dest_desc_tag) {
+                decodes.emplace_back([&buffer, m, field_data = data, encoded_field, &buffers, encdoing_version] () mutable {
+                    m.dest_type_desc_.visit_tag([&buffer, &m, &field_data, encoded_field, &buffers, encdoing_version] (auto dest_desc_tag) {
                         using DestinationType =  typename decltype(dest_desc_tag)::DataTypeTag::raw_type;
-                        m.source_type_desc_.visit_tag([&buffer, &m, &data, &encoded_field, &buffers, encdoing_version] (auto src_desc_tag ) {
+                        m.source_type_desc_.visit_tag([&buffer, &m, &field_data, &encoded_field, &buffers, encdoing_version] (auto src_desc_tag ) {
                             using SourceType =  typename decltype(src_desc_tag)::DataTypeTag::raw_type;
                             if constexpr(std::is_arithmetic_v<SourceType> && std::is_arithmetic_v<DestinationType>) {
                                 const auto src_bytes = sizeof_datatype(m.source_type_desc_) * m.num_rows_;
                                 Buffer tmp_buf{src_bytes};
-                                decode_or_expand(data, tmp_buf.data(), encoded_field, m.source_type_desc_, src_bytes, buffers, encdoing_version);
+                                decode_or_expand(field_data, tmp_buf.data(), encoded_field, m.source_type_desc_, src_bytes, buffers, encdoing_version);
                                 auto src_ptr = reinterpret_cast<SourceType *>(tmp_buf.data());
                                 auto dest_ptr = reinterpret_cast<DestinationType *>(buffer.data() + m.offset_bytes_);
                                 for (auto i = 0u; i < m.num_rows_; ++i) {
@@ -459,7 +478,7 @@ void decode_into_frame_dynamic(
                             }
                         });
                     });
-                    ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", m.frame_field_descriptor_.name(), data - begin);
+                });
             } else {
                 ARCTICDB_TRACE(log::storage(), "Creating data slice at {} with total size {} ({} rows)", m.offset_bytes_, m.dest_bytes_,
                                      context.slice_and_key().slice_.row_range.diff());
@@ -467,10 +486,14 @@ void decode_into_frame_dynamic(
                             "Reached end of input block with {} fields to decode",
                             field_count - field_col);
 
-                decode_or_expand(data, buffer.data() + m.offset_bytes_, encoded_field, m.source_type_desc_, m.dest_bytes_, buffers, encdoing_version);
+                decodes.emplace_back([field_data = data, dest = buffer.data() + m.offset_bytes_, encoded_field, type_desc = m.source_type_desc_, dest_bytes = m.dest_bytes_, &buffers, encdoing_version] () mutable {
+                    decode_or_expand(field_data, dest, encoded_field, type_desc, dest_bytes, buffers, encdoing_version);
+                });
             }
-            ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", frame.field(dst_col).name(), data - begin);
+            advance_field_size(encoded_field, data, has_magic_numbers);
+            ARCTICDB_TRACE(log::codec(), "Found column {} ending at position {}", frame.field(dst_col).name(), data - begin);
         }
+        run_field_decodes(decodes, seg.buffer().bytes());
 
         decode_string_pool(hdr, data, begin, end, context);
     }
@@ -987,6 +1010,62 @@ public:
     }
 };
 
+/*
+ * Used instead of the Python string reducers when the output is Arrow. Rather than creating an object per row,
+ * each slice's string offsets are re-pointed at a copy of the string in the frame's own pool, so that the
+ * frame no longer depends on the pipeline context and can be exported directly from the pool.
+ */
+class StringPoolConsolidatingReducer {
+    Column& column_;
+    SegmentInMemory frame_;
+    size_t row_ = 0;
+    std::shared_ptr<LockType> lock_;
+    bool do_lock_;
+
+public:
+    StringPoolConsolidatingReducer(
+        Column& column,
+        SegmentInMemory frame,
+        std::shared_ptr<LockType> lock,
+        bool do_lock) :
+        column_(column),
+        frame_(std::move(frame)),
+        lock_(std::move(lock)),
+        do_lock_(do_lock) {
+    }
+
+    void reduce(PipelineContextRow& context_row) {
+        const size_t end = context_row.slice_and_key().slice_.row_range.second - frame_.offset();
+        if(row_ >= end)
+            return;
+
+        auto& src_buffer = column_.data().buffer();
+        // Output data is expected to be contiguous, see DynamicStringReducer
+        auto ptr = src_buffer.ptr_cast<StringPool::offset_t>(row_ * sizeof(StringPool::offset_t), (end - row_) * sizeof(StringPool::offset_t));
+        const auto& slice_pool = context_row.string_pool();
+        auto& frame_pool = frame_.string_pool();
+        robin_hood::unordered_flat_map<StringPool::offset_t, StringPool::offset_t> remapped;
+        if(do_lock_)
+            lock_->lock();
+
+        for(; row_ < end; ++row_, ++ptr) {
+            if(!is_a_string(*ptr))
+                continue;
+
+            if(auto it = remapped.find(*ptr); it != remapped.end()) {
+                *ptr = it->second;
+            } else {
+                const auto new_offset = frame_pool.get(get_string_from_pool(*ptr, slice_pool)).offset();
+                remapped.emplace(*ptr, new_offset);
+                *ptr = new_offset;
+            }
+        }
+
+        if(do_lock_)
+            lock_->unlock();
+    }
+};
+
 bool was_coerced_from_dynamic_to_fixed(DataType field_type, const Column& column) {
     return field_type == DataType::UTF_FIXED64
         && column.has_orig_type()
@@ -1031,6 +1110,7 @@ struct ReduceColumnTask : async::BaseTask {
     std::shared_ptr<LockType> lock_;
     bool dynamic_schema_;
     bool do_lock_;
+    bool arrow_output_;
 
     ReduceColumnTask(
         const SegmentInMemory& frame,
@@ -1041,7 +1121,8 @@ struct ReduceColumnTask : async::BaseTask {
         std::shared_ptr<PyObject> py_nan,
         std::shared_ptr<LockType> lock,
         bool dynamic_schema,
-        bool do_lock) :
+        bool do_lock,
+        bool arrow_output) :
         frame_(frame),
         column_index_(c),
         slice_map_(std::move(slice_map)),
@@ -1050,7 +1131,8 @@ struct ReduceColumnTask : async::BaseTask {
         py_nan_(py_nan),
         lock_(std::move(lock)),
         dynamic_schema_(dynamic_schema),
-        do_lock_(do_lock) {
+        do_lock_(do_lock),
+        arrow_output_(arrow_output) {
     }
 
     folly::Unit operator()() {
@@ -1062,7 +1144,7 @@ struct ReduceColumnTask : async::BaseTask {
         if(dynamic_schema_ && column_data == slice_map_->columns_.end()) {
             column.default_initialize_rows(0, frame_.row_count(), false);
             bool dynamic_type = is_dynamic_string_type(field_type);
-            if(dynamic_type) {
+            if(dynamic_type && !arrow_output_) {
                 EmptyDynamicStringReducer reducer(column, frame_, frame_field, sizeof(StringPool::offset_t), lock_);
                 reducer.reduce(frame_.row_count());
             }
@@ -1075,7 +1157,14 @@ struct ReduceColumnTask : async::BaseTask {
                 }
                 null_reducer.finalize();
             }
-            if (is_sequence_type(field_type)) {
+            if (arrow_output_ && is_dynamic_string_type(field_type)) {
+                StringPoolConsolidatingReducer string_reducer{column, frame_, lock_, do_lock_};
+                for (const auto &row : column_data->second) {
+                    PipelineContextRow context_row{context_, row.second.context_index_};
+                    if(context_row.slice_and_key().slice().row_range.diff() > 0)
+                        string_reducer.reduce(context_row);
+                }
+            } else if (is_sequence_type(field_type)) {
                 auto string_reducer = get_string_reducer(column, context_, frame_, frame_field, *slice_map_, unique_string_map_, py_nan_, lock_, do_lock_);
                 for (const auto &row : column_data->second) {
                     PipelineContextRow context_row{context_, row.second.context_index_};
@@ -1100,12 +1189,13 @@ void reduce_and_fix_columns(
         return;
 
     bool dynamic_schema = opt_false(read_options.dynamic_schema_);
+    const bool arrow_output = read_options.get_output_format() == OutputFormat::ARROW;
     auto slice_map = std::make_shared<FrameSliceMap>(context, dynamic_schema);
     static auto spinlock = std::make_shared<LockType>();
     std::shared_ptr<UniqueStringMapType> unique_string_map;
     std::shared_ptr<PyObject> py_nan;
 
-    if (opt_false(read_options.optimise_string_memory_)) {
+    if (opt_false(read_options.optimise_string_memory_) && !arrow_output) {
         ARCTICDB_DEBUG(log::version(), "Optimising dynamic string memory consumption");
         unique_string_map = std::make_shared<UniqueStringMapType>();
         py_nan = std::shared_ptr<PyObject>(create_py_nan(spinlock),[lock=spinlock](PyObject* py_obj) {
@@ -1121,7 +1211,7 @@ void reduce_and_fix_columns(
         std::vector<folly::Future<folly::Unit>> jobs;
         static const auto batch_size = ConfigsMap::instance()->get_int("StringAllocation.BatchSize", 50);
         for (size_t c = 0; c < static_cast<size_t>(frame.descriptor().fields().size()); ++c) {
-            jobs.emplace_back(async::submit_cpu_task(ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, true)));
+            jobs.emplace_back(async::submit_cpu_task(ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, true, arrow_output)));
             if(jobs.size() == static_cast<size_t>(batch_size)) {
                 folly::collect(jobs).get();
                 jobs.clear();
@@ -1132,7 +1222,7 @@ void reduce_and_fix_columns(
             folly::collect(jobs).get();
     } else {
         for (size_t c = 0; c < static_cast<size_t>(frame.descriptor().fields().size()); ++c) {
-            ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, false)();
+            ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, false, arrow_output)();
         }
     }
 
@@ -1146,7 +1236,8 @@ folly::Future<std::vector<VariantKey>> fetch_data(
     const std::shared_ptr<PipelineContext> &context,
     const std::shared_ptr<stream::StreamSource>& ssource,
     bool dynamic_schema,
-    std::shared_ptr<BufferHolder> buffers
+    std::shared_ptr<BufferHolder> buffers,
+    std::shared_ptr<ProfileStage> profile
     ) {
     ARCTICDB_SAMPLE_DEFAULT(FetchSlices)
     if (frame.empty())
@@ -1155,12 +1246,15 @@ folly::Future<std::vector<VariantKey>> fetch_data(
     std::vector<std::pair<VariantKey, stream::StreamSource::ReadContinuation>> keys_and_continuations;
     keys_and_continuations.reserve(context->slice_and_keys_.size());
     context->ensure_vectors();
+    auto decode_stage = profile_child(profile, "decode");
     {
         ARCTICDB_SUBSAMPLE_DEFAULT(QueueReadContinuations)
         for ( auto& row : *context) {
             keys_and_continuations.emplace_back(row.slice_and_key().key(),
-            [row=row, frame=frame, dynamic_schema=dynamic_schema, buffers](auto &&ks) mutable {
+            [row=row, frame=frame, dynamic_schema=dynamic_schema, buffers, decode_stage](auto &&ks) mutable {
                 auto key_seg = std::forward<storage::KeySegmentPair>(ks);
+                ScopedProfileTimer profile_timer(decode_stage);
+                profile_add(decode_stage, "rows", row.slice_and_key().slice_.row_range.diff());
                 if(dynamic_schema)
                     decode_into_frame_dynamic(frame, row, std::move(key_seg.segment()), buffers);
                 else
@@ -1170,7 +1264,9 @@ folly::Future<std::vector<VariantKey>> fetch_data(
         }
     }
     ARCTICDB_SUBSAMPLE_DEFAULT(DoBatchReadCompressed)
-    return ssource->batch_read_compressed(std::move(keys_and_continuations), BatchReadArgs{});
+    BatchReadArgs args;
+    args.profile_stage_ = profile_child(profile, "storage_read");
+    return ssource->batch_read_compressed(std::move(keys_and_continuations), args);
 }
 
 } // namespace read
@@ -74,7 +74,8 @@ folly::Future<std::vector<VariantKey>> fetch_data(
     const std::shared_ptr<PipelineContext> &context,
     const std::shared_ptr<stream::StreamSource>& ssource,
     bool dynamic_schema,
-    std::shared_ptr<BufferHolder> buffers
+    std::shared_ptr<BufferHolder> buffers,
+    std::shared_ptr<ProfileStage> profile = nullptr
     );
 
 void decode_into_frame_static(
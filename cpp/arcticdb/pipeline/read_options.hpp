@@ -9,8 +9,19 @@
 
 #include <arcticdb/entity/protobufs.hpp>
 #include <arcticdb/util/optional_defaults.hpp>
+#include <arcticdb/util/read_profile.hpp>
+
+#include <memory>
 
 namespace arcticdb {
+
+enum class OutputFormat : uint8_t {
+    // Numpy arrays, with one Python object per string
+    PANDAS,
+    // Arrow C Data Interface structs, with strings left in the string pool until export
+    ARROW
+};
+
 struct ReadOptions {
     std::optional<bool> force_strings_to_fixed_;
     std::optional<bool> force_strings_to_object_;
@@ -21,6 +32,9 @@ struct ReadOptions {
     std::optional<bool> optimise_string_memory_;
     std::optional<bool> batch_throw_on_error_;
     std::optional<bool> read_previous_on_failure_;
+    std::optional<OutputFormat> output_format_;
+    // Shared by copies of these options, so that the caller can collect the profile once the read is done
+    std::shared_ptr<ProfileStage> profile_;
 
     void set_force_strings_to_fixed(const std::optional<bool>& force_strings_to_fixed) {
         force_strings_to_fixed_ = force_strings_to_fixed;
@@ -57,5 +71,25 @@ struct ReadOptions {
     void set_batch_throw_on_error(bool batch_throw_on_error) {
         batch_throw_on_error_ = batch_throw_on_error;
     }
+
+    void set_output_format(OutputFormat output_format) {
+        output_format_ = output_format;
+    }
+
+    OutputFormat get_output_format() const {
+        return output_format_.value_or(OutputFormat::PANDAS);
+    }
+
+    // Starts a new, empty profile for the next read made with these options, or stops profiling
+    void set_profile(bool profile) {
+        profile_ = profile ? std::make_shared<ProfileStage>("read") : nullptr;
+    }
+
+    std::optional<ProfileNode> get_profile() const {
+        if (!profile_)
+            return std::nullopt;
+
+        return profile_->snapshot();
+    }
 };
 } //namespace arcticdb
\ No newline at end of file
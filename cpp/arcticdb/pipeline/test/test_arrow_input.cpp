@@ -0,0 +1,89 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/pipeline/arrow_input_frame.hpp>
+#include <arcticdb/pipeline/arrow_output_frame.hpp>
+#include <arcticdb/util/test/generators.hpp>
+
+#include <cmath>
+
+TEST(ArrowInput, TimeseriesFrameIsZeroCopy) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+    constexpr size_t num_rows = 10;
+    auto seg = get_standard_timeseries_segment("arrow_input", num_rows);
+
+    ArrowArray array;
+    ArrowSchema schema;
+    ArrowOutputFrame{seg}.export_frame(&array, &schema);
+    const auto exported_values = array.children[2]->buffers[1];
+
+    auto frame = arrow_to_frame(StreamId{"arrow_input"}, &array, &schema);
+    // The frame has taken ownership of the structs
+    ASSERT_EQ(array.release, nullptr);
+    ASSERT_EQ(schema.release, nullptr);
+
+    ASSERT_EQ(frame.num_rows, num_rows);
+    ASSERT_EQ(frame.desc.index().type(), IndexDescriptor::TIMESTAMP);
+    ASSERT_EQ(frame.desc.get_sorted(), SortedValue::ASCENDING);
+    ASSERT_TRUE(frame.index_tensor.has_value());
+    ASSERT_EQ(frame.index_range.start_, IndexValue{timestamp{0}});
+    ASSERT_EQ(frame.index_range.end_, IndexValue{static_cast<timestamp>(num_rows - 1)});
+    ASSERT_TRUE(frame.norm_meta.df().common().index().is_not_range_index());
+
+    ASSERT_EQ(frame.field_tensors.size(), 3u);
+    ASSERT_EQ(frame.field_tensors[0].data_type(), DataType::INT8);
+    const auto& uint64s = frame.field_tensors[1];
+    ASSERT_EQ(uint64s.data_type(), DataType::UINT64);
+    ASSERT_EQ(uint64s.data(), exported_values);
+    ASSERT_FALSE(uint64s.arrow().has_value());
+
+    const auto& strings = frame.field_tensors[2];
+    ASSERT_EQ(strings.data_type(), DataType::UTF_DYNAMIC64);
+    ASSERT_TRUE(strings.arrow().has_value());
+    for(size_t i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(*uint64s.ptr_cast<uint64_t>(i), i * 2);
+        ASSERT_TRUE(strings.arrow()->is_valid(i));
+        ASSERT_EQ(strings.arrow()->string_at(i), fmt::format("string_{}", i));
+    }
+}
+
+TEST(ArrowInput, NullIntegersAreRejected) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+    auto seg = get_sparse_timeseries_segment("arrow_input_sparse", 10);
+
+    ArrowArray array;
+    ArrowSchema schema;
+    ArrowOutputFrame{seg}.export_frame(&array, &schema);
+    ASSERT_THROW(arrow_to_frame(StreamId{"arrow_input_sparse"}, &array, &schema), UserInputException);
+    // The structs were still moved from, and released when the holder was destroyed
+    ASSERT_EQ(array.release, nullptr);
+}
+
+TEST(ArrowInput, NullFloatsBecomeNaN) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+    constexpr size_t num_rows = 10;
+    auto seg = get_sparse_timeseries_segment_floats("arrow_input_floats", num_rows);
+
+    ArrowArray array;
+    ArrowSchema schema;
+    ArrowOutputFrame{seg}.export_frame(&array, &schema);
+    auto frame = arrow_to_frame(StreamId{"arrow_input_floats"}, &array, &schema);
+
+    const auto& col2 = frame.field_tensors[1];
+    ASSERT_FALSE(col2.arrow().has_value());
+    for(size_t i = 0; i < num_rows; ++i) {
+        if(i % 2 == 1)
+            ASSERT_EQ(*col2.ptr_cast<double>(i), double(i) * 2);
+        else
+            ASSERT_TRUE(std::isnan(*col2.ptr_cast<double>(i)));
+    }
+}
@@ -0,0 +1,97 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/pipeline/arrow_output_frame.hpp>
+#include <arcticdb/util/test/generators.hpp>
+
+namespace {
+std::string_view arrow_string_at(const ArrowArray& array, int64_t row) {
+    auto offsets = static_cast<const int64_t*>(array.buffers[1]);
+    auto chars = static_cast<const char*>(array.buffers[2]);
+    return {chars + offsets[row], static_cast<size_t>(offsets[row + 1] - offsets[row])};
+}
+}
+
+TEST(ArrowOutput, DenseColumns) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+    constexpr size_t num_rows = 10;
+    auto seg = get_standard_timeseries_segment("arrow_dense", num_rows);
+
+    ArrowArray array;
+    ArrowSchema schema;
+    ArrowOutputFrame{seg}.export_frame(&array, &schema);
+
+    ASSERT_STREQ(schema.format, "+s");
+    ASSERT_EQ(schema.n_children, 4);
+    ASSERT_EQ(array.n_children, 4);
+    ASSERT_EQ(array.length, num_rows);
+    ASSERT_STREQ(schema.children[0]->format, "tsn:");
+    ASSERT_STREQ(schema.children[1]->format, "c");
+    ASSERT_STREQ(schema.children[2]->format, "L");
+    ASSERT_STREQ(schema.children[3]->format, "U");
+    ASSERT_STREQ(schema.children[3]->name, "strings");
+
+    // Contiguous numeric columns point straight at the segment's buffer
+    ASSERT_EQ(array.children[2]->buffers[1], seg.column(2).data().buffer().data());
+
+    auto uint64s = static_cast<const uint64_t*>(array.children[2]->buffers[1]);
+    const auto& strings = *array.children[3];
+    ASSERT_EQ(strings.null_count, 0);
+    for(size_t i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(uint64s[i], i * 2);
+        ASSERT_EQ(arrow_string_at(strings, i), fmt::format("string_{}", i));
+    }
+
+    // The export must outlive the segment it came from
+    seg = SegmentInMemory{};
+    ASSERT_EQ(uint64s[num_rows - 1], (num_rows - 1) * 2);
+
+    array.release(&array);
+    schema.release(&schema);
+    ASSERT_EQ(array.release, nullptr);
+    ASSERT_EQ(schema.release, nullptr);
+}
+
+TEST(ArrowOutput, SparseColumnsHaveValidity) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+    constexpr size_t num_rows = 10;
+    auto seg = get_sparse_timeseries_segment("arrow_sparse", num_rows);
+
+    ArrowArray array;
+    ArrowSchema schema;
+    ArrowOutputFrame{seg}.export_frame(&array, &schema);
+    ASSERT_EQ(array.length, num_rows);
+
+    const auto& uint64s = *array.children[2];
+    const auto validity = static_cast<const uint8_t*>(uint64s.buffers[0]);
+    ASSERT_NE(validity, nullptr);
+    ASSERT_EQ(uint64s.null_count, num_rows / 2);
+    auto values = static_cast<const uint64_t*>(uint64s.buffers[1]);
+    for(size_t i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(arrow_bit_is_set(validity, i), i % 2 == 1);
+        if(i % 2 == 1)
+            ASSERT_EQ(values[i], i * 2);
+    }
+
+    const auto& strings = *array.children[3];
+    const auto string_validity = static_cast<const uint8_t*>(strings.buffers[0]);
+    ASSERT_NE(string_validity, nullptr);
+    for(size_t i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(arrow_bit_is_set(string_validity, i), i % 3 == 2);
+        if(i % 3 == 2)
+            ASSERT_EQ(arrow_string_at(strings, i), fmt::format("string_{}", i));
+        else
+            ASSERT_TRUE(arrow_string_at(strings, i).empty());
+    }
+
+    array.release(&array);
+    schema.release(&schema);
+}
@@ -0,0 +1,122 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+#include <arcticdb/pipeline/column_stats.hpp>
+#include <arcticdb/entity/stream_descriptor.hpp>
+#include <arcticdb/stream/index.hpp>
+
+namespace {
+
+using namespace arcticdb;
+using namespace arcticdb::pipelines;
+
+constexpr size_t rows_per_slice = 10;
+constexpr size_t row_slices = 4;
+constexpr size_t col_slices = 2;
+
+// Row slice i holds the index values and the values of "col" in [10 * i, 10 * i + 9], and is split over two column
+// slices, so each row slice that is kept is two segments fetched
+std::vector<SliceAndKey> slice_and_keys() {
+    std::vector<SliceAndKey> res;
+    for (size_t row_slice = 0; row_slice < row_slices; ++row_slice) {
+        const auto start = row_slice * rows_per_slice;
+        for (size_t col_slice = 0; col_slice < col_slices; ++col_slice) {
+            res.emplace_back(
+                FrameSlice{ColRange{1 + col_slice, 2 + col_slice}, RowRange{start, start + rows_per_slice}},
+                AtomKey{StreamId{"sym"}, 0, 0, 0,
+                        IndexValue{NumericIndex(start)}, IndexValue{NumericIndex(start + rows_per_slice)},
+                        KeyType::TABLE_DATA});
+        }
+    }
+    return res;
+}
+
+// Stats for all but the last row slice, so that it is always fetched
+SegmentInMemory column_stats_segment() {
+    SegmentInMemory seg{StreamDescriptor{stream_descriptor(StreamId{"sym"}, stream::RowCountIndex(), {
+        scalar_field(DataType::NANOSECONDS_UTC64, start_index_column_name),
+        scalar_field(DataType::NANOSECONDS_UTC64, end_index_column_name),
+        scalar_field(DataType::INT64, "v1.0_MIN(col)"),
+        scalar_field(DataType::INT64, "v1.0_MAX(col)")
+    })}};
+    for (size_t row_slice = 0; row_slice < row_slices - 1; ++row_slice) {
+        const auto start = static_cast<timestamp>(row_slice * rows_per_slice);
+        seg.set_scalar<timestamp>(0, start);
+        seg.set_scalar<timestamp>(1, start + static_cast<timestamp>(rows_per_slice));
+        seg.set_scalar<int64_t>(2, start);
+        seg.set_scalar<int64_t>(3, start + static_cast<timestamp>(rows_per_slice) - 1);
+        seg.end_row();
+    }
+    return seg;
+}
+
+ExpressionContext comparison(const VariantNode& left, OperationType operation, const VariantNode& right, Value value) {
+    ExpressionContext expression_context;
+    expression_context.add_value("value", std::make_shared<Value>(value));
+    expression_context.add_expression_node("root", std::make_shared<ExpressionNode>(left, right, operation));
+    expression_context.root_node_name_ = ExpressionName("root");
+    return expression_context;
+}
+
+ExpressionContext column_comparison(OperationType operation, int64_t value) {
+    return comparison(ColumnName("col"), operation, ValueName("value"), Value{value, DataType::INT64});
+}
+
+// Returns the start index of each segment that would still be fetched
+std::vector<NumericIndex> fetched(const ExpressionContext& expression_context) {
+    auto keys = slice_and_keys();
+    const auto pruned = prune_with_column_stats(column_stats_segment(), expression_context, keys);
+    EXPECT_EQ(pruned + keys.size(), row_slices * col_slices);
+    std::vector<NumericIndex> res;
+    for (const auto& key: keys)
+        res.emplace_back(std::get<NumericIndex>(key.key().start_index()));
+    return res;
+}
+
+} // namespace
+
+TEST(ColumnStatsPruning, Comparisons) {
+    using Fetched = std::vector<NumericIndex>;
+    ASSERT_EQ(fetched(column_comparison(OperationType::GT, 25)), (Fetched{20, 20, 30, 30}));
+    ASSERT_EQ(fetched(column_comparison(OperationType::LE, 9)), (Fetched{0, 0, 30, 30}));
+    ASSERT_EQ(fetched(column_comparison(OperationType::EQ, 15)), (Fetched{10, 10, 30, 30}));
+    ASSERT_EQ(fetched(column_comparison(OperationType::GE, 100)), (Fetched{30, 30}));
+    // NE is never used to rule a slice out
+    ASSERT_EQ(fetched(column_comparison(OperationType::NE, 15)).size(), row_slices * col_slices);
+}
+
+TEST(ColumnStatsPruning, ValueOnLeft) {
+    auto expression_context = comparison(ValueName("value"), OperationType::LT, ColumnName("col"), Value{int64_t{25}, DataType::INT64});
+    ASSERT_EQ(fetched(expression_context), (std::vector<NumericIndex>{20, 20, 30, 30}));
+}
+
+TEST(ColumnStatsPruning, AndOr) {
+    ExpressionContext expression_context;
+    expression_context.add_value("low", std::make_shared<Value>(int64_t{5}, DataType::INT64));
+    expression_context.add_value("high", std::make_shared<Value>(int64_t{25}, DataType::INT64));
+    expression_context.add_expression_node("below", std::make_shared<ExpressionNode>(ColumnName("col"), ValueName("low"), OperationType::LT));
+    expression_context.add_expression_node("above", std::make_shared<ExpressionNode>(ColumnName("col"), ValueName("high"), OperationType::GE));
+    expression_context.add_expression_node("either", std::make_shared<ExpressionNode>(ExpressionName("below"), ExpressionName("above"), OperationType::OR));
+    expression_context.add_expression_node("both", std::make_shared<ExpressionNode>(ExpressionName("below"), ExpressionName("above"), OperationType::AND));
+
+    expression_context.root_node_name_ = ExpressionName("either");
+    ASSERT_EQ(fetched(expression_context), (std::vector<NumericIndex>{0, 0, 20, 20, 30, 30}));
+    expression_context.root_node_name_ = ExpressionName("both");
+    ASSERT_EQ(fetched(expression_context), (std::vector<NumericIndex>{30, 30}));
+}
+
+TEST(ColumnStatsPruning, UnknownIsFetched) {
+    const auto all = row_slices * col_slices;
+    ASSERT_EQ(fetched(comparison(ColumnName("other"), OperationType::GT, ValueName("value"), Value{int64_t{100}, DataType::INT64})).size(), all);
+    ASSERT_EQ(fetched(comparison(ColumnName("col"), OperationType::GT, ValueName("value"), construct_string_value("a"))).size(), all);
+
+    auto negated = column_comparison(OperationType::GT, 100);
+    negated.add_expression_node("not", std::make_shared<ExpressionNode>(ExpressionName("root"), OperationType::NOT));
+    negated.root_node_name_ = ExpressionName("not");
+    ASSERT_EQ(fetched(negated).size(), all);
+}
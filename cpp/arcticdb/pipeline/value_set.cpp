@@ -27,34 +27,34 @@ namespace arcticdb {
     ValueSet::ValueSet(py::array value_list) {
         if (py::isinstance<py::array_t<uint8_t>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::UINT, entity::SizeBits::S8));
-            numeric_base_set_ = typed_set_uint8_t_.create(value_list);
+            numeric_base_set_ = create_base_set<uint8_t>(value_list);
         } else if (py::isinstance<py::array_t<uint16_t>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::UINT, entity::SizeBits::S16));
-            numeric_base_set_ = typed_set_uint16_t_.create(value_list);
+            numeric_base_set_ = create_base_set<uint16_t>(value_list);
         } else if (py::isinstance<py::array_t<uint32_t>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::UINT, entity::SizeBits::S32));
-            numeric_base_set_ = typed_set_uint32_t_.create(value_list);
+            numeric_base_set_ = create_base_set<uint32_t>(value_list);
         } else if (py::isinstance<py::array_t<uint64_t>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::UINT, entity::SizeBits::S64));
-            numeric_base_set_ = typed_set_uint64_t_.create(value_list);
+            numeric_base_set_ = create_base_set<uint64_t>(value_list);
         } else if (py::isinstance<py::array_t<int8_t>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::INT, entity::SizeBits::S8));
-            numeric_base_set_ = typed_set_int8_t_.create(value_list);
+            numeric_base_set_ = create_base_set<int8_t>(value_list);
         } else if (py::isinstance<py::array_t<int16_t>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::INT, entity::SizeBits::S16));
-            numeric_base_set_ = typed_set_int16_t_.create(value_list);
+            numeric_base_set_ = create_base_set<int16_t>(value_list);
         } else if (py::isinstance<py::array_t<int32_t>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::INT, entity::SizeBits::S32));
-            numeric_base_set_ = typed_set_int32_t_.create(value_list);
+            numeric_base_set_ = create_base_set<int32_t>(value_list);
         } else if (py::isinstance<py::array_t<int64_t>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::INT, entity::SizeBits::S64));
-            numeric_base_set_ = typed_set_int64_t_.create(value_list);
+            numeric_base_set_ = create_base_set<int64_t>(value_list);
         } else if (py::isinstance<py::array_t<float>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::FLOAT, entity::SizeBits::S32));
-            numeric_base_set_ = typed_set_float_.create(value_list);
+            numeric_base_set_ = create_base_set<float>(value_list);
         } else if (py::isinstance<py::array_t<double>>(value_list)) {
             base_type_ = make_scalar_type(combine_data_type(entity::ValueType::FLOAT, entity::SizeBits::S64));
-            numeric_base_set_ = typed_set_double_.create(value_list);
+            numeric_base_set_ = create_base_set<double>(value_list);
         } else {
             util::raise_rte("Unexpected numpy array type passed to ValueSet constructor");
         }
@@ -18,6 +18,7 @@
 #include <pybind11/numpy.h>
 
 #include <arcticdb/entity/types.hpp>
+#include <arcticdb/pipeline/membership_set.hpp>
 #include <arcticdb/util/preprocess.hpp>
 #include <arcticdb/util/variant.hpp>
 
@@ -52,6 +53,12 @@ public:
         util::raise_rte("ValueSet::get_set called with unexpected template type");
     }
 
+    // The members converted to T, in the representation best suited to probing them, built on first use
+    template<typename T>
+    std::shared_ptr<const MembershipSet<T>> get_membership_set() {
+        util::raise_rte("ValueSet::get_membership_set called with unexpected template type");
+    }
+
     std::shared_ptr<std::unordered_set<std::string>> get_fixed_width_string_set(size_t width);
 
 private:
@@ -60,40 +67,37 @@ private:
     NumericSetType numeric_base_set_;
 
     template<typename T>
-    class typed_set {
-    public:
-        ARCTICDB_VISIBILITY_HIDDEN std::shared_ptr<std::unordered_set<T>> create(py::array value_list) {
-            std::call_once(flag_, [&]{set_ = create_internal(value_list);});
-            return set_;
+    ARCTICDB_VISIBILITY_HIDDEN static std::shared_ptr<std::unordered_set<T>> create_base_set(py::array value_list) {
+        auto arr = value_list.unchecked<T, 1>();
+        auto set = std::make_shared<std::unordered_set<T>>();
+        for (py::ssize_t i = 0; i < arr.shape(0); i++) {
+            set->insert(arr(i));
         }
+        return set;
+    }
 
-        std::shared_ptr<std::unordered_set<T>> transform(const NumericSetType& numeric_base_set) {
+    template<typename T>
+    class typed_set {
+    public:
+        std::shared_ptr<const MembershipSet<T>> transform(const NumericSetType& numeric_base_set) {
             std::call_once(flag_, [&]{set_ = transform_internal(numeric_base_set);});
             return set_;
         }
 
     private:
-        std::shared_ptr<std::unordered_set<T>> set_;
+        std::shared_ptr<const MembershipSet<T>> set_;
         std::once_flag flag_;
 
-        std::shared_ptr<std::unordered_set<T>> create_internal(py::array value_list) {
-            auto arr = value_list.unchecked<T, 1>();
-            auto set = std::make_shared<std::unordered_set<T>>();
-            for (py::ssize_t i = 0; i < arr.shape(0); i++) {
-                set->insert(arr(i));
-            }
-            return set;
-        }
-
-        std::shared_ptr<std::unordered_set<T>> transform_internal(const NumericSetType& numeric_base_set) {
-            auto target_set = std::make_shared<std::unordered_set<T>>();
+        std::shared_ptr<const MembershipSet<T>> transform_internal(const NumericSetType& numeric_base_set) {
+            std::vector<T> members;
             util::variant_match(numeric_base_set,
             [&](const auto& source_set) {
+                members.reserve(source_set->size());
                 for (const auto& member: *source_set) {
-                    target_set->insert(static_cast<T>(member));
+                    members.emplace_back(static_cast<T>(member));
                 }
             });
-            return target_set;
+            return std::make_shared<const MembershipSet<T>>(make_membership_set(std::move(members)));
         }
     };
 
@@ -120,52 +124,52 @@ inline std::shared_ptr<std::unordered_set<std::string>> ValueSet::get_set<std::s
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<uint8_t>> ValueSet::get_set<uint8_t>() {
+inline std::shared_ptr<const MembershipSet<uint8_t>> ValueSet::get_membership_set<uint8_t>() {
     return typed_set_uint8_t_.transform(numeric_base_set_);
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<uint16_t>> ValueSet::get_set<uint16_t>() {
+inline std::shared_ptr<const MembershipSet<uint16_t>> ValueSet::get_membership_set<uint16_t>() {
     return typed_set_uint16_t_.transform(numeric_base_set_);
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<uint32_t>> ValueSet::get_set<uint32_t>() {
+inline std::shared_ptr<const MembershipSet<uint32_t>> ValueSet::get_membership_set<uint32_t>() {
     return typed_set_uint32_t_.transform(numeric_base_set_);
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<uint64_t>> ValueSet::get_set<uint64_t>() {
+inline std::shared_ptr<const MembershipSet<uint64_t>> ValueSet::get_membership_set<uint64_t>() {
     return typed_set_uint64_t_.transform(numeric_base_set_);
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<int8_t>> ValueSet::get_set<int8_t>() {
+inline std::shared_ptr<const MembershipSet<int8_t>> ValueSet::get_membership_set<int8_t>() {
     return typed_set_int8_t_.transform(numeric_base_set_);
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<int16_t>> ValueSet::get_set<int16_t>() {
+inline std::shared_ptr<const MembershipSet<int16_t>> ValueSet::get_membership_set<int16_t>() {
     return typed_set_int16_t_.transform(numeric_base_set_);
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<int32_t>> ValueSet::get_set<int32_t>() {
+inline std::shared_ptr<const MembershipSet<int32_t>> ValueSet::get_membership_set<int32_t>() {
     return typed_set_int32_t_.transform(numeric_base_set_);
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<int64_t>> ValueSet::get_set<int64_t>() {
+inline std::shared_ptr<const MembershipSet<int64_t>> ValueSet::get_membership_set<int64_t>() {
     return typed_set_int64_t_.transform(numeric_base_set_);
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<float>> ValueSet::get_set<float>() {
+inline std::shared_ptr<const MembershipSet<float>> ValueSet::get_membership_set<float>() {
     return typed_set_float_.transform(numeric_base_set_);
 }
 
 template<>
-inline std::shared_ptr<std::unordered_set<double>> ValueSet::get_set<double>() {
+inline std::shared_ptr<const MembershipSet<double>> ValueSet::get_membership_set<double>() {
     return typed_set_double_.transform(numeric_base_set_);
 }
 
@@ -144,13 +144,14 @@ write_frame(
         const SlicingPolicy &slicing,
         const std::shared_ptr<Store>& store,
         const std::shared_ptr<DeDupMap>& de_dup_map,
-        bool sparsify_floats) {
+        bool sparsify_floats,
+        size_t index_leaf_size) {
     ARCTICDB_SAMPLE_DEFAULT(WriteFrame)
     auto fut_slice_keys = slice_and_write(frame, slicing, get_partial_key_gen(frame, key), store, de_dup_map, sparsify_floats);
     // Write the keys of the slices into an index segment
     ARCTICDB_SUBSAMPLE_DEFAULT(WriteIndex)
-    return std::move(fut_slice_keys).thenValue([frame = std::move(frame), key = std::move(key), &store](auto&& slice_keys) mutable {
-        return index::write_index(std::move(frame), std::forward<decltype(slice_keys)>(slice_keys), key, store);
+    return std::move(fut_slice_keys).thenValue([frame = std::move(frame), key = std::move(key), &store, index_leaf_size](auto&& slice_keys) mutable {
+        return index::write_index(std::move(frame), std::forward<decltype(slice_keys)>(slice_keys), key, store, index_leaf_size);
     });
 }
 
@@ -161,7 +162,8 @@ folly::Future<entity::AtomKey> append_frame(
         index::IndexSegmentReader& index_segment_reader,
         const std::shared_ptr<Store>& store,
         bool dynamic_schema,
-        bool ignore_sort_order)
+        bool ignore_sort_order,
+        size_t index_leaf_size)
 {
     ARCTICDB_SAMPLE_DEFAULT(AppendFrame)
     util::variant_match(frame.index,
@@ -185,9 +187,18 @@ folly::Future<entity::AtomKey> append_frame(
     );
 
     auto existing_slices = unfiltered_index(index_segment_reader);
+    // Of a multi-level index, only the last leaf is rewritten along with the root, and the others are kept as they are
+    std::vector<SliceAndKey> kept_leaves;
+    if(const auto& leaves = index_segment_reader.leaves(); !leaves.empty() && index_leaf_size != 0) {
+        const auto first_rewritten_row = leaves.back().slice_.row_range.first;
+        kept_leaves.assign(std::begin(leaves), std::prev(std::end(leaves)));
+        existing_slices.erase(std::remove_if(std::begin(existing_slices), std::end(existing_slices), [first_rewritten_row](const SliceAndKey& slice_and_key) {
+            return slice_and_key.slice_.row_range.first < first_rewritten_row;
+        }), std::end(existing_slices));
+    }
     auto keys_fut = slice_and_write(frame, slicing, get_partial_key_gen(frame, key), store);
     return std::move(keys_fut)
-    .thenValue([dynamic_schema, slices_to_write = std::move(existing_slices), frame = std::move(frame), index_segment_reader = std::move(index_segment_reader), key = key, &store](auto&& slice_and_keys_to_append) mutable {
+    .thenValue([dynamic_schema, index_leaf_size, slices_to_write = std::move(existing_slices), kept_leaves = std::move(kept_leaves), frame = std::move(frame), index_segment_reader = std::move(index_segment_reader), key = key, &store](auto&& slice_and_keys_to_append) mutable {
         slices_to_write.insert(std::end(slices_to_write), std::make_move_iterator(std::begin(slice_and_keys_to_append)), std::make_move_iterator(std::end(slice_and_keys_to_append)));
         std::sort(std::begin(slices_to_write), std::end(slices_to_write));
         if(dynamic_schema) {
@@ -196,10 +207,10 @@ folly::Future<entity::AtomKey> append_frame(
             merged_descriptor.set_sorted(deduce_sorted(index_segment_reader.get_sorted(), frame.desc.get_sorted()));
             auto tsd =
                 make_timeseries_descriptor(frame.num_rows + frame.offset, std::move(merged_descriptor), std::move(frame.norm_meta), std::move(frame.user_meta), std::nullopt, std::nullopt, frame.bucketize_dynamic);
-            return index::write_index(stream::index_type_from_descriptor(frame.desc), std::move(tsd), std::move(slices_to_write), key, store);
+            return index::write_index(stream::index_type_from_descriptor(frame.desc), std::move(tsd), std::move(slices_to_write), key, store, index_leaf_size, std::move(kept_leaves));
         } else {
             frame.desc.set_sorted(deduce_sorted(index_segment_reader.get_sorted(), frame.desc.get_sorted()));
-            return index::write_index(std::move(frame), std::move(slices_to_write), key, store);
+            return index::write_index(std::move(frame), std::move(slices_to_write), key, store, index_leaf_size, std::move(kept_leaves));
         }
     });
 }
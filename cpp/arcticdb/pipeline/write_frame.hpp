@@ -50,7 +50,8 @@ folly::Future<entity::AtomKey> write_frame(
     const SlicingPolicy &slicing,
     const std::shared_ptr<Store> &store,
     const std::shared_ptr<DeDupMap>& de_dup_map = std::make_shared<DeDupMap>(),
-    bool allow_sparse = false
+    bool allow_sparse = false,
+    size_t index_leaf_size = 0
 );
 
 folly::Future<entity::AtomKey> append_frame(
@@ -60,7 +61,8 @@ folly::Future<entity::AtomKey> append_frame(
         index::IndexSegmentReader &index_segment_reader,
         const std::shared_ptr<Store>& store,
         bool dynamic_schema,
-        bool ignore_sort_order
+        bool ignore_sort_order,
+        size_t index_leaf_size = 0
 );
 
 std::optional<SliceAndKey> rewrite_partial_segment(
@@ -24,7 +24,8 @@ struct WriteOptions {
                 opt.ignore_sort_order(),
                 opt.bucketize_dynamic(),
                 opt.max_num_buckets() > 0 ? size_t(opt.max_num_buckets()) : def.max_num_buckets,
-                opt.compact_incomplete_dedup_rows()
+                opt.compact_incomplete_dedup_rows(),
+                size_t(opt.index_leaf_size())
         };
     }
 
@@ -38,5 +39,7 @@ struct WriteOptions {
     bool bucketize_dynamic = false;
     size_t max_num_buckets = 150;
     bool compact_incomplete_dedup_rows = false;
+    // Zero for a single-level index
+    size_t index_leaf_size = 0;
 };
 } //namespace arcticdb
\ No newline at end of file
@@ -499,4 +499,203 @@ SegmentInMemory CountAggregatorData::finalize(const ColumnName& output_column_na
     return res;
 }
 
+/***************************
+ * Approximate aggregators *
+ ***************************/
+
+void HyperLogLogAggregatorData::aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values) {
+    if(input_column.has_value()) {
+        input_column->column_->type().visit_tag([&] (auto type_desc_tag) {
+            using TypeDescriptorTag =  decltype(type_desc_tag);
+            using RawType = typename TypeDescriptorTag::DataTypeTag::raw_type;
+            constexpr auto data_type = TypeDescriptorTag::DataTypeTag::data_type;
+
+            sketches_.resize(unique_values);
+            auto col_data = input_column->column_->data();
+            auto lambda = [this, &col_data, &groups, &input_column](auto iter) {
+                while (auto block = col_data.next<TypeDescriptorTag>()) {
+                    auto ptr = reinterpret_cast<const RawType *>(block.value().data());
+                    for (auto i = 0u; i < block.value().row_count(); ++i, ++ptr, ++iter) {
+                        std::optional<HashedValue> hashed;
+                        if constexpr (is_sequence_type(data_type)) {
+                            if (auto str = input_column->string_at_offset(*ptr); str.has_value())
+                                hashed = hash(*str);
+                        } else if constexpr (is_floating_point_type(data_type)) {
+                            // Widen and drop the sign of zero, so that equal values hash equally whatever their type
+                            if (!std::isnan(*ptr)) {
+                                double value = *ptr == 0 ? 0.0 : static_cast<double>(*ptr);
+                                hashed = hash(&value);
+                            }
+                        } else {
+                            auto value = static_cast<int64_t>(*ptr);
+                            hashed = hash(&value);
+                        }
+                        if (hashed.has_value())
+                            sketches_[groups[deref(iter)]].add(*hashed);
+                    }
+                }
+            };
+            if (input_column->column_->is_sparse()) {
+                lambda(col_data.bit_vector()->first());
+            }
+            else {
+                lambda(std::size_t(0));
+            }
+        });
+    }
+}
+
+SegmentInMemory HyperLogLogAggregatorData::finalize(const ColumnName& output_column_name,  bool, size_t unique_values) {
+    SegmentInMemory res;
+    if(!sketches_.empty()) {
+        sketches_.resize(unique_values);
+        auto pos = res.add_column(scalar_field(DataType::UINT64, output_column_name.value), unique_values, true);
+        auto& column = res.column(pos);
+        auto ptr = reinterpret_cast<uint64_t*>(column.ptr());
+        column.set_row_data(unique_values - 1);
+        for (auto idx = 0u; idx < unique_values; ++idx) {
+            ptr[idx] = static_cast<uint64_t>(std::llround(sketches_[idx].estimate()));
+        }
+    }
+    return res;
+}
+
+size_t HyperLogLogAggregatorData::bytes() const {
+    size_t res = (sketches_.capacity() - sketches_.size()) * sizeof(HyperLogLog);
+    for (const auto& sketch: sketches_)
+        res += sketch.bytes();
+    return res;
+}
+
+void TDigestAggregatorData::aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values) {
+    if(input_column.has_value()) {
+        input_column->column_->type().visit_tag([&] (auto type_desc_tag) {
+            using TypeDescriptorTag =  decltype(type_desc_tag);
+            using RawType = typename TypeDescriptorTag::DataTypeTag::raw_type;
+            constexpr auto data_type = TypeDescriptorTag::DataTypeTag::data_type;
+
+            if constexpr (is_sequence_type(data_type)) {
+                schema::raise<ErrorCode::E_UNSUPPORTED_COLUMN_TYPE>("Cannot compute a quantile of a {} column", input_column->column_->type());
+            } else {
+                sketches_.resize(unique_values);
+                auto col_data = input_column->column_->data();
+                auto lambda = [this, &col_data, &groups](auto iter) {
+                    while (auto block = col_data.next<TypeDescriptorTag>()) {
+                        auto ptr = reinterpret_cast<const RawType *>(block.value().data());
+                        for (auto i = 0u; i < block.value().row_count(); ++i, ++ptr, ++iter) {
+                            const auto value = static_cast<double>(*ptr);
+                            if (!std::isnan(value))
+                                sketches_[groups[deref(iter)]].add(value);
+                        }
+                    }
+                };
+                if (input_column->column_->is_sparse()) {
+                    lambda(col_data.bit_vector()->first());
+                }
+                else {
+                    lambda(std::size_t(0));
+                }
+            }
+        });
+    }
+}
+
+SegmentInMemory TDigestAggregatorData::finalize(const ColumnName& output_column_name,  bool, size_t unique_values) {
+    SegmentInMemory res;
+    if(!sketches_.empty()) {
+        sketches_.resize(unique_values);
+        auto pos = res.add_column(scalar_field(DataType::FLOAT64, output_column_name.value), unique_values, true);
+        auto& column = res.column(pos);
+        auto ptr = reinterpret_cast<double*>(column.ptr());
+        column.set_row_data(unique_values - 1);
+        for (auto idx = 0u; idx < unique_values; ++idx) {
+            ptr[idx] = sketches_[idx].quantile(quantile_);
+        }
+    }
+    return res;
+}
+
+size_t TDigestAggregatorData::bytes() const {
+    size_t res = (sketches_.capacity() - sketches_.size()) * sizeof(TDigest);
+    for (const auto& sketch: sketches_)
+        res += sketch.bytes();
+    return res;
+}
+
+/***********************
+ * Rolling aggregators *
+ ***********************/
+
+namespace
+{
+    template<typename AggregatorData>
+    void roll_impl(const RollingWindow& window, const RollingInput& input, double* output) {
+        const auto& values = input.values_;
+        AggregatorData data;
+        size_t observations = 0;
+        size_t start = 0;
+        for (size_t row = 0; row < values.size(); ++row) {
+            if (!std::isnan(values[row])) {
+                data.add(row, values[row]);
+                ++observations;
+            }
+            while (start < row && (window.rows_.has_value() ?
+                                   start + *window.rows_ <= row :
+                                   input.index_[start] <= input.index_[row] - *window.span_)) {
+                if (!std::isnan(values[start])) {
+                    data.remove(start, values[start]);
+                    --observations;
+                }
+                ++start;
+            }
+            if (row >= input.first_output_) {
+                output[row - input.first_output_] = observations >= window.min_periods_ ?
+                                                    data.result(observations) :
+                                                    std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    }
+}
+
+void RollingSumAggregatorData::add(size_t, double value) {
+    const auto corrected = value - compensation_;
+    const auto sum = sum_ + corrected;
+    compensation_ = (sum - sum_) - corrected;
+    sum_ = sum;
+}
+
+void RollingSumAggregatorData::remove(size_t row, double value) {
+    add(row, -value);
+}
+
+double RollingSumAggregatorData::result(size_t observations) const {
+    return observations == 0 ? 0.0 : sum_;
+}
+
+void RollingSumAggregatorData::roll(const RollingWindow& window, const RollingInput& input, double* output) const {
+    roll_impl<RollingSumAggregatorData>(window, input, output);
+}
+
+double RollingMeanAggregatorData::result(size_t observations) const {
+    return observations == 0 ?
+           std::numeric_limits<double>::quiet_NaN() :
+           RollingSumAggregatorData::result(observations) / static_cast<double>(observations);
+}
+
+void RollingMeanAggregatorData::roll(const RollingWindow& window, const RollingInput& input, double* output) const {
+    roll_impl<RollingMeanAggregatorData>(window, input, output);
+}
+
+void RollingCountAggregatorData::roll(const RollingWindow& window, const RollingInput& input, double* output) const {
+    roll_impl<RollingCountAggregatorData>(window, input, output);
+}
+
+template<typename Compare>
+void RollingExtremumAggregatorData<Compare>::roll(const RollingWindow& window, const RollingInput& input, double* output) const {
+    roll_impl<RollingExtremumAggregatorData<Compare>>(window, input, output);
+}
+
+template class RollingExtremumAggregatorData<std::less<double>>;
+template class RollingExtremumAggregatorData<std::greater<double>>;
+
 } //namespace arcticdb
@@ -11,6 +11,11 @@
 #include <arcticdb/entity/types.hpp>
 #include <arcticdb/entity/type_utils.hpp>
 #include <arcticdb/processing/expression_node.hpp>
+#include <arcticdb/processing/sketches.hpp>
+
+#include <deque>
+#include <functional>
+#include <limits>
 
 namespace arcticdb {
 
@@ -71,6 +76,7 @@ public:
     void add_data_type(DataType data_type);
     void aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values);
     SegmentInMemory finalize(const ColumnName& output_column_name,  bool dynamic_schema, size_t unique_values);
+    [[nodiscard]] size_t bytes() const { return aggregated_.capacity(); }
 
 private:
 
@@ -85,6 +91,7 @@ public:
     void add_data_type(DataType data_type);
     void aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values);
     SegmentInMemory finalize(const ColumnName& output_column_name, bool dynamic_schema, size_t unique_values);
+    [[nodiscard]] size_t bytes() const { return aggregated_.capacity(); }
 
 private:
 
@@ -99,6 +106,7 @@ public:
     void add_data_type(DataType data_type);
     void aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values);
     SegmentInMemory finalize(const ColumnName& output_column_name, bool dynamic_schema, size_t unique_values);
+    [[nodiscard]] size_t bytes() const { return aggregated_.capacity(); }
 
 private:
 
@@ -114,6 +122,7 @@ public:
     void add_data_type(DataType) {}
     void aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values);
     SegmentInMemory finalize(const ColumnName& output_column_name,  bool dynamic_schema, size_t unique_values);
+    [[nodiscard]] size_t bytes() const { return fractions_.capacity() * sizeof(Fraction); }
 
 private:
 
@@ -136,12 +145,49 @@ public:
     void add_data_type(DataType) {}
     void aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values);
     SegmentInMemory finalize(const ColumnName& output_column_name,  bool dynamic_schema, size_t unique_values);
+    [[nodiscard]] size_t bytes() const { return aggregated_.capacity() * sizeof(uint64_t); }
 
 private:
 
     std::vector<uint64_t> aggregated_;
 };
 
+// Approximate number of distinct non-NaN values per group. Strings are hashed by their contents, so the same string in
+// the string pools of different segments is counted once.
+class HyperLogLogAggregatorData : private AggregatorDataBase
+{
+public:
+
+    // Distinct counts are always integers so this is a no-op
+    void add_data_type(DataType) {}
+    void aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values);
+    SegmentInMemory finalize(const ColumnName& output_column_name,  bool dynamic_schema, size_t unique_values);
+    [[nodiscard]] size_t bytes() const;
+
+private:
+
+    std::vector<HyperLogLog> sketches_;
+};
+
+// Approximate quantile of the non-NaN values per group, NaN for groups without any
+class TDigestAggregatorData : private AggregatorDataBase
+{
+public:
+
+    explicit TDigestAggregatorData(double quantile) : quantile_(quantile) {}
+
+    // Quantile values are always doubles so this is a no-op
+    void add_data_type(DataType) {}
+    void aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values);
+    SegmentInMemory finalize(const ColumnName& output_column_name,  bool dynamic_schema, size_t unique_values);
+    [[nodiscard]] size_t bytes() const;
+
+private:
+
+    double quantile_;
+    std::vector<TDigest> sketches_;
+};
+
 template <class AggregatorData>
 class GroupingAggregatorImpl
 {
@@ -170,5 +216,151 @@ using MinAggregator = GroupingAggregatorImpl<MinAggregatorData>;
 using MaxAggregator = GroupingAggregatorImpl<MaxAggregatorData>;
 using MeanAggregator = GroupingAggregatorImpl<MeanAggregatorData>;
 using CountAggregator = GroupingAggregatorImpl<CountAggregatorData>;
+using HyperLogLogAggregator = GroupingAggregatorImpl<HyperLogLogAggregatorData>;
+
+class TDigestAggregator
+{
+public:
+
+    explicit TDigestAggregator(ColumnName input_column_name, ColumnName output_column_name, double quantile)
+        : input_column_name_(std::move(input_column_name))
+        , output_column_name_(std::move(output_column_name))
+        , quantile_(quantile)
+    {
+    }
+
+    ARCTICDB_MOVE_COPY_DEFAULT(TDigestAggregator);
+
+    [[nodiscard]] ColumnName get_input_column_name() const { return input_column_name_; }
+    [[nodiscard]] ColumnName get_output_column_name() const { return output_column_name_; }
+    [[nodiscard]] TDigestAggregatorData get_aggregator_data() const { return TDigestAggregatorData(quantile_); }
+
+private:
+
+    ColumnName input_column_name_;
+    ColumnName output_column_name_;
+    double quantile_;
+};
+
+/*
+ * Rolling window aggregations. Each row's output is the aggregate of the non-NaN input values in its window, or NaN if
+ * there are fewer than min_periods_ of them. Windows are either a number of rows ending at the row, or the rows whose
+ * index is in (t - span, t] for a row with index t.
+ *
+ * The aggregator data classes keep incremental state, so that moving the window along by one row is O(1) amortised.
+ * They are only given the non-NaN values, and the number of them in the window is tracked by roll.
+ */
+struct RollingWindow {
+    // Exactly one of these is set
+    std::optional<size_t> rows_;
+    std::optional<timestamp> span_;
+    size_t min_periods_{1};
+};
+
+// The rows to roll over. Outputs are written for rows from first_output onwards, and the rows before that are only
+// there to fill the windows of the first outputs. index is only needed for windows given as a span.
+struct RollingInput {
+    const std::vector<timestamp>& index_;
+    const std::vector<double>& values_;
+    size_t first_output_{0};
+};
+
+class RollingSumAggregatorData
+{
+public:
+
+    void add(size_t row, double value);
+    void remove(size_t row, double value);
+    [[nodiscard]] double result(size_t observations) const;
+    void roll(const RollingWindow& window, const RollingInput& input, double* output) const;
+
+private:
+
+    // Kahan summation, as values are both added and removed over a long run of rows
+    double sum_{0.0};
+    double compensation_{0.0};
+};
+
+class RollingMeanAggregatorData : private RollingSumAggregatorData
+{
+public:
+
+    using RollingSumAggregatorData::add;
+    using RollingSumAggregatorData::remove;
+    [[nodiscard]] double result(size_t observations) const;
+    void roll(const RollingWindow& window, const RollingInput& input, double* output) const;
+};
+
+class RollingCountAggregatorData
+{
+public:
+
+    void add(size_t, double) {}
+    void remove(size_t, double) {}
+    [[nodiscard]] double result(size_t observations) const { return static_cast<double>(observations); }
+    void roll(const RollingWindow& window, const RollingInput& input, double* output) const;
+};
+
+// Keeps a deque of the rows that could still be the extreme of the window, with their values in monotonic order, so
+// the extreme is always at the front
+template<typename Compare>
+class RollingExtremumAggregatorData
+{
+public:
+
+    void add(size_t row, double value) {
+        while (!candidates_.empty() && !Compare{}(candidates_.back().second, value))
+            candidates_.pop_back();
+
+        candidates_.emplace_back(row, value);
+    }
+
+    void remove(size_t row, double) {
+        if (!candidates_.empty() && candidates_.front().first == row)
+            candidates_.pop_front();
+    }
+
+    [[nodiscard]] double result(size_t) const {
+        return candidates_.empty() ? std::numeric_limits<double>::quiet_NaN() : candidates_.front().second;
+    }
+
+    void roll(const RollingWindow& window, const RollingInput& input, double* output) const;
+
+private:
+
+    std::deque<std::pair<size_t, double>> candidates_;
+};
+
+using RollingMinAggregatorData = RollingExtremumAggregatorData<std::less<double>>;
+using RollingMaxAggregatorData = RollingExtremumAggregatorData<std::greater<double>>;
+
+template <class AggregatorData>
+class RollingAggregatorImpl
+{
+public:
+
+    explicit RollingAggregatorImpl(ColumnName input_column_name, ColumnName output_column_name)
+        : input_column_name_(std::move(input_column_name))
+        , output_column_name_(std::move(output_column_name))
+    {
+    }
+
+    ARCTICDB_MOVE_COPY_DEFAULT(RollingAggregatorImpl);
+
+    [[nodiscard]] ColumnName get_input_column_name() const { return input_column_name_; }
+    [[nodiscard]] ColumnName get_output_column_name() const { return output_column_name_; }
+    [[nodiscard]] AggregatorData get_aggregator_data() const { return AggregatorData(); }
+
+private:
+
+    ColumnName input_column_name_;
+    ColumnName output_column_name_;
+};
+
+using RollingSumAggregator = RollingAggregatorImpl<RollingSumAggregatorData>;
+using RollingMeanAggregator = RollingAggregatorImpl<RollingMeanAggregatorData>;
+using RollingCountAggregator = RollingAggregatorImpl<RollingCountAggregatorData>;
+using RollingMinAggregator = RollingAggregatorImpl<RollingMinAggregatorData>;
+using RollingMaxAggregator = RollingAggregatorImpl<RollingMaxAggregatorData>;
 
 } //namespace arcticdb
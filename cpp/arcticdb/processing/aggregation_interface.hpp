@@ -22,10 +22,12 @@ struct IGroupingAggregatorData {
         [[nodiscard]] SegmentInMemory finalize(const ColumnName& output_column_name, bool dynamic_schema, size_t unique_values) {
             return folly::poly_call<2>(*this, output_column_name, dynamic_schema, unique_values);
         }
+        // The memory held by the state of each group, which is counted against the memory budget of the read
+        [[nodiscard]] size_t bytes() const { return folly::poly_call<3>(*this); }
     };
 
     template<class T>
-    using Members = folly::PolyMembers<&T::add_data_type, &T::aggregate, &T::finalize>;
+    using Members = folly::PolyMembers<&T::add_data_type, &T::aggregate, &T::finalize, &T::bytes>;
 };
 
 using GroupingAggregatorData = folly::Poly<IGroupingAggregatorData>;
@@ -73,4 +75,32 @@ struct IColumnStatsAggregator {
 
 using ColumnStatsAggregator = folly::Poly<IColumnStatsAggregator>;
 
+struct IRollingAggregatorData {
+    template<class Base>
+    struct Interface : Base {
+        void roll(const RollingWindow& window, const RollingInput& input, double* output) const {
+            folly::poly_call<0>(*this, window, input, output);
+        }
+    };
+
+    template<class T>
+    using Members = folly::PolyMembers<&T::roll>;
+};
+
+using RollingAggregatorData = folly::Poly<IRollingAggregatorData>;
+
+struct IRollingAggregator {
+    template<class Base>
+    struct Interface : Base {
+        [[nodiscard]] ColumnName get_input_column_name() const { return folly::poly_call<0>(*this); };
+        [[nodiscard]] ColumnName get_output_column_name() const { return folly::poly_call<1>(*this); };
+        [[nodiscard]] RollingAggregatorData get_aggregator_data() const { return folly::poly_call<2>(*this); }
+    };
+
+    template<class T>
+    using Members = folly::PolyMembers<&T::get_input_column_name, &T::get_output_column_name, &T::get_aggregator_data>;
+};
+
+using RollingAggregator = folly::Poly<IRollingAggregator>;
+
 } //namespace arcticdb
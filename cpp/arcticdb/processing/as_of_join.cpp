@@ -0,0 +1,285 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/processing/as_of_join.hpp>
+#include <arcticdb/processing/processing_unit.hpp>
+#include <arcticdb/entity/type_utils.hpp>
+#include <arcticdb/util/offset_string.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <folly/container/Enumerate.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace arcticdb {
+
+namespace {
+
+template<typename RawType>
+std::optional<AsOfJoinRight::Key> numeric_key(RawType value) {
+    if constexpr (std::is_floating_point_v<RawType>) {
+        const auto as_double = static_cast<double>(value);
+        if (std::isnan(as_double))
+            return std::nullopt;
+
+        if (std::trunc(as_double) == as_double && as_double >= -0x1p63 && as_double < 0x1p63)
+            return static_cast<int64_t>(as_double);
+
+        return as_double;
+    } else if constexpr (std::is_signed_v<RawType>) {
+        return static_cast<int64_t>(value);
+    } else {
+        if (static_cast<uint64_t>(value) <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+            return static_cast<int64_t>(value);
+
+        return static_cast<uint64_t>(value);
+    }
+}
+
+std::optional<AsOfJoinRight::Key> key_at(const Column& column, const StringPool* string_pool, size_t row) {
+    std::optional<AsOfJoinRight::Key> res;
+    details::visit_type(column.type().data_type(), [&](auto column_desc_tag) {
+        using ColumnTagType = std::decay_t<decltype(column_desc_tag)>;
+        using RawType = typename ColumnTagType::raw_type;
+        if constexpr (is_sequence_type(ColumnTagType::data_type)) {
+            auto offset = column.scalar_at<RawType>(static_cast<position_t>(row));
+            if (offset.has_value() && is_a_string(*offset) && string_pool != nullptr)
+                res = string_pool->get_const_view(*offset);
+        } else if constexpr (is_numeric_type(ColumnTagType::data_type) || is_bool_type(ColumnTagType::data_type)) {
+            if (auto value = column.scalar_at<RawType>(static_cast<position_t>(row)); value.has_value())
+                res = numeric_key(*value);
+        }
+    });
+    return res;
+}
+
+// The value given to left rows without a matching right value
+template<typename TagType>
+typename TagType::raw_type fill_value() {
+    using RawType = typename TagType::raw_type;
+    if constexpr (is_sequence_type(TagType::data_type))
+        return static_cast<RawType>(not_a_string());
+    else if constexpr (std::is_floating_point_v<RawType>)
+        return std::numeric_limits<RawType>::quiet_NaN();
+    else
+        return RawType{};
+}
+
+// Columns of other types, which hold no values, are left sparse
+void set_fill_value(Column& target, size_t target_row) {
+    details::visit_type(target.type().data_type(), [&](auto target_desc_tag) {
+        using TargetTagType = std::decay_t<decltype(target_desc_tag)>;
+        if constexpr (is_sequence_type(TargetTagType::data_type) || is_numeric_type(TargetTagType::data_type) || is_bool_type(TargetTagType::data_type))
+            target.set_scalar(static_cast<ssize_t>(target_row), fill_value<TargetTagType>());
+    });
+}
+
+// Returns false if the source row is absent
+bool copy_value(
+    const Column& source,
+    const StringPool& source_pool,
+    size_t source_row,
+    Column& target,
+    StringPool& target_pool,
+    size_t target_row) {
+    if (is_empty_type(source.type().data_type()))
+        return false;
+
+    bool copied = false;
+    details::visit_type(target.type().data_type(), [&](auto target_desc_tag) {
+        using TargetTagType = std::decay_t<decltype(target_desc_tag)>;
+        using TargetRawType = typename TargetTagType::raw_type;
+        details::visit_type(source.type().data_type(), [&](auto source_desc_tag) {
+            using SourceTagType = std::decay_t<decltype(source_desc_tag)>;
+            using SourceRawType = typename SourceTagType::raw_type;
+            constexpr bool both_strings = is_sequence_type(TargetTagType::data_type) && is_sequence_type(SourceTagType::data_type);
+            constexpr bool both_numeric = is_numeric_type(TargetTagType::data_type) && is_numeric_type(SourceTagType::data_type);
+            constexpr bool both_bool = is_bool_type(TargetTagType::data_type) && is_bool_type(SourceTagType::data_type);
+            if constexpr (both_strings) {
+                if (auto offset = source.scalar_at<SourceRawType>(static_cast<position_t>(source_row)); offset.has_value()) {
+                    const auto target_offset = is_a_string(*offset) ? target_pool.get(source_pool.get_const_view(*offset)).offset() : *offset;
+                    target.set_scalar(static_cast<ssize_t>(target_row), static_cast<TargetRawType>(target_offset));
+                    copied = true;
+                }
+            } else if constexpr (both_numeric || both_bool) {
+                if (auto value = source.scalar_at<SourceRawType>(static_cast<position_t>(source_row)); value.has_value()) {
+                    target.set_scalar(static_cast<ssize_t>(target_row), static_cast<TargetRawType>(*value));
+                    copied = true;
+                }
+            } else {
+                schema::raise<ErrorCode::E_UNSUPPORTED_COLUMN_TYPE>(
+                    "As-of join cannot put a {} value in a {} column", source.type(), target.type());
+            }
+        });
+    });
+    return copied;
+}
+
+} // namespace
+
+AsOfJoinRight::AsOfJoinRight(std::vector<std::pair<std::string, TypeDescriptor>> columns, std::optional<std::string> by) :
+    columns_(std::move(columns)),
+    by_(std::move(by)) {
+}
+
+void AsOfJoinRight::add_row_slice(std::vector<SegmentInMemory>&& segments) {
+    internal::check<ErrorCode::E_ASSERTION_FAILURE>(!segments.empty(), "Expected at least one segment in as-of join row slice");
+    RowSlice row_slice;
+    row_slice.columns_.resize(columns_.size());
+    std::optional<std::pair<size_t, position_t>> by_column;
+    for (auto&& [segment_idx, segment]: folly::enumerate(segments)) {
+        segment.init_column_map();
+        for (auto&& [column_idx, column]: folly::enumerate(columns_)) {
+            if (auto position = segment.column_index(column->first); position.has_value())
+                row_slice.columns_[column_idx] = std::make_pair(segment_idx, static_cast<position_t>(*position));
+        }
+        if (by_.has_value()) {
+            if (auto position = segment.column_index(*by_); position.has_value())
+                by_column = std::make_pair(segment_idx, static_cast<position_t>(*position));
+        }
+    }
+
+    const auto first_row = index_.size();
+    const auto& first_segment = segments.front();
+    const auto& index_column = first_segment.column(0);
+    for (size_t row = 0; row < first_segment.row_count(); ++row) {
+        const auto index = index_column.scalar_at<timestamp>(static_cast<position_t>(row)).value();
+        sorting::check<ErrorCode::E_UNSORTED_DATA>(
+            index_.empty() || index_.back() <= index,
+            "As-of join requires the right side to be sorted by its index");
+        index_.emplace_back(index);
+    }
+
+    if (by_column.has_value()) {
+        const auto& segment = segments[by_column->first];
+        const auto& key_column = segment.column(by_column->second);
+        const auto is_string = is_sequence_type(key_column.type().data_type());
+        user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+            !by_is_string_.has_value() || *by_is_string_ == is_string,
+            "As-of join by column '{}' holds both strings and numbers on the right side", *by_);
+        by_is_string_ = is_string;
+        for (size_t row = 0; row < segment.row_count(); ++row) {
+            if (auto key = key_at(key_column, &segment.const_string_pool(), row); key.has_value())
+                rows_by_key_[*key].emplace_back(first_row + row);
+        }
+    }
+
+    row_slice_starts_.emplace_back(first_row);
+    row_slice.segments_ = std::move(segments);
+    row_slices_.emplace_back(std::move(row_slice));
+}
+
+std::optional<size_t> AsOfJoinRight::last_at_or_before(timestamp index, const std::vector<size_t>& candidates) const {
+    auto after = std::upper_bound(candidates.begin(), candidates.end(), index, [this](timestamp left, size_t right_row) {
+        return left < index_[right_row];
+    });
+    if (after == candidates.begin())
+        return std::nullopt;
+
+    return *std::prev(after);
+}
+
+void AsOfJoinRight::join(ProcessingUnit& proc, std::optional<timestamp> tolerance) const {
+    internal::check<ErrorCode::E_ASSERTION_FAILURE>(
+        proc.segments_.has_value() && !proc.segments_->empty() && proc.col_ranges_.has_value(),
+        "As-of join requires segments and column ranges");
+    const auto& segments = *proc.segments_;
+    const auto& first_segment = *segments.front();
+    schema::check<ErrorCode::E_UNSUPPORTED_INDEX_TYPE>(
+        first_segment.descriptor().index().type() == IndexDescriptor::TIMESTAMP,
+        "As-of join requires the left side to have a timestamp index");
+    for (const auto& [name, _]: columns_) {
+        for (const auto& segment: segments) {
+            segment->init_column_map();
+            user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+                !segment->column_index(name).has_value(),
+                "As-of join would give two columns named '{}'", name);
+        }
+    }
+
+    std::optional<ColumnWithStrings> left_key;
+    if (by_.has_value()) {
+        auto key = proc.get(ColumnName(*by_));
+        schema::check<ErrorCode::E_COLUMN_DOESNT_EXIST>(
+            std::holds_alternative<ColumnWithStrings>(key),
+            "As-of join by column '{}' is not on the left side", *by_);
+        left_key.emplace(std::get<ColumnWithStrings>(key));
+        user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+            !by_is_string_.has_value() || *by_is_string_ == is_sequence_type(left_key->column_->type().data_type()),
+            "As-of join by column '{}' must hold strings on both sides or numbers on both sides", *by_);
+    }
+
+    // The right row matched by each left row, as a row count across all the right row slices
+    const auto rows = first_segment.row_count();
+    const auto& index_column = first_segment.column(0);
+    std::vector<std::optional<size_t>> matches(rows);
+    size_t next = 0;
+    auto previous = std::numeric_limits<timestamp>::min();
+    for (size_t row = 0; row < rows; ++row) {
+        const auto index = index_column.scalar_at<timestamp>(static_cast<position_t>(row)).value();
+        sorting::check<ErrorCode::E_UNSORTED_DATA>(previous <= index, "As-of join requires the left side to be sorted by its index");
+        previous = index;
+
+        std::optional<size_t> match;
+        if (left_key.has_value()) {
+            if (auto key = key_at(*left_key->column_, left_key->string_pool_.get(), row); key.has_value()) {
+                if (auto candidates = rows_by_key_.find(*key); candidates != rows_by_key_.end())
+                    match = last_at_or_before(index, candidates->second);
+            }
+        } else {
+            // Left rows are in index order too, so the search only has to be done once
+            if (row == 0)
+                next = std::upper_bound(index_.begin(), index_.end(), index) - index_.begin();
+
+            while (next < index_.size() && index_[next] <= index)
+                ++next;
+
+            if (next > 0)
+                match = next - 1;
+        }
+        if (match.has_value() && tolerance.has_value() && index - index_[*match] > *tolerance)
+            match.reset();
+
+        matches[row] = match;
+    }
+
+    auto& target = *segments.back();
+    auto& target_pool = target.string_pool();
+    for (auto&& [column_idx, column]: folly::enumerate(columns_)) {
+        auto output = std::make_shared<Column>(column->second, true);
+        for (size_t row = 0; row < rows; ++row) {
+            bool copied = false;
+            if (matches[row].has_value()) {
+                const auto right_row = *matches[row];
+                const auto slice_idx = static_cast<size_t>(std::upper_bound(row_slice_starts_.begin(), row_slice_starts_.end(), right_row) - row_slice_starts_.begin()) - 1;
+                const auto& row_slice = row_slices_[slice_idx];
+                if (const auto& location = row_slice.columns_[column_idx]; location.has_value()) {
+                    const auto& source_segment = row_slice.segments_[location->first];
+                    copied = copy_value(
+                        source_segment.column(location->second),
+                        source_segment.const_string_pool(),
+                        right_row - row_slice_starts_[slice_idx],
+                        *output,
+                        target_pool,
+                        row);
+                }
+            }
+            if (!copied)
+                set_fill_value(*output, row);
+        }
+        if (const auto filled = static_cast<size_t>(output->last_row() + 1); filled < rows)
+            output->mark_absent_rows(rows - filled);
+
+        target.add_column(scalar_field(column->second.data_type(), column->first), output);
+        ++proc.col_ranges_->back()->second;
+    }
+}
+
+} // namespace arcticdb
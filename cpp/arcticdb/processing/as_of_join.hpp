@@ -0,0 +1,75 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/column_store/memory_segment.hpp>
+#include <arcticdb/entity/types.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace arcticdb {
+
+struct ProcessingUnit;
+
+/*
+ * The right side of an as-of join. It is read in full before the join runs, so that every processing unit of the left
+ * side can be joined against it on its own, in parallel with the others.
+ *
+ * Both sides must be sorted by a timestamp index. For each left row the join takes the last right row whose index is
+ * at or before the left row's, optionally no more than a tolerance before it and with the same value in the by column.
+ * Both by columns must hold strings or both must hold numbers, where numbers of different types match if they are
+ * equal. Left rows without a matching right row get NaN in float columns, None in string columns and zero in integer
+ * and bool columns.
+ */
+class AsOfJoinRight {
+public:
+    // A by value. Integers are widened, and floats that hold integers converted, so that by columns of different
+    // numeric types match on equal values. Strings are views into the string pools of the segments they come from.
+    using Key = std::variant<int64_t, uint64_t, double, std::string_view>;
+
+    // columns are the right columns to add to the left side, in order, with their types in the right side's descriptor
+    AsOfJoinRight(std::vector<std::pair<std::string, TypeDescriptor>> columns, std::optional<std::string> by);
+
+    // Row slices must be added in index order, each as the segments of its column slices
+    void add_row_slice(std::vector<SegmentInMemory>&& segments);
+
+    // Adds the right columns to the last segment of the processing unit. Left rows without a matching right row are
+    // filled with NaN in float columns, None in string columns and zero in integer and bool columns.
+    void join(ProcessingUnit& proc, std::optional<timestamp> tolerance) const;
+
+    [[nodiscard]] size_t row_count() const {
+        return index_.size();
+    }
+
+private:
+    struct RowSlice {
+        std::vector<SegmentInMemory> segments_;
+        // For each of columns_, the segment and position holding it, if this row slice has it
+        std::vector<std::optional<std::pair<size_t, position_t>>> columns_;
+    };
+
+    [[nodiscard]] std::optional<size_t> last_at_or_before(timestamp index, const std::vector<size_t>& candidates) const;
+
+    std::vector<std::pair<std::string, TypeDescriptor>> columns_;
+    std::optional<std::string> by_;
+    std::optional<bool> by_is_string_;
+    std::vector<RowSlice> row_slices_;
+    // The first row of each row slice, counting across all of them
+    std::vector<size_t> row_slice_starts_;
+    std::vector<timestamp> index_;
+    // The rows with each by value, in index order
+    std::unordered_map<Key, std::vector<size_t>> rows_by_key_;
+};
+
+} // namespace arcticdb
@@ -11,10 +11,13 @@
 #include <folly/Poly.h>
 #include <arcticdb/util/composite.hpp>
 #include <arcticdb/processing/clause.hpp>
+#include <arcticdb/processing/operation_dispatch_string.hpp>
 #include <arcticdb/pipeline/column_stats.hpp>
 #include <arcticdb/pipeline/value_set.hpp>
+#include <arcticdb/column_store/segment_utils.hpp>
 #include <arcticdb/pipeline/frame_slice.hpp>
 #include <arcticdb/stream/segment_aggregator.hpp>
+#include <arcticdb/util/read_profile.hpp>
 #ifdef ARCTICDB_USING_CONDA
     #include <robin_hood.h>
 #else
@@ -60,6 +63,22 @@ std::vector<std::vector<size_t>> structure_by_column_slice(std::vector<RangesAnd
     return res;
 }
 
+namespace {
+
+// Rows across the segments of a processing unit, counting column slices of the same rows, which are adjacent, once.
+// Without row ranges, every segment is counted.
+size_t count_rows(const std::vector<std::shared_ptr<SegmentInMemory>>& segments,
+                  const std::vector<std::shared_ptr<RowRange>>& row_ranges) {
+    size_t rows{0};
+    for (size_t idx = 0; idx < segments.size(); ++idx) {
+        if (idx == 0 || idx >= row_ranges.size() || *row_ranges[idx] != *row_ranges[idx - 1])
+            rows += segments[idx]->row_count();
+    }
+    return rows;
+}
+
+} // namespace
+
 /*
  * On entry to a clause, construct ProcessingUnits from the input entity IDs. These will either be provided by the
  * structure_for_processing method for the first clause in the pipeline, or by the previous clause for all subsequent
@@ -85,6 +104,8 @@ Composite<ProcessingUnit> gather_entities(std::shared_ptr<ComponentManager> comp
             row_ranges.emplace_back(component_manager->get<std::shared_ptr<RowRange>>(entity_id));
             col_ranges.emplace_back(component_manager->get<std::shared_ptr<ColRange>>(entity_id));
         }
+        if (auto profile_stage = current_profile_stage())
+            profile_stage->add("rows_in", count_rows(segments, row_ranges));
         res.set_segments(std::move(segments));
         res.set_row_ranges(std::move(row_ranges));
         res.set_col_ranges(std::move(col_ranges));
@@ -124,6 +145,8 @@ Composite<ProcessingUnit> gather_entities(std::shared_ptr<ComponentManager> comp
  * pushed into the component manager with the same ID.
  */
 EntityIds push_entities(std::shared_ptr<ComponentManager> component_manager, ProcessingUnit&& proc) {
+    if (auto profile_stage = current_profile_stage(); profile_stage && proc.segments_.has_value())
+        profile_stage->add("rows_out", count_rows(*proc.segments_, proc.row_ranges_.value_or(std::vector<std::shared_ptr<RowRange>>{})));
     std::optional<EntityIds> res;
     if (proc.segments_.has_value()) {
         res = std::make_optional<EntityIds>();
@@ -210,6 +233,18 @@ public:
                                    });
     }
 
+    // The memory held by the table, which has a byte of metadata per slot besides the entry
+    size_t bytes() const {
+        return util::variant_match(map_,
+                                   [](const std::monostate &) {
+                                       return size_t(0);
+                                   },
+                                   [](const auto &other) {
+                                       using MapType = typename std::decay_t<decltype(other)>::element_type;
+                                       return (other->mask() + 1) * (sizeof(typename MapType::value_type) + 1);
+                                   });
+    }
+
     template<typename T>
     std::shared_ptr<robin_hood::unordered_flat_map<T, size_t>> get() {
         return util::variant_match(map_,
@@ -227,23 +262,57 @@ public:
     }
 };
 
-struct SegmentWrapper {
-    SegmentInMemory seg_;
-    SegmentInMemory::iterator it_;
-    const StreamId id_;
+/*
+ * A sorted run of segments, such as the pieces a sorted segment was split into, that is merged a row at a time. Its
+ * segments are fetched from the component manager one at a time as the merge reaches them, and dropped once it has
+ * moved past them, so however many runs there are only the segment at the head of each is held in memory while the
+ * rest can wait on disk under a memory budget.
+ */
+struct RunWrapper {
+    std::shared_ptr<ComponentManager> component_manager_;
+    EntityIds entity_ids_;
+    size_t next_{0};
+    std::shared_ptr<SegmentInMemory> seg_;
+    std::optional<SegmentInMemory::iterator> it_;
+    StreamId id_;
+
+    RunWrapper(std::shared_ptr<ComponentManager> component_manager, EntityIds&& entity_ids) :
+            component_manager_(std::move(component_manager)),
+            entity_ids_(std::move(entity_ids)) {
+    }
 
-    explicit SegmentWrapper(SegmentInMemory&& seg) :
-            seg_(std::move(seg)),
-            it_(seg_.begin()),
-            id_(seg_.descriptor().id()) {
+    // Moves on to the first row of the next non-empty segment of the run, returning false if there are none left
+    bool next_segment() {
+        // The last row of the segment that has been merged, as the one before the end the merge has advanced to
+        std::optional<IndexValue> previous_index;
+        if (it_.has_value())
+            previous_index = pipelines::index::index_value_from_row(*(*it_ - 1), IndexDescriptor::TIMESTAMP, 0);
+
+        // Release the segment that has been merged before fetching the next
+        it_.reset();
+        seg_.reset();
+        while (next_ < entity_ids_.size()) {
+            auto seg = component_manager_->get<std::shared_ptr<SegmentInMemory>>(entity_ids_[next_++]);
+            if (seg->row_count() == 0)
+                continue;
+
+            seg_ = std::move(seg);
+            it_.emplace(seg_->begin());
+            id_ = seg_->descriptor().id();
+            internal::check<ErrorCode::E_ASSERTION_FAILURE>(
+                    previous_index <= pipelines::index::index_value_from_row(**it_, IndexDescriptor::TIMESTAMP, 0),
+                    "MergeClause expected the segments of each run to be sorted");
+            return true;
+        }
+        return false;
     }
 
     bool advance() {
-        return ++it_ != seg_.end();
+        return ++*it_ != seg_->end() || next_segment();
     }
 
     SegmentInMemory::Row &row() {
-        return *it_;
+        return **it_;
     }
 
     const StreamId &id() const {
@@ -301,8 +370,13 @@ Composite<EntityIds> ProjectClause::process(Composite<EntityIds>&& entity_ids) c
 
                                 const auto data_type = col.column_->type().data_type();
                                 const std::string_view name = output_column_;
+                                auto& segment = *proc.segments_->back();
+                                // A string column produced by a string operation, or taken from another column slice,
+                                // holds offsets into a different string pool to the one of the segment it is added to
+                                if (is_dynamic_string_type(data_type) && col.string_pool_ && col.string_pool_ != segment.string_pool_ptr())
+                                    col.column_ = std::make_shared<Column>(copy_strings_to_pool(col, segment.string_pool()));
 
-                                proc.segments_->back()->add_column(scalar_field(data_type, name), col.column_);
+                                segment.add_column(scalar_field(data_type, name), col.column_);
                                 ++proc.col_ranges_->back()->second;
                                 output.push_back(push_entities(component_manager_, std::move(proc)));
                             },
@@ -323,6 +397,35 @@ Composite<EntityIds> ProjectClause::process(Composite<EntityIds>&& entity_ids) c
     return expression_context_ ? fmt::format("PROJECT Column[\"{}\"] = {}", output_column_, expression_context_->root_node_name_.value) : "";
 }
 
+namespace {
+
+// The quantile of an "approx_quantile(q)" aggregation operator, with "approx_median" short for q of 0.5
+std::optional<double> approx_quantile(const std::string& aggregation_operator) {
+    if (aggregation_operator == "approx_median")
+        return 0.5;
+
+    static const std::string prefix{"approx_quantile("};
+    if (aggregation_operator.size() <= prefix.size() + 1 ||
+        aggregation_operator.compare(0, prefix.size(), prefix) != 0 ||
+        aggregation_operator.back() != ')')
+        return std::nullopt;
+
+    const auto argument = aggregation_operator.substr(prefix.size(), aggregation_operator.size() - prefix.size() - 1);
+    size_t parsed = 0;
+    double quantile = std::numeric_limits<double>::quiet_NaN();
+    try {
+        quantile = std::stod(argument, &parsed);
+    } catch (const std::logic_error&) {
+        parsed = 0;
+    }
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+            parsed == argument.size() && quantile >= 0.0 && quantile <= 1.0,
+            "Expected a quantile between 0 and 1 in aggregation operator {}", aggregation_operator);
+    return quantile;
+}
+
+} // namespace
+
 AggregationClause::AggregationClause(const std::string& grouping_column,
                                      const std::unordered_map<std::string,
                                      std::string>& aggregations):
@@ -348,6 +451,10 @@ AggregationClause::AggregationClause(const std::string& grouping_column,
             aggregators_.emplace_back(MinAggregator(typed_column_name, typed_column_name));
         } else if (aggregation_operator == "count") {
             aggregators_.emplace_back(CountAggregator(typed_column_name, typed_column_name));
+        } else if (aggregation_operator == "approx_nunique") {
+            aggregators_.emplace_back(HyperLogLogAggregator(typed_column_name, typed_column_name));
+        } else if (auto quantile = approx_quantile(aggregation_operator); quantile.has_value()) {
+            aggregators_.emplace_back(TDigestAggregator(typed_column_name, typed_column_name, *quantile));
         } else {
             user_input::raise<ErrorCode::E_INVALID_USER_ARGUMENT>("Unknown aggregation operator provided: {}", aggregation_operator);
         }
@@ -355,6 +462,64 @@ AggregationClause::AggregationClause(const std::string& grouping_column,
 }
 
 Composite<EntityIds> AggregationClause::process(Composite<EntityIds>&& entity_ids) const {
+    return aggregate_within_budget(std::move(entity_ids), partition_num_buckets(), 0);
+}
+
+Composite<EntityIds> AggregationClause::aggregate_within_budget(
+        Composite<EntityIds>&& entity_ids,
+        size_t hash_divisor,
+        size_t splits) const {
+    const auto budget = component_manager_->memory_budget();
+    if (!budget || splits == max_bucket_splits)
+        return aggregate(std::move(entity_ids));
+
+    uint64_t bucket_bytes{0};
+    entity_ids.broadcast([&bucket_bytes, this](const EntityIds& ids) {
+        for (auto entity_id: ids)
+            bucket_bytes += component_manager_->segment_bytes(entity_id);
+    });
+    if (bucket_bytes <= budget->limit_bytes())
+        return aggregate(std::move(entity_ids));
+
+    // Split the bucket on more bits of the same hash as the partitioning, so that each group still lies within one
+    // sub-bucket. The processing units are split one at a time, and the pieces spill if they do not fit either.
+    const auto num_sub_buckets = static_cast<uint8_t>(std::min<uint64_t>(bucket_bytes / budget->limit_bytes() + 1,
+                                                                         std::numeric_limits<uint8_t>::max()));
+    ARCTICDB_DEBUG(log::version(), "Splitting a groupby bucket of {} bytes into {} for a memory budget of {} bytes",
+                   bucket_bytes, num_sub_buckets, budget->limit_bytes());
+    const grouping::SubBucketizer bucketizer(hash_divisor, num_sub_buckets);
+    std::vector<Composite<EntityIds>> sub_buckets(num_sub_buckets);
+    entity_ids.broadcast([&sub_buckets, &bucketizer, this](EntityIds& ids) {
+        auto procs = gather_entities(component_manager_, Composite<EntityIds>(std::move(ids)));
+        procs.broadcast([&sub_buckets, &bucketizer, this](ProcessingUnit& proc) {
+            auto split = partition_processing_segment<grouping::HashingGroupers>(proc,
+                                                                                 ColumnName(grouping_column_),
+                                                                                 processing_config_.dynamic_schema_,
+                                                                                 bucketizer);
+            split.broadcast([&sub_buckets, this](ProcessingUnit& sub_proc) {
+                const auto sub_bucket = *sub_proc.bucket_;
+                sub_buckets[sub_bucket].push_back(push_entities(component_manager_, std::move(sub_proc)));
+            });
+        });
+    });
+
+    const auto non_empty = std::count_if(sub_buckets.begin(), sub_buckets.end(), [](const Composite<EntityIds>& comp) {
+        return !comp.empty();
+    });
+    Composite<EntityIds> output;
+    for (auto&& sub_bucket: sub_buckets) {
+        if (sub_bucket.empty())
+            continue;
+        // If every group landed in one sub-bucket, e.g. because there is only one, splitting again would not help
+        if (non_empty == 1)
+            output.push_back(aggregate(std::move(sub_bucket)));
+        else
+            output.push_back(aggregate_within_budget(std::move(sub_bucket), hash_divisor * num_sub_buckets, splits + 1));
+    }
+    return output;
+}
+
+Composite<EntityIds> AggregationClause::aggregate(Composite<EntityIds>&& entity_ids) const {
     auto procs = gather_entities(component_manager_, std::move(entity_ids));
     std::vector<GroupingAggregatorData> aggregators_data;
     internal::check<ErrorCode::E_INVALID_ARGUMENT>(
@@ -380,14 +545,16 @@ Composite<EntityIds> AggregationClause::process(Composite<EntityIds>&& entity_id
     auto string_pool = std::make_shared<StringPool>();
     DataType grouping_data_type;
     GroupingMap grouping_map;
+    // The groups and the state of the aggregators grow with each processing unit, and count against any memory budget
+    auto groups_reservation = component_manager_->reserve(0);
     procs.broadcast(
-        [&num_unique, &grouping_data_type, &grouping_map, &next_group_id, &aggregators_data, &string_pool, this](auto &proc) {
+        [&num_unique, &grouping_data_type, &grouping_map, &next_group_id, &aggregators_data, &string_pool, &groups_reservation, this](auto &proc) {
             auto partitioning_column = proc.get(ColumnName(grouping_column_));
             if (std::holds_alternative<ColumnWithStrings>(partitioning_column)) {
                 ColumnWithStrings col = std::get<ColumnWithStrings>(partitioning_column);
                 entity::details::visit_type(col.column_->type().data_type(),
                                             [&proc_=proc, &grouping_map, &next_group_id, &aggregators_data, &string_pool, &col,
-                                             &num_unique, &grouping_data_type, this](auto data_type_tag) {
+                                             &num_unique, &grouping_data_type, &groups_reservation, this](auto data_type_tag) {
                                                 using DataTypeTagType = decltype(data_type_tag);
                                                 using RawType = typename DataTypeTagType::raw_type;
                                                 constexpr auto data_type = DataTypeTagType::data_type;
@@ -396,17 +563,31 @@ Composite<EntityIds> AggregationClause::process(Composite<EntityIds>&& entity_id
                                                 row_to_group.reserve(col.column_->row_count());
                                                 auto input_data = col.column_->data();
                                                 auto hash_to_group = grouping_map.get<RawType>();
-                                                // For string grouping columns, keep a local map within this ProcessingUnit
-                                                // from offsets to groups, to avoid needless calls to col.string_at_offset and
-                                                // string_pool->get
-                                                // This could be slower in cases where there aren't many repeats in string
-                                                // grouping columns. Maybe track hit ratio of finds and stop using it if it is
-                                                // too low?
-                                                // Tested with 100,000,000 row dataframe with 100,000 unique values in the grouping column. Timings:
-                                                // 11.14 seconds without caching
-                                                // 11.01 seconds with caching
-                                                // Not worth worrying about right now
+                                                // For string grouping columns, map each offset in this ProcessingUnit's pool
+                                                // to the offset of the same string in the output pool. The distinct strings
+                                                // are interned in one batch up front, so the loop below only needs a lookup
+                                                // per row rather than a call to string_pool->get per new value.
                                                 robin_hood::unordered_flat_map<RawType, size_t> offset_to_group;
+                                                if constexpr(is_sequence_type(data_type)) {
+                                                    auto unique_offsets = unique_values_for_string_column(*col.column_);
+                                                    std::vector<RawType> input_offsets;
+                                                    std::vector<std::string_view> strings;
+                                                    input_offsets.reserve(unique_offsets.size());
+                                                    strings.reserve(unique_offsets.size());
+                                                    offset_to_group.reserve(unique_offsets.size());
+                                                    for (auto offset : unique_offsets) {
+                                                        if (auto str = col.string_at_offset(offset); str.has_value()) {
+                                                            input_offsets.emplace_back(offset);
+                                                            strings.emplace_back(*str);
+                                                        } else {
+                                                            offset_to_group.insert(robin_hood::pair<RawType, size_t>(offset, offset));
+                                                        }
+                                                    }
+                                                    std::vector<StringPool::offset_t> output_offsets(strings.size());
+                                                    string_pool->get_batch(strings.data(), strings.size(), output_offsets.data());
+                                                    for (size_t i = 0; i < input_offsets.size(); ++i)
+                                                        offset_to_group.insert(robin_hood::pair<RawType, size_t>(input_offsets[i], output_offsets[i]));
+                                                }
 
                                                 const bool is_sparse = col.column_->is_sparse();
                                                 using optional_iter_type = std::optional<decltype(input_data.bit_vector()->first())>;
@@ -427,19 +608,7 @@ Composite<EntityIds> AggregationClause::process(Composite<EntityIds>&& entity_id
                                                     for (size_t i = 0; i < row_count; ++i, ++ptr) {
                                                         RawType val;
                                                         if constexpr(is_sequence_type(data_type)) {
-                                                            auto offset = *ptr;
-                                                            if (auto it = offset_to_group.find(offset); it != offset_to_group.end()) {
-                                                                val = it->second;
-                                                            } else {
-                                                                std::optional<std::string_view> str = col.string_at_offset(offset);
-                                                                if (str.has_value()) {
-                                                                    val = string_pool->get(*str, true).offset();
-                                                                } else {
-                                                                    val = offset;
-                                                                }
-                                                                RawType val_copy(val);
-                                                                offset_to_group.insert(robin_hood::pair<RawType, size_t>(offset, val_copy));
-                                                            }
+                                                            val = offset_to_group.at(*ptr);
                                                         } else {
                                                             val = *ptr;
                                                         }
@@ -481,6 +650,12 @@ Composite<EntityIds> AggregationClause::process(Composite<EntityIds>&& entity_id
                                                     }
                                                     agg_data->aggregate(opt_input_column, row_to_group, num_unique);
                                                 }
+                                                if (groups_reservation) {
+                                                    size_t groups_bytes = grouping_map.bytes() + string_pool->size();
+                                                    for (const auto& agg_data: aggregators_data)
+                                                        groups_bytes += agg_data.bytes();
+                                                    groups_reservation->resize(groups_bytes);
+                                                }
                                             });
             } else {
                 util::raise_rte("Expected single column from expression");
@@ -622,18 +797,16 @@ void merge_impl(
             std::move(func), std::move(segmentation_policy), desc, std::nullopt
     };
 
-    stream::do_merge<IndexType, SegmentWrapper, AggregatorType, decltype(input_streams)>(
+    stream::do_merge<IndexType, RunWrapper, AggregatorType, decltype(input_streams)>(
         input_streams, agg, add_symbol_column);
 }
 
 // MergeClause receives a list of DataFrames as input and merge them into a single one where all 
 // the rows are sorted by time stamp
 Composite<EntityIds> MergeClause::process(Composite<EntityIds>&& entity_ids) const {
-    auto procs = gather_entities(component_manager_, std::move(entity_ids));
-
     auto compare =
-            [](const std::unique_ptr<SegmentWrapper> &left,
-               const std::unique_ptr<SegmentWrapper> &right) {
+            [](const std::unique_ptr<RunWrapper> &left,
+               const std::unique_ptr<RunWrapper> &right) {
                 const auto left_index = index::index_value_from_row(left->row(),
                                                                                IndexDescriptor::TIMESTAMP, 0);
                 const auto right_index = index::index_value_from_row(right->row(),
@@ -641,26 +814,51 @@ Composite<EntityIds> MergeClause::process(Composite<EntityIds>&& entity_ids) con
                 return left_index > right_index;
             };
 
-    movable_priority_queue<std::unique_ptr<SegmentWrapper>, std::vector<std::unique_ptr<SegmentWrapper>>, decltype(compare)> input_streams{
+    movable_priority_queue<std::unique_ptr<RunWrapper>, std::vector<std::unique_ptr<RunWrapper>>, decltype(compare)> input_streams{
             compare};
 
     size_t min_start_row = std::numeric_limits<size_t>::max();
     size_t max_end_row = 0;
     size_t min_start_col = std::numeric_limits<size_t>::max();
     size_t max_end_col = 0;
-    procs.broadcast([&input_streams, &min_start_row, &max_end_row, &min_start_col, &max_end_col](auto&& proc) {
-        for (auto&& [idx, segment]: folly::enumerate(proc.segments_.value())) {
-            size_t start_row = proc.row_ranges_->at(idx)->start();
-            min_start_row = start_row < min_start_row ? start_row : min_start_row;
-            size_t end_row = proc.row_ranges_->at(idx)->end();
-            max_end_row = end_row > max_end_row ? end_row : max_end_row;
-            size_t start_col = proc.col_ranges_->at(idx)->start();
-            min_start_col = start_col < min_start_col ? start_col : min_start_col;
-            size_t end_col = proc.col_ranges_->at(idx)->end();
-            max_end_col = end_col > max_end_col ? end_col : max_end_col;
-            input_streams.push(std::make_unique<SegmentWrapper>(std::move(*segment)));
+    auto add_run = [this, &input_streams, &min_start_row, &max_end_row, &min_start_col, &max_end_col](EntityIds&& run) {
+        // The ranges are known without fetching any segments
+        for (auto entity_id: run) {
+            const auto row_range = component_manager_->get<std::shared_ptr<RowRange>>(entity_id);
+            const auto col_range = component_manager_->get<std::shared_ptr<ColRange>>(entity_id);
+            min_start_row = std::min(min_start_row, row_range->start());
+            max_end_row = std::max(max_end_row, row_range->end());
+            min_start_col = std::min(min_start_col, col_range->start());
+            max_end_col = std::max(max_end_col, col_range->end());
         }
-    });
+        auto wrapper = std::make_unique<RunWrapper>(component_manager_, std::move(run));
+        if (wrapper->next_segment())
+            input_streams.push(std::move(wrapper));
+    };
+    // Each child composite produced by repartition holds the sorted segments, in order, of one of the processing units
+    // that were sorted and split. Where a child is not a chain of single segments, or the segments are passed in
+    // directly, each segment is a run of its own.
+    for (size_t idx = 0; idx < entity_ids.level_1_size(); ++idx) {
+        util::variant_match(entity_ids[idx],
+                            [&add_run](EntityIds& ids) {
+                                for (auto entity_id: ids)
+                                    add_run(EntityIds{entity_id});
+                            },
+                            [&add_run](std::unique_ptr<Composite<EntityIds>>& comp) {
+                                auto pieces = comp->as_range();
+                                if (std::all_of(pieces.begin(), pieces.end(), [](const EntityIds& ids) { return ids.size() == 1; })) {
+                                    EntityIds run;
+                                    for (const auto& ids: pieces)
+                                        run.emplace_back(ids.front());
+                                    add_run(std::move(run));
+                                } else {
+                                    for (const auto& ids: pieces) {
+                                        for (auto entity_id: ids)
+                                            add_run(EntityIds{entity_id});
+                                    }
+                                }
+                            });
+    }
     const RowRange row_range{min_start_row, max_end_row};
     const ColRange col_range{min_start_col, max_end_col};
     Composite<EntityIds> ret;
@@ -680,10 +878,11 @@ Composite<EntityIds> MergeClause::process(Composite<EntityIds>&& entity_ids) con
     return ret;
 }
 
+// Keeps the output of each processing unit as a child of its own, as MergeClause::process streams each as one run
 std::optional<std::vector<Composite<EntityIds>>> MergeClause::repartition(
         std::vector<Composite<EntityIds>> &&comps) const {
     std::vector<Composite<EntityIds>> v;
-    v.push_back(merge_composites_shallow(std::move(comps)));
+    v.push_back(merge_composites(std::move(comps)));
     return v;
 }
 
@@ -874,4 +1073,552 @@ std::string DateRangeClause::to_string() const {
     return fmt::format("DATE RANGE {} - {}", start_, end_);
 }
 
+Composite<EntityIds> AsOfJoinClause::process(Composite<EntityIds>&& entity_ids) const {
+    internal::check<ErrorCode::E_ASSERTION_FAILURE>(
+            static_cast<bool>(right_),
+            "As-of join with {} run before the right side was read", right_stream_id_);
+    auto procs = gather_entities(component_manager_, std::move(entity_ids));
+    Composite<EntityIds> output;
+    procs.broadcast([&output, this](auto&& proc) {
+        right_->join(proc, tolerance_);
+        output.push_back(push_entities(component_manager_, std::move(proc)));
+    });
+    return output;
+}
+
+std::string AsOfJoinClause::to_string() const {
+    return fmt::format("ASOF JOIN {}{}", right_stream_id_, by_.has_value() ? fmt::format(" BY {}", *by_) : "");
+}
+
+RollingClause::RollingClause(
+        std::optional<uint64_t> rows,
+        std::optional<timestamp> span,
+        std::optional<uint64_t> min_periods,
+        std::vector<std::tuple<std::string, std::string, std::string>> aggregations) :
+        aggregations_(std::move(aggregations)) {
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+            rows.has_value() != span.has_value(),
+            "Rolling window must be given as either a number of rows or a time span");
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(!rows.has_value() || *rows > 0, "Rolling window must be at least one row");
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(!span.has_value() || *span > 0, "Rolling window span must be positive");
+    window_.rows_ = rows;
+    window_.span_ = span;
+    // As in pandas, windows of rows default to needing all of their rows, and windows given as a span to needing one
+    window_.min_periods_ = min_periods.value_or(rows.value_or(1));
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+            !rows.has_value() || window_.min_periods_ <= *rows,
+            "Rolling min_periods {} must not be more than the window of {} rows", window_.min_periods_, rows.value_or(0));
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(!aggregations_.empty(), "Rolling requires at least one aggregation");
+
+    clause_info_.requires_repartition_ = true;
+    clause_info_.modifies_output_descriptor_ = true;
+    clause_info_.input_columns_ = std::make_optional<std::unordered_set<std::string>>();
+    std::unordered_set<std::string> output_columns;
+    for (const auto& [output_column, input_column, aggregation_operator]: aggregations_) {
+        clause_info_.input_columns_->insert(input_column);
+        user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+                output_columns.insert(output_column).second,
+                "Cannot output two rolling aggregations to the same column: {}", output_column);
+        auto typed_input_column = ColumnName(input_column);
+        auto typed_output_column = ColumnName(output_column);
+        if (aggregation_operator == "sum") {
+            aggregators_.emplace_back(RollingSumAggregator(typed_input_column, typed_output_column));
+        } else if (aggregation_operator == "mean") {
+            aggregators_.emplace_back(RollingMeanAggregator(typed_input_column, typed_output_column));
+        } else if (aggregation_operator == "max") {
+            aggregators_.emplace_back(RollingMaxAggregator(typed_input_column, typed_output_column));
+        } else if (aggregation_operator == "min") {
+            aggregators_.emplace_back(RollingMinAggregator(typed_input_column, typed_output_column));
+        } else if (aggregation_operator == "count") {
+            aggregators_.emplace_back(RollingCountAggregator(typed_input_column, typed_output_column));
+        } else {
+            user_input::raise<ErrorCode::E_INVALID_USER_ARGUMENT>("Unknown rolling aggregation operator provided: {}", aggregation_operator);
+        }
+    }
+}
+
+namespace {
+
+std::optional<ColumnWithStrings> rolling_input_column(ProcessingUnit& proc, const ColumnName& name, bool dynamic_schema) {
+    auto variant_data = proc.get(name);
+    if (std::holds_alternative<ColumnWithStrings>(variant_data))
+        return std::get<ColumnWithStrings>(variant_data);
+
+    // With dynamic schema the column may be missing from some row slices, which then only hold NaN for it
+    schema::check<ErrorCode::E_COLUMN_DOESNT_EXIST>(dynamic_schema, "Rolling aggregation input column '{}' does not exist", name);
+    return std::nullopt;
+}
+
+std::vector<double> rolling_values(const std::optional<ColumnWithStrings>& input_column, size_t rows) {
+    std::vector<double> values(rows, std::numeric_limits<double>::quiet_NaN());
+    if (!input_column.has_value())
+        return values;
+
+    const auto& column = *input_column->column_;
+    column.type().visit_tag([&column, &values] (auto type_desc_tag) {
+        using TypeDescriptorTag = decltype(type_desc_tag);
+        using RawType = typename TypeDescriptorTag::DataTypeTag::raw_type;
+        constexpr auto data_type = TypeDescriptorTag::DataTypeTag::data_type;
+        if constexpr (is_numeric_type(data_type) || is_bool_type(data_type)) {
+            auto col_data = column.data();
+            auto copy = [&col_data, &values](auto iter) {
+                while (auto block = col_data.next<TypeDescriptorTag>()) {
+                    auto ptr = reinterpret_cast<const RawType *>(block.value().data());
+                    for (auto i = 0u; i < block.value().row_count(); ++i, ++ptr, ++iter) {
+                        if constexpr (std::is_same_v<decltype(iter), size_t>)
+                            values[iter] = static_cast<double>(*ptr);
+                        else
+                            values[*iter] = static_cast<double>(*ptr);
+                    }
+                }
+            };
+            if (column.is_sparse())
+                copy(col_data.bit_vector()->first());
+            else
+                copy(size_t(0));
+        } else if constexpr (!is_empty_type(data_type)) {
+            schema::raise<ErrorCode::E_UNSUPPORTED_COLUMN_TYPE>("Rolling aggregations are not supported on {} columns", column.type());
+        }
+    });
+    return values;
+}
+
+double rolling_value_at(const std::optional<ColumnWithStrings>& input_column, size_t row) {
+    auto res = std::numeric_limits<double>::quiet_NaN();
+    if (!input_column.has_value())
+        return res;
+
+    const auto& column = *input_column->column_;
+    details::visit_type(column.type().data_type(), [&column, &res, row] (auto type_desc_tag) {
+        using TagType = std::decay_t<decltype(type_desc_tag)>;
+        if constexpr (is_numeric_type(TagType::data_type) || is_bool_type(TagType::data_type)) {
+            if (auto value = column.scalar_at<typename TagType::raw_type>(static_cast<position_t>(row)); value.has_value())
+                res = static_cast<double>(*value);
+        }
+    });
+    return res;
+}
+
+timestamp rolling_index_at(const ProcessingUnit& proc, size_t row) {
+    return proc.segments_->front()->column(0).scalar_at<timestamp>(static_cast<position_t>(row)).value();
+}
+
+size_t rolling_row_count(const ProcessingUnit& proc) {
+    return proc.segments_->front()->row_count();
+}
+
+} // namespace
+
+Composite<EntityIds> RollingClause::process(Composite<EntityIds>&& entity_ids) const {
+    auto procs = gather_entities(component_manager_, std::move(entity_ids));
+    Composite<EntityIds> output;
+    procs.broadcast([&output, this](auto&& proc) {
+        const auto rows = rolling_row_count(proc);
+        std::vector<timestamp> index;
+        if (window_.span_.has_value()) {
+            schema::check<ErrorCode::E_UNSUPPORTED_INDEX_TYPE>(
+                    proc.segments_->front()->descriptor().index().type() == IndexDescriptor::TIMESTAMP,
+                    "Rolling windows given as a time span require a timestamp index");
+            index.reserve(rows);
+            for (size_t row = 0; row < rows; ++row) {
+                index.emplace_back(rolling_index_at(proc, row));
+                sorting::check<ErrorCode::E_UNSORTED_DATA>(
+                        row == 0 || index[row - 1] <= index[row],
+                        "Rolling windows given as a time span require the index to be sorted");
+            }
+        }
+
+        auto& target = *proc.segments_->back();
+        for (const auto& aggregator: aggregators_) {
+            const auto output_column_name = aggregator.get_output_column_name();
+            for (const auto& segment: *proc.segments_) {
+                segment->init_column_map();
+                user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+                        !segment->column_index(output_column_name.value).has_value(),
+                        "Rolling aggregation output column '{}' already exists", output_column_name);
+            }
+            const auto values = rolling_values(
+                    rolling_input_column(proc, aggregator.get_input_column_name(), processing_config_.dynamic_schema_),
+                    rows);
+            auto column = std::make_shared<Column>(make_scalar_type(DataType::FLOAT64), rows, true, false);
+            if (rows > 0) {
+                aggregator.get_aggregator_data().roll(window_, RollingInput{index, values, 0}, reinterpret_cast<double*>(column->ptr()));
+                column->set_row_data(rows - 1);
+            }
+            target.add_column(scalar_field(DataType::FLOAT64, output_column_name.value), column);
+            ++proc.col_ranges_->back()->second;
+        }
+        output.push_back(push_entities(component_manager_, std::move(proc)));
+    });
+    return output;
+}
+
+std::optional<std::vector<Composite<EntityIds>>> RollingClause::repartition(
+        std::vector<Composite<EntityIds>>&& entity_ids) const {
+    std::vector<ProcessingUnit> procs;
+    for (auto&& comp: entity_ids) {
+        for (auto&& proc: gather_entities(component_manager_, std::move(comp)).as_range())
+            procs.emplace_back(std::move(proc));
+    }
+    std::sort(procs.begin(), procs.end(), [](const ProcessingUnit& left, const ProcessingUnit& right) {
+        return left.row_ranges_->front()->first < right.row_ranges_->front()->first;
+    });
+
+    // The rows of each processing unit whose windows reach back into the ones before it are rolled again, over the
+    // rows before them that are still in their windows
+    for (size_t proc_idx = 1; proc_idx < procs.size(); ++proc_idx) {
+        auto& proc = procs[proc_idx];
+        const auto rows = rolling_row_count(proc);
+        auto previous_idx = proc_idx;
+        while (previous_idx > 0 && rolling_row_count(procs[previous_idx - 1]) == 0)
+            --previous_idx;
+        if (rows == 0 || previous_idx == 0)
+            continue;
+
+        const auto& previous = procs[previous_idx - 1];
+        size_t head_rows;
+        if (window_.rows_.has_value()) {
+            head_rows = std::min(rows, *window_.rows_ - 1);
+        } else {
+            const auto previous_last = rolling_index_at(previous, rolling_row_count(previous) - 1);
+            sorting::check<ErrorCode::E_UNSORTED_DATA>(
+                    previous_last <= rolling_index_at(proc, 0),
+                    "Rolling windows given as a time span require the index to be sorted");
+            head_rows = 0;
+            while (head_rows < rows && previous_last > rolling_index_at(proc, head_rows) - *window_.span_)
+                ++head_rows;
+        }
+        if (head_rows == 0)
+            continue;
+
+        // Walk back from the end of the preceding processing units for the rows in the first row's window
+        std::vector<std::pair<size_t, size_t>> tail;
+        const auto first_index = window_.span_.has_value() ? rolling_index_at(proc, 0) : timestamp{0};
+        for (auto tail_proc_idx = proc_idx; tail_proc_idx > 0; --tail_proc_idx) {
+            const auto& tail_proc = procs[tail_proc_idx - 1];
+            bool window_filled = false;
+            for (auto row = rolling_row_count(tail_proc); row > 0; --row) {
+                window_filled = window_.rows_.has_value() ?
+                                tail.size() + 1 >= *window_.rows_ :
+                                rolling_index_at(tail_proc, row - 1) <= first_index - *window_.span_;
+                if (window_filled)
+                    break;
+                tail.emplace_back(tail_proc_idx - 1, row - 1);
+            }
+            if (window_filled)
+                break;
+        }
+        std::reverse(tail.begin(), tail.end());
+
+        std::vector<timestamp> index;
+        if (window_.span_.has_value()) {
+            index.reserve(tail.size() + head_rows);
+            for (const auto& [tail_proc_idx, row]: tail)
+                index.emplace_back(rolling_index_at(procs[tail_proc_idx], row));
+            for (size_t row = 0; row < head_rows; ++row)
+                index.emplace_back(rolling_index_at(proc, row));
+        }
+        auto& target = *proc.segments_->back();
+        for (const auto& aggregator: aggregators_) {
+            std::vector<double> values;
+            values.reserve(tail.size() + head_rows);
+            std::optional<ColumnWithStrings> input_column;
+            std::optional<size_t> input_proc_idx;
+            auto add_value = [&](size_t value_proc_idx, size_t row) {
+                if (input_proc_idx != value_proc_idx) {
+                    input_column.reset();
+                    if (auto column = rolling_input_column(procs[value_proc_idx], aggregator.get_input_column_name(), processing_config_.dynamic_schema_))
+                        input_column.emplace(*column);
+                    input_proc_idx = value_proc_idx;
+                }
+                values.emplace_back(rolling_value_at(input_column, row));
+            };
+            for (const auto& [tail_proc_idx, row]: tail)
+                add_value(tail_proc_idx, row);
+            for (size_t row = 0; row < head_rows; ++row)
+                add_value(proc_idx, row);
+
+            auto& column = target.column(static_cast<position_t>(*target.column_index(aggregator.get_output_column_name().value)));
+            aggregator.get_aggregator_data().roll(window_, RollingInput{index, values, tail.size()}, reinterpret_cast<double*>(column.ptr()));
+        }
+    }
+
+    std::vector<Composite<EntityIds>> res;
+    res.reserve(procs.size());
+    for (auto&& proc: procs)
+        res.emplace_back(Composite<EntityIds>(push_entities(component_manager_, std::move(proc))));
+    return res;
+}
+
+std::string RollingClause::to_string() const {
+    std::vector<std::string> aggregations;
+    for (const auto& [output_column, input_column, aggregation_operator]: aggregations_)
+        aggregations.emplace_back(fmt::format("{}={}({})", output_column, aggregation_operator, input_column));
+    return fmt::format(
+            "ROLLING {} {}",
+            window_.rows_.has_value() ? fmt::format("{} ROWS", *window_.rows_) : fmt::format("{}ns", *window_.span_),
+            aggregations);
+}
+
+TopKClause::TopKClause(std::string column, uint64_t k, bool largest, std::optional<std::string> by) :
+        column_(std::move(column)),
+        k_(k),
+        largest_(largest),
+        by_(std::move(by)) {
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(k_ > 0, "Top k requires k to be positive");
+    clause_info_.requires_repartition_ = true;
+    clause_info_.input_columns_ = std::make_optional<std::unordered_set<std::string>>({column_});
+    if (by_.has_value())
+        clause_info_.input_columns_->insert(*by_);
+}
+
+namespace {
+
+// The group of each row, numbered in order of first appearance, or std::nullopt for rows without one. Groups are keyed
+// by value, as when aggregating, so that distinct values never share a group.
+std::vector<std::optional<size_t>> top_k_groups(const ColumnWithStrings& group_column) {
+    schema::check<ErrorCode::E_UNSUPPORTED_COLUMN_TYPE>(!group_column.column_->is_sparse(), "Top k by group not supported with sparse columns");
+    std::vector<std::optional<size_t>> row_to_group(group_column.column_->row_count());
+    group_column.column_->type().visit_tag([&group_column, &row_to_group] (auto type_desc_tag) {
+        using TypeDescriptorTag = decltype(type_desc_tag);
+        using RawType = typename TypeDescriptorTag::DataTypeTag::raw_type;
+        constexpr auto data_type = TypeDescriptorTag::DataTypeTag::data_type;
+        if constexpr (!is_empty_type(data_type)) {
+            using Key = std::conditional_t<is_sequence_type(data_type), std::string_view, RawType>;
+            robin_hood::unordered_flat_map<Key, size_t> value_to_group;
+            auto col_data = group_column.column_->data();
+            size_t row = 0;
+            while (auto block = col_data.next<TypeDescriptorTag>()) {
+                auto ptr = reinterpret_cast<const RawType*>(block->data());
+                for (auto i = 0u; i < block->row_count(); ++i, ++ptr, ++row) {
+                    Key key;
+                    if constexpr (is_sequence_type(data_type)) {
+                        auto str = group_column.string_at_offset(*ptr);
+                        if (!str.has_value())
+                            continue;
+                        key = *str;
+                    } else if constexpr (is_floating_point_type(data_type)) {
+                        if (std::isnan(*ptr))
+                            continue;
+                        // So that -0.0 and 0.0 are one group
+                        key = *ptr == 0 ? RawType{0} : *ptr;
+                    } else {
+                        key = *ptr;
+                    }
+                    if (auto it = value_to_group.find(key); it != value_to_group.end()) {
+                        row_to_group[row] = it->second;
+                    } else {
+                        const auto group = value_to_group.size();
+                        value_to_group.insert(robin_hood::pair<Key, size_t>(key, group));
+                        row_to_group[row] = group;
+                    }
+                }
+            }
+        }
+    });
+    return row_to_group;
+}
+
+/*
+ * The rows holding the top k values of the column, best first, per group if row_to_group is given. Each group keeps a
+ * heap of its best k rows so far with the worst of them at the front, so most rows are rejected with one comparison.
+ * Of two equal values the earlier row is preferred.
+ */
+std::vector<size_t> top_k_rows(const Column& column, size_t k, bool largest, const std::optional<std::vector<std::optional<size_t>>>& row_to_group) {
+    std::vector<size_t> res;
+    column.type().visit_tag([&] (auto type_desc_tag) {
+        using TypeDescriptorTag = decltype(type_desc_tag);
+        using RawType = typename TypeDescriptorTag::DataTypeTag::raw_type;
+        constexpr auto data_type = TypeDescriptorTag::DataTypeTag::data_type;
+        if constexpr (is_numeric_type(data_type) || is_bool_type(data_type)) {
+            using Entry = std::pair<RawType, size_t>;
+            auto better = [largest](const Entry& left, const Entry& right) {
+                if (left.first != right.first)
+                    return largest ? left.first > right.first : left.first < right.first;
+                return left.second < right.second;
+            };
+            robin_hood::unordered_flat_map<size_t, std::vector<Entry>> heaps;
+            auto offer = [&](size_t row, RawType value) {
+                if constexpr (is_floating_point_type(data_type)) {
+                    if (std::isnan(value))
+                        return;
+                }
+                size_t group = 0;
+                if (row_to_group.has_value()) {
+                    const auto& row_group = (*row_to_group)[row];
+                    if (!row_group.has_value())
+                        return;
+                    group = *row_group;
+                }
+                auto& heap = heaps[group];
+                Entry entry{value, row};
+                if (heap.size() < k) {
+                    heap.emplace_back(entry);
+                    std::push_heap(heap.begin(), heap.end(), better);
+                } else if (better(entry, heap.front())) {
+                    std::pop_heap(heap.begin(), heap.end(), better);
+                    heap.back() = entry;
+                    std::push_heap(heap.begin(), heap.end(), better);
+                }
+            };
+
+            auto col_data = column.data();
+            auto visit_rows = [&col_data, &offer](auto iter) {
+                while (auto block = col_data.next<TypeDescriptorTag>()) {
+                    auto ptr = reinterpret_cast<const RawType *>(block.value().data());
+                    for (auto i = 0u; i < block.value().row_count(); ++i, ++ptr, ++iter) {
+                        if constexpr (std::is_same_v<decltype(iter), size_t>)
+                            offer(iter, *ptr);
+                        else
+                            offer(*iter, *ptr);
+                    }
+                }
+            };
+            if (column.is_sparse())
+                visit_rows(col_data.bit_vector()->first());
+            else
+                visit_rows(size_t(0));
+
+            std::vector<Entry> selected;
+            for (auto& [_, heap]: heaps)
+                selected.insert(selected.end(), heap.begin(), heap.end());
+            std::sort(selected.begin(), selected.end(), better);
+            res.reserve(selected.size());
+            for (const auto& entry: selected)
+                res.emplace_back(entry.second);
+        } else if constexpr (!is_empty_type(data_type)) {
+            schema::raise<ErrorCode::E_UNSUPPORTED_COLUMN_TYPE>("Top k is not supported on {} columns", column.type());
+        }
+    });
+    return res;
+}
+
+} // namespace
+
+Composite<EntityIds> TopKClause::process(Composite<EntityIds>&& entity_ids) const {
+    auto procs = gather_entities(component_manager_, std::move(entity_ids));
+    Composite<EntityIds> output;
+    procs.broadcast([&output, this](auto&& proc) {
+        auto column = proc.get(ColumnName(column_));
+        if (!std::holds_alternative<ColumnWithStrings>(column)) {
+            schema::check<ErrorCode::E_COLUMN_DOESNT_EXIST>(
+                    processing_config_.dynamic_schema_,
+                    "Top k column '{}' does not exist", column_);
+            return;
+        }
+        std::optional<std::vector<std::optional<size_t>>> row_to_group;
+        if (by_.has_value()) {
+            auto group_column = proc.get(ColumnName(*by_));
+            if (!std::holds_alternative<ColumnWithStrings>(group_column)) {
+                schema::check<ErrorCode::E_COLUMN_DOESNT_EXIST>(
+                        processing_config_.dynamic_schema_,
+                        "Top k group column '{}' does not exist", *by_);
+                return;
+            }
+            row_to_group = top_k_groups(std::get<ColumnWithStrings>(group_column));
+        }
+
+        const auto rows = top_k_rows(*std::get<ColumnWithStrings>(column).column_, k_, largest_, row_to_group);
+        if (rows.empty())
+            return;
+
+        const auto row_count = proc.segments_->front()->row_count();
+        if (rows.size() < row_count) {
+            util::BitSet bitset(static_cast<util::BitSetSizeType>(row_count));
+            for (auto row: rows)
+                bitset.set_bit(static_cast<util::BitSetSizeType>(row));
+            // Only k rows per group are left, so dropping the strings they do not use is cheap and bounds memory
+            proc.apply_filter(bitset, PipelineOptimisation::MEMORY);
+        }
+        output.push_back(push_entities(component_manager_, std::move(proc)));
+    });
+    return output;
+}
+
+std::optional<std::vector<Composite<EntityIds>>> TopKClause::repartition(
+        std::vector<Composite<EntityIds>>&& entity_ids) const {
+    std::vector<ProcessingUnit> procs;
+    for (auto&& comp: entity_ids) {
+        for (auto&& proc: gather_entities(component_manager_, std::move(comp)).as_range())
+            procs.emplace_back(std::move(proc));
+    }
+    // Keep the rows in their original order, so that ties are still broken in favour of the earlier row
+    std::sort(procs.begin(), procs.end(), [](const ProcessingUnit& left, const ProcessingUnit& right) {
+        return left.row_ranges_->front()->first < right.row_ranges_->front()->first;
+    });
+
+    std::vector<SegmentInMemory> row_slices;
+    size_t min_start_col = std::numeric_limits<size_t>::max();
+    size_t max_end_col = 0;
+    for (auto& proc: procs) {
+        std::optional<SegmentInMemory> row_slice;
+        for (auto&& [idx, segment]: folly::enumerate(*proc.segments_)) {
+            min_start_col = std::min(min_start_col, proc.col_ranges_->at(idx)->start());
+            max_end_col = std::max(max_end_col, proc.col_ranges_->at(idx)->end());
+            if (row_slice.has_value()) {
+                merge_string_columns(**segment, row_slice->string_pool_ptr(), false);
+                row_slice->concatenate(std::move(**segment), true);
+            } else {
+                row_slice = std::make_optional<SegmentInMemory>(std::move(**segment));
+            }
+        }
+        if (row_slice.has_value() && row_slice->row_count() > 0)
+            row_slices.emplace_back(std::move(*row_slice));
+    }
+
+    std::vector<Composite<EntityIds>> res;
+    if (row_slices.empty()) {
+        res.emplace_back();
+        return res;
+    }
+
+    auto merged = std::move(row_slices.front());
+    row_slices.erase(row_slices.begin());
+    merge_segments(row_slices, merged, false);
+    merged.init_column_map();
+
+    std::optional<std::vector<std::optional<size_t>>> row_to_group;
+    if (by_.has_value()) {
+        auto position = merged.column_index(*by_);
+        internal::check<ErrorCode::E_ASSERTION_FAILURE>(position.has_value(), "Top k group column '{}' missing after merge", *by_);
+        row_to_group = top_k_groups(ColumnWithStrings(merged.column_ptr(static_cast<position_t>(*position)), merged.string_pool_ptr()));
+    }
+    auto position = merged.column_index(column_);
+    internal::check<ErrorCode::E_ASSERTION_FAILURE>(position.has_value(), "Top k column '{}' missing after merge", column_);
+    const auto order = top_k_rows(merged.column(static_cast<position_t>(*position)), k_, largest_, row_to_group);
+
+    // Filter down to the chosen rows, which keeps them in their original order, then move them into the chosen order
+    auto selected = order;
+    std::sort(selected.begin(), selected.end());
+    util::BitSet bitset(static_cast<util::BitSetSizeType>(merged.row_count()));
+    for (auto row: selected)
+        bitset.set_bit(static_cast<util::BitSetSizeType>(row));
+    auto output = merged.filter(bitset, true);
+
+    JiveTable jive_table(order.size());
+    for (size_t idx = 0; idx < order.size(); ++idx) {
+        const auto filtered_row = static_cast<uint32_t>(std::lower_bound(selected.begin(), selected.end(), order[idx]) - selected.begin());
+        jive_table.orig_pos_[idx] = filtered_row;
+        jive_table.sorted_pos_[filtered_row] = static_cast<uint32_t>(idx);
+    }
+    for (size_t idx = 0; idx < order.size(); ++idx) {
+        if (jive_table.sorted_pos_[idx] != idx) {
+            jive_table.unsorted_rows_.set(bv_size(idx), true);
+            ++jive_table.num_unsorted_;
+        }
+    }
+    if (jive_table.num_unsorted_ > 0) {
+        for (size_t field_col = 0; field_col < output.descriptor().field_count(); ++field_col)
+            output.column(static_cast<position_t>(field_col)).sort_external(jive_table);
+    }
+
+    const auto rows = output.row_count();
+    res.emplace_back(push_entities(component_manager_, ProcessingUnit(std::move(output), RowRange{0, rows}, ColRange{min_start_col, max_end_col})));
+    return res;
+}
+
+std::string TopKClause::to_string() const {
+    return fmt::format("TOP {} {} {}{}", k_, largest_ ? "LARGEST" : "SMALLEST", column_, by_.has_value() ? fmt::format(" BY {}", *by_) : "");
+}
+
 }
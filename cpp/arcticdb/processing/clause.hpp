@@ -17,6 +17,7 @@
 #include <arcticdb/processing/aggregation.hpp>
 #include <arcticdb/processing/aggregation_interface.hpp>
 #include <arcticdb/processing/processing_unit.hpp>
+#include <arcticdb/processing/as_of_join.hpp>
 #include <arcticdb/processing/grouper.hpp>
 #include <arcticdb/stream/aggregator.hpp>
 #include <arcticdb/util/movable_priority_queue.hpp>
@@ -30,6 +31,7 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <tuple>
 #include <variant>
 #include <memory>
 #include <atomic>
@@ -96,6 +98,8 @@ struct IClause {
         void set_component_manager(std::shared_ptr<ComponentManager> component_manager) {
             folly::poly_call<5>(*this, component_manager);
         }
+
+        [[nodiscard]] std::string to_string() const { return folly::poly_call<6>(*this); }
     };
 
     template<class T>
@@ -105,7 +109,8 @@ struct IClause {
             &T::repartition,
             &T::clause_info,
             &T::set_processing_config,
-            &T::set_component_manager>;
+            &T::set_component_manager,
+            &T::to_string>;
 };
 
 using Clause = folly::Poly<IClause>;
@@ -148,6 +153,10 @@ struct PassthroughClause {
     void set_processing_config(ARCTICDB_UNUSED const ProcessingConfig&) {}
 
     void set_component_manager(ARCTICDB_UNUSED std::shared_ptr<ComponentManager>) {}
+
+    [[nodiscard]] std::string to_string() const {
+        return "PASSTHROUGH";
+    }
 };
 
 struct FilterClause {
@@ -288,40 +297,35 @@ struct PartitionClause {
         return output;
     }
 
+    /*
+     * Regroups the entity IDs by the bucket they were partitioned into, without fetching their segments, so that any
+     * spilled to disk under a memory budget stay there until the aggregation of their bucket reads them back.
+     */
     [[nodiscard]] std::optional<std::vector<Composite<EntityIds>>> repartition(
             std::vector<Composite<EntityIds>>&& entity_ids) const {
-        std::vector<Composite<ProcessingUnit>> input_procs;
-        input_procs.reserve(entity_ids.size());
-        for (auto&& comp: entity_ids) {
-            input_procs.emplace_back(gather_entities(component_manager_, std::move(comp), false, true));
-        }
-        std::unordered_map<size_t, Composite<ProcessingUnit>> partition_map;
         schema::check<ErrorCode::E_COLUMN_DOESNT_EXIST>(
-                std::any_of(input_procs.begin(), input_procs.end(), [](const Composite<ProcessingUnit>& proc) {
-                    return !proc.empty();
+                std::any_of(entity_ids.begin(), entity_ids.end(), [](const Composite<EntityIds>& comp) {
+                    return !comp.empty();
                 }),
                 "Grouping column {} does not exist or is empty", grouping_column_
         );
 
-        for (auto &comp : input_procs) {
-            comp.broadcast([&partition_map](auto &proc) {
-                internal::check<ErrorCode::E_ASSERTION_FAILURE>(proc.bucket_.has_value(),
-                                                                "PartitionClause::repartition failed, all processing units must have a bucket ID");
+        std::unordered_map<bucket_id, Composite<EntityIds>> partition_map;
+        for (auto &comp : entity_ids) {
+            comp.broadcast([&partition_map, this](auto &ids) {
+                if (ids.empty())
+                    return;
 
-                if (partition_map.find(*proc.bucket_) == partition_map.end()) {
-                    partition_map[*proc.bucket_] = Composite<ProcessingUnit>(std::move(proc));
-                } else {
-                    partition_map[*proc.bucket_].push_back(std::move(proc));
-                }
+                // Each processing unit produced by partitioning lies within one bucket
+                const auto bucket = component_manager_->get<bucket_id>(ids.front());
+                partition_map[bucket].push_back(std::move(ids));
             });
         }
 
         std::vector<Composite<EntityIds>> ret;
         ret.reserve(partition_map.size());
         for (auto&& [_, comp] : partition_map) {
-            ret.emplace_back(comp.transform([this](auto&& proc) {
-                return push_entities(component_manager_, std::move(proc));
-            }));
+            ret.emplace_back(std::move(comp));
         }
 
         return ret;
@@ -376,6 +380,20 @@ struct AggregationClause {
 
     [[nodiscard]] Composite<EntityIds> process(Composite<EntityIds>&& entity_ids) const;
 
+    /*
+     * A bucket too large for the memory budget is split into sub-buckets by the hash of the grouping column, as in a
+     * grace hash join, and each is aggregated on its own. Sub-buckets still too large are split again, up to
+     * max_bucket_splits times.
+     */
+    static constexpr size_t max_bucket_splits = 3;
+
+    [[nodiscard]] Composite<EntityIds> aggregate_within_budget(
+            Composite<EntityIds>&& entity_ids,
+            size_t hash_divisor,
+            size_t splits) const;
+
+    [[nodiscard]] Composite<EntityIds> aggregate(Composite<EntityIds>&& entity_ids) const;
+
     [[nodiscard]] std::optional<std::vector<Composite<EntityIds>>> repartition(
             ARCTICDB_UNUSED std::vector<Composite<EntityIds>>&&
             ) const {
@@ -430,6 +448,10 @@ struct RemoveColumnPartitioningClause {
     void set_component_manager(std::shared_ptr<ComponentManager> component_manager) {
         component_manager_ = component_manager;
     }
+
+    [[nodiscard]] std::string to_string() const {
+        return "REMOVE COLUMN PARTITIONING";
+    }
 };
 
 struct SplitClause {
@@ -463,6 +485,10 @@ struct SplitClause {
     void set_component_manager(std::shared_ptr<ComponentManager> component_manager) {
         component_manager_ = component_manager;
     }
+
+    [[nodiscard]] std::string to_string() const {
+        return fmt::format("SPLIT rows={}", rows_);
+    }
 };
 
 struct SortClause {
@@ -496,6 +522,10 @@ struct SortClause {
     void set_component_manager(std::shared_ptr<ComponentManager> component_manager) {
         component_manager_ = component_manager;
     }
+
+    [[nodiscard]] std::string to_string() const {
+        return fmt::format("SORT Column[\"{}\"]", column_);
+    }
 };
 
 struct MergeClause {
@@ -541,6 +571,10 @@ struct MergeClause {
     void set_component_manager(std::shared_ptr<ComponentManager> component_manager) {
         component_manager_ = component_manager;
     }
+
+    [[nodiscard]] std::string to_string() const {
+        return "MERGE";
+    }
 };
 
 struct ColumnStatsGenerationClause {
@@ -585,6 +619,10 @@ struct ColumnStatsGenerationClause {
     void set_component_manager(std::shared_ptr<ComponentManager> component_manager) {
         component_manager_ = component_manager;
     }
+
+    [[nodiscard]] std::string to_string() const {
+        return "COLUMN STATS GENERATION";
+    }
 };
 
 // Used by head and tail to discard rows not requested by the user
@@ -703,4 +741,167 @@ struct DateRangeClause {
     [[nodiscard]] std::string to_string() const;
 };
 
+/*
+ * Adds the columns of another symbol to each row, taken from its last row at or before the row's index. The other
+ * symbol is read in full by the version store and handed over with set_right before processing starts.
+ */
+struct AsOfJoinClause {
+    ClauseInfo clause_info_;
+    std::shared_ptr<ComponentManager> component_manager_;
+    StreamId right_stream_id_;
+    // Latest if not given
+    std::optional<SignedVersionId> right_version_;
+    std::optional<timestamp> tolerance_;
+    std::optional<std::string> by_;
+    std::shared_ptr<const AsOfJoinRight> right_;
+
+    AsOfJoinClause(
+            StreamId right_stream_id,
+            std::optional<SignedVersionId> right_version,
+            std::optional<timestamp> tolerance,
+            std::optional<std::string> by) :
+            right_stream_id_(std::move(right_stream_id)),
+            right_version_(right_version),
+            tolerance_(tolerance),
+            by_(std::move(by)) {
+        user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+                !tolerance_.has_value() || *tolerance_ >= 0,
+                "As-of join tolerance must not be negative");
+        if (by_.has_value())
+            clause_info_.input_columns_ = std::make_optional<std::unordered_set<std::string>>({*by_});
+        clause_info_.modifies_output_descriptor_ = true;
+    }
+
+    AsOfJoinClause() = delete;
+
+    ARCTICDB_MOVE_COPY_DEFAULT(AsOfJoinClause)
+
+    [[nodiscard]] std::vector<std::vector<size_t>> structure_for_processing(
+            std::vector<RangesAndKey>& ranges_and_keys,
+            size_t start_from) const {
+        return structure_by_row_slice(ranges_and_keys, start_from);
+    }
+
+    [[nodiscard]] Composite<EntityIds> process(Composite<EntityIds>&& entity_ids) const;
+
+    [[nodiscard]] std::optional<std::vector<Composite<EntityIds>>> repartition(
+            ARCTICDB_UNUSED std::vector<Composite<EntityIds>>&&) const {
+        return std::nullopt;
+    }
+
+    [[nodiscard]] const ClauseInfo& clause_info() const {
+        return clause_info_;
+    }
+
+    void set_processing_config(ARCTICDB_UNUSED const ProcessingConfig& processing_config) {
+    }
+
+    void set_component_manager(std::shared_ptr<ComponentManager> component_manager) {
+        component_manager_ = component_manager;
+    }
+
+    void set_right(std::shared_ptr<const AsOfJoinRight> right) {
+        right_ = std::move(right);
+    }
+
+    [[nodiscard]] std::string to_string() const;
+};
+
+/*
+ * Adds a column per aggregator holding a rolling window aggregate of its input column. Each row slice is first rolled
+ * on its own, in parallel. The first rows of a row slice have windows reaching back into the slices before it, so
+ * repartition then rolls those rows again, seeded with just the tail of the preceding slices.
+ */
+struct RollingClause {
+    ClauseInfo clause_info_;
+    std::shared_ptr<ComponentManager> component_manager_;
+    ProcessingConfig processing_config_;
+    RollingWindow window_;
+    // Output column, input column and operator of each aggregation, in the order the columns are added
+    std::vector<std::tuple<std::string, std::string, std::string>> aggregations_;
+    std::vector<RollingAggregator> aggregators_;
+
+    RollingClause(
+            std::optional<uint64_t> rows,
+            std::optional<timestamp> span,
+            std::optional<uint64_t> min_periods,
+            std::vector<std::tuple<std::string, std::string, std::string>> aggregations);
+
+    RollingClause() = delete;
+
+    ARCTICDB_MOVE_COPY_DEFAULT(RollingClause)
+
+    [[nodiscard]] std::vector<std::vector<size_t>> structure_for_processing(
+            std::vector<RangesAndKey>& ranges_and_keys,
+            size_t start_from) const {
+        return structure_by_row_slice(ranges_and_keys, start_from);
+    }
+
+    [[nodiscard]] Composite<EntityIds> process(Composite<EntityIds>&& entity_ids) const;
+
+    [[nodiscard]] std::optional<std::vector<Composite<EntityIds>>> repartition(
+            std::vector<Composite<EntityIds>>&& entity_ids) const;
+
+    [[nodiscard]] const ClauseInfo& clause_info() const {
+        return clause_info_;
+    }
+
+    void set_processing_config(const ProcessingConfig& processing_config) {
+        processing_config_ = processing_config;
+    }
+
+    void set_component_manager(std::shared_ptr<ComponentManager> component_manager) {
+        component_manager_ = component_manager;
+    }
+
+    [[nodiscard]] std::string to_string() const;
+};
+
+/*
+ * Keeps the k rows with the largest (or smallest) values in a column, optionally per group of another column, best
+ * first. Each processing unit keeps a bounded heap of k rows per group and filters down to them, and repartition then
+ * merges the survivors into a single processing unit and picks the final k from those. Rows with missing or NaN
+ * values, or without a group, are dropped.
+ */
+struct TopKClause {
+    ClauseInfo clause_info_;
+    std::shared_ptr<ComponentManager> component_manager_;
+    ProcessingConfig processing_config_;
+    std::string column_;
+    size_t k_;
+    bool largest_;
+    std::optional<std::string> by_;
+
+    TopKClause(std::string column, uint64_t k, bool largest, std::optional<std::string> by);
+
+    TopKClause() = delete;
+
+    ARCTICDB_MOVE_COPY_DEFAULT(TopKClause)
+
+    [[nodiscard]] std::vector<std::vector<size_t>> structure_for_processing(
+            std::vector<RangesAndKey>& ranges_and_keys,
+            size_t start_from) const {
+        return structure_by_row_slice(ranges_and_keys, start_from);
+    }
+
+    [[nodiscard]] Composite<EntityIds> process(Composite<EntityIds>&& entity_ids) const;
+
+    [[nodiscard]] std::optional<std::vector<Composite<EntityIds>>> repartition(
+            std::vector<Composite<EntityIds>>&& entity_ids) const;
+
+    [[nodiscard]] const ClauseInfo& clause_info() const {
+        return clause_info_;
+    }
+
+    void set_processing_config(const ProcessingConfig& processing_config) {
+        processing_config_ = processing_config;
+    }
+
+    void set_component_manager(std::shared_ptr<ComponentManager> component_manager) {
+        component_manager_ = component_manager;
+    }
+
+    [[nodiscard]] std::string to_string() const;
+};
+
 }//namespace arcticdb
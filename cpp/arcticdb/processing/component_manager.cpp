@@ -9,7 +9,20 @@
 
 namespace arcticdb {
 
+ComponentManager::ComponentManager(uint64_t memory_budget_bytes, std::filesystem::path spill_path) {
+    if (memory_budget_bytes != 0) {
+        memory_budget_ = std::make_shared<MemoryBudget>(memory_budget_bytes);
+        spill_directory_ = std::make_unique<SpillDirectory>(std::move(spill_path));
+    }
+}
+
 void ComponentManager::set_next_entity_id(EntityId id) {
+    // The IDs below this have been handed out up front, so their slots will all be filled
+    segment_map_.reserve(id);
+    row_range_map_.reserve(id);
+    col_range_map_.reserve(id);
+    atom_key_map_.reserve(id);
+    bucket_map_.reserve(id);
     next_entity_id_ = id;
 }
 
@@ -18,4 +31,57 @@ EntityId ComponentManager::entity_id(const std::optional<EntityId>& id) {
     return id.has_value() ? *id : next_entity_id_.fetch_add(1);
 }
 
-} // namespace arcticdb
\ No newline at end of file
+namespace {
+
+/*
+ * The deleter of the segments handed out by get under a budget. It owns nothing itself, but keeps the stored segment
+ * alive along with the reservation counting it, so that the segment stays counted until the clause that fetched it is
+ * done with it.
+ */
+struct HeldSegment {
+    std::shared_ptr<SegmentInMemory> segment_;
+    std::shared_ptr<MemoryReservation> reservation_;
+
+    void operator()(SegmentInMemory*) const {}
+};
+
+} // namespace
+
+std::shared_ptr<MemoryReservation> ComponentManager::reserve(uint64_t bytes) {
+    if (!memory_budget_)
+        return nullptr;
+
+    memory_budget_->reserve(bytes);
+    return std::make_shared<MemoryReservation>(memory_budget_, bytes);
+}
+
+ComponentManager::StoredSegment ComponentManager::store_segment(std::shared_ptr<SegmentInMemory>&& segment, EntityId id) {
+    if (!memory_budget_)
+        return {std::move(segment), nullptr, nullptr};
+
+    // A segment fetched from here and added back, e.g. by a clause that passes it through, is counted afresh, as it may
+    // have changed size, rather than keeping the reservation it was fetched with alive
+    if (auto held = std::get_deleter<HeldSegment>(segment))
+        segment = held->segment_;
+
+    const auto bytes = segment->num_bytes() + segment->string_pool_size();
+    if (memory_budget_->try_reserve(bytes))
+        return {std::move(segment), std::make_shared<MemoryReservation>(memory_budget_, bytes), nullptr, bytes};
+
+    ARCTICDB_DEBUG(log::version(), "Segment {} of {} bytes does not fit in the memory budget, {} of {} bytes used",
+                   id, bytes, memory_budget_->used_bytes(), memory_budget_->limit_bytes());
+    return {nullptr, nullptr, spill_directory_->spill(*segment, id), bytes};
+}
+
+std::shared_ptr<SegmentInMemory> ComponentManager::load_segment(const StoredSegment& stored) {
+    if (!memory_budget_)
+        return stored.segment_;
+
+    auto held = stored.spilled_ ?
+            HeldSegment{std::make_shared<SegmentInMemory>(stored.spilled_->load()), reserve(stored.bytes_)} :
+            HeldSegment{stored.segment_, stored.reservation_};
+    auto segment = held.segment_.get();
+    return std::shared_ptr<SegmentInMemory>(segment, std::move(held));
+}
+
+} // namespace arcticdb
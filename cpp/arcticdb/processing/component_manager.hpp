@@ -7,10 +7,16 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
-#include <unordered_map>
+#include <filesystem>
+#include <memory>
+#include <utility>
+
+#include <folly/lang/Bits.h>
 
 #include <arcticdb/pipeline/frame_slice.hpp>
+#include <arcticdb/processing/memory_budget.hpp>
 #include <arcticdb/util/constructors.hpp>
 
 namespace arcticdb {
@@ -22,15 +28,36 @@ using bucket_id = size_t;
 class ComponentManager {
 public:
     ComponentManager() = default;
+    // Segments added while the budget is exhausted are spilled to a new directory under spill_path. A budget of zero
+    // means unlimited.
+    ComponentManager(uint64_t memory_budget_bytes, std::filesystem::path spill_path);
     ARCTICDB_NO_MOVE_OR_COPY(ComponentManager)
 
     void set_next_entity_id(EntityId id);
 
+    [[nodiscard]] std::shared_ptr<const MemoryBudget> memory_budget() const {
+        return memory_budget_;
+    }
+
+    [[nodiscard]] uint64_t segments_spilled() const {
+        return spill_directory_ ? spill_directory_->segments_spilled() : 0;
+    }
+
+    // Counts memory a clause holds outside of the component manager against the budget, for as long as the returned
+    // reservation is kept. Null if there is no budget.
+    [[nodiscard]] std::shared_ptr<MemoryReservation> reserve(uint64_t bytes);
+
+    // The bytes in memory of a segment that has not had its last expected get yet, whether it is held or spilled. Only
+    // tracked under a budget.
+    [[nodiscard]] uint64_t segment_bytes(EntityId id) const {
+        return segment_map_.peek(id).bytes_;
+    }
+
     template<typename T>
     EntityId add(T component, std::optional<EntityId> id=std::nullopt, std::optional<uint64_t> expected_get_calls=std::nullopt) {
         auto insertion_id = entity_id(id);
         if constexpr(std::is_same_v<T, std::shared_ptr<SegmentInMemory>>) {
-            segment_map_.add(insertion_id, std::move(component), expected_get_calls);
+            segment_map_.add(insertion_id, store_segment(std::move(component), insertion_id), expected_get_calls);
         } else if constexpr(std::is_same_v<T, std::shared_ptr<RowRange>>) {
             row_range_map_.add(insertion_id, std::move(component));
         } else if constexpr(std::is_same_v<T, std::shared_ptr<ColRange>>) {
@@ -50,7 +77,7 @@ public:
     template<typename T>
     T get(EntityId id) {
         if constexpr(std::is_same_v<T, std::shared_ptr<SegmentInMemory>>) {
-            return segment_map_.get(id);
+            return load_segment(segment_map_.get(id));
         } else if constexpr(std::is_same_v<T, std::shared_ptr<RowRange>>) {
             return row_range_map_.get(id);
         } else if constexpr(std::is_same_v<T, std::shared_ptr<ColRange>>) {
@@ -67,64 +94,189 @@ public:
     }
 
 private:
+    /*
+     * Entity IDs are dense integers handed out by the manager (or up front by read_and_process), so rather than a
+     * hash map behind a mutex the components live in an array of slots indexed by ID. The array is split into
+     * fixed size chunks that are allocated on first use and published with a CAS. The chunks are found through a
+     * directory whose levels double in size, and are allocated and published the same way, so it can keep growing
+     * as clauses push new entities without any limit on the number of IDs and without ever moving a slot or chunk
+     * pointer that another thread is reading.
+     *
+     * Each slot is written once. Readers only see it after the writer publishes it by setting the state to READY.
+     * Where the number of gets is tracked, each get decrements the slot's count after taking its copy. The get that
+     * takes the count to zero is therefore the last reader, so it can drop the component without locking.
+     */
     template<typename T>
     class ComponentMap {
+        static constexpr size_t slots_per_chunk = 1024;
+        // Level n of the directory holds 2^n chunks, so 64 levels can hold any ID
+        static constexpr size_t num_levels = 64;
+
+        enum class SlotState : uint8_t {
+            EMPTY,
+            WRITING,
+            READY,
+            RELEASED
+        };
+
+        struct Slot {
+            std::atomic<SlotState> state_{SlotState::EMPTY};
+            std::atomic<uint64_t> remaining_gets_{0};
+            T entity_{};
+        };
+
+        using Chunk = std::array<Slot, slots_per_chunk>;
+        using Level = std::atomic<Chunk*>;
+
     public:
         explicit ComponentMap(std::string&& entity_type, bool track_expected_gets):
                 entity_type_(std::move(entity_type)),
-                opt_expected_get_calls_map_(track_expected_gets ? std::make_optional<std::unordered_map<EntityId, uint64_t>>() : std::nullopt){
+                track_expected_gets_(track_expected_gets) {
         };
         ARCTICDB_NO_MOVE_OR_COPY(ComponentMap)
 
+        ~ComponentMap() {
+            for (size_t level = 0; level < num_levels; ++level) {
+                auto chunks = levels_[level].load(std::memory_order_relaxed);
+                if (chunks == nullptr)
+                    continue;
+
+                for (size_t i = 0; i < level_size(level); ++i)
+                    delete chunks[i].load(std::memory_order_relaxed);
+                delete[] chunks;
+            }
+        }
+
+        // Allocates the chunks for IDs below num_ids, so the first add for each of them does not have to
+        void reserve(EntityId num_ids) {
+            for (EntityId id = 0; id < num_ids; id += slots_per_chunk)
+                get_or_create_chunk(id / slots_per_chunk);
+        }
+
         void add(EntityId id, T&& entity, std::optional<uint64_t> expected_get_calls=std::nullopt) {
-            std::lock_guard <std::mutex> lock(mtx_);
             ARCTICDB_DEBUG(log::storage(), "Adding {} with id {}", entity_type_, id);
-            internal::check<ErrorCode::E_ASSERTION_FAILURE>(map_.try_emplace(id, std::move(entity)).second,
-                                                            "Failed to insert {} with ID {}, already exists",
-                                                            entity_type_, id);
-            if (opt_expected_get_calls_map_.has_value()) {
+            auto& slot = get_or_create_chunk(id / slots_per_chunk)[id % slots_per_chunk];
+            auto expected_state = SlotState::EMPTY;
+            internal::check<ErrorCode::E_ASSERTION_FAILURE>(
+                    slot.state_.compare_exchange_strong(expected_state, SlotState::WRITING, std::memory_order_acquire),
+                    "Failed to insert {} with ID {}, already exists",
+                    entity_type_, id);
+            if (track_expected_gets_) {
                 internal::check<ErrorCode::E_ASSERTION_FAILURE>(expected_get_calls.has_value() && *expected_get_calls > 0,
                                                                 "Failed to insert {} with ID {}, must provide expected gets",
                                                                 entity_type_, id);
-                internal::check<ErrorCode::E_ASSERTION_FAILURE>(opt_expected_get_calls_map_->try_emplace(id, *expected_get_calls).second,
-                                                                "Failed to insert {} with ID {}, already exists",
-                                                                entity_type_, id);
+                slot.remaining_gets_.store(*expected_get_calls, std::memory_order_relaxed);
             }
+            slot.entity_ = std::move(entity);
+            slot.state_.store(SlotState::READY, std::memory_order_release);
         }
+
         T get(EntityId id) {
-            std::lock_guard <std::mutex> lock(mtx_);
             ARCTICDB_DEBUG(log::storage(), "Getting {} with id {}", entity_type_, id);
-            auto entity_it = map_.find(id);
-            internal::check<ErrorCode::E_ASSERTION_FAILURE>(entity_it != map_.end(),
+            Chunk* chunk = find_chunk(id / slots_per_chunk);
+            internal::check<ErrorCode::E_ASSERTION_FAILURE>(chunk != nullptr,
                                                             "Requested non-existent {} with ID {}",
                                                             entity_type_, id);
-            auto res = entity_it->second;
-            if (opt_expected_get_calls_map_.has_value()) {
-                auto expected_get_calls_it = opt_expected_get_calls_map_->find(id);
-                internal::check<ErrorCode::E_ASSERTION_FAILURE>(expected_get_calls_it != opt_expected_get_calls_map_->end(),
-                                                                "Requested non-existent {} with ID {}",
+            auto& slot = (*chunk)[id % slots_per_chunk];
+            internal::check<ErrorCode::E_ASSERTION_FAILURE>(
+                    slot.state_.load(std::memory_order_acquire) == SlotState::READY &&
+                    (!track_expected_gets_ || slot.remaining_gets_.load(std::memory_order_relaxed) > 0),
+                    "Requested non-existent {} with ID {}",
+                    entity_type_, id);
+            auto res = slot.entity_;
+            if (track_expected_gets_) {
+                const auto previous_gets = slot.remaining_gets_.fetch_sub(1, std::memory_order_acq_rel);
+                internal::check<ErrorCode::E_ASSERTION_FAILURE>(previous_gets > 0,
+                                                                "Requested {} with ID {} more times than expected",
                                                                 entity_type_, id);
-                if (--expected_get_calls_it->second == 0) {
+                if (previous_gets == 1) {
                     ARCTICDB_DEBUG(log::storage(),
                                    "{} with id {} has been fetched the expected number of times, erasing from component manager",
                                    entity_type_, id);
-                    map_.erase(entity_it);
-                    opt_expected_get_calls_map_->erase(expected_get_calls_it);
+                    slot.entity_ = T{};
+                    slot.state_.store(SlotState::RELEASED, std::memory_order_release);
                 }
             }
             return res;
         }
+
+        // Reads an entity without counting as one of its expected gets, so it must not race with the last of them
+        const T& peek(EntityId id) const {
+            Chunk* chunk = find_chunk(id / slots_per_chunk);
+            internal::check<ErrorCode::E_ASSERTION_FAILURE>(
+                    chunk != nullptr && (*chunk)[id % slots_per_chunk].state_.load(std::memory_order_acquire) == SlotState::READY,
+                    "Requested non-existent {} with ID {}",
+                    entity_type_, id);
+            return (*chunk)[id % slots_per_chunk].entity_;
+        }
     private:
+        static constexpr size_t level_size(size_t level) {
+            return size_t{1} << level;
+        }
+
+        // The directory level holding a chunk, and the chunk's position within that level
+        static std::pair<size_t, size_t> locate(size_t chunk_index) {
+            const size_t level = folly::findLastSet(chunk_index + 1) - 1;
+            return {level, chunk_index + 1 - level_size(level)};
+        }
+
+        Chunk* find_chunk(size_t chunk_index) const {
+            const auto [level, pos] = locate(chunk_index);
+            auto chunks = levels_[level].load(std::memory_order_acquire);
+            return chunks != nullptr ? chunks[pos].load(std::memory_order_acquire) : nullptr;
+        }
+
+        Level* get_or_create_level(size_t level) {
+            auto chunks = levels_[level].load(std::memory_order_acquire);
+            if (chunks == nullptr) {
+                auto new_chunks = std::make_unique<Level[]>(level_size(level));
+                if (levels_[level].compare_exchange_strong(chunks, new_chunks.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+                    chunks = new_chunks.release();
+            }
+            return chunks;
+        }
+
+        Chunk& get_or_create_chunk(size_t chunk_index) {
+            const auto [level, pos] = locate(chunk_index);
+            auto& slot = get_or_create_level(level)[pos];
+            auto chunk = slot.load(std::memory_order_acquire);
+            if (chunk == nullptr) {
+                auto new_chunk = std::make_unique<Chunk>();
+                if (slot.compare_exchange_strong(chunk, new_chunk.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+                    chunk = new_chunk.release();
+            }
+            return *chunk;
+        }
+
         // Just used for logging/exception messages
         std::string entity_type_;
-        std::unordered_map<EntityId, T> map_;
-        // If not nullopt, tracks the number of calls to get for each entity id, and erases from maps when it has been
+        // If true, tracks the number of calls to get for each entity id, and drops the entity when it has been
         // called this many times
-        std::optional<std::unordered_map<EntityId, uint64_t>> opt_expected_get_calls_map_;
-        std::mutex mtx_;
+        bool track_expected_gets_;
+        std::array<std::atomic<Level*>, num_levels> levels_{};
+    };
+
+    /*
+     * Segments count against the memory budget, if there is one, from when they are added until the last copy handed
+     * out by get is dropped, so that the segments a clause is working on are counted as well as those waiting for it.
+     * Any that do not fit when they are added are held on disk instead, and read back on each get, so that e.g. the
+     * partitions of a groupby wait on disk until the aggregation of their bucket.
+     */
+    struct StoredSegment {
+        std::shared_ptr<SegmentInMemory> segment_;
+        std::shared_ptr<MemoryReservation> reservation_;
+        std::shared_ptr<SpilledSegment> spilled_;
+        uint64_t bytes_{0};
     };
 
-    ComponentMap<std::shared_ptr<SegmentInMemory>> segment_map_{"segment", true};
+    StoredSegment store_segment(std::shared_ptr<SegmentInMemory>&& segment, EntityId id);
+    std::shared_ptr<SegmentInMemory> load_segment(const StoredSegment& stored);
+
+    // Declared before the maps so that the directory outlives the spilled segments held in them
+    std::shared_ptr<MemoryBudget> memory_budget_;
+    std::unique_ptr<SpillDirectory> spill_directory_;
+
+    ComponentMap<StoredSegment> segment_map_{"segment", true};
     ComponentMap<std::shared_ptr<RowRange>> row_range_map_{"row range", false};
     ComponentMap<std::shared_ptr<ColRange>> col_range_map_{"col range", false};
     ComponentMap<std::shared_ptr<AtomKey>> atom_key_map_{"atom key", false};
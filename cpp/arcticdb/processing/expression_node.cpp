@@ -7,12 +7,226 @@
 
 #include <arcticdb/processing/expression_node.hpp>
 #include <arcticdb/processing/processing_unit.hpp>
+#include <arcticdb/processing/fused_expression.hpp>
 #include <arcticdb/processing/operation_types.hpp>
 #include <arcticdb/processing/operation_dispatch_binary.hpp>
 #include <arcticdb/processing/operation_dispatch_unary.hpp>
+#include <arcticdb/processing/operation_dispatch.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+#include <folly/container/Enumerate.h>
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
 
 namespace arcticdb {
 
+void OperandStats::record(uint64_t rows_in, uint64_t rows_selected, uint64_t nanos) {
+    rows_in_.fetch_add(rows_in, std::memory_order_relaxed);
+    rows_selected_.fetch_add(rows_selected, std::memory_order_relaxed);
+    nanos_.fetch_add(nanos, std::memory_order_relaxed);
+    evaluations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+double OperandStats::rank(OperationType operation) const {
+    const auto rows_in = rows_in_.load(std::memory_order_relaxed);
+    if (evaluations_.load(std::memory_order_relaxed) == 0 || rows_in == 0)
+        return 0.0;
+
+    const auto cost_per_row = static_cast<double>(nanos_.load(std::memory_order_relaxed)) / static_cast<double>(rows_in);
+    const auto selectivity = static_cast<double>(rows_selected_.load(std::memory_order_relaxed)) / static_cast<double>(rows_in);
+    // An AND operand settles the rows it rejects, an OR operand the rows it accepts
+    const auto decided = operation == OperationType::AND ? 1.0 - selectivity : selectivity;
+    return cost_per_row / std::max(decided, 1e-6);
+}
+
+namespace {
+
+// Flattens a chain of the same operation, e.g. (a & b) & c, into its operands a, b and c
+void collect_operands(const VariantNode& node, OperationType operation, ProcessingUnit& proc, std::vector<VariantNode>& operands) {
+    if (const auto* expression_name = std::get_if<ExpressionName>(&node)) {
+        auto expr = proc.expression_context_->expression_nodes_.get_value(expression_name->value);
+        if (expr->operation_type_ == operation) {
+            collect_operands(expr->left_, operation, proc, operands);
+            collect_operands(expr->right_, operation, proc, operands);
+            return;
+        }
+    }
+    operands.push_back(node);
+}
+
+void collect_column_names(const VariantNode& node, ProcessingUnit& proc, std::unordered_set<std::string>& column_names) {
+    util::variant_match(node,
+        [&column_names](const ColumnName& column_name) {
+            column_names.insert(column_name.value);
+            column_names.insert(fmt::format("__idx__{}", column_name.value));
+        },
+        [&](const ExpressionName& expression_name) {
+            auto expr = proc.expression_context_->expression_nodes_.get_value(expression_name.value);
+            collect_column_names(expr->left_, proc, column_names);
+            collect_column_names(expr->right_, proc, column_names);
+        },
+        [](const auto&) {}
+    );
+}
+
+std::shared_ptr<OperandStats> operand_stats(const VariantNode& node, ProcessingUnit& proc) {
+    if (const auto* expression_name = std::get_if<ExpressionName>(&node))
+        return proc.expression_context_->expression_nodes_.get_value(expression_name->value)->operand_stats_;
+
+    // Columns and values are already materialised and cost nothing to fetch
+    return {};
+}
+
+uint64_t selected_row_count(const VariantData& data, uint64_t row_count) {
+    return util::variant_match(data,
+        [](const std::shared_ptr<util::BitSet>& bitset) -> uint64_t { return bitset->count(); },
+        [row_count](FullResult) { return row_count; },
+        [](const auto&) -> uint64_t { return 0; }
+    );
+}
+
+/*
+ * Builds a processing unit holding only the given rows of the columns the operand refers to. Returns std::nullopt if
+ * the operand cannot be evaluated that way, e.g. it only refers to values, or one of its columns is sparse so that
+ * filtering could drop it altogether.
+ */
+std::optional<ProcessingUnit> restrict_to_rows(const VariantNode& operand, ProcessingUnit& proc, const util::BitSet& rows) {
+    std::unordered_set<std::string> column_names;
+    collect_column_names(operand, proc, column_names);
+    std::vector<std::shared_ptr<SegmentInMemory>> segments;
+    for (const auto& segment : *proc.segments_) {
+        segment->init_column_map();
+        SegmentInMemory narrow;
+        for (const auto& column_name : column_names) {
+            if (auto opt_idx = segment->column_index(column_name)) {
+                const auto& column = segment->column_ptr(position_t(*opt_idx));
+                if (column->is_sparse())
+                    return std::nullopt;
+
+                narrow.add_column(segment->field(*opt_idx), column);
+            }
+        }
+        if (narrow.descriptor().field_count() == 0)
+            continue;
+
+        narrow.descriptor().set_index(IndexDescriptor(0, IndexDescriptor::ROWCOUNT));
+        narrow.set_string_pool(segment->string_pool_ptr());
+        narrow.set_row_id(segment->row_count() - 1);
+        segments.emplace_back(std::make_shared<SegmentInMemory>(filter_segment(narrow, rows)));
+    }
+    if (segments.empty())
+        return std::nullopt;
+
+    ProcessingUnit restricted;
+    restricted.set_segments(std::move(segments));
+    restricted.set_expression_context(proc.expression_context_);
+    return restricted;
+}
+
+// Maps the result of evaluating an operand over the given rows back to the rows of the full processing unit
+std::shared_ptr<util::BitSet> expand_to_rows(const VariantData& data, const util::BitSet& rows) {
+    auto output = std::make_shared<util::BitSet>(rows.size());
+    util::variant_match(transform_to_bitset(data),
+        [&output, &rows](const std::shared_ptr<util::BitSet>& bitset) {
+            util::BitSet::bulk_insert_iterator inserter(*output);
+            util::BitSetSizeType pos = 0;
+            for (auto en = rows.first(); en.valid(); ++en, ++pos) {
+                if (bitset->test(pos))
+                    inserter = *en;
+            }
+            inserter.flush();
+        },
+        [&output, &rows](FullResult) {
+            *output = rows;
+        },
+        [](const auto&) {}
+    );
+    return output;
+}
+
+/*
+ * Evaluates a chain of ANDs or ORs one operand at a time, stopping as soon as the result is decided. Operands run in
+ * order of their rank from earlier processing units, and once few enough rows are left undecided the remaining
+ * operands are only evaluated over those rows.
+ */
+VariantData compute_short_circuit(const ExpressionNode& node, ProcessingUnit& proc) {
+    const auto operation = node.operation_type_;
+    std::vector<VariantNode> operands;
+    collect_operands(node.left_, operation, proc, operands);
+    collect_operands(node.right_, operation, proc, operands);
+
+    std::vector<std::pair<double, size_t>> order;
+    order.reserve(operands.size());
+    for (auto&& [idx, operand] : folly::enumerate(operands)) {
+        auto stats = operand_stats(operand, proc);
+        order.emplace_back(stats ? stats->rank(operation) : 0.0, idx);
+    }
+    std::stable_sort(std::begin(order), std::end(order), [](const auto& l, const auto& r) { return l.first < r.first; });
+
+    const auto row_count = static_cast<uint64_t>(proc.segments_->at(0)->row_count());
+    const auto subset_ratio = ConfigsMap::instance()->get_double("Filter.SubsetEvaluationRatio", 0.25);
+    std::optional<VariantData> result;
+    for (const auto& ranked : order) {
+        const auto& operand = operands[ranked.second];
+        auto stats = operand_stats(operand, proc);
+        const auto start = std::chrono::steady_clock::now();
+        uint64_t rows_in = row_count;
+        VariantData data;
+
+        // The rows whose result this operand can still change
+        std::optional<util::BitSet> undecided;
+        if (result && stats) {
+            if (const auto* bitset = std::get_if<std::shared_ptr<util::BitSet>>(&*result); bitset && (*bitset)->size() == row_count) {
+                undecided = **bitset;
+                if (operation == OperationType::OR)
+                    undecided->invert();
+            }
+        }
+
+        std::optional<ProcessingUnit> restricted;
+        if (undecided && static_cast<double>(undecided->count()) <= subset_ratio * static_cast<double>(row_count))
+            restricted = restrict_to_rows(operand, proc, *undecided);
+
+        if (restricted) {
+            rows_in = undecided->count();
+            auto restricted_data = transform_to_bitset(restricted->get(operand));
+            if (stats) {
+                stats->record(rows_in, selected_row_count(restricted_data, rows_in),
+                              std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            }
+            // Rows outside the undecided set come out false, which leaves them as they were for both AND and OR
+            data = expand_to_rows(restricted_data, *undecided);
+        } else {
+            data = transform_to_bitset(proc.get(operand));
+            if (stats) {
+                stats->record(rows_in, selected_row_count(data, rows_in),
+                              std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            }
+        }
+
+        if (restricted && operation == OperationType::AND)
+            result = transform_to_placeholder(data);
+        else
+            result = result ? dispatch_binary(*result, data, operation) : transform_to_placeholder(data);
+
+        // A full bitset can only end an OR early, so only pay for the count there
+        if (const auto* bitset = std::get_if<std::shared_ptr<util::BitSet>>(&*result);
+            bitset && operation == OperationType::OR && (*bitset)->count() == row_count)
+            result = FullResult{};
+
+        if (operation == OperationType::AND && std::holds_alternative<EmptyResult>(*result))
+            break;
+
+        if (operation == OperationType::OR && std::holds_alternative<FullResult>(*result))
+            break;
+    }
+    return *result;
+}
+
+} // namespace
+
 ExpressionNode::ExpressionNode(VariantNode left, VariantNode right, OperationType op) :
     left_(std::move(left)),
     right_(std::move(right)),
@@ -27,7 +241,11 @@ ExpressionNode::ExpressionNode(VariantNode left, OperationType op) :
 }
 
 VariantData ExpressionNode::compute(ProcessingUnit& seg) const {
-    if (is_binary_operation(operation_type_)) {
+    if (operation_type_ == OperationType::AND || operation_type_ == OperationType::OR) {
+        return compute_short_circuit(*this, seg);
+    } else if (auto fused = compute_fused(*this, seg)) {
+        return std::move(*fused);
+    } else if (is_binary_operation(operation_type_)) {
         return dispatch_binary(seg.get(left_), seg.get(right_), operation_type_);
     } else {
         return dispatch_unary(seg.get(left_), operation_type_);
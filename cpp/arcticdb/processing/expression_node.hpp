@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <arcticdb/util/bitset.hpp>
@@ -98,6 +99,23 @@ struct EmptyResult {};
 
 using VariantData = std::variant<FullResult, EmptyResult, std::shared_ptr<Value>, std::shared_ptr<ValueSet>, ColumnWithStrings, std::shared_ptr<util::BitSet>>;
 
+/*
+ * Running totals of how an expression has done as an operand of an AND or OR, shared by all the processing units of a
+ * query. They are used to evaluate the cheapest and most decisive operands first.
+ */
+struct OperandStats {
+    std::atomic<uint64_t> evaluations_{0};
+    std::atomic<uint64_t> rows_in_{0};
+    std::atomic<uint64_t> rows_selected_{0};
+    std::atomic<uint64_t> nanos_{0};
+
+    void record(uint64_t rows_in, uint64_t rows_selected, uint64_t nanos);
+
+    // Expected time spent per row that the operand removes from further evaluation, lower runs earlier. Operands that
+    // have never been evaluated rank first so that they get measured.
+    [[nodiscard]] double rank(OperationType operation) const;
+};
+
 /*
  * Basic AST node.
  */
@@ -105,6 +123,7 @@ struct ExpressionNode {
     VariantNode left_;
     VariantNode right_;
     OperationType operation_type_;
+    std::shared_ptr<OperandStats> operand_stats_ = std::make_shared<OperandStats>();
 
     ExpressionNode(VariantNode left, VariantNode right, OperationType op);
 
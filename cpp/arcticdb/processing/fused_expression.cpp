@@ -0,0 +1,451 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/processing/fused_expression.hpp>
+#include <arcticdb/processing/processing_unit.hpp>
+#include <arcticdb/processing/operation_types.hpp>
+#include <arcticdb/processing/operation_dispatch.hpp>
+#include <arcticdb/entity/type_conversion.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+#include <algorithm>
+
+namespace arcticdb {
+
+namespace {
+
+// Rows per batch. Large enough to amortise the kernel calls, small enough for a few intermediates to stay in L1/L2.
+constexpr size_t fused_batch_size = 1024;
+
+template <typename T>
+struct FusedType {
+    using type = T;
+};
+
+template <typename T>
+inline constexpr bool is_fused_type_v = std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> ||
+    std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// The kernels are instantiated for each combination of these types. Arithmetic on any pair of them promotes to
+// another one of them, so a fused tree never needs a type outside the set.
+template <typename Visitor>
+bool visit_fused_type(DataType data_type, Visitor&& visitor) {
+    switch (data_type) {
+    case DataType::INT32: visitor(FusedType<int32_t>{}); return true;
+    case DataType::INT64: visitor(FusedType<int64_t>{}); return true;
+    case DataType::UINT32: visitor(FusedType<uint32_t>{}); return true;
+    case DataType::UINT64: visitor(FusedType<uint64_t>{}); return true;
+    case DataType::FLOAT32: visitor(FusedType<float>{}); return true;
+    case DataType::FLOAT64: visitor(FusedType<double>{}); return true;
+    default: return false;
+    }
+}
+
+// A batch of input to a kernel, either one value per row or a single value for every row
+struct FusedOperand {
+    const uint8_t* data_ = nullptr;
+    bool scalar_ = false;
+};
+
+using BinaryKernel = void (*)(FusedOperand, FusedOperand, uint8_t*, size_t);
+using UnaryKernel = void (*)(FusedOperand, uint8_t*, size_t);
+using ComparisonKernel = void (*)(FusedOperand, FusedOperand, size_t, size_t, util::BitSet::bulk_insert_iterator&);
+
+template <typename L, typename R, typename Func>
+void binary_kernel(FusedOperand left, FusedOperand right, uint8_t* out, size_t num_rows) {
+    using TargetType = typename type_arithmetic_promoted_type<L, R, Func>::type;
+    Func func;
+    auto left_ptr = reinterpret_cast<const L*>(left.data_);
+    auto right_ptr = reinterpret_cast<const R*>(right.data_);
+    auto out_ptr = reinterpret_cast<TargetType*>(out);
+    if (left.scalar_) {
+        const auto left_value = *left_ptr;
+        for (size_t i = 0; i < num_rows; ++i)
+            out_ptr[i] = func.apply(left_value, right_ptr[i]);
+    } else if (right.scalar_) {
+        const auto right_value = *right_ptr;
+        for (size_t i = 0; i < num_rows; ++i)
+            out_ptr[i] = func.apply(left_ptr[i], right_value);
+    } else {
+        for (size_t i = 0; i < num_rows; ++i)
+            out_ptr[i] = func.apply(left_ptr[i], right_ptr[i]);
+    }
+}
+
+template <typename T, typename Func>
+void unary_kernel(FusedOperand input, uint8_t* out, size_t num_rows) {
+    using TargetType = typename unary_arithmetic_promoted_type<T, Func>::type;
+    Func func;
+    auto input_ptr = reinterpret_cast<const T*>(input.data_);
+    auto out_ptr = reinterpret_cast<TargetType*>(out);
+    for (size_t i = 0; i < num_rows; ++i)
+        out_ptr[i] = func.apply(input_ptr[i]);
+}
+
+template <typename L, typename R, typename Func>
+void comparison_kernel(FusedOperand left, FusedOperand right, size_t num_rows, size_t pos, util::BitSet::bulk_insert_iterator& inserter) {
+    using comp = typename arcticdb::Comparable<L, R>;
+    Func func;
+    auto left_ptr = reinterpret_cast<const L*>(left.data_);
+    auto right_ptr = reinterpret_cast<const R*>(right.data_);
+    if (left.scalar_) {
+        const auto left_value = static_cast<typename comp::left_type>(*left_ptr);
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (func(left_value, static_cast<typename comp::right_type>(right_ptr[i])))
+                inserter = static_cast<util::BitSetSizeType>(pos + i);
+        }
+    } else if (right.scalar_) {
+        const auto right_value = static_cast<typename comp::right_type>(*right_ptr);
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (func(static_cast<typename comp::left_type>(left_ptr[i]), right_value))
+                inserter = static_cast<util::BitSetSizeType>(pos + i);
+        }
+    } else {
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (func(static_cast<typename comp::left_type>(left_ptr[i]), static_cast<typename comp::right_type>(right_ptr[i])))
+                inserter = static_cast<util::BitSetSizeType>(pos + i);
+        }
+    }
+}
+
+template <typename Func>
+std::optional<std::pair<BinaryKernel, DataType>> select_binary_kernel(DataType left, DataType right) {
+    std::optional<std::pair<BinaryKernel, DataType>> res;
+    visit_fused_type(left, [&res, right](auto left_tag) {
+        using L = typename decltype(left_tag)::type;
+        visit_fused_type(right, [&res](auto right_tag) {
+            using R = typename decltype(right_tag)::type;
+            using TargetType = typename type_arithmetic_promoted_type<L, R, Func>::type;
+            if constexpr (is_fused_type_v<TargetType>)
+                res.emplace(&binary_kernel<L, R, Func>, data_type_from_raw_type<TargetType>());
+        });
+    });
+    return res;
+}
+
+template <typename Func>
+std::optional<std::pair<UnaryKernel, DataType>> select_unary_kernel(DataType input) {
+    std::optional<std::pair<UnaryKernel, DataType>> res;
+    visit_fused_type(input, [&res](auto tag) {
+        using T = typename decltype(tag)::type;
+        using TargetType = typename unary_arithmetic_promoted_type<T, Func>::type;
+        if constexpr (is_fused_type_v<TargetType>)
+            res.emplace(&unary_kernel<T, Func>, data_type_from_raw_type<TargetType>());
+    });
+    return res;
+}
+
+template <typename Func>
+std::optional<ComparisonKernel> select_comparison_kernel(DataType left, DataType right) {
+    std::optional<ComparisonKernel> res;
+    visit_fused_type(left, [&res, right](auto left_tag) {
+        using L = typename decltype(left_tag)::type;
+        visit_fused_type(right, [&res](auto right_tag) {
+            using R = typename decltype(right_tag)::type;
+            res.emplace(&comparison_kernel<L, R, Func>);
+        });
+    });
+    return res;
+}
+
+std::optional<std::pair<BinaryKernel, DataType>> binary_kernel_for(OperationType operation, DataType left, DataType right) {
+    switch (operation) {
+    case OperationType::ADD: return select_binary_kernel<PlusOperator>(left, right);
+    case OperationType::SUB: return select_binary_kernel<MinusOperator>(left, right);
+    case OperationType::MUL: return select_binary_kernel<TimesOperator>(left, right);
+    case OperationType::DIV: return select_binary_kernel<DivideOperator>(left, right);
+    default: return std::nullopt;
+    }
+}
+
+std::optional<std::pair<UnaryKernel, DataType>> unary_kernel_for(OperationType operation, DataType input) {
+    switch (operation) {
+    case OperationType::ABS: return select_unary_kernel<AbsOperator>(input);
+    case OperationType::NEG: return select_unary_kernel<NegOperator>(input);
+    default: return std::nullopt;
+    }
+}
+
+std::optional<ComparisonKernel> comparison_kernel_for(OperationType operation, DataType left, DataType right) {
+    switch (operation) {
+    case OperationType::EQ: return select_comparison_kernel<EqualsOperator>(left, right);
+    case OperationType::NE: return select_comparison_kernel<NotEqualsOperator>(left, right);
+    case OperationType::LT: return select_comparison_kernel<LessThanOperator>(left, right);
+    case OperationType::LE: return select_comparison_kernel<LessThanEqualsOperator>(left, right);
+    case OperationType::GT: return select_comparison_kernel<GreaterThanOperator>(left, right);
+    case OperationType::GE: return select_comparison_kernel<GreaterThanEqualsOperator>(left, right);
+    default: return std::nullopt;
+    }
+}
+
+// Walks the blocks of an input column, handing out pointers to runs of consecutive rows
+class BlockCursor {
+public:
+    BlockCursor(const Column& column, size_t type_size) :
+        column_(&column),
+        type_size_(type_size) {
+        skip_exhausted();
+    }
+
+    [[nodiscard]] size_t available() const {
+        return block_ < column_->blocks().size() ? column_->blocks()[block_]->bytes() / type_size_ - row_in_block_ : 0;
+    }
+
+    [[nodiscard]] const uint8_t* data() const {
+        return column_->blocks()[block_]->data() + row_in_block_ * type_size_;
+    }
+
+    void advance(size_t num_rows) {
+        row_in_block_ += num_rows;
+        skip_exhausted();
+    }
+
+private:
+    void skip_exhausted() {
+        const auto& blocks = column_->blocks();
+        while (block_ < blocks.size() && (blocks[block_] == nullptr || row_in_block_ * type_size_ >= blocks[block_]->bytes())) {
+            ++block_;
+            row_in_block_ = 0;
+        }
+    }
+
+    const Column* column_;
+    size_t type_size_;
+    size_t block_ = 0;
+    size_t row_in_block_ = 0;
+};
+
+struct FusedNode {
+    enum class Kind : uint8_t {
+        COLUMN,
+        VALUE,
+        UNARY,
+        BINARY,
+        COMPARISON
+    };
+
+    Kind kind_;
+    DataType data_type_;
+    // Index into FusedExpression::columns_ for COLUMN, otherwise the children's indices into FusedExpression::nodes_
+    size_t left_ = 0;
+    size_t right_ = 0;
+    std::shared_ptr<Value> value_;
+    BinaryKernel binary_ = nullptr;
+    UnaryKernel unary_ = nullptr;
+    ComparisonKernel comparison_ = nullptr;
+};
+
+/*
+ * The compiled form of an expression tree for one processing unit. Nodes are stored children first, so the root is
+ * the last node and each batch is evaluated by a single pass over the vector.
+ */
+class FusedExpression {
+public:
+    explicit FusedExpression(ProcessingUnit& proc) :
+        proc_(proc) {
+    }
+
+    bool compile(const ExpressionNode& root) {
+        if (!add_expression(root, true))
+            return false;
+
+        return num_operations_ >= 2 && !columns_.empty() && row_count_ > 0;
+    }
+
+    VariantData evaluate() {
+        std::vector<BlockCursor> cursors;
+        cursors.reserve(columns_.size());
+        for (const auto& column : columns_)
+            cursors.emplace_back(*column, get_type_size(column->type().data_type()));
+
+        // One scratch buffer of a batch of 64 bit values for each intermediate result
+        std::vector<std::vector<uint64_t>> scratch(nodes_.size());
+        for (size_t i = 0; i + 1 < nodes_.size(); ++i) {
+            if (nodes_[i].kind_ == FusedNode::Kind::UNARY || nodes_[i].kind_ == FusedNode::Kind::BINARY)
+                scratch[i].resize(fused_batch_size);
+        }
+
+        const auto& root = nodes_.back();
+        std::unique_ptr<Column> output_column;
+        std::shared_ptr<util::BitSet> output_bitset;
+        std::optional<util::BitSet::bulk_insert_iterator> inserter;
+        if (root.kind_ == FusedNode::Kind::COMPARISON) {
+            output_bitset = std::make_shared<util::BitSet>(static_cast<util::BitSetSizeType>(row_count_));
+            inserter.emplace(*output_bitset);
+        } else {
+            output_column = std::make_unique<Column>(make_scalar_type(root.data_type_), row_count_, true, false);
+        }
+        const auto root_type_size = get_type_size(root.data_type_);
+
+        std::vector<FusedOperand> operands(nodes_.size());
+        for (size_t pos = 0; pos < row_count_;) {
+            auto num_rows = std::min(fused_batch_size, row_count_ - pos);
+            for (const auto& cursor : cursors)
+                num_rows = std::min(num_rows, cursor.available());
+            util::check(num_rows > 0, "Ran out of column data at row {} of {} in fused expression", pos, row_count_);
+
+            for (size_t i = 0; i < nodes_.size(); ++i) {
+                const auto& node = nodes_[i];
+                const bool is_root = i + 1 == nodes_.size();
+                uint8_t* out = is_root && output_column
+                    ? output_column->ptr() + pos * root_type_size
+                    : reinterpret_cast<uint8_t*>(scratch[i].data());
+                switch (node.kind_) {
+                case FusedNode::Kind::COLUMN:
+                    operands[i] = {cursors[node.left_].data(), false};
+                    break;
+                case FusedNode::Kind::VALUE:
+                    operands[i] = {reinterpret_cast<const uint8_t*>(node.value_->data_), true};
+                    break;
+                case FusedNode::Kind::UNARY:
+                    node.unary_(operands[node.left_], out, num_rows);
+                    operands[i] = {out, false};
+                    break;
+                case FusedNode::Kind::BINARY:
+                    node.binary_(operands[node.left_], operands[node.right_], out, num_rows);
+                    operands[i] = {out, false};
+                    break;
+                case FusedNode::Kind::COMPARISON:
+                    node.comparison_(operands[node.left_], operands[node.right_], num_rows, pos, *inserter);
+                    break;
+                }
+            }
+
+            for (auto& cursor : cursors)
+                cursor.advance(num_rows);
+
+            pos += num_rows;
+        }
+
+        if (output_bitset) {
+            inserter->flush();
+            return transform_to_placeholder(VariantData{std::move(output_bitset)});
+        }
+        output_column->set_row_data(row_count_ - 1);
+        return VariantData{ColumnWithStrings(std::move(output_column))};
+    }
+
+private:
+    std::optional<size_t> add_leaf(const VariantNode& node) {
+        auto data = proc_.get(node);
+        if (const auto* column_with_strings = std::get_if<ColumnWithStrings>(&data)) {
+            const auto& column = column_with_strings->column_;
+            if (column->is_sparse() || !visit_fused_type(column->type().data_type(), [](auto) {}))
+                return std::nullopt;
+
+            const auto column_rows = static_cast<size_t>(column->row_count());
+            if (!columns_.empty() && column_rows != row_count_)
+                return std::nullopt;
+
+            row_count_ = column_rows;
+            columns_.emplace_back(column);
+            return push({FusedNode::Kind::COLUMN, column->type().data_type(), columns_.size() - 1});
+        } else if (const auto* value = std::get_if<std::shared_ptr<Value>>(&data)) {
+            if (!visit_fused_type((*value)->data_type_, [](auto) {}))
+                return std::nullopt;
+
+            FusedNode fused{FusedNode::Kind::VALUE, (*value)->data_type_};
+            fused.value_ = *value;
+            return push(std::move(fused));
+        }
+        return std::nullopt;
+    }
+
+    std::optional<size_t> add_child(const VariantNode& node) {
+        if (const auto* expression_name = std::get_if<ExpressionName>(&node)) {
+            // A subexpression that has already been evaluated is read like a column
+            if (proc_.computed_data_.count(expression_name->value) != 0)
+                return add_leaf(node);
+
+            auto expr = proc_.expression_context_->expression_nodes_.get_value(expression_name->value);
+            return add_expression(*expr, false);
+        }
+        return add_leaf(node);
+    }
+
+    std::optional<size_t> add_expression(const ExpressionNode& expr, bool is_root) {
+        const auto operation = expr.operation_type_;
+        if (operation == OperationType::ABS || operation == OperationType::NEG) {
+            auto input = add_child(expr.left_);
+            if (!input || nodes_[*input].kind_ == FusedNode::Kind::VALUE)
+                return std::nullopt;
+
+            auto kernel = unary_kernel_for(operation, nodes_[*input].data_type_);
+            if (!kernel)
+                return std::nullopt;
+
+            FusedNode fused{FusedNode::Kind::UNARY, kernel->second, *input};
+            fused.unary_ = kernel->first;
+            ++num_operations_;
+            return push(std::move(fused));
+        }
+
+        const bool is_arithmetic = operation >= OperationType::ADD && operation <= OperationType::DIV;
+        const bool is_comparison = operation >= OperationType::EQ && operation <= OperationType::GE;
+        // A comparison produces a bitset, so can only be the last step
+        if (!is_arithmetic && !(is_comparison && is_root))
+            return std::nullopt;
+
+        auto left = add_child(expr.left_);
+        if (!left)
+            return std::nullopt;
+
+        auto right = add_child(expr.right_);
+        if (!right)
+            return std::nullopt;
+
+        const auto& left_node = nodes_[*left];
+        const auto& right_node = nodes_[*right];
+        if (left_node.kind_ == FusedNode::Kind::VALUE && right_node.kind_ == FusedNode::Kind::VALUE)
+            return std::nullopt;
+
+        ++num_operations_;
+        if (is_comparison) {
+            auto kernel = comparison_kernel_for(operation, left_node.data_type_, right_node.data_type_);
+            if (!kernel)
+                return std::nullopt;
+
+            FusedNode fused{FusedNode::Kind::COMPARISON, DataType::BOOL8, *left, *right};
+            fused.comparison_ = *kernel;
+            return push(std::move(fused));
+        }
+
+        auto kernel = binary_kernel_for(operation, left_node.data_type_, right_node.data_type_);
+        if (!kernel)
+            return std::nullopt;
+
+        FusedNode fused{FusedNode::Kind::BINARY, kernel->second, *left, *right};
+        fused.binary_ = kernel->first;
+        return push(std::move(fused));
+    }
+
+    size_t push(FusedNode&& node) {
+        nodes_.emplace_back(std::move(node));
+        return nodes_.size() - 1;
+    }
+
+    ProcessingUnit& proc_;
+    std::vector<FusedNode> nodes_;
+    std::vector<std::shared_ptr<Column>> columns_;
+    size_t row_count_ = 0;
+    size_t num_operations_ = 0;
+};
+
+} // namespace
+
+std::optional<VariantData> compute_fused(const ExpressionNode& node, ProcessingUnit& proc) {
+    if (ConfigsMap::instance()->get_int("Expression.FusedKernels", 1) == 0)
+        return std::nullopt;
+
+    FusedExpression fused(proc);
+    if (!fused.compile(node))
+        return std::nullopt;
+
+    return fused.evaluate();
+}
+
+} //namespace arcticdb
@@ -0,0 +1,28 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <arcticdb/processing/expression_node.hpp>
+
+namespace arcticdb {
+
+/*
+ * Evaluates an arithmetic expression tree, or a comparison at the root of one, in a single pass over the input
+ * columns. The tree is compiled into kernels specialised for the types at each node. They are run over batches of
+ * rows small enough that the intermediate results stay in cache, and only the final column or bitset is allocated.
+ * A node whose children would otherwise each materialise a full-length column is the case this is for.
+ *
+ * Only dense columns of the common numeric types (32 and 64 bit integers and floats) and numeric values are fused,
+ * and only trees with at least two operations. Returns std::nullopt for anything else, which is then evaluated a node
+ * at a time as before. Results and output types are the same as the unfused evaluation.
+ */
+std::optional<VariantData> compute_fused(const ExpressionNode& node, ProcessingUnit& proc);
+
+} //namespace arcticdb
@@ -104,6 +104,29 @@ public:
     virtual ~ModuloBucketizer() = default;
 };
 
+// Splits one bucket of a ModuloBucketizer further, on the bits of the group that the modulo did not use
+class SubBucketizer : Bucketizer {
+    size_t divisor_;
+    uint8_t mod_;
+public:
+    SubBucketizer(size_t divisor, uint8_t mod) :
+        divisor_(divisor),
+        mod_(mod) {
+    }
+
+    ARCTICDB_MOVE_COPY_DEFAULT(SubBucketizer)
+
+    uint8_t bucket(size_t group) const {
+        return (group / divisor_) % mod_;
+    }
+
+    virtual uint8_t num_buckets() const {
+        return mod_;
+    }
+
+    virtual ~SubBucketizer() = default;
+};
+
 class IdentityBucketizer : Bucketizer {
 public:
     uint8_t bucket(size_t group) const {
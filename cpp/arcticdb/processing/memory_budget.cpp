@@ -0,0 +1,97 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/processing/memory_budget.hpp>
+#include <arcticdb/codec/codec.hpp>
+#include <arcticdb/codec/default_codecs.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/preconditions.hpp>
+#include <arcticdb/log/log.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace arcticdb {
+
+SpilledSegment::~SpilledSegment() {
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+    if (ec)
+        log::version().warn("Failed to remove spilled segment {}: {}", path_.string(), ec.message());
+}
+
+SegmentInMemory SpilledSegment::load() const {
+    std::vector<uint8_t> bytes(file_bytes_);
+    std::ifstream file(path_, std::ios::binary);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    util::check(file.good(), "Failed to read spilled segment {}", path_.string());
+    return decode_segment(Segment::from_bytes(bytes.data(), bytes.size(), true));
+}
+
+SpillDirectory::SpillDirectory(std::filesystem::path parent) {
+    // Unique across the reads of this process and any others sharing the parent directory
+    static std::atomic<uint64_t> read_count{0};
+    path_ = std::move(parent) / fmt::format("arcticdb-spill-{:x}-{:x}-{}",
+                                            std::random_device{}(),
+                                            std::chrono::steady_clock::now().time_since_epoch().count(),
+                                            read_count.fetch_add(1));
+}
+
+SpillDirectory::~SpillDirectory() {
+    if (segments_spilled() == 0)
+        return;
+
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+    if (ec)
+        log::version().warn("Failed to remove spill directory {}: {}", path_.string(), ec.message());
+}
+
+const std::filesystem::path& SpillDirectory::create_once() {
+    std::call_once(created_, [this]() {
+        std::filesystem::create_directories(path_);
+        log::version().info("Memory budget exceeded, spilling intermediate segments to {}", path_.string());
+    });
+    return path_;
+}
+
+std::shared_ptr<SpilledSegment> SpillDirectory::spill(const SegmentInMemory& segment, uint64_t entity_id) {
+    const auto path = create_once() / fmt::format("{}.seg", entity_id);
+    // Encoding only reads the segment, so a shallow copy sharing its columns is enough
+    auto encoded = encode_dispatch(SegmentInMemory(segment), codec::default_lz4_codec(), EncodingVersion::V1);
+    const auto header_bytes = encoded.segment_header_bytes_size();
+    std::vector<uint8_t> bytes(encoded.total_segment_size(header_bytes));
+    encoded.write_to(bytes.data(), header_bytes);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    file.close();
+    util::check(file.good(), "Failed to spill segment to {}", path.string());
+
+    segments_spilled_.fetch_add(1, std::memory_order_relaxed);
+    bytes_spilled_.fetch_add(bytes.size(), std::memory_order_relaxed);
+    ARCTICDB_DEBUG(log::version(), "Spilled segment {} of {} bytes in memory to {} bytes in {}",
+                   entity_id, segment.num_bytes(), bytes.size(), path.string());
+    return std::make_shared<SpilledSegment>(path, bytes.size());
+}
+
+uint64_t configured_memory_budget_bytes() {
+    const auto limit = ConfigsMap::instance()->get_int("Processing.MemoryBudgetBytes", 0);
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(limit >= 0,
+                                                          "Processing.MemoryBudgetBytes must not be negative, got {}", limit);
+    return static_cast<uint64_t>(limit);
+}
+
+std::filesystem::path configured_spill_path() {
+    if (auto path = ConfigsMap::instance()->get_string("Processing.SpillDirectory"); path.has_value())
+        return *path;
+    return std::filesystem::temp_directory_path();
+}
+
+} // namespace arcticdb
@@ -0,0 +1,173 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+
+#include <arcticdb/column_store/memory_segment.hpp>
+#include <arcticdb/util/constructors.hpp>
+
+namespace arcticdb {
+
+/*
+ * The number of bytes of intermediate segments that a single read may hold in the component manager at once. Clauses
+ * such as grouping and sorting hold on to everything they have seen until they produce their output, so without a
+ * limit a high-cardinality groupby or the sort of a large symbol allocates until the process is killed. Segments added
+ * while the budget is exhausted are spilled to local files instead, and read back when a clause asks for them.
+ *
+ * What clauses hold while they process, the segments they have fetched and e.g. the hash table of an aggregation, is
+ * counted too. That cannot be spilled, so it may take the budget over its limit, but it makes the segments added
+ * meanwhile spill sooner.
+ *
+ * A limit of zero means unlimited, which is the default.
+ */
+class MemoryBudget {
+public:
+    explicit MemoryBudget(uint64_t limit_bytes) :
+        limit_bytes_(limit_bytes) {
+    }
+    ARCTICDB_NO_MOVE_OR_COPY(MemoryBudget)
+
+    // Takes bytes from the budget if they fit in what is left of it, returning whether they did
+    bool try_reserve(uint64_t bytes) {
+        auto used = used_bytes_.load(std::memory_order_relaxed);
+        do {
+            if (limit_bytes_ != 0 && used + bytes > limit_bytes_)
+                return false;
+        } while (!used_bytes_.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+        update_peak(used + bytes);
+        return true;
+    }
+
+    // Takes bytes from the budget even if that goes over its limit, for memory that is already in use
+    void reserve(uint64_t bytes) {
+        update_peak(used_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    }
+
+    void release(uint64_t bytes) {
+        used_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t limit_bytes() const {
+        return limit_bytes_;
+    }
+
+    [[nodiscard]] uint64_t used_bytes() const {
+        return used_bytes_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t peak_bytes() const {
+        return peak_bytes_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void update_peak(uint64_t used) {
+        auto peak = peak_bytes_.load(std::memory_order_relaxed);
+        while (used > peak && !peak_bytes_.compare_exchange_weak(peak, used, std::memory_order_relaxed));
+    }
+
+    const uint64_t limit_bytes_;
+    std::atomic<uint64_t> used_bytes_{0};
+    std::atomic<uint64_t> peak_bytes_{0};
+};
+
+// Bytes taken from a budget, which are returned to it when the holder of the reservation is dropped
+class MemoryReservation {
+public:
+    MemoryReservation(std::shared_ptr<MemoryBudget> budget, uint64_t bytes) :
+        budget_(std::move(budget)),
+        bytes_(bytes) {
+    }
+    ARCTICDB_NO_MOVE_OR_COPY(MemoryReservation)
+
+    ~MemoryReservation() {
+        budget_->release(bytes_);
+    }
+
+    // Grows or shrinks the reservation as the memory it accounts for does. Growing always succeeds.
+    void resize(uint64_t bytes) {
+        if (bytes > bytes_)
+            budget_->reserve(bytes - bytes_);
+        else
+            budget_->release(bytes_ - bytes);
+        bytes_ = bytes;
+    }
+
+    [[nodiscard]] uint64_t bytes() const {
+        return bytes_;
+    }
+
+private:
+    std::shared_ptr<MemoryBudget> budget_;
+    uint64_t bytes_;
+};
+
+// A segment written to a local file, which is deleted when this is dropped
+class SpilledSegment {
+public:
+    SpilledSegment(std::filesystem::path path, uint64_t file_bytes) :
+        path_(std::move(path)),
+        file_bytes_(file_bytes) {
+    }
+    ARCTICDB_NO_MOVE_OR_COPY(SpilledSegment)
+
+    ~SpilledSegment();
+
+    [[nodiscard]] SegmentInMemory load() const;
+
+    [[nodiscard]] uint64_t file_bytes() const {
+        return file_bytes_;
+    }
+
+private:
+    std::filesystem::path path_;
+    uint64_t file_bytes_;
+};
+
+/*
+ * The directory one read spills segments to. It is a uniquely named subdirectory of the configured spill path, created
+ * the first time a segment is spilled, and removed along with anything still in it when the read is finished.
+ */
+class SpillDirectory {
+public:
+    explicit SpillDirectory(std::filesystem::path parent);
+    ARCTICDB_NO_MOVE_OR_COPY(SpillDirectory)
+
+    ~SpillDirectory();
+
+    // Segments are written LZ4 compressed in the storage format, one file per entity
+    std::shared_ptr<SpilledSegment> spill(const SegmentInMemory& segment, uint64_t entity_id);
+
+    [[nodiscard]] uint64_t segments_spilled() const {
+        return segments_spilled_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t bytes_spilled() const {
+        return bytes_spilled_.load(std::memory_order_relaxed);
+    }
+
+private:
+    const std::filesystem::path& create_once();
+
+    std::filesystem::path path_;
+    std::once_flag created_;
+    std::atomic<uint64_t> segments_spilled_{0};
+    std::atomic<uint64_t> bytes_spilled_{0};
+};
+
+// The budget for the intermediate segments of one read, from Processing.MemoryBudgetBytes
+uint64_t configured_memory_budget_bytes();
+
+// Where reads spill to, from Processing.SpillDirectory, or the system temporary directory if that is not set
+std::filesystem::path configured_spill_path();
+
+} // namespace arcticdb
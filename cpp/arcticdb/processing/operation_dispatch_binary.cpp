@@ -7,6 +7,7 @@
  */
 
 #include <arcticdb/processing/operation_dispatch_binary.hpp>
+#include <arcticdb/processing/operation_dispatch_string.hpp>
 
 namespace arcticdb {
 
@@ -154,6 +155,11 @@ VariantData dispatch_binary(const VariantData& left, const VariantData& right, O
         case OperationType::OR:
         case OperationType::XOR:
             return visit_binary_boolean(left, right, operation);
+        case OperationType::STARTSWITH:
+        case OperationType::ENDSWITH:
+        case OperationType::CONTAINS:
+        case OperationType::REGEX_MATCH:
+            return visit_string_predicate(left, right, operation);
         default:
             util::raise_rte("Unknown operation {}", int(operation));
     }
@@ -100,25 +100,29 @@ VariantData binary_membership(const ColumnWithStrings& column_with_strings, Valu
                     using ValueSetBaseType =  typename decltype(value_set_desc_tag)::DataTypeTag::raw_type;
 
                     using WideType = typename type_arithmetic_promoted_type<ColumnType, ValueSetBaseType, std::remove_reference_t<Func>>::type;
-                    auto typed_value_set = value_set.get_set<WideType>();
+                    auto typed_value_set = value_set.get_membership_set<WideType>();
                     auto column_data = column_with_strings.column_->data();
 
                     util::BitSet::bulk_insert_iterator inserter(*output);
                     auto pos = 0u;
-                    while (auto block = column_data.next<ScalarTagType<ColumnTagType>>()) {
-                        auto ptr = reinterpret_cast<const ColumnType*>(block->data());
-                        const auto row_count = block->row_count();
-                        for (auto i = 0u; i < row_count; ++i, ++pos) {
-                            if constexpr (MembershipOperator::needs_uint64_special_handling<ColumnType, ValueSetBaseType>) {
-                                // Avoid narrowing conversion on *ptr:
-                                if (func(*ptr++, *typed_value_set, UInt64SpecialHandlingTag{}))
-                                    inserter = pos;
-                            } else {
-                                if (func(static_cast<WideType>(*ptr++), *typed_value_set))
-                                    inserter = pos;
+                    // The probe loop is instantiated for each representation of the set, so that the lookup is inlined
+                    // into it rather than dispatched per row
+                    std::visit([&](const auto& members) {
+                        while (auto block = column_data.next<ScalarTagType<ColumnTagType>>()) {
+                            auto ptr = reinterpret_cast<const ColumnType*>(block->data());
+                            const auto row_count = block->row_count();
+                            for (auto i = 0u; i < row_count; ++i, ++pos) {
+                                if constexpr (MembershipOperator::needs_uint64_special_handling<ColumnType, ValueSetBaseType>) {
+                                    // Avoid narrowing conversion on *ptr:
+                                    if (func(*ptr++, members, UInt64SpecialHandlingTag{}))
+                                        inserter = pos;
+                                } else {
+                                    if (func(static_cast<WideType>(*ptr++), members))
+                                        inserter = pos;
+                                }
                             }
                         }
-                    }
+                    }, *typed_value_set);
                     inserter.flush();
                 } else {
                     util::raise_rte("Cannot check membership of {} in set of {} (possible categorical?)",
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/processing/operation_dispatch_string.hpp>
+#include <arcticdb/processing/operation_dispatch.hpp>
+#include <arcticdb/pipeline/value.hpp>
+#include <arcticdb/util/regex_filter.hpp>
+#include <arcticdb/util/variant.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace arcticdb {
+
+namespace {
+
+std::string_view string_operation_name(OperationType operation) {
+    switch(operation) {
+        case OperationType::LOWER: return "lower";
+        case OperationType::UPPER: return "upper";
+        case OperationType::LEN: return "len";
+        case OperationType::STARTSWITH: return "startswith";
+        case OperationType::ENDSWITH: return "endswith";
+        case OperationType::CONTAINS: return "contains";
+        case OperationType::REGEX_MATCH: return "regex match";
+        default:
+            util::raise_rte("Unexpected string operation {}", int(operation));
+    }
+}
+
+void check_string_column(const ColumnWithStrings& column_with_strings, OperationType operation) {
+    const auto& type = column_with_strings.column_->type();
+    schema::check<ErrorCode::E_UNSUPPORTED_COLUMN_TYPE>(
+            is_dynamic_string_type(type.data_type()) && type.dimension() == Dimension::Dim0,
+            "String operation {} is only supported on dynamic string columns, not {}", string_operation_name(operation), type);
+    util::check(static_cast<bool>(column_with_strings.string_pool_), "String column without a string pool in string operation");
+}
+
+std::string string_argument(const Value& value, OperationType operation) {
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(
+            is_sequence_type(value.data_type_),
+            "String operation {} expects a string argument, not {}", string_operation_name(operation), value.type());
+    return {*value.str_data(), value.len()};
+}
+
+char ascii_lower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+char ascii_upper(char c) {
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+VariantData evaluate_string_predicate(const ColumnWithStrings& column_with_strings, const std::string& argument, OperationType operation) {
+    switch(operation) {
+        case OperationType::STARTSWITH:
+            return string_predicate(column_with_strings, [&argument](std::string_view str) {
+                return str.substr(0, argument.size()) == argument;
+            });
+        case OperationType::ENDSWITH:
+            return string_predicate(column_with_strings, [&argument](std::string_view str) {
+                return str.size() >= argument.size() && str.substr(str.size() - argument.size()) == argument;
+            });
+        case OperationType::CONTAINS:
+            return string_predicate(column_with_strings, [&argument](std::string_view str) {
+                return str.find(argument) != std::string_view::npos;
+            });
+        case OperationType::REGEX_MATCH: {
+            util::RegexPattern pattern{argument};
+            util::LinearRegex regex{pattern};
+            return string_predicate(column_with_strings, [&regex](std::string_view str) {
+                return regex.search(str);
+            });
+        }
+        default:
+            util::raise_rte("Unexpected operator in evaluate_string_predicate {}", int(operation));
+    }
+}
+
+} // namespace
+
+VariantData string_length(const ColumnWithStrings& column_with_strings) {
+    const auto& column = *column_with_strings.column_;
+    auto evaluate = [&column_with_strings](StringPool::offset_t offset) {
+        return static_cast<double>(column_with_strings.string_pool_->get_const_view(offset).size());
+    };
+    PerStringCache<double, decltype(evaluate)> cache(std::move(evaluate));
+
+    const auto row_count = static_cast<size_t>(column.row_count());
+    auto output = std::make_shared<Column>(make_scalar_type(DataType::FLOAT64), row_count, true, false);
+    if (row_count > 0) {
+        auto ptr = reinterpret_cast<double*>(output->ptr());
+        for_each_string_offset(column, [ptr, &cache](size_t pos, StringPool::offset_t offset) {
+            ptr[pos] = is_a_string(offset) ? cache(offset) : std::numeric_limits<double>::quiet_NaN();
+        });
+        output->set_row_data(row_count - 1);
+    }
+    return {ColumnWithStrings(std::move(output), {})};
+}
+
+VariantData visit_string_transform(const VariantData& left, OperationType operation) {
+    return std::visit(util::overload{
+        [operation] (const ColumnWithStrings& l) -> VariantData {
+            schema::check<ErrorCode::E_UNSUPPORTED_COLUMN_TYPE>(
+                    !is_empty_type(l.column_->type().data_type()),
+                    "Empty column provided to string operation {}", string_operation_name(operation));
+            check_string_column(l, operation);
+            switch(operation) {
+                case OperationType::LOWER:
+                    return string_transform(l, [](std::string_view str, std::string& output) {
+                        output.resize(str.size());
+                        std::transform(str.begin(), str.end(), output.begin(), ascii_lower);
+                    });
+                case OperationType::UPPER:
+                    return string_transform(l, [](std::string_view str, std::string& output) {
+                        output.resize(str.size());
+                        std::transform(str.begin(), str.end(), output.begin(), ascii_upper);
+                    });
+                case OperationType::LEN:
+                    return string_length(l);
+                default:
+                    util::raise_rte("Unexpected operator in visit_string_transform {}", int(operation));
+            }
+        },
+        [] (EmptyResult l) -> VariantData {
+            return l;
+        },
+        [operation] (const auto&) -> VariantData {
+            user_input::raise<ErrorCode::E_INVALID_USER_ARGUMENT>("String operation {} must be applied to a column", string_operation_name(operation));
+        }
+    }, left);
+}
+
+VariantData visit_string_predicate(const VariantData& left, const VariantData& right, OperationType operation) {
+    if (std::holds_alternative<EmptyResult>(left))
+        return EmptyResult{};
+
+    return std::visit(util::overload{
+        [operation] (const ColumnWithStrings& l, const std::shared_ptr<Value>& r) -> VariantData {
+            const auto argument = string_argument(*r, operation);
+            // Nothing to match in a column of only missing values
+            if (is_empty_type(l.column_->type().data_type()))
+                return EmptyResult{};
+
+            check_string_column(l, operation);
+            return transform_to_placeholder(evaluate_string_predicate(l, argument, operation));
+        },
+        [operation] (const auto&, const auto&) -> VariantData {
+            user_input::raise<ErrorCode::E_INVALID_USER_ARGUMENT>("String operation {} must be between a column and a string", string_operation_name(operation));
+        }
+    }, left, right);
+}
+
+Column copy_strings_to_pool(const ColumnWithStrings& column_with_strings, StringPool& string_pool) {
+    const auto& column = *column_with_strings.column_;
+    auto evaluate = [&column_with_strings, &string_pool](StringPool::offset_t offset) {
+        return string_pool.get(column_with_strings.string_pool_->get_const_view(offset)).offset();
+    };
+    PerStringCache<StringPool::offset_t, decltype(evaluate)> cache(std::move(evaluate));
+
+    const auto row_count = static_cast<size_t>(column.row_count());
+    Column output(column.type(), row_count, true, false);
+    if (row_count > 0) {
+        auto ptr = reinterpret_cast<StringPool::offset_t*>(output.ptr());
+        for_each_string_offset(column, [ptr, &cache](size_t pos, StringPool::offset_t offset) {
+            ptr[pos] = is_a_string(offset) ? cache(offset) : offset;
+        });
+        output.set_row_data(row_count - 1);
+    }
+    return output;
+}
+
+} //namespace arcticdb
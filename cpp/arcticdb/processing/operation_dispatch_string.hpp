@@ -0,0 +1,150 @@
+/*
+ * Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <arcticdb/column_store/column.hpp>
+#include <arcticdb/column_store/string_pool.hpp>
+#include <arcticdb/processing/expression_node.hpp>
+#include <arcticdb/processing/operation_types.hpp>
+#include <arcticdb/util/bitset.hpp>
+#include <arcticdb/util/offset_string.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#ifdef ARCTICDB_USING_CONDA
+    #include <robin_hood.h>
+#else
+    #include <arcticdb/util/third_party/robin_hood.hpp>
+#endif
+
+namespace arcticdb {
+
+/*
+ * String operations work on the offsets a string column holds into its string pool rather than on the strings
+ * themselves. Columns typically hold far fewer distinct strings than rows, so each operation is evaluated once per
+ * distinct offset, with the results cached by offset and then broadcast to the rows holding it. The cost of anything
+ * more expensive than reading the offsets, such as matching a regex, is then proportional to the cardinality of the
+ * column rather than to its length.
+ *
+ * Only dynamic string columns are supported. Case mapping is of ASCII characters only, in keeping with the rest of the
+ * string support in processing.
+ */
+
+// Calls func once per distinct offset it is asked about, and returns the cached result after that
+template<typename Result, typename Func>
+class PerStringCache {
+public:
+    explicit PerStringCache(Func&& func) :
+        func_(std::move(func)) {
+    }
+
+    Result operator()(StringPool::offset_t offset) {
+        // Repeated strings often come in runs, which this avoids hashing
+        if (offset == last_offset_)
+            return last_result_;
+
+        auto it = results_.find(offset);
+        if (it == results_.end())
+            it = results_.emplace(offset, func_(offset)).first;
+
+        last_offset_ = offset;
+        last_result_ = it->second;
+        return last_result_;
+    }
+
+    [[nodiscard]] size_t evaluations() const {
+        return results_.size();
+    }
+
+private:
+    Func func_;
+    robin_hood::unordered_flat_map<StringPool::offset_t, Result> results_;
+    StringPool::offset_t last_offset_ = not_a_string();
+    Result last_result_{};
+};
+
+template<typename Func>
+void for_each_string_offset(const Column& column, Func&& func) {
+    column.type().visit_tag([&column, &func](auto column_desc_tag) {
+        using ColumnDescriptorType = std::decay_t<decltype(column_desc_tag)>;
+        if constexpr (is_dynamic_string_type(ColumnDescriptorType::DataTypeTag::data_type)) {
+            auto column_data = column.data();
+            size_t pos = 0;
+            while (auto block = column_data.next<ColumnDescriptorType>()) {
+                auto ptr = reinterpret_cast<const StringPool::offset_t*>(block->data());
+                const auto row_count = block->row_count();
+                for (auto i = 0u; i < row_count; ++i, ++pos)
+                    func(pos, *ptr++);
+            }
+        } else {
+            util::raise_rte("Unexpected column type {} in string operation", column.type());
+        }
+    });
+}
+
+// Rows holding a string that the predicate is true for. Missing strings never match.
+template<typename Predicate>
+VariantData string_predicate(const ColumnWithStrings& column_with_strings, Predicate&& predicate) {
+    auto output = std::make_shared<util::BitSet>(static_cast<util::BitSetSizeType>(column_with_strings.column_->row_count()));
+    auto evaluate = [&column_with_strings, &predicate](StringPool::offset_t offset) {
+        return predicate(column_with_strings.string_pool_->get_const_view(offset));
+    };
+    PerStringCache<bool, decltype(evaluate)> cache(std::move(evaluate));
+
+    util::BitSet::bulk_insert_iterator inserter(*output);
+    for_each_string_offset(*column_with_strings.column_, [&inserter, &cache](size_t pos, StringPool::offset_t offset) {
+        if (is_a_string(offset) && cache(offset))
+            inserter = pos;
+    });
+    inserter.flush();
+    ARCTICDB_DEBUG(log::version(), "Evaluated string predicate on {} distinct strings for {} rows, selecting {}",
+                   cache.evaluations(), output->size(), output->count());
+    return VariantData{std::move(output)};
+}
+
+// A string column of the same type, holding the transformed strings in a new string pool. Missing strings stay missing.
+template<typename Transform>
+VariantData string_transform(const ColumnWithStrings& column_with_strings, Transform&& transform) {
+    const auto& column = *column_with_strings.column_;
+    auto string_pool = std::make_shared<StringPool>();
+    auto evaluate = [&column_with_strings, &transform, &string_pool, transformed = std::string{}](StringPool::offset_t offset) mutable {
+        transformed.clear();
+        transform(column_with_strings.string_pool_->get_const_view(offset), transformed);
+        return string_pool->get(transformed).offset();
+    };
+    PerStringCache<StringPool::offset_t, decltype(evaluate)> cache(std::move(evaluate));
+
+    const auto row_count = static_cast<size_t>(column.row_count());
+    auto output = std::make_shared<Column>(column.type(), row_count, true, false);
+    if (row_count > 0) {
+        auto ptr = reinterpret_cast<StringPool::offset_t*>(output->ptr());
+        for_each_string_offset(column, [ptr, &cache](size_t pos, StringPool::offset_t offset) {
+            ptr[pos] = is_a_string(offset) ? cache(offset) : offset;
+        });
+        output->set_row_data(row_count - 1);
+    }
+    return {ColumnWithStrings(std::move(output), string_pool)};
+}
+
+// The length of each string, as a float column so that missing strings can be NaN, as pandas does
+VariantData string_length(const ColumnWithStrings& column_with_strings);
+
+VariantData visit_string_transform(const VariantData& left, OperationType operation);
+
+VariantData visit_string_predicate(const VariantData& left, const VariantData& right, OperationType operation);
+
+/*
+ * Copies a string column into another string pool, e.g. that of the segment it is being added to, each distinct string
+ * once.
+ */
+Column copy_strings_to_pool(const ColumnWithStrings& column_with_strings, StringPool& string_pool);
+
+} //namespace arcticdb
@@ -7,6 +7,7 @@
  */
 
 #include <arcticdb/processing/operation_dispatch_unary.hpp>
+#include <arcticdb/processing/operation_dispatch_string.hpp>
 
 namespace arcticdb {
 
@@ -70,6 +71,10 @@ VariantData dispatch_unary(const VariantData& left, OperationType operation) {
         case OperationType::IDENTITY:
         case OperationType::NOT:
             return visit_unary_boolean(left, operation);
+        case OperationType::LOWER:
+        case OperationType::UPPER:
+        case OperationType::LEN:
+            return visit_string_transform(left, operation);
         default:
             util::raise_rte("Unknown operation {}", int(operation));
     }
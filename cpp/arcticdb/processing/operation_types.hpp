@@ -10,6 +10,7 @@
 #include <unordered_set>
 #include <optional>
 
+#include <arcticdb/pipeline/membership_set.hpp>
 #include <arcticdb/processing/signed_unsigned_comparison.hpp>
 #include <arcticdb/util/preconditions.hpp>
 #ifdef ARCTICDB_USING_CONDA
@@ -19,7 +20,7 @@
 #endif
 
 namespace arcticdb {
-// If reordering this enum, is_binary_operation may also need to be changed
+// New operations go at the end of this enum, and binary ones must also be added to is_binary_operation
 enum class OperationType : uint8_t {
     // Unary
     // Operator
@@ -46,11 +47,44 @@ enum class OperationType : uint8_t {
     // Boolean
     AND,
     OR,
-    XOR
+    XOR,
+    // String
+    STARTSWITH,
+    ENDSWITH,
+    CONTAINS,
+    REGEX_MATCH,
+    // Unary
+    // String
+    LOWER,
+    UPPER,
+    LEN
 };
 
 constexpr bool is_binary_operation(OperationType o) {
-    return uint8_t(o) >= uint8_t(OperationType::ADD);
+    switch (o) {
+        case OperationType::ADD:
+        case OperationType::SUB:
+        case OperationType::MUL:
+        case OperationType::DIV:
+        case OperationType::EQ:
+        case OperationType::NE:
+        case OperationType::LT:
+        case OperationType::LE:
+        case OperationType::GT:
+        case OperationType::GE:
+        case OperationType::ISIN:
+        case OperationType::ISNOTIN:
+        case OperationType::AND:
+        case OperationType::OR:
+        case OperationType::XOR:
+        case OperationType::STARTSWITH:
+        case OperationType::ENDSWITH:
+        case OperationType::CONTAINS:
+        case OperationType::REGEX_MATCH:
+            return true;
+        default:
+            return false;
+    }
 }
 
 struct AbsOperator;
@@ -402,6 +436,26 @@ public:
 struct UInt64SpecialHandlingTag {};
 
 struct IsInOperator: MembershipOperator {
+template<typename T, typename Derived, typename U>
+bool operator()(T t, const MembershipRepresentation<Derived, U>& u) const {
+    return u.derived().contains(t);
+}
+
+template<typename Derived, typename U, typename=std::enable_if_t<is_signed_int<U>>>
+bool operator()(uint64_t t, const MembershipRepresentation<Derived, U>& u, UInt64SpecialHandlingTag = {}) const {
+    if (t > static_cast<uint64_t>(std::numeric_limits<U>::max()))
+        return false;
+    else
+        return u.derived().contains(static_cast<U>(t));
+}
+template<typename Derived>
+bool operator()(int64_t t, const MembershipRepresentation<Derived, uint64_t>& u, UInt64SpecialHandlingTag = {}) const {
+    if (t < 0)
+        return false;
+    else
+        return u.derived().contains(static_cast<uint64_t>(t));
+}
+
 template<typename T, typename U>
 bool operator()(T t, const std::unordered_set<U>& u) const {
     return u.count(t) > 0;
@@ -442,6 +496,26 @@ bool operator()(T t, const robin_hood::unordered_set<U>& u) const {
 };
 
 struct IsNotInOperator: MembershipOperator {
+template<typename T, typename Derived, typename U>
+bool operator()(T t, const MembershipRepresentation<Derived, U>& u) const {
+    return !u.derived().contains(t);
+}
+
+template<typename Derived, typename U, typename=std::enable_if_t<is_signed_int<U>>>
+bool operator()(uint64_t t, const MembershipRepresentation<Derived, U>& u, UInt64SpecialHandlingTag = {}) const {
+    if (t > static_cast<uint64_t>(std::numeric_limits<U>::max()))
+        return true;
+    else
+        return !u.derived().contains(static_cast<U>(t));
+}
+template<typename Derived>
+bool operator()(int64_t t, const MembershipRepresentation<Derived, uint64_t>& u, UInt64SpecialHandlingTag = {}) const {
+    if (t < 0)
+        return true;
+    else
+        return !u.derived().contains(static_cast<uint64_t>(t));
+}
+
 template<typename T, typename U>
 bool operator()(T t, const std::unordered_set<U>& u) const {
     return u.count(t) == 0;
@@ -163,17 +163,31 @@ namespace arcticdb {
         return {std::move(row_to_bucket), std::move(bucket_counts)};
     }
 
+    // The number of buckets a groupby partitions its input into, from Partition.NumBuckets
+    inline uint8_t partition_num_buckets() {
+        auto num_buckets = ConfigsMap::instance()->get_int("Partition.NumBuckets",
+                                                           async::TaskScheduler::instance()->cpu_thread_count());
+        if (num_buckets > std::numeric_limits<uint8_t>::max()) {
+            log::version().warn("GroupBy partitioning buckets capped at {} (received {})",
+                                std::numeric_limits<uint8_t>::max(),
+                                num_buckets);
+            num_buckets = std::numeric_limits<uint8_t>::max();
+        }
+        return static_cast<uint8_t>(num_buckets);
+    }
+
     template<typename GrouperType, typename BucketizerType>
     Composite<ProcessingUnit> partition_processing_segment(
             ProcessingUnit& input,
             const ColumnName& grouping_column_name,
-            bool dynamic_schema) {
+            bool dynamic_schema,
+            const BucketizerType& bucketizer) {
 
         Composite<ProcessingUnit> output;
         auto get_result = input.get(ColumnName(grouping_column_name));
         if (std::holds_alternative<ColumnWithStrings>(get_result)) {
             auto partitioning_column = std::get<ColumnWithStrings>(get_result);
-            partitioning_column.column_->type().visit_tag([&output, &input, &partitioning_column](auto type_desc_tag) {
+            partitioning_column.column_->type().visit_tag([&output, &input, &partitioning_column, &bucketizer](auto type_desc_tag) {
                 using TypeDescriptorTag = decltype(type_desc_tag);
                 using DescriptorType = std::decay_t<TypeDescriptorTag>;
                 using TagType =  typename DescriptorType::DataTypeTag;
@@ -182,16 +196,7 @@ namespace arcticdb {
                 // Partitioning on an empty column should return an empty composite
                 if constexpr(!is_empty_type(TagType::data_type)) {
                     ResolvedGrouperType grouper;
-                    auto num_buckets = ConfigsMap::instance()->get_int("Partition.NumBuckets",
-                                                                       async::TaskScheduler::instance()->cpu_thread_count());
-                    if (num_buckets > std::numeric_limits<uint8_t>::max()) {
-                        log::version().warn("GroupBy partitioning buckets capped at {} (received {})",
-                                            std::numeric_limits<uint8_t>::max(),
-                                            num_buckets);
-                        num_buckets = std::numeric_limits<uint8_t>::max();
-                    }
-                    std::vector<ProcessingUnit> procs{static_cast<bucket_id>(num_buckets)};
-                    BucketizerType bucketizer(num_buckets);
+                    std::vector<ProcessingUnit> procs{static_cast<bucket_id>(bucketizer.num_buckets())};
                     auto [row_to_bucket, bucket_counts] = get_buckets(partitioning_column, grouper, bucketizer);
                     for (auto&& [input_idx, seg]: folly::enumerate(input.segments_.value())) {
                         auto new_segs = partition_segment(*seg, row_to_bucket, bucket_counts);
@@ -225,4 +230,12 @@ namespace arcticdb {
         return output;
     }
 
+    template<typename GrouperType, typename BucketizerType>
+    Composite<ProcessingUnit> partition_processing_segment(
+            ProcessingUnit& input,
+            const ColumnName& grouping_column_name,
+            bool dynamic_schema) {
+        return partition_processing_segment<GrouperType>(input, grouping_column_name, dynamic_schema, BucketizerType(partition_num_buckets()));
+    }
+
 } //namespace arcticdb
\ No newline at end of file
@@ -0,0 +1,208 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/processing/sketches.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <folly/lang/Bits.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace arcticdb {
+
+/***************
+ * HyperLogLog *
+ ***************/
+
+HyperLogLog::HyperLogLog(uint8_t precision) :
+        precision_(precision) {
+    util::check(precision_ >= 4 && precision_ <= 18, "HyperLogLog precision must be between 4 and 18, got {}", precision_);
+}
+
+void HyperLogLog::add(HashedValue hash) {
+    if (ARCTICDB_UNLIKELY(registers_.empty()))
+        registers_.resize(size_t(1) << precision_);
+
+    const auto index = hash >> (64 - precision_);
+    // The set bit caps the rank, so that a hash with all zeros in the remaining bits still gives a finite one
+    const uint64_t remaining = (hash << precision_) | (uint64_t(1) << (precision_ - 1));
+    const auto rank = static_cast<uint8_t>(64 - folly::findLastSet(remaining) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    util::check(precision_ == other.precision_, "Cannot merge HyperLogLog sketches with precisions {} and {}", precision_, other.precision_);
+    if (other.registers_.empty())
+        return;
+
+    if (registers_.empty()) {
+        registers_ = other.registers_;
+        return;
+    }
+    for (size_t idx = 0; idx < registers_.size(); ++idx)
+        registers_[idx] = std::max(registers_[idx], other.registers_[idx]);
+}
+
+double HyperLogLog::estimate() const {
+    if (registers_.empty())
+        return 0.0;
+
+    const auto m = static_cast<double>(registers_.size());
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (auto reg: registers_) {
+        sum += std::ldexp(1.0, -reg);
+        zeros += reg == 0;
+    }
+    const double alpha = 0.7213 / (1.0 + 1.079 / m);
+    const double raw = alpha * m * m / sum;
+    // Linear counting is more accurate while many registers are still empty. With 64-bit hashes no correction is
+    // needed at the top of the range.
+    if (raw <= 2.5 * m && zeros > 0)
+        return m * std::log(m / static_cast<double>(zeros));
+
+    return raw;
+}
+
+/***********
+ * TDigest *
+ ***********/
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+
+// The k1 scale function of Dunning and Ertl, under which a centroid may span at most one unit of k
+struct ScaleFunction {
+    double normalizer_;
+
+    explicit ScaleFunction(double compression) :
+        normalizer_(compression / (2.0 * pi)) {
+    }
+
+    [[nodiscard]] double k(double q) const {
+        return normalizer_ * std::asin(2.0 * std::clamp(q, 0.0, 1.0) - 1.0);
+    }
+
+    [[nodiscard]] double q(double k) const {
+        return (std::sin(std::clamp(k / normalizer_, -pi / 2.0, pi / 2.0)) + 1.0) / 2.0;
+    }
+};
+
+} // namespace
+
+TDigest::TDigest(double compression) :
+        compression_(compression),
+        min_(std::numeric_limits<double>::infinity()),
+        max_(-std::numeric_limits<double>::infinity()) {
+    util::check(compression_ >= 10.0, "TDigest compression must be at least 10, got {}", compression_);
+}
+
+void TDigest::add(double value) {
+    buffer_.push_back(Centroid{value, 1.0});
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    if (buffer_.size() >= static_cast<size_t>(5 * compression_))
+        compress();
+}
+
+void TDigest::merge(const TDigest& other) {
+    if (other.count() == 0.0)
+        return;
+
+    buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+    buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    compress();
+}
+
+void TDigest::compress() const {
+    if (buffer_.empty())
+        return;
+
+    buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+    std::sort(buffer_.begin(), buffer_.end(), [](const Centroid& left, const Centroid& right) {
+        return left.mean_ < right.mean_;
+    });
+    double total = 0.0;
+    for (const auto& centroid: buffer_)
+        total += centroid.weight_;
+
+    const ScaleFunction scale(compression_);
+    centroids_.clear();
+    auto current = buffer_.front();
+    double weight_so_far = 0.0;
+    double weight_limit = total * scale.q(scale.k(0.0) + 1.0);
+    for (auto it = std::next(buffer_.begin()); it != buffer_.end(); ++it) {
+        if (weight_so_far + current.weight_ + it->weight_ <= weight_limit) {
+            current.weight_ += it->weight_;
+            current.mean_ += (it->mean_ - current.mean_) * it->weight_ / current.weight_;
+        } else {
+            weight_so_far += current.weight_;
+            centroids_.push_back(current);
+            weight_limit = total * scale.q(scale.k(weight_so_far / total) + 1.0);
+            current = *it;
+        }
+    }
+    centroids_.push_back(current);
+    buffer_.clear();
+}
+
+double TDigest::count() const {
+    double res = 0.0;
+    for (const auto& centroid: centroids_)
+        res += centroid.weight_;
+    for (const auto& centroid: buffer_)
+        res += centroid.weight_;
+    return res;
+}
+
+size_t TDigest::centroid_count() const {
+    compress();
+    return centroids_.size();
+}
+
+double TDigest::quantile(double q) const {
+    compress();
+    if (centroids_.empty())
+        return std::numeric_limits<double>::quiet_NaN();
+
+    // Each centroid sits at the middle of the ranks it covers, so with one value per centroid this is the position
+    // pandas interpolates at, q * (count - 1), between values at positions 0, 1, ...
+    const double index = q * (count() - 1.0) + 0.5;
+    const auto& first = centroids_.front();
+    if (index < first.weight_ / 2.0) {
+        // Between the minimum, at the start of the first centroid, and its mean
+        const double t = (index - 0.5) / (first.weight_ / 2.0 - 0.5);
+        return min_ + std::clamp(t, 0.0, 1.0) * (first.mean_ - min_);
+    }
+
+    double cumulative = first.weight_ / 2.0;
+    for (size_t idx = 0; idx + 1 < centroids_.size(); ++idx) {
+        const auto& left = centroids_[idx];
+        const auto& right = centroids_[idx + 1];
+        const double step = (left.weight_ + right.weight_) / 2.0;
+        if (index <= cumulative + step) {
+            const double t = (index - cumulative) / step;
+            return left.mean_ + std::clamp(t, 0.0, 1.0) * (right.mean_ - left.mean_);
+        }
+        cumulative += step;
+    }
+
+    // Between the mean of the last centroid and the maximum, at its end
+    const auto& last = centroids_.back();
+    if (last.weight_ <= 1.0)
+        return last.mean_;
+
+    const double t = (index - cumulative) / (last.weight_ / 2.0 - 0.5);
+    return last.mean_ + std::clamp(t, 0.0, 1.0) * (max_ - last.mean_);
+}
+
+} // namespace arcticdb
@@ -0,0 +1,96 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/util/hash.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arcticdb {
+
+/*
+ * Estimates the number of distinct values added to it, from their 64-bit hashes. Holds 2^precision one-byte registers
+ * whatever the number of values, and the relative standard error of the estimate is about 1.04 / sqrt(2^precision),
+ * so 1.6% with the default precision. Merging two sketches gives exactly the sketch of all the values added to either.
+ */
+class HyperLogLog {
+public:
+    static constexpr uint8_t DEFAULT_PRECISION = 12;
+
+    explicit HyperLogLog(uint8_t precision = DEFAULT_PRECISION);
+
+    void add(HashedValue hash);
+
+    void merge(const HyperLogLog& other);
+
+    [[nodiscard]] double estimate() const;
+
+    // Memory held, for accounting against a memory budget
+    [[nodiscard]] size_t bytes() const {
+        return sizeof(HyperLogLog) + registers_.capacity();
+    }
+
+private:
+    uint8_t precision_;
+    // Only allocated once a value is added, so that groups without values cost nothing
+    std::vector<uint8_t> registers_;
+};
+
+/*
+ * Estimates quantiles of the values added to it, as a merging t-digest. Values are summarised as centroids of their
+ * mean and weight, sized so that those near the tails hold few values and those near the median many, which keeps the
+ * error in the rank of an estimated quantile small relative to min(q, 1 - q). There are at most about compression
+ * centroids however many values are added.
+ *
+ * Quantiles are interpolated between the centroids in the same way pandas interpolates between values, so a digest
+ * holding few enough values to keep one centroid each gives the exact quantile.
+ */
+class TDigest {
+public:
+    static constexpr double DEFAULT_COMPRESSION = 100.0;
+
+    explicit TDigest(double compression = DEFAULT_COMPRESSION);
+
+    // NaN values must not be added
+    void add(double value);
+
+    void merge(const TDigest& other);
+
+    // NaN if no values have been added
+    [[nodiscard]] double quantile(double q) const;
+
+    [[nodiscard]] double count() const;
+
+    // The number of centroids once all added values are merged
+    [[nodiscard]] size_t centroid_count() const;
+
+    // Memory held, for accounting against a memory budget
+    [[nodiscard]] size_t bytes() const {
+        return sizeof(TDigest) + (centroids_.capacity() + buffer_.capacity()) * sizeof(Centroid);
+    }
+
+private:
+    struct Centroid {
+        double mean_;
+        double weight_;
+    };
+
+    void compress() const;
+
+    double compression_;
+    // Values are buffered and merged into the centroids in batches, which is both cheaper and more accurate than
+    // merging them one at a time. compress is const so that quantile can flush the buffer first.
+    mutable std::vector<Centroid> centroids_;
+    mutable std::vector<Centroid> buffer_;
+    double min_;
+    double max_;
+};
+
+} // namespace arcticdb
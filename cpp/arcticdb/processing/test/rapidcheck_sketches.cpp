@@ -0,0 +1,147 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+#include <arcticdb/util/test/rapidcheck.hpp>
+#include <arcticdb/processing/sketches.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+using namespace arcticdb;
+
+// Distinct values, each added a random number of times
+std::vector<int64_t> values_with_repeats(size_t distinct, uint32_t seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<size_t> repeats(1, 3);
+    std::vector<int64_t> res;
+    for (size_t idx = 0; idx < distinct; ++idx) {
+        const auto value = static_cast<int64_t>(idx * 0x9E3779B97F4A7C15ULL + seed);
+        res.insert(res.end(), repeats(gen), value);
+    }
+    std::shuffle(res.begin(), res.end(), gen);
+    return res;
+}
+
+// Skewed like latencies, with some values repeated
+std::vector<double> latencies(size_t count, uint32_t seed) {
+    std::mt19937_64 gen(seed);
+    std::lognormal_distribution<double> latency(3.0, 1.0);
+    std::bernoulli_distribution repeat(0.1);
+    std::vector<double> res;
+    for (size_t idx = 0; idx < count; ++idx)
+        res.emplace_back(repeat(gen) && !res.empty() ? res.back() : latency(gen));
+    return res;
+}
+
+// The linear interpolation pandas uses by default
+double exact_quantile(std::vector<double> values, double q) {
+    std::sort(values.begin(), values.end());
+    const double position = q * static_cast<double>(values.size() - 1);
+    const auto lower = static_cast<size_t>(std::floor(position));
+    const auto upper = std::min(lower + 1, values.size() - 1);
+    return values[lower] + (position - static_cast<double>(lower)) * (values[upper] - values[lower]);
+}
+
+// Whether the estimate falls at a rank within tolerance of q among the sorted values
+bool within_rank_tolerance(const std::vector<double>& sorted, double q, double estimate, double tolerance) {
+    const auto n = static_cast<double>(sorted.size());
+    const auto below = static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin()) / n;
+    const auto at_or_below = static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin()) / n;
+    return below - tolerance <= q && q <= at_or_below + tolerance;
+}
+
+} // namespace
+
+RC_GTEST_PROP(HyperLogLog, EstimateWithinErrorBound, ()) {
+    const auto distinct = *rc::gen::inRange<size_t>(0, 50000);
+    const auto seed = *rc::gen::arbitrary<uint32_t>();
+    HyperLogLog sketch;
+    for (auto value: values_with_repeats(distinct, seed))
+        sketch.add(hash(&value));
+
+    // About four standard errors at the default precision
+    const auto tolerance = std::max(0.065 * static_cast<double>(distinct), 2.0);
+    RC_ASSERT(std::abs(sketch.estimate() - static_cast<double>(distinct)) <= tolerance);
+}
+
+RC_GTEST_PROP(HyperLogLog, MergeEqualsUnion, ()) {
+    const auto distinct = *rc::gen::inRange<size_t>(0, 20000);
+    const auto seed = *rc::gen::arbitrary<uint32_t>();
+    const auto values = values_with_repeats(distinct, seed);
+    const auto split = *rc::gen::inRange<size_t>(0, values.size() + 1);
+
+    HyperLogLog all;
+    HyperLogLog left;
+    HyperLogLog right;
+    for (size_t idx = 0; idx < values.size(); ++idx) {
+        const auto hashed = hash(&values[idx]);
+        all.add(hashed);
+        (idx < split ? left : right).add(hashed);
+    }
+    left.merge(right);
+    RC_ASSERT(left.estimate() == all.estimate());
+}
+
+RC_GTEST_PROP(TDigest, ExactForFewValues, ()) {
+    const auto count = *rc::gen::inRange<size_t>(1, 50);
+    const auto seed = *rc::gen::arbitrary<uint32_t>();
+    const auto q = *rc::gen::inRange(0, 1001) / 1000.0;
+    const auto values = latencies(count, seed);
+
+    TDigest digest;
+    for (auto value: values)
+        digest.add(value);
+
+    const auto expected = exact_quantile(values, q);
+    RC_ASSERT(std::abs(digest.quantile(q) - expected) <= 1e-9 * std::max(1.0, std::abs(expected)));
+}
+
+RC_GTEST_PROP(TDigest, QuantileWithinRankError, ()) {
+    const auto count = *rc::gen::inRange<size_t>(1, 50000);
+    const auto seed = *rc::gen::arbitrary<uint32_t>();
+    const auto q = *rc::gen::inRange(0, 1001) / 1000.0;
+    auto values = latencies(count, seed);
+
+    TDigest digest;
+    for (auto value: values)
+        digest.add(value);
+
+    std::sort(values.begin(), values.end());
+    const auto estimate = digest.quantile(q);
+    RC_ASSERT(estimate >= values.front() && estimate <= values.back());
+    RC_ASSERT(within_rank_tolerance(values, q, estimate, 0.02 + 1.0 / static_cast<double>(count)));
+    RC_ASSERT(digest.centroid_count() <= static_cast<size_t>(TDigest::DEFAULT_COMPRESSION));
+}
+
+// Digests of the segments of a group merge into one as accurate as a digest of all the values
+RC_GTEST_PROP(TDigest, MergeWithinRankError, ()) {
+    const auto parts = *rc::gen::inRange<size_t>(1, 20);
+    const auto seed = *rc::gen::arbitrary<uint32_t>();
+    const auto q = *rc::gen::inRange(0, 1001) / 1000.0;
+
+    TDigest merged;
+    std::vector<double> all;
+    for (size_t part = 0; part < parts; ++part) {
+        const auto values = latencies(*rc::gen::inRange<size_t>(0, 5000), seed + static_cast<uint32_t>(part));
+        TDigest digest;
+        for (auto value: values)
+            digest.add(value);
+        merged.merge(digest);
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    RC_ASSERT(merged.count() == static_cast<double>(all.size()));
+    if (all.empty()) {
+        RC_ASSERT(std::isnan(merged.quantile(q)));
+    } else {
+        std::sort(all.begin(), all.end());
+        RC_ASSERT(within_rank_tolerance(all, q, merged.quantile(q), 0.02 + 1.0 / static_cast<double>(all.size())));
+    }
+}
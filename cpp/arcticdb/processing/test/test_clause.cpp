@@ -10,6 +10,7 @@
 #include <arcticdb/processing/clause.hpp>
 #include <arcticdb/util/test/generators.hpp>
 #include <folly/futures/Future.h>
+#include <filesystem>
 #include <arcticdb/pipeline/frame_slice.hpp>
 
 template<typename T>
@@ -194,6 +195,100 @@ TEST(Clause, AggregationColumn)
     check_column<uint64_t>(*segments[0], "count_int", unique_grouping_values, [](size_t) { return 10; });
 }
 
+TEST(Clause, AggregationSpilledPartitions)
+{
+    // With a budget smaller than any segment every partition is spilled to disk, and read back for aggregation
+    using namespace arcticdb;
+    ScopedConfig num_buckets("Partition.NumBuckets", 4);
+    const auto spill_path = std::filesystem::temp_directory_path();
+    auto component_manager = std::make_shared<ComponentManager>(1, spill_path);
+
+    PartitionClause<grouping::HashingGroupers, grouping::ModuloBucketizer> partition{"int_repeated_values"};
+    partition.set_component_manager(component_manager);
+    AggregationClause aggregation("int_repeated_values", {{"sum_int", "sum"}, {"count_int", "count"}});
+    aggregation.set_component_manager(component_manager);
+
+    size_t num_rows{100};
+    size_t unique_grouping_values{10};
+    auto proc_unit = ProcessingUnit{generate_groupby_testing_segment(num_rows, unique_grouping_values)};
+    auto entity_ids = Composite<EntityIds>(push_entities(component_manager, std::move(proc_unit)));
+    std::vector<Composite<EntityIds>> partitioned;
+    partitioned.emplace_back(partition.process(std::move(entity_ids)));
+    auto buckets = partition.repartition(std::move(partitioned));
+    ASSERT_TRUE(buckets.has_value());
+    ASSERT_GT(component_manager->segments_spilled(), 0);
+
+    int64_t total_sum{0};
+    uint64_t total_count{0};
+    size_t groups{0};
+    for (auto&& bucket: *buckets) {
+        auto aggregated = gather_entities(component_manager, aggregation.process(std::move(bucket))).as_range();
+        for (const auto& proc: aggregated) {
+            for (const auto& segment: *proc.segments_) {
+                const auto& sum_column = segment->column(*segment->column_index("sum_int"));
+                const auto& count_column = segment->column(*segment->column_index("count_int"));
+                for (size_t idx = 0; idx < segment->row_count(); ++idx) {
+                    total_sum += *sum_column.scalar_at<int64_t>(idx);
+                    total_count += *count_column.scalar_at<uint64_t>(idx);
+                }
+                groups += segment->row_count();
+            }
+        }
+    }
+    ASSERT_EQ(unique_grouping_values, groups);
+    ASSERT_EQ(num_rows, total_count);
+    ASSERT_EQ(4950, total_sum);
+    ASSERT_EQ(0, component_manager->memory_budget()->used_bytes());
+}
+
+TEST(Clause, AggregationSplitsBucketsOverBudget)
+{
+    // The one bucket is larger than the budget, so it is split by group into sub-buckets that are aggregated apart
+    using namespace arcticdb;
+    ScopedConfig num_buckets("Partition.NumBuckets", 1);
+    const auto spill_path = std::filesystem::temp_directory_path();
+    auto component_manager = std::make_shared<ComponentManager>(1, spill_path);
+
+    PartitionClause<grouping::HashingGroupers, grouping::ModuloBucketizer> partition{"int_repeated_values"};
+    partition.set_component_manager(component_manager);
+    AggregationClause aggregation("int_repeated_values", {{"sum_int", "sum"}, {"count_int", "count"}});
+    aggregation.set_component_manager(component_manager);
+
+    size_t num_rows{100};
+    size_t unique_grouping_values{10};
+    auto proc_unit = ProcessingUnit{generate_groupby_testing_segment(num_rows, unique_grouping_values)};
+    auto entity_ids = Composite<EntityIds>(push_entities(component_manager, std::move(proc_unit)));
+    std::vector<Composite<EntityIds>> partitioned;
+    partitioned.emplace_back(partition.process(std::move(entity_ids)));
+    auto buckets = partition.repartition(std::move(partitioned));
+    ASSERT_TRUE(buckets.has_value());
+    ASSERT_EQ(buckets->size(), 1);
+
+    auto aggregated = gather_entities(component_manager, aggregation.process(std::move(buckets->front()))).as_range();
+    ASSERT_GT(aggregated.size(), 1);
+    std::unordered_set<int64_t> groups;
+    int64_t total_sum{0};
+    uint64_t total_count{0};
+    for (const auto& proc: aggregated) {
+        for (const auto& segment: *proc.segments_) {
+            const auto& group_column = segment->column(*segment->column_index("int_repeated_values"));
+            const auto& sum_column = segment->column(*segment->column_index("sum_int"));
+            const auto& count_column = segment->column(*segment->column_index("count_int"));
+            for (size_t idx = 0; idx < segment->row_count(); ++idx) {
+                // Each group is aggregated in one sub-bucket only
+                ASSERT_TRUE(groups.insert(*group_column.scalar_at<int64_t>(idx)).second);
+                total_sum += *sum_column.scalar_at<int64_t>(idx);
+                total_count += *count_column.scalar_at<uint64_t>(idx);
+            }
+        }
+    }
+    ASSERT_EQ(unique_grouping_values, groups.size());
+    ASSERT_EQ(num_rows, total_count);
+    ASSERT_EQ(4950, total_sum);
+    aggregated.clear();
+    ASSERT_EQ(0, component_manager->memory_budget()->used_bytes());
+}
+
 TEST(Clause, AggregationSparseColumn)
 {
     using namespace arcticdb;
@@ -441,3 +536,67 @@ TEST(Clause, Merge) {
         }
     }
 }
+
+TEST(Clause, SortMergeOverMemoryBudget) {
+    // With a budget smaller than any segment, the sorted runs wait on disk in pieces and the merge only reads back the
+    // piece at the head of each run
+    using namespace arcticdb;
+    ScopedConfig merge_segment_size("Merge.SegmentSize", 25);
+    const auto spill_path = std::filesystem::temp_directory_path();
+    auto component_manager = std::make_shared<ComponentManager>(1, spill_path);
+
+    SortClause sort_clause("time");
+    sort_clause.set_component_manager(component_manager);
+    SplitClause split_clause(10);
+    split_clause.set_component_manager(component_manager);
+    auto stream_id = StreamId("sort_merge");
+    StreamDescriptor descriptor{};
+    descriptor.add_field(FieldRef{make_scalar_type(DataType::NANOSECONDS_UTC64),"time"});
+    MergeClause merge_clause{TimeseriesIndex{"time"}, DenseColumnPolicy{}, stream_id, descriptor};
+    merge_clause.set_component_manager(component_manager);
+
+    // Run r holds the timestamps r, r + num_runs, r + 2 * num_runs... in a random order
+    const size_t num_runs = 4;
+    const size_t rows_per_run = 100;
+    std::mt19937 urng(0);
+    size_t run_bytes{0};
+    std::vector<Composite<EntityIds>> runs;
+    for (size_t run = 0; run < num_runs; ++run) {
+        auto wrapper = SinkWrapper(fmt::format("run_{}", run), {scalar_field(DataType::UINT64, "value")});
+        for (size_t row = 0; row < rows_per_run; ++row) {
+            const auto value = row * num_runs + run;
+            wrapper.aggregator_.start_row(timestamp(value))([&](auto &&rb) {
+                rb.set_scalar(1, uint64_t(value));
+            });
+        }
+        wrapper.aggregator_.commit();
+        auto seg = wrapper.segment();
+        std::shuffle(seg.begin(), seg.end(), urng);
+        run_bytes = seg.num_bytes();
+        auto entity_ids = Composite<EntityIds>(push_entities(component_manager, ProcessingUnit{std::move(seg)}));
+        runs.emplace_back(split_clause.process(sort_clause.process(std::move(entity_ids))));
+    }
+    ASSERT_GT(component_manager->segments_spilled(), 0);
+
+    auto merge_input = merge_clause.repartition(std::move(runs));
+    ASSERT_TRUE(merge_input.has_value());
+    ASSERT_EQ(merge_input->size(), 1);
+    auto merged = merge_clause.process(std::move(merge_input->front()));
+    // At most a whole run was in memory at once, while it was sorted and split, rather than all of them for the merge
+    ASSERT_LE(component_manager->memory_budget()->peak_bytes(), run_bytes);
+
+    auto res = gather_entities(component_manager, std::move(merged)).as_range();
+    ASSERT_EQ(res.size(), num_runs * rows_per_run / 25);
+    uint64_t expected{0};
+    for (const auto& proc: res) {
+        const auto& seg = *proc.segments_->at(0);
+        const auto value_idx = *seg.column_index("value");
+        for (size_t row = 0; row < seg.row_count(); ++row, ++expected) {
+            ASSERT_EQ(seg.scalar_at<timestamp>(row, 0), timestamp(expected));
+            ASSERT_EQ(seg.scalar_at<uint64_t>(row, value_idx), expected);
+        }
+    }
+    ASSERT_EQ(expected, num_runs * rows_per_run);
+    res.clear();
+    ASSERT_EQ(0, component_manager->memory_budget()->used_bytes());
+}
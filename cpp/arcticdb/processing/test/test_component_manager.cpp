@@ -8,7 +8,11 @@
 #include <folly/executors/ThreadedExecutor.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <thread>
+
 #include <arcticdb/processing/component_manager.hpp>
+#include <arcticdb/util/test/generators.hpp>
 
 using namespace arcticdb;
 using namespace arcticdb::pipelines;
@@ -53,3 +57,99 @@ TEST(ComponentManager, Simple) {
     ASSERT_EQ(component_manager.get<std::shared_ptr<AtomKey>>(id_1), key_1);
     EXPECT_THROW(component_manager.get<std::shared_ptr<SegmentInMemory>>(id_1), InternalException);
 }
+
+TEST(ComponentManager, ConcurrentAddAndGet) {
+    ComponentManager component_manager;
+    constexpr size_t num_threads = 8;
+    constexpr size_t entities_per_thread = 2000;
+    constexpr uint64_t expected_get_calls = 3;
+    component_manager.set_next_entity_id(num_threads * entities_per_thread / 2);
+
+    std::vector<std::shared_ptr<SegmentInMemory>> segments;
+    for (size_t i = 0; i < num_threads * entities_per_thread; ++i)
+        segments.emplace_back(std::make_shared<SegmentInMemory>());
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&component_manager, &segments, t]() {
+            // Half the IDs were allocated up front, the rest are spread across chunks allocated on demand
+            for (size_t i = 0; i < entities_per_thread; ++i) {
+                const EntityId id = t * entities_per_thread + i;
+                component_manager.add(segments[id], id, expected_get_calls);
+                component_manager.add(std::make_shared<RowRange>(id, id + 1), id);
+            }
+            for (size_t i = 0; i < entities_per_thread; ++i) {
+                const EntityId id = t * entities_per_thread + i;
+                for (uint64_t get = 0; get < expected_get_calls; ++get)
+                    ASSERT_EQ(component_manager.get<std::shared_ptr<SegmentInMemory>>(id), segments[id]);
+                ASSERT_EQ(component_manager.get<std::shared_ptr<RowRange>>(id)->first, id);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    // Every segment has been fetched the expected number of times, so the component manager has dropped them all
+    for (const auto& segment : segments)
+        ASSERT_EQ(segment.use_count(), 1);
+
+    EXPECT_THROW(component_manager.get<std::shared_ptr<SegmentInMemory>>(0), InternalException);
+}
+
+TEST(ComponentManager, IdsBeyondInitialCapacity) {
+    ComponentManager component_manager;
+    // Well past the 8M IDs a fixed directory of 8192 chunks of 1024 slots could hold
+    const std::vector<EntityId> ids{0, 1023, 1024, 8'388'608, 20'000'000};
+    for (auto id : ids)
+        component_manager.add(std::make_shared<RowRange>(id, id + 1), id);
+
+    for (auto id : ids)
+        ASSERT_EQ(component_manager.get<std::shared_ptr<RowRange>>(id)->first, id);
+
+    EXPECT_THROW(component_manager.get<std::shared_ptr<RowRange>>(8'388'609), InternalException);
+}
+
+TEST(ComponentManager, SpillsOverMemoryBudget) {
+    const auto spill_path = std::filesystem::temp_directory_path() / "arcticdb_test_component_manager_spill";
+    std::filesystem::remove_all(spill_path);
+    std::filesystem::create_directories(spill_path);
+    auto segment_0 = std::make_shared<SegmentInMemory>(get_standard_timeseries_segment("spill", 100));
+    auto segment_1 = std::make_shared<SegmentInMemory>(get_standard_timeseries_segment("spill", 100));
+    const auto segment_bytes = segment_0->num_bytes() + segment_0->string_pool_size();
+    {
+        // Room for one segment but not both
+        ComponentManager component_manager(segment_bytes + segment_bytes / 2, spill_path);
+        auto id_0 = component_manager.add(segment_0, std::nullopt, 1);
+        auto id_1 = component_manager.add(segment_1, std::nullopt, 2);
+        ASSERT_EQ(component_manager.memory_budget()->used_bytes(), segment_bytes);
+        ASSERT_EQ(component_manager.segments_spilled(), 1);
+        ASSERT_FALSE(std::filesystem::is_empty(spill_path));
+
+        // The spilled segment is read back on each get
+        for (auto i = 0; i < 2; ++i) {
+            auto reloaded = component_manager.get<std::shared_ptr<SegmentInMemory>>(id_1);
+            ASSERT_NE(reloaded, segment_1);
+            ASSERT_EQ(reloaded->row_count(), segment_1->row_count());
+            ASSERT_EQ(reloaded->num_columns(), segment_1->num_columns());
+            for (auto row = 0u; row < segment_1->row_count(); ++row) {
+                ASSERT_EQ(reloaded->scalar_at<uint64_t>(row, 2), segment_1->scalar_at<uint64_t>(row, 2));
+                ASSERT_EQ(reloaded->string_at(row, 3), segment_1->string_at(row, 3));
+            }
+            // A segment read back counts against the budget while it is held, even though that takes it over the limit
+            ASSERT_EQ(component_manager.memory_budget()->used_bytes(), 2 * segment_bytes);
+        }
+        ASSERT_EQ(component_manager.memory_budget()->used_bytes(), segment_bytes);
+
+        // The budget is released once the segment held in memory has been fetched for the last time, and dropped
+        {
+            auto held = component_manager.get<std::shared_ptr<SegmentInMemory>>(id_0);
+            ASSERT_EQ(held, segment_0);
+            ASSERT_EQ(component_manager.memory_budget()->used_bytes(), segment_bytes);
+        }
+        ASSERT_EQ(component_manager.memory_budget()->used_bytes(), 0);
+        ASSERT_EQ(component_manager.memory_budget()->peak_bytes(), 2 * segment_bytes);
+    }
+    // Nothing is left behind once the read is finished
+    ASSERT_TRUE(std::filesystem::is_empty(spill_path));
+    std::filesystem::remove_all(spill_path);
+}
@@ -9,6 +9,7 @@
 #include <arcticdb/processing/expression_context.hpp>
 #include <arcticdb/processing/expression_node.hpp>
 #include <arcticdb/processing/processing_unit.hpp>
+#include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/util/test/generators.hpp>
 
 TEST(ExpressionNode, AddBasic) {
@@ -45,3 +46,152 @@ TEST(ExpressionNode, AddBasic) {
         ASSERT_EQ(col->scalar_at<uint64_t>(j), v1.value() + v2.value());
     }
 }
+
+namespace {
+
+arcticdb::ProcessingUnit short_circuit_processing_unit(size_t num_rows) {
+    using namespace arcticdb;
+    auto wrapper = SinkWrapper(StreamId{"short_circuit"}, {
+        scalar_field(DataType::UINT64, "thing1"),
+        scalar_field(DataType::UINT64, "thing2")
+    });
+
+    for(size_t j = 0; j < num_rows; ++j ) {
+        wrapper.aggregator_.start_row(timestamp(j))([&](auto &&rb) {
+            rb.set_scalar(1, j);
+            rb.set_scalar(2, j + 1);
+        });
+    }
+    wrapper.aggregator_.commit();
+    return ProcessingUnit(std::move(wrapper.segment()));
+}
+
+std::shared_ptr<arcticdb::ExpressionContext> short_circuit_context(
+    arcticdb::OperationType root_op,
+    arcticdb::OperationType left_op,
+    uint64_t left_value,
+    arcticdb::OperationType right_op,
+    uint64_t right_value) {
+    using namespace arcticdb;
+    auto expression_context = std::make_shared<ExpressionContext>();
+    expression_context->add_value("left_value", std::make_shared<Value>(left_value, DataType::UINT64));
+    expression_context->add_value("right_value", std::make_shared<Value>(right_value, DataType::UINT64));
+    expression_context->add_expression_node("left", std::make_shared<ExpressionNode>(ColumnName("thing1"), ValueName("left_value"), left_op));
+    expression_context->add_expression_node("right", std::make_shared<ExpressionNode>(ColumnName("thing2"), ValueName("right_value"), right_op));
+    expression_context->add_expression_node("root", std::make_shared<ExpressionNode>(ExpressionName("left"), ExpressionName("right"), root_op));
+    expression_context->root_node_name_ = ExpressionName("root");
+    return expression_context;
+}
+
+} // namespace
+
+TEST(ExpressionNode, AndStopsAtEmptyOperand) {
+    using namespace arcticdb;
+    auto proc = short_circuit_processing_unit(100);
+    proc.set_expression_context(short_circuit_context(OperationType::AND, OperationType::EQ, 1000, OperationType::LT, 50));
+    auto ret = proc.get(ExpressionName("root"));
+    ASSERT_TRUE(std::holds_alternative<EmptyResult>(ret));
+    ASSERT_EQ(proc.computed_data_.count("right"), 0u);
+}
+
+TEST(ExpressionNode, OrStopsAtFullOperand) {
+    using namespace arcticdb;
+    auto proc = short_circuit_processing_unit(100);
+    proc.set_expression_context(short_circuit_context(OperationType::OR, OperationType::GE, 0, OperationType::LT, 50));
+    auto ret = proc.get(ExpressionName("root"));
+    ASSERT_TRUE(std::holds_alternative<FullResult>(ret));
+    ASSERT_EQ(proc.computed_data_.count("right"), 0u);
+}
+
+TEST(ExpressionNode, AndEvaluatesLaterOperandsOnSelectedRows) {
+    using namespace arcticdb;
+    auto proc = short_circuit_processing_unit(100);
+    proc.set_expression_context(short_circuit_context(OperationType::AND, OperationType::LT, 10, OperationType::GT, 5));
+    auto ret = proc.get(ExpressionName("root"));
+    const auto& bitset = *std::get<std::shared_ptr<util::BitSet>>(ret);
+    // The left side leaves 10 rows, so the right side is evaluated over a restricted copy rather than the whole unit
+    ASSERT_EQ(proc.computed_data_.count("right"), 0u);
+    ASSERT_EQ(bitset.size(), 100u);
+    ASSERT_EQ(bitset.count(), 5u);
+    for(size_t j = 0; j < 100; ++j)
+        ASSERT_EQ(bitset.test(j), j >= 5 && j < 10);
+}
+
+TEST(ExpressionNode, OperandsOrderedByLearnedSelectivity) {
+    using namespace arcticdb;
+    auto expression_context = short_circuit_context(OperationType::AND, OperationType::LT, 90, OperationType::LT, 4);
+    // As if earlier segments had found the left side passes most rows and the right side very few, at the same cost
+    expression_context->expression_nodes_.get_value("left")->operand_stats_->record(100, 90, 1000);
+    expression_context->expression_nodes_.get_value("right")->operand_stats_->record(100, 3, 1000);
+
+    auto proc = short_circuit_processing_unit(100);
+    proc.set_expression_context(expression_context);
+    auto ret = proc.get(ExpressionName("root"));
+    const auto& bitset = *std::get<std::shared_ptr<util::BitSet>>(ret);
+    ASSERT_EQ(proc.computed_data_.count("right"), 1u);
+    ASSERT_EQ(proc.computed_data_.count("left"), 0u);
+    ASSERT_EQ(bitset.count(), 3u);
+    for(size_t j = 0; j < 3; ++j)
+        ASSERT_TRUE(bitset.test(j));
+
+    // The left side was evaluated over the 3 rows the right side selected
+    const auto& left_stats = *expression_context->expression_nodes_.get_value("left")->operand_stats_;
+    ASSERT_EQ(left_stats.evaluations_.load(), 2u);
+    ASSERT_EQ(left_stats.rows_in_.load(), 103u);
+}
+
+namespace {
+
+std::shared_ptr<arcticdb::ExpressionContext> fused_context(arcticdb::OperationType root_op, arcticdb::VariantNode right) {
+    using namespace arcticdb;
+    auto expression_context = std::make_shared<ExpressionContext>();
+    expression_context->add_value("two", std::make_shared<Value>(uint64_t{2}, DataType::UINT64));
+    expression_context->add_expression_node("product", std::make_shared<ExpressionNode>(ColumnName("thing1"), ValueName("two"), OperationType::MUL));
+    expression_context->add_expression_node("root", std::make_shared<ExpressionNode>(ExpressionName("product"), std::move(right), root_op));
+    expression_context->root_node_name_ = ExpressionName("root");
+    return expression_context;
+}
+
+} // namespace
+
+TEST(ExpressionNode, FusedArithmeticMatchesUnfused) {
+    using namespace arcticdb;
+    // More rows than a batch, so the kernels are run more than once
+    constexpr size_t num_rows = 3000;
+    auto expression_context = fused_context(OperationType::SUB, ColumnName("thing2"));
+
+    auto fused = short_circuit_processing_unit(num_rows);
+    fused.set_expression_context(expression_context);
+    auto fused_col = std::get<ColumnWithStrings>(fused.get(ExpressionName("root"))).column_;
+    // The intermediate product was never materialised
+    ASSERT_EQ(fused.computed_data_.count("product"), 0u);
+
+    ScopedConfig unfused_config("Expression.FusedKernels", 0);
+    auto unfused = short_circuit_processing_unit(num_rows);
+    unfused.set_expression_context(expression_context);
+    auto unfused_col = std::get<ColumnWithStrings>(unfused.get(ExpressionName("root"))).column_;
+    ASSERT_EQ(unfused.computed_data_.count("product"), 1u);
+
+    // uint64 * uint64 is uint64, and uint64 - uint64 is int64
+    ASSERT_EQ(fused_col->type().data_type(), DataType::INT64);
+    ASSERT_EQ(fused_col->type(), unfused_col->type());
+    ASSERT_EQ(fused_col->row_count(), unfused_col->row_count());
+    for(size_t j = 0; j < num_rows; ++j) {
+        ASSERT_EQ(fused_col->scalar_at<int64_t>(j), static_cast<int64_t>(j) - 1);
+        ASSERT_EQ(fused_col->scalar_at<int64_t>(j), unfused_col->scalar_at<int64_t>(j));
+    }
+}
+
+TEST(ExpressionNode, FusedComparison) {
+    using namespace arcticdb;
+    constexpr size_t num_rows = 3000;
+    auto proc = short_circuit_processing_unit(num_rows);
+    proc.set_expression_context(fused_context(OperationType::GT, ColumnName("thing2")));
+    auto ret = proc.get(ExpressionName("root"));
+    ASSERT_EQ(proc.computed_data_.count("product"), 0u);
+    const auto& bitset = *std::get<std::shared_ptr<util::BitSet>>(ret);
+    ASSERT_EQ(bitset.size(), num_rows);
+    ASSERT_EQ(bitset.count(), num_rows - 2);
+    for(size_t j = 0; j < num_rows; ++j)
+        ASSERT_EQ(bitset.test(j), j * 2 > j + 1);
+}
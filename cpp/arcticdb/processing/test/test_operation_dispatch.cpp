@@ -7,9 +7,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
 #include <arcticdb/processing/expression_node.hpp>
 #include <arcticdb/processing/operation_dispatch_binary.hpp>
 #include <arcticdb/processing/operation_dispatch_unary.hpp>
+#include <arcticdb/processing/operation_dispatch_string.hpp>
 #include <arcticdb/pipeline/value.hpp>
 #include <arcticdb/pipeline/value_set.hpp>
 #include <arcticdb/util/test/generators.hpp>
@@ -136,4 +141,90 @@ TEST(OperationDispatch, binary_membership) {
     ASSERT_TRUE(std::holds_alternative<EmptyResult>(visit_binary_membership(empty_column, value_set, IsInOperator{})));
     // empty col isnotin set
     ASSERT_TRUE(std::holds_alternative<FullResult>(visit_binary_membership(empty_column, value_set, IsNotInOperator{})));
-}
\ No newline at end of file
+}
+
+namespace {
+
+arcticdb::ColumnWithStrings generate_string_column(const std::vector<std::optional<std::string>>& strings) {
+    using namespace arcticdb;
+    auto string_pool = std::make_shared<StringPool>();
+    auto column = std::make_shared<Column>(make_scalar_type(DataType::UTF_DYNAMIC64), false);
+    for (const auto& str : strings)
+        column->push_back(str ? string_pool->get(*str).offset() : not_a_string());
+    return {column, string_pool};
+}
+
+std::vector<std::optional<std::string>> repeated_strings(size_t num_rows) {
+    const std::vector<std::optional<std::string>> distinct{"Apple", "apricot", "Banana", std::nullopt, "cherry", ""};
+    std::vector<std::optional<std::string>> output;
+    for (size_t idx = 0; idx < num_rows; ++idx)
+        output.emplace_back(distinct[(idx * 7) % distinct.size()]);
+    return output;
+}
+
+} // namespace
+
+TEST(OperationDispatch, string_predicate) {
+    using namespace arcticdb;
+    const auto strings = repeated_strings(100);
+    auto string_column = generate_string_column(strings);
+    auto check = [&](OperationType operation, const std::string& argument, auto&& expected) {
+        auto value = std::make_shared<Value>(construct_string_value(argument));
+        auto variant_data = dispatch_binary(string_column, value, operation);
+        ASSERT_TRUE(std::holds_alternative<std::shared_ptr<util::BitSet>>(variant_data));
+        auto bitset = std::get<std::shared_ptr<util::BitSet>>(variant_data);
+        for (size_t idx = 0; idx < strings.size(); ++idx)
+            ASSERT_EQ(strings[idx].has_value() && expected(*strings[idx]), bitset->get_bit(idx));
+    };
+    check(OperationType::STARTSWITH, "ap", [](const std::string& str) { return str.rfind("ap", 0) == 0; });
+    check(OperationType::ENDSWITH, "y", [](const std::string& str) { return !str.empty() && str.back() == 'y'; });
+    check(OperationType::CONTAINS, "an", [](const std::string& str) { return str.find("an") != std::string::npos; });
+    check(OperationType::REGEX_MATCH, "^[A-Z].*a$", [](const std::string& str) { return str == "Banana"; });
+
+    // Predicates that no row satisfies give an empty result
+    auto value = std::make_shared<Value>(construct_string_value("zzz"));
+    ASSERT_TRUE(std::holds_alternative<EmptyResult>(dispatch_binary(string_column, value, OperationType::CONTAINS)));
+    // Only strings are accepted on either side
+    auto int_column = ColumnWithStrings(std::make_unique<Column>(generate_int_column(10)));
+    EXPECT_THROW(dispatch_binary(int_column, value, OperationType::STARTSWITH), SchemaException);
+    auto int_value = std::make_shared<Value>(static_cast<int64_t>(50), DataType::INT64);
+    EXPECT_THROW(dispatch_binary(string_column, int_value, OperationType::STARTSWITH), UserInputException);
+}
+
+TEST(OperationDispatch, string_transform) {
+    using namespace arcticdb;
+    const auto strings = repeated_strings(100);
+    auto string_column = generate_string_column(strings);
+
+    auto lower = std::get<ColumnWithStrings>(dispatch_unary(string_column, OperationType::LOWER));
+    auto upper = std::get<ColumnWithStrings>(dispatch_unary(string_column, OperationType::UPPER));
+    auto len = std::get<ColumnWithStrings>(dispatch_unary(string_column, OperationType::LEN));
+    ASSERT_EQ(lower.column_->type(), string_column.column_->type());
+    ASSERT_EQ(len.column_->type(), make_scalar_type(DataType::FLOAT64));
+    for (size_t idx = 0; idx < strings.size(); ++idx) {
+        const auto lower_string = lower.string_at_offset(lower.column_->scalar_at<StringPool::offset_t>(idx).value());
+        const auto upper_string = upper.string_at_offset(upper.column_->scalar_at<StringPool::offset_t>(idx).value());
+        const auto length = len.column_->scalar_at<double>(idx).value();
+        if (strings[idx].has_value()) {
+            auto expected_lower = *strings[idx];
+            auto expected_upper = *strings[idx];
+            std::transform(expected_lower.begin(), expected_lower.end(), expected_lower.begin(), ::tolower);
+            std::transform(expected_upper.begin(), expected_upper.end(), expected_upper.begin(), ::toupper);
+            ASSERT_EQ(lower_string, expected_lower);
+            ASSERT_EQ(upper_string, expected_upper);
+            ASSERT_EQ(length, static_cast<double>(strings[idx]->size()));
+        } else {
+            ASSERT_FALSE(lower_string.has_value());
+            ASSERT_FALSE(upper_string.has_value());
+            ASSERT_TRUE(std::isnan(length));
+        }
+    }
+
+    // Copying the transformed strings into another pool keeps the same strings
+    auto target = std::make_shared<StringPool>();
+    auto copied = ColumnWithStrings(copy_strings_to_pool(lower, *target), target);
+    for (size_t idx = 0; idx < strings.size(); ++idx) {
+        ASSERT_EQ(copied.string_at_offset(copied.column_->scalar_at<StringPool::offset_t>(idx).value()),
+                  lower.string_at_offset(lower.column_->scalar_at<StringPool::offset_t>(idx).value()));
+    }
+}
@@ -0,0 +1,146 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+#include <arcticdb/processing/aggregation.hpp>
+#include <arcticdb/processing/aggregation_interface.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace {
+
+using namespace arcticdb;
+
+constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+// Aggregates each window from scratch
+std::vector<double> brute_force(const std::string& aggregation, const RollingWindow& window, const std::vector<timestamp>& index, const std::vector<double>& values) {
+    std::vector<double> res;
+    for (size_t row = 0; row < values.size(); ++row) {
+        std::vector<double> in_window;
+        for (size_t other = 0; other <= row; ++other) {
+            const auto in = window.rows_.has_value() ? other + *window.rows_ > row : index[other] > index[row] - *window.span_;
+            if (in && !std::isnan(values[other]))
+                in_window.emplace_back(values[other]);
+        }
+        if (in_window.size() < window.min_periods_) {
+            res.emplace_back(nan);
+        } else if (aggregation == "sum") {
+            res.emplace_back(std::accumulate(in_window.begin(), in_window.end(), 0.0));
+        } else if (aggregation == "mean") {
+            res.emplace_back(in_window.empty() ? nan : std::accumulate(in_window.begin(), in_window.end(), 0.0) / double(in_window.size()));
+        } else if (aggregation == "count") {
+            res.emplace_back(double(in_window.size()));
+        } else if (aggregation == "min") {
+            res.emplace_back(in_window.empty() ? nan : *std::min_element(in_window.begin(), in_window.end()));
+        } else {
+            res.emplace_back(in_window.empty() ? nan : *std::max_element(in_window.begin(), in_window.end()));
+        }
+    }
+    return res;
+}
+
+RollingAggregatorData aggregator_data(const std::string& aggregation) {
+    if (aggregation == "sum")
+        return RollingSumAggregatorData{};
+    if (aggregation == "mean")
+        return RollingMeanAggregatorData{};
+    if (aggregation == "count")
+        return RollingCountAggregatorData{};
+    if (aggregation == "min")
+        return RollingMinAggregatorData{};
+    return RollingMaxAggregatorData{};
+}
+
+void assert_outputs_equal(const std::vector<double>& expected, const std::vector<double>& output) {
+    ASSERT_EQ(expected.size(), output.size());
+    for (size_t row = 0; row < expected.size(); ++row) {
+        if (std::isnan(expected[row]))
+            ASSERT_TRUE(std::isnan(output[row])) << "row " << row;
+        else
+            ASSERT_NEAR(expected[row], output[row], 1e-9) << "row " << row;
+    }
+}
+
+struct RollingTestData {
+    std::vector<timestamp> index_;
+    std::vector<double> values_;
+};
+
+// Index values with repeats and gaps, and values with NaNs and runs that rise and fall
+RollingTestData test_data(size_t rows) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<timestamp> step(0, 3);
+    std::uniform_real_distribution<double> value(-100.0, 100.0);
+    std::bernoulli_distribution missing(0.1);
+    RollingTestData res;
+    timestamp ts = 0;
+    for (size_t row = 0; row < rows; ++row) {
+        ts += step(gen);
+        res.index_.emplace_back(ts);
+        res.values_.emplace_back(missing(gen) ? nan : value(gen));
+    }
+    return res;
+}
+
+const std::vector<std::string> aggregations{"sum", "mean", "count", "min", "max"};
+
+std::vector<RollingWindow> windows() {
+    std::vector<RollingWindow> res;
+    res.push_back(RollingWindow{size_t{1}, std::nullopt, 1});
+    res.push_back(RollingWindow{size_t{5}, std::nullopt, 5});
+    res.push_back(RollingWindow{size_t{7}, std::nullopt, 0});
+    res.push_back(RollingWindow{std::nullopt, timestamp{1}, 1});
+    res.push_back(RollingWindow{std::nullopt, timestamp{6}, 2});
+    return res;
+}
+
+} // namespace
+
+TEST(Rolling, MatchesBruteForce) {
+    const auto data = test_data(200);
+    for (const auto& aggregation: aggregations) {
+        for (const auto& window: windows()) {
+            std::vector<double> output(data.values_.size());
+            aggregator_data(aggregation).roll(window, RollingInput{data.index_, data.values_, 0}, output.data());
+            assert_outputs_equal(brute_force(aggregation, window, data.index_, data.values_), output);
+        }
+    }
+}
+
+// Rolling a run of rows seeded with the rows before it gives the same outputs as rolling over all of them, which is
+// what lets each row slice only need the tail of the one before it
+TEST(Rolling, FirstOutput) {
+    const auto data = test_data(100);
+    const size_t first_output = 37;
+    for (const auto& aggregation: aggregations) {
+        for (const auto& window: windows()) {
+            const auto expected = brute_force(aggregation, window, data.index_, data.values_);
+            std::vector<double> output(data.values_.size() - first_output);
+            aggregator_data(aggregation).roll(window, RollingInput{data.index_, data.values_, first_output}, output.data());
+            assert_outputs_equal(std::vector<double>(expected.begin() + first_output, expected.end()), output);
+        }
+    }
+}
+
+TEST(Rolling, MinMaxDeque) {
+    RollingMinAggregatorData min;
+    min.add(0, 3.0);
+    min.add(1, 1.0);
+    min.add(2, 2.0);
+    ASSERT_EQ(min.result(3), 1.0);
+    // Row 0 was already dropped from the deque when row 1 was added
+    min.remove(0, 3.0);
+    ASSERT_EQ(min.result(2), 1.0);
+    min.remove(1, 1.0);
+    ASSERT_EQ(min.result(1), 2.0);
+    min.remove(2, 2.0);
+    ASSERT_TRUE(std::isnan(min.result(0)));
+}
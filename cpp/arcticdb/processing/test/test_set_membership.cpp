@@ -8,6 +8,8 @@
 #include <cstdint>
 #include <limits>
 #include <unordered_set>
+#include <variant>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -44,3 +46,81 @@ TEST(SetMembership, int64_isnotin_uint64) {
     ASSERT_FALSE(uset.count(i) == 0);
     ASSERT_TRUE(IsNotInOperator{}(i, uset));
 }
+
+TEST(SetMembership, uint64_isin_int64_membership_set) {
+    using namespace arcticdb;
+    uint64_t u = std::numeric_limits<uint64_t>::max();
+    auto members = make_membership_set<int64_t>({-1});
+    std::visit([u](const auto& set) {
+        ASSERT_FALSE(IsInOperator{}(u, set, UInt64SpecialHandlingTag{}));
+        ASSERT_TRUE(IsNotInOperator{}(u, set, UInt64SpecialHandlingTag{}));
+    }, members);
+}
+
+TEST(SetMembership, int64_isin_uint64_membership_set) {
+    using namespace arcticdb;
+    int64_t i = -1;
+    auto members = make_membership_set<uint64_t>({std::numeric_limits<uint64_t>::max()});
+    std::visit([i](const auto& set) {
+        ASSERT_FALSE(IsInOperator{}(i, set, UInt64SpecialHandlingTag{}));
+        ASSERT_TRUE(IsNotInOperator{}(i, set, UInt64SpecialHandlingTag{}));
+    }, members);
+}
+
+namespace {
+
+// Checks every value in [min, max] against a std::unordered_set of the same members
+template<typename T>
+void check_membership_set(std::vector<T> values, size_t expected_index, T min, T max) {
+    using namespace arcticdb;
+    std::unordered_set<T> expected(values.begin(), values.end());
+    auto members = make_membership_set(std::move(values));
+    ASSERT_EQ(members.index(), expected_index);
+    std::visit([&](const auto& set) {
+        for (T value = min; ; ++value) {
+            ASSERT_EQ(IsInOperator{}(value, set), expected.count(value) > 0) << value;
+            ASSERT_EQ(IsNotInOperator{}(value, set), expected.count(value) == 0) << value;
+            if (value == max)
+                break;
+        }
+    }, members);
+}
+
+} // namespace
+
+TEST(SetMembership, sorted_members) {
+    check_membership_set<int64_t>({-1000, 7, 3, 3, 1 << 20, -5}, 0, -2000, 2000);
+    check_membership_set<uint8_t>({}, 0, 0, 255);
+}
+
+TEST(SetMembership, bitmap_members) {
+    std::vector<int32_t> values;
+    for (int32_t value = -500; value < 1500; value += 3)
+        values.emplace_back(value);
+    check_membership_set<int32_t>(values, 1, -1000, 2000);
+    check_membership_set<uint8_t>({0, 255, 17, 100}, 1, 0, 255);
+    check_membership_set<int8_t>({-128, 127, 0, 5}, 1, -128, 127);
+}
+
+TEST(SetMembership, hash_members) {
+    std::vector<int64_t> values;
+    for (int64_t value = -100000; value < 100000; value += 97)
+        values.emplace_back(value * 1000);
+    check_membership_set<int64_t>(values, 2, -100000 * 1000 - 50, -100000 * 1000 + 50000);
+    // Every member is found, not just those near the start of the range
+    std::visit([&values](const auto& set) {
+        for (auto value: values)
+            ASSERT_TRUE(arcticdb::IsInOperator{}(value, set));
+    }, arcticdb::make_membership_set(std::vector<int64_t>(values)));
+}
+
+TEST(SetMembership, floating_point_members) {
+    using namespace arcticdb;
+    auto members = make_membership_set<double>({1.5, -0.0, std::numeric_limits<double>::quiet_NaN(), 2.5});
+    std::visit([](const auto& set) {
+        ASSERT_TRUE(IsInOperator{}(0.0, set));
+        ASSERT_TRUE(IsInOperator{}(1.5, set));
+        ASSERT_FALSE(IsInOperator{}(2.0, set));
+        ASSERT_FALSE(IsInOperator{}(std::numeric_limits<double>::quiet_NaN(), set));
+    }, members);
+}
@@ -12,6 +12,7 @@
 #include <arcticdb/entity/native_tensor.hpp>
 #include <arcticdb/python/python_utils.hpp>
 #include <arcticdb/python/python_types.hpp>
+#include <arcticdb/pipeline/arrow_input_frame.hpp>
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 
@@ -267,6 +268,18 @@ InputTensorFrame py_ndf_to_frame(
     return res;
 }
 
+InputTensorFrame py_arrow_to_frame(
+    const StreamId& stream_name,
+    uintptr_t array_ptr,
+    uintptr_t schema_ptr,
+    const py::object &user_meta) {
+    auto res = arrow_to_frame(stream_name, reinterpret_cast<ArrowArray*>(array_ptr), reinterpret_cast<ArrowSchema*>(schema_ptr));
+    if (!user_meta.is_none())
+        python_util::pb_from_python(user_meta, res.user_meta);
+
+    return res;
+}
+
 InputTensorFrame py_none_to_frame() {
     ARCTICDB_SUBSAMPLE_DEFAULT(NormalizeNoneFrame)
     InputTensorFrame res;
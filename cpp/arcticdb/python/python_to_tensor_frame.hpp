@@ -88,6 +88,13 @@ pipelines::InputTensorFrame py_ndf_to_frame(
     const py::object &norm_meta,
     const py::object &user_meta);
 
+// Takes ownership of the Arrow record batch whose C Data Interface structs are at array_ptr and schema_ptr
+pipelines::InputTensorFrame py_arrow_to_frame(
+    const StreamId& stream_name,
+    uintptr_t array_ptr,
+    uintptr_t schema_ptr,
+    const py::object &user_meta);
+
 pipelines::InputTensorFrame py_none_to_frame();
 
 } // namespace arcticdb::convert
@@ -353,6 +353,19 @@ AzureStorage::AzureStorage(const LibraryPath &library_path, OpenMode mode, const
         unsigned int max_connections = conf.max_connections() == 0 ? ConfigsMap::instance()->get_int("VersionStore.NumIOThreads", 16) : conf.max_connections();
         upload_option_.TransferOptions.Concurrency = max_connections;
         download_option_.TransferOptions.Concurrency = max_connections;
+
+        // Blobs larger than the single upload threshold are uploaded as blocks of the chunk size with up to
+        // max_connections concurrent StageBlock calls followed by a CommitBlockList. Similarly, blobs larger than the
+        // initial download chunk are downloaded with concurrent ranged requests into the buffer. The SDK's defaults of
+        // 256MB mean that almost every segment would otherwise be sent over a single connection.
+        upload_option_.TransferOptions.SingleUploadThreshold = ConfigsMap::instance()->get_int("AzureStorage.SingleUploadThresholdBytes", 8 * 1024 * 1024);
+        upload_option_.TransferOptions.ChunkSize = ConfigsMap::instance()->get_int("AzureStorage.UploadChunkBytes", 4 * 1024 * 1024);
+        download_option_.TransferOptions.InitialChunkSize = ConfigsMap::instance()->get_int("AzureStorage.DownloadInitialChunkBytes", 8 * 1024 * 1024);
+        download_option_.TransferOptions.ChunkSize = ConfigsMap::instance()->get_int("AzureStorage.DownloadChunkBytes", 4 * 1024 * 1024);
+        ARCTICDB_RUNTIME_DEBUG(log::storage(), "Azure transfers above {} bytes up and {} bytes down are split with concurrency {}",
+                               upload_option_.TransferOptions.SingleUploadThreshold,
+                               download_option_.TransferOptions.InitialChunkSize,
+                               max_connections);
 }
 
 Azure::Storage::Blobs::BlobClientOptions AzureStorage::get_client_options(const Config &conf) {
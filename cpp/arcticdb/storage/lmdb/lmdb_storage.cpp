@@ -17,6 +17,7 @@
 #include <arcticdb/util/format_bytes.hpp>
 #include <arcticdb/util/preconditions.hpp>
 #include <arcticdb/util/pb_util.hpp>
+#include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/entity/serialized_key.hpp>
 #include <arcticdb/storage/storage.hpp>
 #include <arcticdb/storage/storage_options.hpp>
@@ -25,10 +26,98 @@
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <folly/gen/Base.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <optional>
+#include <thread>
+
 namespace arcticdb::storage::lmdb {
 
 namespace fg = folly::gen;
 
+/*
+ * Read-only transactions that have been reset, so that a read can renew one rather than begin a new one. The env is
+ * opened with MDB_NOTLS, so a reader slot belongs to the transaction rather than to the thread that began it, and the
+ * transaction can be given back by whichever thread drops the last reference to it.
+ */
+class ReadTxnPool : public std::enable_shared_from_this<ReadTxnPool> {
+  public:
+    ReadTxnPool(::lmdb::env& env, size_t max_idle) :
+        env_(env),
+        max_idle_(max_idle) {
+    }
+
+    // The transaction is only reset once every segment read through it has been dropped, as until then the segments
+    // point into pages that belong to its snapshot
+    std::shared_ptr<::lmdb::txn> acquire() {
+        std::optional<::lmdb::txn> txn;
+        {
+            std::lock_guard lock{mutex_};
+            if(!idle_.empty()) {
+                txn.emplace(std::move(idle_.back()));
+                idle_.pop_back();
+            }
+        }
+        if(txn) {
+            try {
+                txn->renew();
+            } catch(const ::lmdb::error& ex) {
+                log::storage().warn("Failed to renew lmdb read transaction, beginning a new one: {}", ex.what());
+                txn.reset();
+            }
+        }
+        if(!txn)
+            txn.emplace(::lmdb::txn::begin(env_, nullptr, MDB_RDONLY));
+
+        auto give_back = [weak_pool = weak_from_this()](::lmdb::txn* released) {
+            std::unique_ptr<::lmdb::txn> owned{released};
+            if(auto pool = weak_pool.lock())
+                pool->release(std::move(*owned));
+        };
+        return std::shared_ptr<::lmdb::txn>{new ::lmdb::txn(std::move(*txn)), std::move(give_back)};
+    }
+
+  private:
+    void release(::lmdb::txn&& txn) {
+        txn.reset();
+        std::lock_guard lock{mutex_};
+        if(idle_.size() < max_idle_)
+            idle_.emplace_back(std::move(txn));
+    }
+
+    ::lmdb::env& env_;
+    const size_t max_idle_;
+    std::mutex mutex_;
+    std::vector<::lmdb::txn> idle_;
+};
+
+struct PendingWrite {
+    explicit PendingWrite(std::vector<KeySegmentPair>&& kvs) :
+        kvs_(std::move(kvs)) {
+    }
+
+    std::vector<KeySegmentPair> kvs_;
+    std::exception_ptr error_;
+    bool done_ = false;
+};
+
+/*
+ * Writes from concurrent callers that are waiting to be committed. The first caller to find no commit in progress
+ * leads the next one, taking every write that has queued up by then into a single transaction, while the others wait
+ * for it to finish. Each caller still sees only the outcome of its own write.
+ */
+struct GroupCommitQueue {
+    explicit GroupCommitQueue(std::chrono::microseconds window) :
+        window_(window) {
+    }
+
+    std::mutex mutex_;
+    std::condition_variable committed_;
+    std::vector<std::shared_ptr<PendingWrite>> pending_;
+    bool committing_ = false;
+    const std::chrono::microseconds window_;
+};
+
 void LmdbStorage::do_write_internal(Composite<KeySegmentPair>&& kvs, ::lmdb::txn& txn) {
     auto fmt_db = [](auto &&kv) { return kv.key_type(); };
 
@@ -69,14 +158,71 @@ void LmdbStorage::do_write_internal(Composite<KeySegmentPair>&& kvs, ::lmdb::txn
     });
 }
 
+void LmdbStorage::commit_group(std::vector<std::shared_ptr<PendingWrite>>& group) {
+    std::lock_guard<std::mutex> lock{*write_mutex_};
+    try {
+        auto txn = ::lmdb::txn::begin(env()); // scoped abort on exception, so no partial writes
+        ARCTICDB_SUBSAMPLE(LmdbStorageInTransaction, 0)
+        for(auto& pending : group) {
+            if(!pending->kvs_.empty())
+                do_write_internal(Composite<KeySegmentPair>(std::vector<KeySegmentPair>(pending->kvs_)), txn);
+        }
+        ARCTICDB_SUBSAMPLE(LmdbStorageCommit, 0)
+        txn.commit();
+        return;
+    } catch(...) {
+        if(group.size() == 1) {
+            group[0]->error_ = std::current_exception();
+            return;
+        }
+    }
+
+    // One of the writes failed and took the others down with it, so commit them separately to find which
+    ARCTICDB_DEBUG(log::storage(), "Lmdb group commit of {} writes failed, committing them separately", group.size());
+    for(auto& pending : group) {
+        try {
+            auto txn = ::lmdb::txn::begin(env());
+            if(!pending->kvs_.empty())
+                do_write_internal(Composite<KeySegmentPair>(std::move(pending->kvs_)), txn);
+            txn.commit();
+        } catch(...) {
+            pending->error_ = std::current_exception();
+        }
+    }
+}
+
 void LmdbStorage::do_write(Composite<KeySegmentPair>&& kvs) {
     ARCTICDB_SAMPLE(LmdbStorageWrite, 0)
-    std::lock_guard<std::mutex> lock{*write_mutex_};
-    auto txn = ::lmdb::txn::begin(env()); // scoped abort on exception, so no partial writes
-    ARCTICDB_SUBSAMPLE(LmdbStorageInTransaction, 0)
-    do_write_internal(std::move(kvs), txn);
-    ARCTICDB_SUBSAMPLE(LmdbStorageCommit, 0)
-    txn.commit();
+    auto pending = std::make_shared<PendingWrite>(kvs.as_range());
+    auto& queue = *commit_queue_;
+    std::unique_lock lock{queue.mutex_};
+    queue.pending_.emplace_back(pending);
+    while(!pending->done_) {
+        if(queue.committing_) {
+            queue.committed_.wait(lock);
+            continue;
+        }
+
+        queue.committing_ = true;
+        if(queue.window_.count() > 0) {
+            lock.unlock();
+            std::this_thread::sleep_for(queue.window_);
+            lock.lock();
+        }
+        auto group = std::move(queue.pending_);
+        queue.pending_.clear();
+        lock.unlock();
+        commit_group(group);
+        lock.lock();
+        for(auto& committed : group)
+            committed->done_ = true;
+
+        queue.committing_ = false;
+        queue.committed_.notify_all();
+    }
+    lock.unlock();
+    if(pending->error_)
+        std::rethrow_exception(pending->error_);
 }
 
 void LmdbStorage::do_update(Composite<KeySegmentPair>&& kvs, UpdateOpts opts) {
@@ -101,7 +247,7 @@ void LmdbStorage::do_update(Composite<KeySegmentPair>&& kvs, UpdateOpts opts) {
 
 void LmdbStorage::do_read(Composite<VariantKey>&& ks, const ReadVisitor& visitor, storage::ReadKeyOpts) {
     ARCTICDB_SAMPLE(LmdbStorageRead, 0)
-    auto txn = std::make_shared<::lmdb::txn>(::lmdb::txn::begin(env(), nullptr, MDB_RDONLY));
+    auto txn = read_txns_->acquire();
 
     auto fmt_db = [](auto &&k) { return variant_key_type(k); };
     ARCTICDB_SUBSAMPLE(LmdbStorageInTransaction, 0)
@@ -121,8 +267,7 @@ void LmdbStorage::do_read(Composite<VariantKey>&& ks, const ReadVisitor& visitor
                 ARCTICDB_SUBSAMPLE(LmdbStorageVisitSegment, 0)
                 auto segment = Segment::from_bytes(reinterpret_cast<std::uint8_t *>(mdb_val.mv_data),
                                                    mdb_val.mv_size);
-                std::any keepalive;
-                segment.set_keepalive(std::any(std::move(txn)));
+                segment.set_keepalive(std::any(txn));
                 visitor(k, std::move(segment));
 
                 ARCTICDB_DEBUG(log::storage(), "Read key {}: {}, with {} bytes of data", variant_key_type(k), variant_key_view(k), mdb_val.mv_size);
@@ -138,7 +283,7 @@ void LmdbStorage::do_read(Composite<VariantKey>&& ks, const ReadVisitor& visitor
 
 bool LmdbStorage::do_key_exists(const VariantKey&key) {
     ARCTICDB_SAMPLE(LmdbStorageKeyExists, 0)
-    auto txn = ::lmdb::txn::begin(env(), nullptr, MDB_RDONLY);
+    auto txn = read_txns_->acquire();
     ARCTICDB_SUBSAMPLE(LmdbStorageInTransaction, 0)
 
     auto db_name = fmt::format("{}", variant_key_type(key));
@@ -146,13 +291,13 @@ bool LmdbStorage::do_key_exists(const VariantKey&key) {
 
     try {
         ::lmdb::dbi& dbi = dbi_by_key_type_.at(db_name);
-        if (unsigned int tmp; ::mdb_dbi_flags(txn, dbi, &tmp) == EINVAL) {
+        if (unsigned int tmp; ::mdb_dbi_flags(*txn, dbi, &tmp) == EINVAL) {
             return false;
         }
         auto stored_key = to_serialized_key(key);
         MDB_val mdb_key{stored_key.size(), stored_key.data()};
         MDB_val mdb_val;
-        return ::lmdb::dbi_get(txn, dbi.handle(), &mdb_key, &mdb_val);
+        return ::lmdb::dbi_get(*txn, dbi.handle(), &mdb_key, &mdb_val);
     } catch (const ::lmdb::not_found_error &ex) {
         ARCTICDB_DEBUG(log::storage(), "Caught lmdb not found error: {}", ex.what());
         return false;
@@ -326,6 +471,10 @@ LmdbStorage::LmdbStorage(const LibraryPath &library_path, OpenMode mode, const C
 
     txn.commit();
 
+    read_txns_ = std::make_shared<ReadTxnPool>(env(), ConfigsMap::instance()->get_int("LmdbStorage.MaxIdleReadTxns", 64));
+    commit_queue_ = std::make_unique<GroupCommitQueue>(
+        std::chrono::microseconds{ConfigsMap::instance()->get_int("LmdbStorage.GroupCommitWindowMicros", 0)});
+
     ARCTICDB_DEBUG(log::storage(), "Opened lmdb storage at {} with map size {}", lib_dir_.string(), format_bytes(mapsize));
 }
 
@@ -349,6 +498,8 @@ LmdbStorage::LmdbStorage(LmdbStorage&& other)  noexcept
     : Storage(std::move(static_cast<Storage&>(other))),
     write_mutex_(std::move(other.write_mutex_)),
     env_(std::move(other.env_)),
+    read_txns_(std::move(other.read_txns_)),
+    commit_queue_(std::move(other.commit_queue_)),
     dbi_by_key_type_(std::move(other.dbi_by_key_type_)),
     lib_dir_(std::move(other.lib_dir_)) {
     other.lib_dir_ = "";
@@ -28,6 +28,10 @@ namespace fs = std::filesystem;
 
 namespace arcticdb::storage::lmdb {
 
+class ReadTxnPool;
+struct GroupCommitQueue;
+struct PendingWrite;
+
 class LmdbStorage final : public Storage {
   public:
     using Config = arcticdb::proto::lmdb_storage::Config;
@@ -65,9 +69,17 @@ class LmdbStorage final : public Storage {
     // _internal methods assume the write mutex is already held
     void do_write_internal(Composite<KeySegmentPair>&& kvs, ::lmdb::txn& txn);
     std::vector<VariantKey> do_remove_internal(Composite<VariantKey>&& ks, ::lmdb::txn& txn, RemoveOpts opts);
+
+    // Writes the pending writes of a commit group, taking the write mutex
+    void commit_group(std::vector<std::shared_ptr<PendingWrite>>& group);
+
     std::unique_ptr<std::mutex> write_mutex_;
     std::unique_ptr<::lmdb::env> env_;
 
+    // Declared after the env so that the idle read transactions are aborted before it is closed
+    std::shared_ptr<ReadTxnPool> read_txns_;
+    std::unique_ptr<GroupCommitQueue> commit_queue_;
+
     std::unordered_map<std::string, ::lmdb::dbi> dbi_by_key_type_;
 
     std::filesystem::path lib_dir_;
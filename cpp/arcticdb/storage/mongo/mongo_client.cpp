@@ -20,9 +20,16 @@
 #include <arcticdb/util/key_utils.hpp>
 #include <arcticdb/util/exponential_backoff.hpp>
 #include <mongocxx/model/replace_one.hpp>
+#include <mongocxx/model/insert_one.hpp>
+#include <mongocxx/options/bulk_write.hpp>
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
 #include <mongocxx/config/version.hpp>
 #include <arcticdb/util/composite.hpp>
 
+#include <unordered_map>
+#include <unordered_set>
+
 namespace arcticdb::storage::mongo {
 
 namespace detail {
@@ -201,6 +208,17 @@ class MongoClientImpl {
         const std::string &collection_name,
         const  entity::VariantKey &key);
 
+    void write_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        std::vector<storage::KeySegmentPair>&& kvs,
+        bool ordered);
+
+    std::vector<storage::KeySegmentPair> read_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        const std::vector<entity::VariantKey> &keys);
+
     void remove_keyvalue(
         const std::string &database_name,
         const std::string &collection_name,
@@ -344,6 +362,104 @@ storage::KeySegmentPair MongoClientImpl::read_segment(const std::string &databas
     }
 }
 
+void MongoClientImpl::write_segments(const std::string &database_name,
+                                     const std::string &collection_name,
+                                     std::vector<storage::KeySegmentPair> &&kvs,
+                                     bool ordered) {
+    using namespace bsoncxx::builder::stream;
+    using bsoncxx::builder::stream::document;
+    if(kvs.empty())
+        return;
+
+    ARCTICDB_SUBSAMPLE(MongoStorageWriteGetClient, 0)
+    auto client = get_client();
+
+    ARCTICDB_SUBSAMPLE(MongoStorageWriteGetCol, 0)
+    mongocxx::database database = client->database(database_name.c_str());
+    auto collection = database[collection_name];
+
+    ARCTICDB_SUBSAMPLE(MongoStorageWriteBuildDoc, 0)
+    mongocxx::options::bulk_write bulk_opts;
+    bulk_opts.ordered(ordered);
+    auto bulk_write = collection.create_bulk_write(bulk_opts);
+    for(auto& kv : kvs) {
+        auto doc = detail::build_document(kv);
+        // As in write_segment, reference keys replace whatever is there and others are always inserted
+        if(std::holds_alternative<RefKey>(kv.variant_key())) {
+            mongocxx::model::replace_one replace{document{} << "key" << fmt::format("{}", kv.ref_key()) << finalize, doc.view()};
+            replace.upsert(true);
+            bulk_write.append(replace);
+        } else {
+            bulk_write.append(mongocxx::model::insert_one{doc.view()});
+        }
+    }
+
+    ARCTICDB_SUBSAMPLE(MongoStorageWriteBulk, 0)
+    auto result = bulk_write.execute();
+    util::check(bool(result), "Mongo error while putting {} keys starting with {}", kvs.size(), kvs.front().key_view());
+}
+
+std::vector<storage::KeySegmentPair> MongoClientImpl::read_segments(const std::string &database_name,
+                                                                    const std::string &collection_name,
+                                                                    const std::vector<entity::VariantKey> &keys) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+    ARCTICDB_SUBSAMPLE(MongoStorageReadGetClient, 0)
+    if(keys.empty())
+        return {};
+
+    auto client = get_client();
+
+    ARCTICDB_SUBSAMPLE(MongoStorageReadGetCol, 0)
+    auto database = client->database(database_name);
+    auto collection = database[collection_name];
+
+    // Filtered on stream_id as well as key, as in read_segment, with the ids stored as they are by build_document
+    std::unordered_map<std::string, const entity::VariantKey*> requested;
+    std::unordered_set<StreamId> requested_ids;
+    bsoncxx::builder::basic::array key_strings;
+    bsoncxx::builder::basic::array stream_ids;
+    for(const auto& key : keys) {
+        auto [it, inserted] = requested.try_emplace(fmt::format("{}", key), &key);
+        if(inserted)
+            key_strings.append(it->first);
+
+        const auto& stream_id = variant_key_id(key);
+        if(requested_ids.insert(stream_id).second) {
+            if(std::holds_alternative<StringId>(stream_id))
+                stream_ids.append(std::get<StringId>(stream_id));
+            else
+                stream_ids.append(bsoncxx::types::b_int64{int64_t(std::get<NumericId>(stream_id))});
+        }
+    }
+
+    if(StorageFailureSimulator::instance()->configured())
+        StorageFailureSimulator::instance()->go(FailureType::READ);
+
+    ARCTICDB_SUBSAMPLE(MongoStorageReadFindMany, 0)
+    std::vector<storage::KeySegmentPair> results;
+    results.reserve(requested.size());
+    auto cursor = collection.find(make_document(
+        kvp("key", make_document(kvp("$in", key_strings.view()))),
+        kvp("stream_id", make_document(kvp("$in", stream_ids.view())))));
+    for(const auto& doc : cursor) {
+        auto it = requested.find(detail::get_string_element(doc["key"]));
+        if(it == requested.end())
+            continue; // A reference key with more than one document, of which the first has already been read
+
+        const auto& key = *it->second;
+        entity::VariantKey stored_key{detail::variant_key_from_document(doc, key)};
+        util::check(stored_key == key, "Key mismatch: {} != {}", stored_key, key);
+        auto size = doc["total_size"].get_int64().value;
+        results.emplace_back(
+            std::move(stored_key),
+            Segment::from_bytes(const_cast<uint8_t *>(doc["data"].get_binary().bytes), std::size_t(size), true));
+        requested.erase(it);
+    }
+    ARCTICDB_DEBUG(log::storage(), "Read {} of {} keys from {} in one query", results.size(), keys.size(), collection_name);
+    return results;
+}
+
 bool MongoClientImpl::key_exists(const std::string &database_name,
                                                       const std::string &collection_name,
                                                       const  entity::VariantKey &key) {
@@ -487,6 +603,19 @@ storage::KeySegmentPair MongoClient::read_segment(const std::string &database_na
     return client_->read_segment(database_name, collection_name, key);
 }
 
+void MongoClient::write_segments(const std::string &database_name,
+                                 const std::string &collection_name,
+                                 std::vector<storage::KeySegmentPair> &&kvs,
+                                 bool ordered) {
+    client_->write_segments(database_name, collection_name, std::move(kvs), ordered);
+}
+
+std::vector<storage::KeySegmentPair> MongoClient::read_segments(const std::string &database_name,
+                                                                const std::string &collection_name,
+                                                                const std::vector<entity::VariantKey> &keys) {
+    return client_->read_segments(database_name, collection_name, keys);
+}
+
 void MongoClient::remove_keyvalue(const std::string &database_name,
                                   const std::string &collection_name,
                                   const entity::VariantKey &key) {
@@ -11,6 +11,8 @@
 #include <arcticdb/storage/storage.hpp>
 #include <arcticdb/entity/protobufs.hpp>
 
+#include <vector>
+
 namespace arcticdb::storage::mongo {
 
 class MongoClientImpl;
@@ -42,6 +44,19 @@ class MongoClient {
         const std::string &collection_name,
         const entity::VariantKey &key);
 
+    // Writes all the segments in a single bulk write. If ordered, the writes after a failed one are not attempted.
+    void write_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        std::vector<storage::KeySegmentPair>&& kvs,
+        bool ordered);
+
+    // Fetches all the keys with a single query. Keys that are not found are left out of the result.
+    std::vector<storage::KeySegmentPair> read_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        const std::vector<entity::VariantKey> &keys);
+
     void remove_keyvalue(
         const std::string &database_name,
         const std::string &collection_name,
@@ -13,6 +13,8 @@
 #include <fmt/format.h>
 #include <folly/gen/Base.h>
 
+#include <unordered_set>
+
 #include <arcticdb/storage/mongo/mongo_instance.hpp>
 #include <arcticdb/entity/index_range.hpp>
 #include <arcticdb/storage/mongo/mongo_client.hpp>
@@ -33,10 +35,15 @@ void MongoStorage::do_write(Composite<KeySegmentPair>&& kvs) {
     ARCTICDB_SAMPLE(MongoStorageWrite, 0)
 
     (fg::from(kvs.as_range()) | fg::move | fg::groupBy(fmt_db)).foreach([&](auto &&group) {
-        for (auto &kv : group.values()) {
-            auto collection = collection_name(kv.key_type());
-            client_->write_segment(db_, collection, std::move(kv));
-        }
+        auto collection = collection_name(group.key());
+        auto segment_bytes = [](const KeySegmentPair& kv) { return kv.segment().total_segment_size(); };
+        detail::for_each_batch(group.values(), batch_size_, batch_bytes_, segment_bytes, [&](std::vector<KeySegmentPair>&& batch) {
+            // Almost all writes are of a single key, which are not worth a bulk write
+            if (batch.size() == 1)
+                client_->write_segment(db_, collection, std::move(batch.front()));
+            else
+                client_->write_segments(db_, collection, std::move(batch), ordered_writes_);
+        });
     });
 }
 
@@ -60,15 +67,26 @@ void MongoStorage::do_read(Composite<VariantKey>&& ks, const ReadVisitor& visito
     ARCTICDB_SAMPLE(MongoStorageRead, 0)
     std::vector<VariantKey> failed_reads;
 
+    // The size of a segment is not known until it is read, so reads are batched by count alone
+    auto no_bytes = [](const VariantKey&) { return size_t{0}; };
     (fg::from(ks.as_range()) | fg::move | fg::groupBy(fmt_db)).foreach([&](auto &&group) {
-        for (auto &k : group.values()) {
-                auto collection = collection_name(variant_key_type(k));
-                auto kv = client_->read_segment(db_, collection, k);
-                if(kv.has_segment())
-                    visitor(k, std::move(kv.segment()));
-                else
-                   failed_reads.push_back(k);
-        }
+        auto collection = collection_name(group.key());
+        detail::for_each_batch(group.values(), batch_size_, batch_bytes_, no_bytes, [&](std::vector<VariantKey>&& batch) {
+            auto kvs = client_->read_segments(db_, collection, batch);
+            for (auto& kv : kvs)
+                visitor(kv.variant_key(), std::move(kv.segment()));
+
+            if (kvs.size() < batch.size()) {
+                std::unordered_set<VariantKey> found;
+                for (const auto& kv : kvs)
+                    found.insert(kv.variant_key());
+
+                for (auto& k : batch) {
+                    if (found.find(k) == found.end())
+                        failed_reads.push_back(std::move(k));
+                }
+            }
+        });
     });
 
     if(!failed_reads.empty())
@@ -122,7 +140,10 @@ MongoStorage::MongoStorage(
         ConfigsMap::instance()->get_int("MongoClient.MinPoolSize", 100),
         ConfigsMap::instance()->get_int("MongoClient.MaxPoolSize", 1000),
         ConfigsMap::instance()->get_int("MongoClient.SelectionTimeoutMs", 120000))
-        ) {
+        ),
+    batch_size_(ConfigsMap::instance()->get_int("MongoClient.BatchSize", 1000)),
+    batch_bytes_(ConfigsMap::instance()->get_int("MongoClient.BatchBytes", 32 * 1024 * 1024)),
+    ordered_writes_(ConfigsMap::instance()->get_int("MongoClient.OrderedWrites", 0) != 0) {
     instance_.reset(); //Just want to ensure singleton here, not hang onto it
     auto key_rg = lib.as_range();
     auto it = key_rg.begin();
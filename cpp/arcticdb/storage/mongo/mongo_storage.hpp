@@ -13,8 +13,35 @@
 #include <arcticdb/util/composite.hpp>
 #include <folly/Range.h>
 
+#include <vector>
+
 namespace arcticdb::storage::mongo {
 
+namespace detail {
+
+// Calls flush with consecutive runs of the values, each of at most max_count values and, apart from runs of a single
+// value, at most max_bytes as measured by bytes
+template<typename Values, typename BytesFunc, typename FlushFunc>
+void for_each_batch(Values&& values, size_t max_count, size_t max_bytes, BytesFunc&& bytes, FlushFunc&& flush) {
+    using ValueType = std::decay_t<decltype(*values.begin())>;
+    std::vector<ValueType> batch;
+    size_t batch_bytes = 0;
+    for (auto& value : values) {
+        const auto value_bytes = bytes(value);
+        if (!batch.empty() && (batch.size() >= max_count || batch_bytes + value_bytes > max_bytes)) {
+            flush(std::move(batch));
+            batch.clear();
+            batch_bytes = 0;
+        }
+        batch_bytes += value_bytes;
+        batch.emplace_back(std::move(value));
+    }
+    if (!batch.empty())
+        flush(std::move(batch));
+}
+
+} // namespace detail
+
 class MongoInstance;
 class MongoClient;
 
@@ -39,6 +66,10 @@ class MongoStorage final : public Storage {
         return false;
     }
 
+    size_t do_batch_size() const final {
+        return batch_size_;
+    }
+
     inline bool do_fast_delete() final;
 
     void do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string &prefix) final;
@@ -51,6 +82,10 @@ class MongoStorage final : public Storage {
     std::shared_ptr<MongoClient> client_;
     std::string db_;
     std::string prefix_;
+    // Keys are read and written in batches of at most batch_size_ keys and, for writes, batch_bytes_ of segments
+    size_t batch_size_;
+    size_t batch_bytes_;
+    bool ordered_writes_;
 };
 
 inline arcticdb::proto::storage::VariantStorage pack_config(InstanceUri uri) {
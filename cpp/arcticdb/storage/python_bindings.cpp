@@ -63,6 +63,8 @@ void register_bindings(py::module& storage, py::exception<arcticdb::ArcticExcept
         .value("SNAPSHOT_TOMBSTONE", KeyType::SNAPSHOT_TOMBSTONE)
         .value("LOG_COMPACTED", KeyType::LOG_COMPACTED)
         .value("COLUMN_STATS", KeyType::COLUMN_STATS)
+        .value("CODEC_DICTIONARY", KeyType::CODEC_DICTIONARY)
+        .value("TABLE_INDEX_LEAF", KeyType::TABLE_INDEX_LEAF)
         ;
 
     py::enum_<OpenMode>(storage, "OpenMode")
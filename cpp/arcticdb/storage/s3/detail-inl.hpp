@@ -14,6 +14,7 @@
 #include <arcticdb/util/exponential_backoff.hpp>
 #include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/util/composite.hpp>
+#include <arcticdb/storage/s3/s3_storage.hpp>
 
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
@@ -24,10 +25,20 @@
 #include <aws/s3/model/Object.h>
 #include <aws/s3/model/Delete.h>
 #include <aws/s3/model/ObjectIdentifier.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompletedMultipartUpload.h>
+#include <aws/s3/model/CompletedPart.h>
 
 #include <boost/interprocess/streams/bufferstream.hpp>
 #include <folly/ThreadLocal.h>
 
+#include <deque>
+#include <future>
+#include <optional>
+
 #undef GetMessage
 
 namespace arcticdb::storage {
@@ -44,18 +55,138 @@ namespace s3 {
         template<class It>
         using Range = folly::Range<It>;
 
+
+        /*
+         * Sends count requests, each a part of a larger transfer, with at most concurrency in flight. start(i) sends
+         * the request for part i asynchronously and returns a future of its outcome, and retry(i) sends it again
+         * synchronously. on_success(i, outcome) is called for each part that succeeds, on this thread. Returns the
+         * error of a part that failed every attempt, once the parts in flight have finished.
+         */
+        template<class Outcome, class StartFunc, class RetryFunc, class SuccessFunc>
+        std::optional<Aws::S3::S3Error> transfer_parts(
+                size_t count,
+                const S3TransferOptions &transfer_options,
+                StartFunc &&start,
+                RetryFunc &&retry,
+                SuccessFunc &&on_success) {
+            std::deque<std::pair<size_t, std::future<Outcome>>> in_flight;
+            std::optional<Aws::S3::S3Error> error;
+            auto finish_oldest = [&]() {
+                auto [part, future] = std::move(in_flight.front());
+                in_flight.pop_front();
+                auto outcome = future.get();
+                for (size_t attempt = 0; !outcome.IsSuccess() && attempt < transfer_options.part_retries_ && !error; ++attempt) {
+                    ARCTICDB_DEBUG(log::storage(), "Retrying part {} after error {}", part, outcome.GetError().GetMessage().c_str());
+                    outcome = retry(part);
+                }
+                if (outcome.IsSuccess())
+                    on_success(part, outcome);
+                else if (!error)
+                    error = outcome.GetError();
+            };
+
+            for (size_t part = 0; part < count && !error; ++part) {
+                if (in_flight.size() >= transfer_options.concurrency_)
+                    finish_oldest();
+
+                in_flight.emplace_back(part, start(part));
+            }
+            while (!in_flight.empty())
+                finish_oldest();
+
+            return error;
+        }
+
+        template<class S3ClientType>
+        void put_object_multipart(
+                S3ClientType &s3_client,
+                const std::string &bucket_name,
+                const std::string &s3_object_name,
+                uint8_t *data,
+                size_t size,
+                const S3TransferOptions &transfer_options) {
+            ARCTICDB_SUBSAMPLE(S3StorageCreateMultipartUpload, 0)
+            Aws::S3::Model::CreateMultipartUploadRequest create_request;
+            create_request.WithBucket(bucket_name.c_str()).WithKey(s3_object_name.c_str());
+            auto create_outcome = s3_client.CreateMultipartUpload(create_request);
+            if (!create_outcome.IsSuccess()) {
+                auto &error = create_outcome.GetError();
+                util::raise_rte("Failed to start multipart upload of s3 object '{}' {}: {}",
+                                s3_object_name,
+                                error.GetExceptionName().c_str(),
+                                error.GetMessage().c_str());
+            }
+            const auto upload_id = create_outcome.GetResult().GetUploadId();
+
+            const auto part_size = transfer_options.multipart_part_size_;
+            const auto num_parts = (size + part_size - 1) / part_size;
+            auto part_request = [&](size_t part) {
+                const auto offset = part * part_size;
+                const auto bytes = std::min(part_size, size - offset);
+                Aws::S3::Model::UploadPartRequest request;
+                request.WithBucket(bucket_name.c_str())
+                       .WithKey(s3_object_name.c_str())
+                       .WithUploadId(upload_id)
+                       .WithPartNumber(static_cast<int>(part + 1))
+                       .WithContentLength(static_cast<long long>(bytes));
+                request.SetBody(std::make_shared<boost::interprocess::bufferstream>(reinterpret_cast<char *>(data + offset), bytes));
+                return request;
+            };
+
+            ARCTICDB_SUBSAMPLE(S3StorageUploadParts, 0)
+            std::vector<Aws::S3::Model::CompletedPart> completed_parts(num_parts);
+            auto error = transfer_parts<Aws::S3::Model::UploadPartOutcome>(
+                    num_parts,
+                    transfer_options,
+                    [&](size_t part) { return s3_client.UploadPartCallable(part_request(part)); },
+                    [&](size_t part) { return s3_client.UploadPart(part_request(part)); },
+                    [&](size_t part, const Aws::S3::Model::UploadPartOutcome &outcome) {
+                        completed_parts[part].WithPartNumber(static_cast<int>(part + 1)).WithETag(outcome.GetResult().GetETag());
+                    });
+
+            if (!error) {
+                ARCTICDB_SUBSAMPLE(S3StorageCompleteMultipartUpload, 0)
+                Aws::S3::Model::CompletedMultipartUpload completed;
+                completed.SetParts(std::move(completed_parts));
+                Aws::S3::Model::CompleteMultipartUploadRequest complete_request;
+                complete_request.WithBucket(bucket_name.c_str())
+                                .WithKey(s3_object_name.c_str())
+                                .WithUploadId(upload_id)
+                                .WithMultipartUpload(std::move(completed));
+                auto complete_outcome = s3_client.CompleteMultipartUpload(complete_request);
+                if (complete_outcome.IsSuccess()) {
+                    ARCTICDB_RUNTIME_DEBUG(log::storage(), "Uploaded {} bytes to {} in {} parts", size, s3_object_name, num_parts);
+                    return;
+                }
+                error = complete_outcome.GetError();
+            }
+
+            // The parts already uploaded are stored, and charged for, until the upload is aborted
+            Aws::S3::Model::AbortMultipartUploadRequest abort_request;
+            abort_request.WithBucket(bucket_name.c_str()).WithKey(s3_object_name.c_str()).WithUploadId(upload_id);
+            auto abort_outcome = s3_client.AbortMultipartUpload(abort_request);
+            if (!abort_outcome.IsSuccess())
+                log::storage().warn("Failed to abort multipart upload {} of '{}': {}", upload_id.c_str(), s3_object_name, abort_outcome.GetError().GetMessage().c_str());
+
+            util::raise_rte("Failed multipart upload of s3 object '{}' {}: {}",
+                            s3_object_name,
+                            error->GetExceptionName().c_str(),
+                            error->GetMessage().c_str());
+        }
+
         template<class S3ClientType, class KeyBucketizer>
         void do_write_impl(
                 Composite<KeySegmentPair> &&kvs,
                 const std::string &root_folder,
                 const std::string &bucket_name,
                 S3ClientType &s3_client,
-                KeyBucketizer &&bucketizer) {
+                KeyBucketizer &&bucketizer,
+                const S3TransferOptions &transfer_options = S3TransferOptions{}) {
             ARCTICDB_SAMPLE(S3StorageWrite, 0)
             auto fmt_db = [](auto &&kv) { return kv.key_type(); };
 
             (fg::from(kvs.as_range()) | fg::move | fg::groupBy(fmt_db)).foreach(
-                    [&s3_client, &bucket_name, &root_folder, b = std::move(bucketizer)](auto &&group) {
+                    [&s3_client, &bucket_name, &root_folder, b = std::move(bucketizer), &transfer_options](auto &&group) {
                         auto key_type_dir = key_type_folder(root_folder, group.key());
                         ARCTICDB_TRACE(log::storage(), "S3 key_type_folder is {}", key_type_dir);
 
@@ -66,11 +197,6 @@ namespace s3 {
                             auto &seg = kv.segment();
 
                             ARCTICDB_SUBSAMPLE(S3StorageWritePreamble, 0)
-                            Aws::S3::Model::PutObjectRequest object_request;
-                            object_request.SetBucket(bucket_name.c_str());
-                            object_request.SetKey(s3_object_name.c_str());
-                            ARCTICDB_RUNTIME_DEBUG(log::storage(), "Set s3 key {}", object_request.GetKey().c_str());
-
                             std::shared_ptr<Buffer> tmp;
                             auto hdr_size = seg.segment_header_bytes_size();
                             auto [dst, write_size] = seg.try_internal_write(tmp, hdr_size);
@@ -81,20 +207,30 @@ namespace s3 {
                                         hdr_size,
                                         seg.buffer().bytes(),
                                         write_size);
-                            auto body = std::make_shared<boost::interprocess::bufferstream>(
-                                    reinterpret_cast<char *>(dst), write_size);
-                            util::check(body->good(), "Overflow of bufferstream with size {}", write_size);
-                            object_request.SetBody(body);
-
-                            ARCTICDB_SUBSAMPLE(S3StoragePutObject, 0)
-                            auto put_object_outcome = s3_client.PutObject(object_request);
-
-                            if (!put_object_outcome.IsSuccess()) {
-                                auto &error = put_object_outcome.GetError();
-                                util::raise_rte("Failed to write s3 with key '{}' {}: {}",
-                                                k,
-                                                error.GetExceptionName().c_str(),
-                                                error.GetMessage().c_str());
+
+                            if (transfer_options.multipart_upload_threshold_ != 0 && write_size > transfer_options.multipart_upload_threshold_) {
+                                put_object_multipart(s3_client, bucket_name, s3_object_name, dst, write_size, transfer_options);
+                            } else {
+                                Aws::S3::Model::PutObjectRequest object_request;
+                                object_request.SetBucket(bucket_name.c_str());
+                                object_request.SetKey(s3_object_name.c_str());
+                                ARCTICDB_RUNTIME_DEBUG(log::storage(), "Set s3 key {}", object_request.GetKey().c_str());
+
+                                auto body = std::make_shared<boost::interprocess::bufferstream>(
+                                        reinterpret_cast<char *>(dst), write_size);
+                                util::check(body->good(), "Overflow of bufferstream with size {}", write_size);
+                                object_request.SetBody(body);
+
+                                ARCTICDB_SUBSAMPLE(S3StoragePutObject, 0)
+                                auto put_object_outcome = s3_client.PutObject(object_request);
+
+                                if (!put_object_outcome.IsSuccess()) {
+                                    auto &error = put_object_outcome.GetError();
+                                    util::raise_rte("Failed to write s3 with key '{}' {}: {}",
+                                                    k,
+                                                    error.GetExceptionName().c_str(),
+                                                    error.GetMessage().c_str());
+                                }
                             }
                             ARCTICDB_RUNTIME_DEBUG(log::storage(), "Wrote key {}: {}, with {} bytes of data",
                                                    variant_key_type(k),
@@ -110,9 +246,10 @@ namespace s3 {
                 const std::string &root_folder,
                 const std::string &bucket_name,
                 S3ClientType &s3_client,
-                KeyBucketizer &&bucketizer) {
+                KeyBucketizer &&bucketizer,
+                const S3TransferOptions &transfer_options = S3TransferOptions{}) {
             // s3 updates the key if it already exists (our buckets don't have versioning)
-            do_write_impl(std::move(kvs), root_folder, bucket_name, s3_client, std::move(bucketizer));
+            do_write_impl(std::move(kvs), root_folder, bucket_name, s3_client, std::move(bucketizer), transfer_options);
         }
 
         struct UnexpectedS3ErrorException : public std::exception {
@@ -176,7 +313,8 @@ namespace s3 {
                 const std::string &root_folder,
                 const std::string &bucket_name,
                 S3ClientType &s3_client,
-                KeyBucketizer &b) {
+                KeyBucketizer &b,
+                size_t first_bytes = 0) {
             auto key_type_dir = key_type_folder(root_folder, variant_key_type(key));
             auto s3_object_name = object_path(b.bucketize(key_type_dir, key), key);
 
@@ -184,6 +322,9 @@ namespace s3 {
             Aws::S3::Model::GetObjectRequest request;
             request.WithBucket(bucket_name.c_str()).WithKey(s3_object_name.c_str());
             request.SetResponseStreamFactory(S3StreamFactory());
+            if (first_bytes != 0)
+                request.SetRange(fmt::format("bytes=0-{}", first_bytes - 1).c_str());
+
             auto res = s3_client.GetObject(request);
 
             if (!res.IsSuccess() && !is_expected_error_type(res.GetError().GetErrorType())) {
@@ -199,6 +340,74 @@ namespace s3 {
             return res;
         }
 
+        // The total size of the object from a Content-Range header of the form "bytes 0-1023/4096"
+        inline std::optional<size_t> object_size_from_content_range(const Aws::String &content_range) {
+            const auto slash = content_range.rfind('/');
+            if (slash == Aws::String::npos || slash + 1 == content_range.size() || content_range[slash + 1] == '*')
+                return std::nullopt;
+
+            return std::stoull(std::string{content_range.substr(slash + 1)});
+        }
+
+        /*
+         * Downloads bytes [received, total) of the object with concurrent ranged GETs, each writing directly into its
+         * part of the buffer, which already holds the first received bytes.
+         */
+        template<class KeyType, class S3ClientType, class KeyBucketizer>
+        void get_remaining_ranges(
+                const KeyType &key,
+                const std::string &root_folder,
+                const std::string &bucket_name,
+                S3ClientType &s3_client,
+                KeyBucketizer &b,
+                Buffer &buffer,
+                size_t received,
+                size_t total,
+                const S3TransferOptions &transfer_options) {
+            auto key_type_dir = key_type_folder(root_folder, variant_key_type(key));
+            auto s3_object_name = object_path(b.bucketize(key_type_dir, key), key);
+            buffer.ensure(total);
+
+            const auto range_size = transfer_options.ranged_get_size_;
+            const auto num_ranges = (total - received + range_size - 1) / range_size;
+            auto range_request = [&](size_t range) {
+                const auto offset = received + range * range_size;
+                const auto bytes = std::min(range_size, total - offset);
+                auto *dst = buffer.ptr_cast<char>(offset, bytes);
+                Aws::S3::Model::GetObjectRequest request;
+                request.WithBucket(bucket_name.c_str())
+                       .WithKey(s3_object_name.c_str())
+                       .WithRange(fmt::format("bytes={}-{}", offset, offset + bytes - 1).c_str());
+                request.SetResponseStreamFactory([dst, bytes]() {
+                    return Aws::New<boost::interprocess::bufferstream>("", dst, bytes);
+                });
+                return request;
+            };
+
+            ARCTICDB_SUBSAMPLE(S3StorageGetRanges, 0)
+            auto error = transfer_parts<Aws::S3::Model::GetObjectOutcome>(
+                    num_ranges,
+                    transfer_options,
+                    [&](size_t range) { return s3_client.GetObjectCallable(range_request(range)); },
+                    [&](size_t range) { return s3_client.GetObject(range_request(range)); },
+                    [&](size_t range, const Aws::S3::Model::GetObjectOutcome &outcome) {
+                        const auto expected = std::min(range_size, total - received - range * range_size);
+                        util::check(static_cast<size_t>(outcome.GetResult().GetContentLength()) == expected,
+                                    "Ranged read of s3 object '{}' returned {} bytes, expected {}",
+                                    s3_object_name, outcome.GetResult().GetContentLength(), expected);
+                    });
+
+            if (error) {
+                log::storage().error("Got unexpected error reading ranges of '{}': '{}' {}: {}",
+                                     s3_object_name,
+                                     int(error->GetErrorType()),
+                                     error->GetExceptionName().c_str(),
+                                     error->GetMessage().c_str());
+                throw UnexpectedS3ErrorException{};
+            }
+            ARCTICDB_RUNTIME_DEBUG(log::storage(), "Read {} bytes of {} in {} ranges", total, s3_object_name, num_ranges + 1);
+        }
+
         template<class KeyType, class S3ClientType, class KeyBucketizer>
         auto head_object(
                 const KeyType &key,
@@ -234,28 +443,39 @@ namespace s3 {
                           const std::string &bucket_name,
                           S3ClientType &s3_client,
                           KeyBucketizer &&bucketizer,
-                          ReadKeyOpts opts) {
+                          ReadKeyOpts opts,
+                          const S3TransferOptions &transfer_options = S3TransferOptions{}) {
             ARCTICDB_SAMPLE(S3StorageRead, 0)
             auto fmt_db = [](auto &&k) { return variant_key_type(k); };
             std::vector<VariantKey> failed_reads;
 
             (fg::from(ks.as_range()) | fg::move | fg::groupBy(fmt_db)).foreach(
                     [&s3_client, &bucket_name, &root_folder, b = std::move(bucketizer), &visitor, &failed_reads,
-                            opts = opts](auto &&group) {
+                            opts = opts, &transfer_options](auto &&group) {
 
                         for (auto &k: group.values()) {
+                            // With ranged reads enabled the first request is for the first range, and its
+                            // Content-Range gives the size of the object, so small objects still take one request
                             auto get_object_outcome = get_object(
                                     k,
                                     root_folder,
                                     bucket_name,
                                     s3_client,
-                                    b);
+                                    b,
+                                    transfer_options.ranged_get_size_);
 
                             if (get_object_outcome.IsSuccess()) {
                                 ARCTICDB_SUBSAMPLE(S3StorageVisitSegment, 0)
-                                auto &retrieved = dynamic_cast<S3IOStream &>(get_object_outcome.GetResult().GetBody());
+                                auto &result = get_object_outcome.GetResult();
+                                auto &retrieved = dynamic_cast<S3IOStream &>(result.GetBody());
+                                auto buffer = retrieved.get_buffer();
+                                if (transfer_options.ranged_get_size_ != 0) {
+                                    const auto total = object_size_from_content_range(result.GetContentRange());
+                                    if (total && *total > buffer->bytes())
+                                        get_remaining_ranges(k, root_folder, bucket_name, s3_client, b, *buffer, buffer->bytes(), *total, transfer_options);
+                                }
 
-                                visitor(k, Segment::from_buffer(retrieved.get_buffer()));
+                                visitor(k, Segment::from_buffer(std::move(buffer)));
 
                                 ARCTICDB_DEBUG(log::storage(), "Read key {}: {}", variant_key_type(k),
                                                variant_key_view(k));
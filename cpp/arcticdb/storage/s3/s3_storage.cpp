@@ -62,15 +62,15 @@ std::string S3Storage::get_key_path(const VariantKey& key) const {
 }
 
 void S3Storage::do_write(Composite<KeySegmentPair>&& kvs) {
-    detail::do_write_impl(std::move(kvs), root_folder_, bucket_name_, s3_client_, FlatBucketizer{});
+    detail::do_write_impl(std::move(kvs), root_folder_, bucket_name_, s3_client_, FlatBucketizer{}, transfer_options_);
 }
 
 void S3Storage::do_update(Composite<KeySegmentPair>&& kvs, UpdateOpts) {
-    detail::do_update_impl(std::move(kvs), root_folder_, bucket_name_, s3_client_, FlatBucketizer{});
+    detail::do_update_impl(std::move(kvs), root_folder_, bucket_name_, s3_client_, FlatBucketizer{}, transfer_options_);
 }
 
 void S3Storage::do_read(Composite<VariantKey>&& ks, const ReadVisitor& visitor, ReadKeyOpts opts) {
-    detail::do_read_impl(std::move(ks), visitor, root_folder_, bucket_name_, s3_client_, FlatBucketizer{}, opts);
+    detail::do_read_impl(std::move(ks), visitor, root_folder_, bucket_name_, s3_client_, FlatBucketizer{}, opts, transfer_options_);
 }
 
 void S3Storage::do_remove(Composite<VariantKey>&& ks, RemoveOpts) {
@@ -117,7 +117,8 @@ S3Storage::S3Storage(const LibraryPath &library_path, OpenMode mode, const Confi
     Storage(library_path, mode),
     s3_api_(S3ApiInstance::instance()),
     root_folder_(object_store_utils::get_root_folder(library_path)),
-    bucket_name_(conf.bucket_name()) {
+    bucket_name_(conf.bucket_name()),
+    transfer_options_(get_transfer_options(conf)) {
 
     auto creds = get_aws_credentials(conf);
 
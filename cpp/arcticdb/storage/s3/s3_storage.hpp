@@ -20,6 +20,7 @@
 #include <arcticdb/storage/s3/s3_client_accessor.hpp>
 #include <arcticdb/util/composite.hpp>
 #include <arcticdb/util/configs_map.hpp>
+#include <algorithm>
 #include <cstdlib>
 #include <sstream>
 #include <string>
@@ -29,6 +30,18 @@ namespace arcticdb::storage::s3 {
 
 const std::string USE_AWS_CRED_PROVIDERS_TOKEN = "_RBAC_";
 
+/*
+ * How objects too large to be sent efficiently in a single request are split up. A zero threshold or size turns the
+ * splitting off, which is the default for storages that have no configuration for it.
+ */
+struct S3TransferOptions {
+    size_t multipart_upload_threshold_ = 0;
+    size_t multipart_part_size_ = 0;
+    size_t ranged_get_size_ = 0;
+    size_t concurrency_ = 1;
+    size_t part_retries_ = 3;
+};
+
 class S3Storage final : public Storage {
   public:
     friend class S3TestClientAccessor<S3Storage>;
@@ -72,6 +85,7 @@ class S3Storage final : public Storage {
     Aws::S3::S3Client s3_client_;
     std::string root_folder_;
     std::string bucket_name_;
+    S3TransferOptions transfer_options_;
 };
 
 inline arcticdb::proto::storage::VariantStorage pack_config(const std::string &bucket_name) {
@@ -234,6 +248,18 @@ auto get_s3_config(const ConfigType& conf) {
     return client_configuration;
 }
 
+template<typename ConfigType>
+S3TransferOptions get_transfer_options(const ConfigType& conf) {
+    static constexpr size_t MIN_PART_SIZE = 5 * 1024 * 1024;
+    S3TransferOptions options;
+    options.multipart_upload_threshold_ = conf.multipart_upload_threshold() == 0 ? 64 * 1024 * 1024 : conf.multipart_upload_threshold();
+    options.multipart_part_size_ = std::max<size_t>(conf.multipart_part_size() == 0 ? 16 * 1024 * 1024 : conf.multipart_part_size(), MIN_PART_SIZE);
+    options.ranged_get_size_ = conf.ranged_get_size() == 0 ? 16 * 1024 * 1024 : conf.ranged_get_size();
+    options.concurrency_ = conf.transfer_concurrency() == 0 ? 8 : conf.transfer_concurrency();
+    options.part_retries_ = ConfigsMap::instance()->get_int("S3Storage.PartRetries", 3);
+    return options;
+}
+
 template<typename ConfigType>
 Aws::Auth::AWSCredentials get_aws_credentials(const ConfigType& conf) {
     return Aws::Auth::AWSCredentials(conf.credential_name().c_str(), conf.credential_key().c_str());
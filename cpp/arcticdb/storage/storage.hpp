@@ -143,6 +143,12 @@ public:
         return do_fast_delete();
     }
 
+    // The number of keys worth sending to the storage in one read or write, for storages that fetch or store many
+    // keys in a single request. Storages that make a request per key keep the default of one.
+    size_t batch_size() const {
+        return do_batch_size();
+    }
+
     inline bool key_exists(const VariantKey &key) {
         return do_key_exists(key);
     }
@@ -173,6 +179,10 @@ private:
 
     virtual bool do_fast_delete() = 0;
 
+    virtual size_t do_batch_size() const {
+        return 1;
+    }
+
     virtual void do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string & prefix) = 0;
 
     virtual std::string do_key_path(const VariantKey& key) const = 0;
@@ -7,6 +7,12 @@
 
 #pragma once
 
+#include <memory>
+
+namespace arcticdb {
+class ProfileStage;
+}
+
 namespace arcticdb::storage {
 
 /**
@@ -34,6 +40,12 @@ struct ReadKeyOpts {
      * - s3_storage-inl.cpp:do_read_impl()
      */
     bool dont_warn_about_missing_key = false;
+
+    /**
+     * Applies to:
+     * - ReadCompressedTask, which records the time spent reading and the bytes read against it when the read is profiled
+     */
+    std::shared_ptr<ProfileStage> profile_stage_;
 };
 
 /**
@@ -58,6 +58,10 @@ class Storages {
         return primary().fast_delete();
     }
 
+    size_t batch_size() const {
+        return primary().batch_size();
+    }
+
     bool key_exists(const VariantKey& key) {
         return primary().key_exists(key);
     }
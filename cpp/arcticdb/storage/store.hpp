@@ -29,6 +29,8 @@ class Store : public stream::StreamSink, public stream::StreamSource, public std
 public:
     virtual void set_failure_sim(const arcticdb::proto::storage::VersionStoreConfig::StorageFailureSimulator& cfg) = 0;
 
+    virtual void set_codec_opts(const arcticdb::proto::encoding::VariantCodec& codec) = 0;
+
     virtual void move_storage(KeyType key_type, timestamp horizon, size_t storage_index) = 0;
 
     virtual folly::Future<VariantKey> copy(KeyType key_type, const StreamId& stream_id, VersionId version_id, const VariantKey& source_key) = 0;
@@ -45,7 +45,8 @@ namespace arcticdb {
 
         std::vector<folly::Future<pipelines::SegmentAndSlice>> batch_read_uncompressed(
                 std::vector<pipelines::RangesAndKey>&&,
-                std::shared_ptr<std::unordered_set<std::string>>) override {
+                std::shared_ptr<std::unordered_set<std::string>>,
+                std::shared_ptr<ProfileStage>) override {
             throw std::runtime_error("Not implemented for tests");
         }
 
@@ -390,6 +391,8 @@ namespace arcticdb {
 
         void set_failure_sim(const arcticdb::proto::storage::VersionStoreConfig::StorageFailureSimulator &) override {}
 
+        void set_codec_opts(const arcticdb::proto::encoding::VariantCodec &) override {}
+
         void add_segment(const AtomKey &key, SegmentInMemory &&seg) {
             StorageFailureSimulator::instance()->go(FailureType::WRITE);
             std::lock_guard lock{mutex_};
@@ -17,7 +17,10 @@
 #endif
 
 #include <filesystem>
+#include <atomic>
+#include <cstring>
 #include <stdexcept>
+#include <thread>
 #include <arcticdb/entity/atom_key.hpp>
 #include <arcticdb/util/buffer.hpp>
 #include <arcticdb/entity/types.hpp>
@@ -203,6 +206,85 @@ TEST_P(SimpleTestSuite, Strings) {
     ASSERT_EQ(std::string("baggy"), res_mem.string_at(1, 3));
 }
 
+TEST_P(SimpleTestSuite, ConcurrentWrites) {
+    std::unique_ptr<as::Storage> storage = GetParam().new_backend();
+    auto make_kv = [](ac::entity::VersionId version) {
+        ac::entity::AtomKey k = ac::entity::atom_key_builder().gen_id(version).build<ac::entity::KeyType::TABLE_DATA>(999);
+        as::KeySegmentPair kv(std::move(k));
+        kv.segment().header().set_start_ts(version);
+        kv.segment().set_buffer(std::make_shared<Buffer>());
+        return kv;
+    };
+    storage->write(make_kv(0));
+
+    // Concurrent writes can be committed together, but a duplicate must still only fail its own write
+    constexpr size_t num_threads = 8;
+    constexpr size_t writes_per_thread = 20;
+    std::atomic<size_t> duplicates{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < writes_per_thread; ++i) {
+                try {
+                    storage->write(make_kv(i == 0 && t == 0 ? 0 : 1 + t * writes_per_thread + i));
+                } catch (const as::DuplicateKeyException&) {
+                    ++duplicates;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(duplicates.load(), 1);
+    for (size_t t = 0; t < num_threads; ++t) {
+        for (size_t i = t == 0 ? 1 : 0; i < writes_per_thread; ++i) {
+            const auto version = 1 + t * writes_per_thread + i;
+            auto res = storage->read(make_kv(version).variant_key(), as::ReadKeyOpts{});
+            ASSERT_EQ(res.segment().header().start_ts(), version);
+        }
+    }
+}
+
+TEST_P(SimpleTestSuite, SegmentsOutliveRead) {
+    std::unique_ptr<as::Storage> storage = GetParam().new_backend();
+    std::vector<ac::entity::VariantKey> keys;
+    for (ac::entity::VersionId version = 0; version < 3; ++version) {
+        ac::entity::AtomKey k = ac::entity::atom_key_builder().gen_id(version).build<ac::entity::KeyType::TABLE_DATA>(999);
+        keys.emplace_back(k);
+        as::KeySegmentPair kv(std::move(k));
+        auto buffer = std::make_shared<Buffer>(64);
+        std::memset(buffer->data(), static_cast<int>(version), buffer->bytes());
+        kv.segment().set_buffer(std::move(buffer));
+        storage->write(std::move(kv));
+    }
+
+    // Every segment of a multi-key read keeps the data it was read from valid, even after later reads and writes
+    std::vector<ac::Segment> segments;
+    storage->read(ac::Composite<ac::entity::VariantKey>(std::vector<ac::entity::VariantKey>(keys)), [&](auto&&, auto&& seg) {
+        segments.emplace_back(std::move(seg));
+    }, as::ReadKeyOpts{});
+    ASSERT_EQ(segments.size(), keys.size());
+
+    for (ac::entity::VersionId version = 3; version < 10; ++version) {
+        ac::entity::AtomKey k = ac::entity::atom_key_builder().gen_id(version).build<ac::entity::KeyType::TABLE_DATA>(999);
+        as::KeySegmentPair kv(std::move(k));
+        kv.segment().header().set_start_ts(1000 + version);
+        kv.segment().set_buffer(std::make_shared<Buffer>());
+        storage->write(std::move(kv));
+        ASSERT_TRUE(storage->key_exists(keys[0]));
+    }
+
+    for (auto& seg : segments) {
+        const auto buffer = seg.buffer();
+        ASSERT_EQ(buffer.bytes(), 64);
+        const auto version = buffer.data()[0];
+        ASSERT_LT(version, keys.size());
+        for (size_t i = 0; i < buffer.bytes(); ++i)
+            ASSERT_EQ(buffer.data()[i], version);
+    }
+}
+
 using namespace std::string_literals;
 
 std::vector<BackendGenerator> get_backend_generators() {
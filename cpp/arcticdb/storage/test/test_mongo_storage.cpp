@@ -12,6 +12,8 @@
 
 #include <thread>
 #include <filesystem>
+#include <numeric>
+#include <vector>
 #include <mongocxx/uri.hpp>
 
 const std::string test_server("mongodb://localhost:27017");
@@ -109,3 +111,22 @@ TEST(MongoStorage, ClientSession) {
     numeric_res = storage.read(numeric_k, as::ReadKeyOpts{});
     ASSERT_EQ(numeric_res.segment().header().start_ts(), 7890);
 }
+
+TEST(MongoStorage, BatchesByCountAndBytes) {
+    namespace asmongo = arcticdb::storage::mongo;
+    std::vector<size_t> values(10);
+    std::iota(values.begin(), values.end(), 1);
+    auto batches_of = [&values](size_t max_count, size_t max_bytes) {
+        std::vector<std::vector<size_t>> batches;
+        asmongo::detail::for_each_batch(std::vector<size_t>{values}, max_count, max_bytes, [](size_t value) { return value; },
+                                        [&batches](std::vector<size_t>&& batch) { batches.emplace_back(std::move(batch)); });
+        return batches;
+    };
+
+    using Batches = std::vector<std::vector<size_t>>;
+    ASSERT_EQ(batches_of(100, 1000), Batches{values});
+    ASSERT_EQ(batches_of(4, 1000), (Batches{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10}}));
+    ASSERT_EQ(batches_of(100, 10), (Batches{{1, 2, 3, 4}, {5}, {6}, {7}, {8}, {9}, {10}}));
+    // A value larger than the byte limit on its own still gets a batch of its own
+    ASSERT_EQ(batches_of(100, 3), (Batches{{1, 2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}, {10}}));
+}
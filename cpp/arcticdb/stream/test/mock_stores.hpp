@@ -142,6 +142,8 @@ class NullStore :
 
     void set_failure_sim(const arcticdb::proto::storage::VersionStoreConfig::StorageFailureSimulator &) override {}
 
+    void set_codec_opts(const arcticdb::proto::encoding::VariantCodec &) override {}
+
 };
 
 } //namespace arcticdb
\ No newline at end of file
@@ -6,10 +6,144 @@
  */
 
 #include <arcticdb/util/buffer_pool.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <algorithm>
 #include <memory>
+#include <thread>
 
 namespace arcticdb {
 
+namespace detail {
+
+BufferQueue::BufferQueue(size_t capacity) :
+    mask_(capacity == 0 ? 0 : capacity - 1),
+    cells_(capacity == 0 ? nullptr : std::make_unique<Cell[]>(capacity)) {
+    util::check(capacity == 0 || (capacity >= 2 && (capacity & (capacity - 1)) == 0),
+                "BufferQueue capacity must be zero or a power of two no smaller than two, got {}", capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        cells_[i].buffer_ = nullptr;
+    }
+}
+
+std::unique_ptr<Buffer> BufferQueue::push(std::unique_ptr<Buffer>&& buffer) {
+    if (!cells_)
+        return std::move(buffer);
+
+    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        auto& cell = cells_[pos & mask_];
+        const auto sequence = cell.sequence_.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.buffer_ = buffer.release();
+                cell.sequence_.store(pos + 1, std::memory_order_release);
+                return nullptr;
+            }
+        } else if (diff < 0) {
+            // The consumer of the previous lap has not emptied this cell yet
+            return std::move(buffer);
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::unique_ptr<Buffer> BufferQueue::pop() {
+    if (!cells_)
+        return nullptr;
+
+    auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        auto& cell = cells_[pos & mask_];
+        const auto sequence = cell.sequence_.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                std::unique_ptr<Buffer> buffer{cell.buffer_};
+                cell.sequence_.store(pos + mask_ + 1, std::memory_order_release);
+                return buffer;
+            }
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace detail
+
+namespace {
+
+size_t class_min_bytes(size_t size_class) {
+    return BufferPool::min_class_bytes << size_class;
+}
+
+// The most buffers of a class that fit under a high-water mark, as a queue capacity
+size_t queue_capacity(size_t size_class, size_t high_water_bytes, size_t max_buffers) {
+    const auto buffers = std::min(max_buffers, high_water_bytes / class_min_bytes(size_class));
+    size_t capacity = 1;
+    while (capacity * 2 <= buffers)
+        capacity *= 2;
+    return capacity >= 2 ? capacity : 0;
+}
+
+size_t configured_num_shards() {
+    const auto configured = ConfigsMap::instance()->get_int("BufferPool.NumShards", static_cast<int64_t>(std::thread::hardware_concurrency()));
+    size_t num_shards = 1;
+    while (num_shards < static_cast<size_t>(std::max(configured, int64_t{1})))
+        num_shards *= 2;
+    return num_shards;
+}
+
+// Threads are numbered in the order they first use a pool, and spread across its shards round robin
+size_t thread_index() {
+    static std::atomic<size_t> next_thread_index{0};
+    thread_local const size_t index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+} // namespace
+
+class BufferPool::Shard {
+public:
+    Shard(size_t high_water_bytes, std::shared_ptr<SizeClassQueues> overflow) :
+        overflow_(std::move(overflow)) {
+        for (size_t size_class = 0; size_class < num_size_classes; ++size_class)
+            cache_[size_class] = std::make_unique<detail::BufferQueue>(queue_capacity(size_class, high_water_bytes, 8));
+    }
+    ARCTICDB_NO_MOVE_OR_COPY(Shard)
+
+    std::unique_ptr<Buffer> take(size_t size_class) {
+        if (auto buffer = cache_[size_class]->pop())
+            return buffer;
+        return (*overflow_)[size_class]->pop();
+    }
+
+    void give_back(std::unique_ptr<Buffer>&& buffer) {
+        const auto size_class = size_class_of_capacity(buffer->preamble_bytes() + buffer->available());
+        if (size_class == num_size_classes)
+            return;
+
+        buffer->reset();
+        if (auto rejected = cache_[size_class]->push(std::move(buffer)))
+            (*overflow_)[size_class]->push(std::move(rejected));
+    }
+
+    void clear() {
+        for (auto& queue: cache_)
+            queue->clear();
+    }
+
+private:
+    SizeClassQueues cache_;
+    std::shared_ptr<SizeClassQueues> overflow_;
+};
+
 std::shared_ptr<BufferPool> BufferPool::instance(){
     std::call_once(BufferPool::init_flag_, &BufferPool::init);
     return BufferPool::instance_;
@@ -25,13 +159,68 @@ void BufferPool::init() {
     instance_ = std::make_shared<BufferPool>();
 }
 
-BufferPool::BufferPool() : pool_(
-            [] () { return std::make_shared<Buffer>(); },
-            [] (std::shared_ptr<Buffer> buf) { buf->reset(); }
-    ){
+BufferPool::BufferPool() :
+    overflow_(std::make_shared<SizeClassQueues>()) {
+    const auto high_water_bytes = static_cast<size_t>(ConfigsMap::instance()->get_int("BufferPool.HighWaterBytes", 256 * 1024 * 1024));
+    const auto shard_high_water_bytes = static_cast<size_t>(ConfigsMap::instance()->get_int("BufferPool.ShardHighWaterBytes", 4 * 1024 * 1024));
+    for (size_t size_class = 0; size_class < num_size_classes; ++size_class)
+        (*overflow_)[size_class] = std::make_unique<detail::BufferQueue>(queue_capacity(size_class, high_water_bytes, 256));
+
+    const auto num_shards = configured_num_shards();
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i)
+        shards_.emplace_back(std::make_shared<Shard>(shard_high_water_bytes, overflow_));
+}
+
+// Buffers still out keep their shard, and through it the overflow, alive until they are returned
+BufferPool::~BufferPool() = default;
+
+const std::shared_ptr<BufferPool::Shard>& BufferPool::shard_for_this_thread() const {
+    return shards_[thread_index() & (shards_.size() - 1)];
+}
+
+std::shared_ptr<Buffer> BufferPool::allocate(size_t min_bytes) {
+    const auto& shard = shard_for_this_thread();
+    const auto size_class = size_class_of_request(min_bytes);
+    std::unique_ptr<Buffer> buffer;
+    if (size_class < num_size_classes)
+        buffer = shard->take(size_class);
+    if (!buffer)
+        buffer = std::make_unique<Buffer>();
+
+    // The smallest class also holds buffers with less capacity than it guarantees
+    if (buffer->available() < min_bytes) {
+        buffer->ensure(min_bytes);
+        buffer->set_bytes(0);
+    }
+    ARCTICDB_DEBUG(log::version(), "Pool returning {}", uintptr_t(buffer.get()));
+    return {buffer.release(), [shard](Buffer* returned) {
+        shard->give_back(std::unique_ptr<Buffer>(returned));
+    }};
+}
+
+void BufferPool::clear() {
+    for (auto& shard: shards_)
+        shard->clear();
+    for (auto& queue: *overflow_)
+        queue->clear();
+}
+
+size_t BufferPool::size_class_of_capacity(size_t capacity) {
+    size_t size_class = 0;
+    while (size_class < num_size_classes && capacity >= class_min_bytes(size_class + 1))
+        ++size_class;
+    return size_class;
+}
+
+size_t BufferPool::size_class_of_request(size_t min_bytes) {
+    size_t size_class = 0;
+    while (size_class < num_size_classes && min_bytes > class_min_bytes(size_class))
+        ++size_class;
+    return size_class;
 }
 
 std::shared_ptr<BufferPool> BufferPool::instance_;
 std::once_flag BufferPool::init_flag_;
 
-}  //namespace arcticdb
\ No newline at end of file
+}  //namespace arcticdb
@@ -8,43 +8,111 @@
 #pragma once
 
 #include <arcticdb/util/buffer.hpp>
+#include <arcticdb/util/constructors.hpp>
 
-#ifdef ARCTICDB_USING_CONDA
-    #include <recycle/shared_pool.hpp>
-#else
-    #include <third_party/recycle/src/recycle/shared_pool.hpp>
-#endif
-
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace arcticdb {
 
-struct lock_policy {
-    using mutex_type = std::mutex;
-    using lock_type = std::lock_guard<mutex_type>;
-};
+namespace detail {
 
-class BufferPool {
-    static std::shared_ptr<BufferPool> instance_;
-    static std::once_flag init_flag_;
+/*
+ * A bounded multi-producer multi-consumer queue of owned buffers, after Dmitry Vyukov's design. Each cell carries a
+ * sequence number that tells producers and consumers whether it is theirs to fill or empty, so neither ever waits on
+ * a lock, and a full or empty queue is reported rather than waited on. A capacity of zero holds nothing.
+ */
+class BufferQueue {
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence_;
+        Buffer* buffer_;
+    };
 
-    static void init();
+public:
+    // capacity must be zero or a power of two no smaller than two
+    explicit BufferQueue(size_t capacity);
+    ARCTICDB_NO_MOVE_OR_COPY(BufferQueue)
+
+    ~BufferQueue() {
+        clear();
+    }
 
-    recycle::shared_pool<Buffer, lock_policy> pool_;
+    // Returns the buffer if the queue is full, for the caller to put elsewhere
+    std::unique_ptr<Buffer> push(std::unique_ptr<Buffer>&& buffer);
+
+    std::unique_ptr<Buffer> pop();
+
+    void clear() {
+        while (pop());
+    }
+
+private:
+    size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+
+} // namespace detail
+
+/*
+ * Recycles buffers, so that their memory is reused rather than reallocated.
+ *
+ * Segments being written to S3 or Azure take their temp buffer from the pool when the header does not fit in the
+ * space reserved ahead of the encoded data. Encoded segments themselves are not pooled, as they can outlive the write.
+ *
+ * Buffers are kept in power of two size classes by capacity, starting from 4KB, so that asking for a small buffer
+ * never hands out, and pins, a large one. Each class has a small cache in each of a number of shards, with threads
+ * spread across the shards, in front of a global overflow queue. Shard caches and overflow queues are all lock-free,
+ * and buffers go back to the shard that handed them out, so threads only contend when they share a shard or overflow.
+ *
+ * How much is kept is bounded by high-water marks on the bytes of each class, in each shard and in the overflow. A
+ * buffer returned to a full class, or larger than the largest class, is freed.
+ */
+class BufferPool {
 public:
+    static constexpr size_t min_class_bytes = 4 * 1024;
+    static constexpr size_t num_size_classes = 15;  // The largest class holds buffers from 64MB up to 128MB
+
     static std::shared_ptr<BufferPool> instance();
     static void destroy_instance();
 
     BufferPool();
+    ~BufferPool();
 
-    auto allocate() {
-        auto output = pool_.allocate();
-        ARCTICDB_DEBUG(log::version(), "Pool returning {}", uintptr_t(output.get()));
-        return output;
-    }
-    
-    void clear() {
-        pool_.free_unused();
+    // An empty buffer, with capacity for at least min_bytes if that is known up front
+    std::shared_ptr<Buffer> allocate(size_t min_bytes = 0);
+
+    // Frees all the buffers the pool is holding
+    void clear();
+
+    [[nodiscard]] size_t num_shards() const {
+        return shards_.size();
     }
+
+    // The class a buffer of this capacity is kept in, or num_size_classes if it is too big to keep
+    static size_t size_class_of_capacity(size_t capacity);
+
+    // The class whose buffers all have capacity for at least min_bytes
+    static size_t size_class_of_request(size_t min_bytes);
+
+private:
+    using SizeClassQueues = std::array<std::unique_ptr<detail::BufferQueue>, num_size_classes>;
+    class Shard;
+
+    static std::shared_ptr<BufferPool> instance_;
+    static std::once_flag init_flag_;
+
+    static void init();
+
+    const std::shared_ptr<Shard>& shard_for_this_thread() const;
+
+    // Shared with the shards, which the deleter of each buffer handed out keeps alive until the buffer comes back
+    std::shared_ptr<SizeClassQueues> overflow_;
+    std::vector<std::shared_ptr<Shard>> shards_;
 };
 
- } //namespace arcticdb
\ No newline at end of file
+ } //namespace arcticdb
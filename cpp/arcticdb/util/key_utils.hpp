@@ -142,6 +142,7 @@ inline std::unordered_set<AtomKey> recurse_segment(const std::shared_ptr<stream:
                     res.emplace(std::move(key));
                     break;
                 case KeyType::TABLE_INDEX:
+                case KeyType::TABLE_INDEX_LEAF:
                 case KeyType::MULTI_KEY:
                     res.merge(recurse_index_key(store, key, version_id));
                     break;
@@ -17,6 +17,8 @@
 #define ARCTICDB_LIKELY(condition) __builtin_expect(condition, 1)
 #define ARCTICDB_UNLIKELY(condition) __builtin_expect(condition, 0)
 
+#define ARCTICDB_PREFETCH(addr) __builtin_prefetch(addr)
+
 #else
 #define ARCTICDB_UNUSED [[maybe_unused]]
 #define ARCTICDB_UNREACHABLE __assume(0);
@@ -25,4 +27,6 @@
 
 #define ARCTICDB_LIKELY
 #define ARCTICDB_UNLIKELY
+
+#define ARCTICDB_PREFETCH(addr)
 #endif
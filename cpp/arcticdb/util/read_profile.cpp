@@ -0,0 +1,102 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/util/read_profile.hpp>
+// This exports CLOCK_THREAD_CPUTIME_ID, used below
+#ifdef _WIN32
+#include <folly/portability/Time.h>
+#endif
+
+#include <algorithm>
+#include <ctime>
+
+namespace arcticdb {
+
+namespace {
+
+thread_local ProfileStage* current_stage = nullptr;
+
+} // namespace
+
+std::shared_ptr<ProfileStage> ProfileStage::child(std::string_view name) {
+    std::lock_guard lock(mutex_);
+    auto it = std::find_if(children_.begin(), children_.end(), [name](const auto& child) {
+        return child->name_ == name;
+    });
+    if (it != children_.end())
+        return *it;
+
+    return children_.emplace_back(std::make_shared<ProfileStage>(std::string{name}));
+}
+
+void ProfileStage::add(std::string_view counter, uint64_t value) {
+    std::lock_guard lock(mutex_);
+    if (auto it = counters_.find(counter); it != counters_.end())
+        it->second += value;
+    else
+        counters_.try_emplace(std::string{counter}, value);
+}
+
+ProfileNode ProfileStage::snapshot() const {
+    ProfileNode node;
+    node.name_ = name_;
+    node.calls_ = calls_.load(std::memory_order_relaxed);
+    node.wall_ns_ = wall_ns_.load(std::memory_order_relaxed);
+    node.cpu_ns_ = cpu_ns_.load(std::memory_order_relaxed);
+    std::vector<std::shared_ptr<ProfileStage>> children;
+    {
+        std::lock_guard lock(mutex_);
+        node.counters_.insert(counters_.begin(), counters_.end());
+        children = children_;
+    }
+    node.children_.reserve(children.size());
+    for (const auto& child : children)
+        node.children_.emplace_back(child->snapshot());
+
+    return node;
+}
+
+uint64_t thread_cpu_ns() {
+    timespec tm{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &tm) == -1)
+        return 0;
+
+    return static_cast<uint64_t>(tm.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(tm.tv_nsec);
+}
+
+ScopedProfileTimer::ScopedProfileTimer(std::shared_ptr<ProfileStage> stage) :
+    stage_(std::move(stage)) {
+    if (stage_) {
+        wall_start_ = std::chrono::steady_clock::now();
+        cpu_start_ = thread_cpu_ns();
+    }
+}
+
+ScopedProfileTimer::~ScopedProfileTimer() {
+    if (!stage_)
+        return;
+
+    const auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wall_start_).count();
+    const auto cpu_end = thread_cpu_ns();
+    stage_->record_call(static_cast<uint64_t>(wall_ns), cpu_end >= cpu_start_ ? cpu_end - cpu_start_ : 0);
+}
+
+ScopedProfileStage::ScopedProfileStage(std::shared_ptr<ProfileStage> stage) :
+    timer_(stage),
+    previous_(current_stage) {
+    current_stage = stage.get();
+}
+
+ScopedProfileStage::~ScopedProfileStage() {
+    current_stage = previous_;
+}
+
+ProfileStage* current_profile_stage() {
+    return current_stage;
+}
+
+} // namespace arcticdb
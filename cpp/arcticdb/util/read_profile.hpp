@@ -0,0 +1,124 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/util/constructors.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arcticdb {
+
+/*
+ * An opt-in profile of a single read, in the spirit of EXPLAIN ANALYZE. Unlike the ARCTICDB_SAMPLE macros, which are
+ * compiled in or out for the whole process, a profile is requested per read through its ReadOptions, and is returned
+ * to the caller alongside the data.
+ *
+ * The profile is a tree of stages, such as version map traversal, index loading, storage reads, decoding and each
+ * clause. Each stage totals the wall and CPU time of every call made to it, from whichever threads made them, and any
+ * counters recorded against it, such as bytes fetched or rows out. Work done in parallel is summed, so the wall time of
+ * a stage can exceed that of the read as a whole.
+ *
+ * Stages are passed down the read as shared pointers, which are null when the read is not being profiled, and all the
+ * functions below do nothing for a null stage.
+ */
+
+// A copy of a stage and everything below it, taken once the read is finished
+struct ProfileNode {
+    std::string name_;
+    uint64_t calls_ = 0;
+    uint64_t wall_ns_ = 0;
+    uint64_t cpu_ns_ = 0;
+    std::map<std::string, uint64_t> counters_;
+    std::vector<ProfileNode> children_;
+};
+
+class ProfileStage {
+public:
+    explicit ProfileStage(std::string name) :
+        name_(std::move(name)) {
+    }
+    ARCTICDB_NO_MOVE_OR_COPY(ProfileStage)
+
+    // The child stage with this name, created the first time it is asked for
+    std::shared_ptr<ProfileStage> child(std::string_view name);
+
+    void record_call(uint64_t wall_ns, uint64_t cpu_ns) {
+        calls_.fetch_add(1, std::memory_order_relaxed);
+        wall_ns_.fetch_add(wall_ns, std::memory_order_relaxed);
+        cpu_ns_.fetch_add(cpu_ns, std::memory_order_relaxed);
+    }
+
+    void add(std::string_view counter, uint64_t value);
+
+    [[nodiscard]] ProfileNode snapshot() const;
+
+private:
+    std::string name_;
+    std::atomic<uint64_t> calls_{0};
+    std::atomic<uint64_t> wall_ns_{0};
+    std::atomic<uint64_t> cpu_ns_{0};
+    mutable std::mutex mutex_;
+    std::map<std::string, uint64_t, std::less<>> counters_;
+    std::vector<std::shared_ptr<ProfileStage>> children_;
+};
+
+// Nanoseconds of CPU time used so far by the calling thread
+uint64_t thread_cpu_ns();
+
+inline std::shared_ptr<ProfileStage> profile_child(const std::shared_ptr<ProfileStage>& stage, std::string_view name) {
+    return stage ? stage->child(name) : nullptr;
+}
+
+inline void profile_add(const std::shared_ptr<ProfileStage>& stage, std::string_view counter, uint64_t value) {
+    if (stage)
+        stage->add(counter, value);
+}
+
+// Records the wall and CPU time from its construction to its destruction as one call to the stage
+class ScopedProfileTimer {
+public:
+    explicit ScopedProfileTimer(std::shared_ptr<ProfileStage> stage);
+    ARCTICDB_NO_MOVE_OR_COPY(ScopedProfileTimer)
+
+    ~ScopedProfileTimer();
+
+private:
+    std::shared_ptr<ProfileStage> stage_;
+    std::chrono::steady_clock::time_point wall_start_;
+    uint64_t cpu_start_ = 0;
+};
+
+/*
+ * Times a stage like ScopedProfileTimer, and also makes it the current stage of this thread until destroyed. This is
+ * for code that is shared by every clause, such as gathering and pushing entities, so that it can count rows against
+ * whichever clause it is running for without each clause passing its stage down.
+ */
+class ScopedProfileStage {
+public:
+    explicit ScopedProfileStage(std::shared_ptr<ProfileStage> stage);
+    ARCTICDB_NO_MOVE_OR_COPY(ScopedProfileStage)
+
+    ~ScopedProfileStage();
+
+private:
+    ScopedProfileTimer timer_;
+    ProfileStage* previous_;
+};
+
+// The stage set by the innermost ScopedProfileStage on this thread, or null
+ProfileStage* current_profile_stage();
+
+} // namespace arcticdb
@@ -11,6 +11,9 @@
 #include <arcticdb/util/constructors.hpp>
 #include <arcticdb/util/preconditions.hpp>
 
+#include <string_view>
+#include <vector>
+
 namespace arcticdb::util {
 
 class PcreRegex {
@@ -95,4 +98,46 @@ public:
     }
 };
 
+/*
+ * Searches with PCRE's alternative matching algorithm, which advances every way the pattern could match in step along
+ * the subject instead of backtracking, so the time taken is linear in the length of the subject whatever the pattern.
+ * Patterns that can only be matched by backtracking, such as those with backreferences, are rejected.
+ */
+class LinearRegex : private PcreRegex {
+    static constexpr size_t INITIAL_WORKSPACE = 128;
+    static constexpr size_t MAX_WORKSPACE = 1 << 20;
+
+    const RegexPattern& pattern_;
+    OptionsType options_ = PCRE_DFA_SHORTEST;
+    std::vector<int> results_;
+    std::vector<int> workspace_;
+public:
+    ARCTICDB_NO_MOVE_OR_COPY(LinearRegex);
+
+    explicit LinearRegex(const RegexPattern& pattern) :
+    pattern_(pattern),
+    results_(2, 0),
+    workspace_(INITIAL_WORKSPACE, 0) {
+    }
+
+    // Whether the pattern matches anywhere in text
+    bool search(std::string_view text) {
+        ResultsType res;
+        while (true) {
+            res = ::pcre_dfa_exec(pattern_.handle(), nullptr, text.data(), static_cast<int>(text.size()), 0, options_,
+                                  results_.data(), static_cast<int>(results_.size()),
+                                  workspace_.data(), static_cast<int>(workspace_.size()));
+            // The workspace holds the states being advanced, so a pattern with many alternatives may need more
+            if (res != PCRE_ERROR_DFA_WSSIZE || workspace_.size() >= MAX_WORKSPACE)
+                break;
+
+            workspace_.resize(workspace_.size() * 2);
+        }
+        user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(res != PCRE_ERROR_DFA_UITEM && res != PCRE_ERROR_DFA_UCOND,
+                "Regex {} needs backtracking to match, e.g. for a backreference, which is not supported", pattern_.text());
+        util::check(res >= 0 || res == PCRE_ERROR_NOMATCH, "Invalid result in regex search with pattern {} and text {}: {}", pattern_.text(), text, res);
+        return res >= 0;
+    }
+};
+
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 RC_GTEST_PROP(StringPool, WriteAndRead, (const std::map<size_t, std::string> &input)) {
     using namespace arcticdb;
@@ -26,4 +28,22 @@ RC_GTEST_PROP(StringPool, WriteAndRead, (const std::map<size_t, std::string> &in
         auto it = input.find(stored.first);
         RC_ASSERT(view == it->second);
     }
-}
\ No newline at end of file
+}
+RC_GTEST_PROP(StringPool, BatchInsertDeduplicates, (const std::vector<std::string> &existing, const std::vector<std::string> &input)) {
+    using namespace arcticdb;
+    StringPool pool;
+    std::unordered_map<std::string, StringPool::offset_t> existing_offsets;
+    for (auto &str : existing)
+        existing_offsets.try_emplace(str, pool.get(str).offset());
+
+    std::vector<std::string_view> views(input.begin(), input.end());
+    std::vector<StringPool::offset_t> offsets(views.size());
+    pool.get_batch(views.data(), views.size(), offsets.data());
+    for (size_t i = 0; i < input.size(); ++i) {
+        RC_ASSERT(pool.get_const_view(offsets[i]) == input[i]);
+        // Looking the string up again must find the copy the batch inserted, or the one that was already there
+        RC_ASSERT(offsets[i] == pool.get(input[i]).offset());
+        if (auto it = existing_offsets.find(input[i]); it != existing_offsets.end())
+            RC_ASSERT(offsets[i] == it->second);
+    }
+}
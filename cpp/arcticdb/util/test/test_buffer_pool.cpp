@@ -8,6 +8,22 @@
 #include <gtest/gtest.h>
 #include <arcticdb/util/buffer_pool.hpp>
 
+#ifdef ARCTICDB_USING_CONDA
+    #include <recycle/shared_pool.hpp>
+#else
+    #include <third_party/recycle/src/recycle/shared_pool.hpp>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define GTEST_COUT std::cerr << "[          ] [ INFO ]"
+
 namespace arcticdb {
     TEST(BufferPool, Basic) {
         auto buffer = BufferPool::instance()->allocate();
@@ -16,4 +32,132 @@ namespace arcticdb {
         auto new_buffer = BufferPool::instance()->allocate();
         ASSERT_EQ(new_buffer->bytes(), 0);
     }
+
+    TEST(BufferPool, SizeClasses) {
+        ASSERT_EQ(BufferPool::size_class_of_request(0), 0);
+        ASSERT_EQ(BufferPool::size_class_of_request(4 * 1024), 0);
+        ASSERT_EQ(BufferPool::size_class_of_request(4 * 1024 + 1), 1);
+        ASSERT_EQ(BufferPool::size_class_of_request(64 * 1024 * 1024), 14);
+        ASSERT_EQ(BufferPool::size_class_of_request(64 * 1024 * 1024 + 1), BufferPool::num_size_classes);
+
+        ASSERT_EQ(BufferPool::size_class_of_capacity(0), 0);
+        ASSERT_EQ(BufferPool::size_class_of_capacity(8 * 1024 - 1), 0);
+        ASSERT_EQ(BufferPool::size_class_of_capacity(8 * 1024), 1);
+        ASSERT_EQ(BufferPool::size_class_of_capacity(128 * 1024 * 1024 - 1), 14);
+        ASSERT_EQ(BufferPool::size_class_of_capacity(128 * 1024 * 1024), BufferPool::num_size_classes);
+
+        // Every buffer kept in the class for a request has the capacity it asks for
+        for (size_t bytes: {size_t{1}, size_t{4096}, size_t{5000}, size_t{1} << 20, (size_t{1} << 20) + 1}) {
+            const auto size_class = BufferPool::size_class_of_request(bytes);
+            ASSERT_GE(BufferPool::min_class_bytes << size_class, bytes);
+            ASSERT_EQ(BufferPool::size_class_of_capacity(BufferPool::min_class_bytes << size_class), size_class);
+        }
+    }
+
+    TEST(BufferPool, RecyclesWithinSizeClass) {
+        BufferPool pool;
+        auto large = pool.allocate(1 << 20);
+        ASSERT_GE(large->available(), 1 << 20);
+        ASSERT_EQ(large->bytes(), 0);
+        const auto large_ptr = large.get();
+        large->ensure(100);
+        large.reset();
+
+        // A small request is not handed the large buffer
+        auto small = pool.allocate(4096);
+        ASSERT_NE(small.get(), large_ptr);
+        ASSERT_GE(small->available(), 4096);
+
+        // A request of the same size reuses it, emptied
+        auto reused = pool.allocate(1 << 20);
+        ASSERT_EQ(reused.get(), large_ptr);
+        ASSERT_EQ(reused->bytes(), 0);
+        ASSERT_GE(reused->available(), 1 << 20);
+    }
+
+    TEST(BufferPool, BuffersOutliveThePool) {
+        std::shared_ptr<Buffer> buffer;
+        {
+            BufferPool pool;
+            buffer = pool.allocate(4096);
+        }
+        buffer->ensure(4096);
+        buffer.reset();
+    }
+
+    TEST(BufferPool, ConcurrentAllocateAndRelease) {
+        BufferPool pool;
+        std::atomic<size_t> shared_buffers{0};
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 8; ++t) {
+            threads.emplace_back([&pool, &shared_buffers, t]() {
+                // Each buffer is marked by the thread holding it, so any handed to two threads at once is overwritten
+                auto release = [&shared_buffers, t](const std::shared_ptr<Buffer>& buffer) {
+                    if (std::any_of(buffer->data(), buffer->data() + 16, [t](uint8_t b) { return b != uint8_t(t); }))
+                        ++shared_buffers;
+                };
+                std::vector<std::shared_ptr<Buffer>> held;
+                for (size_t i = 0; i < 10000; ++i) {
+                    auto buffer = pool.allocate((i % 4) * 8192 + t);
+                    ASSERT_EQ(buffer->bytes(), 0);
+                    buffer->ensure(16);
+                    std::fill(buffer->data(), buffer->data() + 16, uint8_t(t));
+                    held.emplace_back(std::move(buffer));
+                    if (held.size() > 4) {
+                        release(held.front());
+                        held.erase(held.begin());
+                    }
+                }
+            });
+        }
+        for (auto& thread: threads)
+            thread.join();
+        ASSERT_EQ(shared_buffers, 0);
+    }
+
+    struct mutex_lock_policy {
+        using mutex_type = std::mutex;
+        using lock_type = std::lock_guard<mutex_type>;
+    };
+
+    // Allocations and releases per second of 64KB buffers, each thread holding a few at a time as encoding does
+    template<typename Allocate>
+    double buffer_throughput(size_t num_threads, size_t iterations, Allocate&& allocate) {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&allocate, iterations]() {
+                std::vector<std::shared_ptr<Buffer>> held(4);
+                for (size_t i = 0; i < iterations; ++i) {
+                    auto& buffer = held[i % held.size()];
+                    buffer = allocate();
+                    buffer->ensure(64 * 1024);
+                }
+            });
+        }
+        for (auto& thread: threads)
+            thread.join();
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return static_cast<double>(num_threads * iterations) / seconds;
+    }
+
+    // A micro-benchmark against the single mutex pool this replaced, rather than a test of any particular speedup
+    TEST(BufferPool, ThroughputByThreadCount) {
+        constexpr size_t iterations = 1000;
+        for (size_t num_threads = 1; num_threads <= 64; num_threads *= 2) {
+            recycle::shared_pool<Buffer, mutex_lock_policy> mutex_pool(
+                    [] () { return std::make_shared<Buffer>(); },
+                    [] (std::shared_ptr<Buffer> buf) { buf->reset(); });
+            const auto mutex_throughput = buffer_throughput(num_threads, iterations, [&mutex_pool]() {
+                return mutex_pool.allocate();
+            });
+
+            BufferPool sharded_pool;
+            const auto sharded_throughput = buffer_throughput(num_threads, iterations, [&sharded_pool]() {
+                return sharded_pool.allocate(64 * 1024);
+            });
+            GTEST_COUT << num_threads << " threads: mutex pool " << static_cast<size_t>(mutex_throughput)
+                       << "/s, sharded pool " << static_cast<size_t>(sharded_throughput) << "/s" << std::endl;
+        }
+    }
 }
@@ -0,0 +1,92 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+#include <arcticdb/util/read_profile.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace arcticdb {
+
+TEST(ReadProfile, NullStageIsIgnored) {
+    std::shared_ptr<ProfileStage> stage;
+    ASSERT_EQ(profile_child(stage, "child"), nullptr);
+    profile_add(stage, "counter", 1);
+    {
+        ScopedProfileTimer timer(stage);
+        ScopedProfileStage current(stage);
+        ASSERT_EQ(current_profile_stage(), nullptr);
+    }
+}
+
+TEST(ReadProfile, ChildrenAndCounters) {
+    auto root = std::make_shared<ProfileStage>("read");
+    auto first = root->child("first");
+    ASSERT_EQ(root->child("first"), first);
+    root->child("second")->add("rows", 5);
+    first->add("bytes", 10);
+    first->add("bytes", 20);
+    {
+        ScopedProfileTimer timer(first);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const auto node = root->snapshot();
+    ASSERT_EQ(node.name_, "read");
+    ASSERT_EQ(node.calls_, 0);
+    ASSERT_EQ(node.children_.size(), 2);
+    ASSERT_EQ(node.children_[0].name_, "first");
+    ASSERT_EQ(node.children_[0].calls_, 1);
+    ASSERT_GE(node.children_[0].wall_ns_, 1'000'000);
+    ASSERT_EQ(node.children_[0].counters_.at("bytes"), 30);
+    ASSERT_EQ(node.children_[1].name_, "second");
+    ASSERT_EQ(node.children_[1].counters_.at("rows"), 5);
+}
+
+TEST(ReadProfile, CurrentStageNests) {
+    auto outer = std::make_shared<ProfileStage>("outer");
+    auto inner = std::make_shared<ProfileStage>("inner");
+    ASSERT_EQ(current_profile_stage(), nullptr);
+    {
+        ScopedProfileStage outer_scope(outer);
+        ASSERT_EQ(current_profile_stage(), outer.get());
+        {
+            ScopedProfileStage inner_scope(inner);
+            ASSERT_EQ(current_profile_stage(), inner.get());
+        }
+        ASSERT_EQ(current_profile_stage(), outer.get());
+    }
+    ASSERT_EQ(current_profile_stage(), nullptr);
+    ASSERT_EQ(outer->snapshot().calls_, 1);
+    ASSERT_EQ(inner->snapshot().calls_, 1);
+}
+
+TEST(ReadProfile, ConcurrentCalls) {
+    auto root = std::make_shared<ProfileStage>("read");
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&root]() {
+            for (size_t i = 0; i < 1000; ++i) {
+                auto stage = root->child(i % 2 == 0 ? "even" : "odd");
+                ScopedProfileStage current(stage);
+                current_profile_stage()->add("rows", 1);
+            }
+        });
+    }
+    for (auto& thread: threads)
+        thread.join();
+
+    const auto node = root->snapshot();
+    ASSERT_EQ(node.children_.size(), 2);
+    for (const auto& child: node.children_) {
+        ASSERT_EQ(child.calls_, 4000);
+        ASSERT_EQ(child.counters_.at("rows"), 4000);
+    }
+}
+
+} // namespace arcticdb
@@ -29,3 +29,32 @@ TEST(Regex, Complex) {
     ASSERT_EQ(regex.match(no_match), false);
 }
 
+
+TEST(Regex, LinearSearch) {
+    using namespace arcticdb;
+    const std::string pattern_text{"o W[a-z]+d"};
+    util::RegexPattern pattern{pattern_text};
+    util::LinearRegex regex(pattern);
+    ASSERT_TRUE(regex.search("Hello World"));
+    ASSERT_FALSE(regex.search("Hello Wrld"));
+    ASSERT_FALSE(regex.search(""));
+}
+
+TEST(Regex, LinearSearchNoCatastrophicBacktracking) {
+    using namespace arcticdb;
+    // Takes time exponential in the length of the subject to fail with a backtracking matcher
+    const std::string pattern_text{"^(a+)+$"};
+    util::RegexPattern pattern{pattern_text};
+    util::LinearRegex regex(pattern);
+    const std::string subject = std::string(5000, 'a') + "!";
+    ASSERT_FALSE(regex.search(subject));
+    ASSERT_TRUE(regex.search(std::string(5000, 'a')));
+}
+
+TEST(Regex, LinearSearchRejectsBackreferences) {
+    using namespace arcticdb;
+    const std::string pattern_text{"(a)\\1"};
+    util::RegexPattern pattern{pattern_text};
+    util::LinearRegex regex(pattern);
+    ASSERT_THROW(regex.search("aa"), UserInputException);
+}
@@ -0,0 +1,161 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/version/codec_dictionaries.hpp>
+#include <arcticdb/codec/zstd_dictionary.hpp>
+#include <arcticdb/column_store/memory_segment.hpp>
+#include <arcticdb/entity/ref_key.hpp>
+#include <arcticdb/entity/stream_descriptor.hpp>
+#include <arcticdb/log/log.hpp>
+#include <arcticdb/storage/store.hpp>
+#include <arcticdb/stream/index.hpp>
+#include <arcticdb/util/clock.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+#include <map>
+
+namespace arcticdb {
+
+namespace {
+
+const std::string codec_dictionary_prefix = "__codec_dictionary_";
+
+// zstd recommends around a hundred times as much sample data as the size of the dictionary being trained
+constexpr size_t sample_bytes_per_dictionary_byte = 100;
+
+/*
+ * Each dictionary has its own key, named after its id, which is never overwritten or deleted: blocks compressed with
+ * a dictionary can be read at any time after, so retraining adds dictionaries rather than replacing them.
+ */
+RefKey codec_dictionary_key(uint32_t dictionary_id) {
+    return RefKey{StreamId{fmt::format("{}{}", codec_dictionary_prefix, dictionary_id)}, KeyType::CODEC_DICTIONARY};
+}
+
+StreamDescriptor codec_dictionary_descriptor(const StreamId& stream_id) {
+    return StreamDescriptor{stream_descriptor(stream_id, stream::RowCountIndex(), {
+        scalar_field(DataType::UINT8, "data_type"),
+        scalar_field(DataType::INT64, "trained_at"),
+        scalar_field(DataType::ASCII_DYNAMIC64, "dictionary")
+    })};
+}
+
+struct DictionarySamples {
+    std::vector<std::vector<uint8_t>> samples_;
+    size_t bytes_ = 0;
+};
+
+// Each block is a sample, as blocks are the unit that is compressed
+template<typename Blocks>
+void add_samples(const Blocks& blocks, DictionarySamples& samples, size_t max_bytes) {
+    for(const auto* block : blocks) {
+        if(samples.bytes_ >= max_bytes)
+            return;
+
+        if(block->bytes() == 0)
+            continue;
+
+        samples.samples_.emplace_back(block->data(), block->data() + block->bytes());
+        samples.bytes_ += block->bytes();
+    }
+}
+
+arcticdb::proto::encoding::VariantCodec zstd_codec_with_dictionaries(const std::map<DataType, uint32_t>& dictionaries) {
+    arcticdb::proto::encoding::VariantCodec codec;
+    auto* zstd = codec.mutable_zstd();
+    zstd->set_level(static_cast<int32_t>(ConfigsMap::instance()->get_int("Codec.ZstdDictionaryLevel", 3)));
+    for(const auto& [data_type, id] : dictionaries)
+        (*zstd->mutable_dictionaries())[static_cast<uint32_t>(data_type)] = id;
+
+    return codec;
+}
+
+} // namespace
+
+std::optional<arcticdb::proto::encoding::VariantCodec> train_codec_dictionaries(
+    const std::shared_ptr<Store>& store,
+    size_t max_segments,
+    size_t dictionary_bytes) {
+    std::vector<VariantKey> keys;
+    store->iterate_type(KeyType::TABLE_DATA, [&keys, max_segments](VariantKey &&key) {
+        if(keys.size() < max_segments)
+            keys.emplace_back(std::move(key));
+    });
+
+    const auto max_sample_bytes = dictionary_bytes * sample_bytes_per_dictionary_byte;
+    std::map<DataType, DictionarySamples> samples;
+    for(const auto& key : keys) {
+        auto [_, seg] = store->read_sync(key);
+        for(size_t i = 0; i < seg.num_columns(); ++i) {
+            const auto& column = seg.column(static_cast<position_t>(i));
+            add_samples(column.blocks(), samples[column.type().data_type()], max_sample_bytes);
+        }
+        if(seg.has_string_pool())
+            add_samples(seg.const_string_pool().data().blocks(), samples[string_pool_descriptor().type().data_type()], max_sample_bytes);
+    }
+
+    const auto trained_at = util::SysClock::nanos_since_epoch();
+    size_t trained = 0;
+    for(const auto& [data_type, type_samples] : samples) {
+        auto data = codec::train_zstd_dictionary(type_samples.samples_, dictionary_bytes);
+        if(data.empty())
+            continue;
+
+        const auto dictionary = codec::ZstdDictionaryRegistry::instance().add(std::move(data));
+        const auto key = codec_dictionary_key(dictionary->id());
+        ++trained;
+        ARCTICDB_DEBUG(log::codec(), "Trained zstd dictionary {} for {} from {} samples", dictionary->id(), data_type, type_samples.samples_.size());
+        // A dictionary with the same id is the same dictionary, so there is nothing to add
+        if(store->key_exists_sync(key))
+            continue;
+
+        SegmentInMemory segment{codec_dictionary_descriptor(key.id())};
+        segment.set_scalar<uint8_t>(0, static_cast<uint8_t>(data_type));
+        segment.set_scalar<int64_t>(1, trained_at);
+        segment.set_string(2, std::string_view{reinterpret_cast<const char*>(dictionary->data().data()), dictionary->data().size()});
+        segment.end_row();
+        store->write_sync(KeyType::CODEC_DICTIONARY, key.id(), std::move(segment));
+    }
+
+    if(trained == 0)
+        return std::nullopt;
+
+    // Reloading picks up dictionaries trained concurrently by other clients, as well as any older ones for types
+    // that were not retrained this time
+    return load_codec_dictionaries(store);
+}
+
+std::optional<arcticdb::proto::encoding::VariantCodec> load_codec_dictionaries(const std::shared_ptr<Store>& store) {
+    std::vector<VariantKey> keys;
+    store->iterate_type(KeyType::CODEC_DICTIONARY, [&keys](VariantKey &&key) {
+        keys.emplace_back(std::move(key));
+    }, codec_dictionary_prefix);
+
+    // Every dictionary is registered so its blocks can be decoded, but only the newest for each type is written with
+    std::map<DataType, std::pair<int64_t, uint32_t>> newest;
+    for(const auto& key : keys) {
+        auto [_, seg] = store->read_sync(key);
+        for(size_t row = 0; row < seg.row_count(); ++row) {
+            const auto data_type = DataType(seg.scalar_at<uint8_t>(row, 0).value());
+            const auto trained_at = seg.scalar_at<int64_t>(row, 1).value();
+            const auto data = seg.string_at(row, 2).value();
+            const auto dictionary = codec::ZstdDictionaryRegistry::instance().add(std::vector<uint8_t>{data.begin(), data.end()});
+            if(auto it = newest.find(data_type); it == newest.end() || it->second.first < trained_at)
+                newest.insert_or_assign(data_type, std::make_pair(trained_at, dictionary->id()));
+        }
+    }
+
+    if(newest.empty())
+        return std::nullopt;
+
+    std::map<DataType, uint32_t> dictionaries;
+    for(const auto& [data_type, dictionary] : newest)
+        dictionaries.try_emplace(data_type, dictionary.second);
+
+    return zstd_codec_with_dictionaries(dictionaries);
+}
+
+} // namespace arcticdb
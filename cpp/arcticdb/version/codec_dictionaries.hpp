@@ -0,0 +1,39 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/entity/protobufs.hpp>
+
+#include <memory>
+#include <optional>
+
+namespace arcticdb {
+
+class Store;
+
+/*
+ * Trains a zstd dictionary per column type from a sample of the library's data segments, writes each one to its
+ * own CODEC_DICTIONARY key and registers them in this process. Returns zstd codec options that compress each column
+ * with the newest dictionary for its type, or std::nullopt if there was too little data to train any dictionaries.
+ *
+ * Dictionary keys are never overwritten or removed, so data that has already been written is not rewritten and
+ * blocks compressed with an older dictionary, or without one, can always still be read.
+ */
+std::optional<arcticdb::proto::encoding::VariantCodec> train_codec_dictionaries(
+    const std::shared_ptr<Store>& store,
+    size_t max_segments,
+    size_t dictionary_bytes);
+
+/*
+ * Registers every dictionary in the library's CODEC_DICTIONARY keys, so that blocks compressed with them can be
+ * decoded. Returns the codec options to compress with the newest dictionary for each type, or std::nullopt if the
+ * library has no dictionaries.
+ */
+std::optional<arcticdb::proto::encoding::VariantCodec> load_codec_dictionaries(const std::shared_ptr<Store>& store);
+
+} // namespace arcticdb
@@ -7,6 +7,8 @@
 
 #include <arcticdb/version/local_versioned_engine.hpp>
 #include <arcticdb/codec/default_codecs.hpp>
+#include <arcticdb/version/codec_dictionaries.hpp>
+#include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/version/version_core.hpp>
 #include <arcticdb/storage/storage.hpp>
 #include <arcticdb/storage/storage_options.hpp>
@@ -30,6 +32,15 @@ LocalVersionedEngine::LocalVersionedEngine(
     store_(std::make_shared<async::AsyncStore<ClockType>>(library, codec::default_lz4_codec(), encoding_version(library->config()))),
     symbol_list_(std::make_shared<SymbolList>(version_map_)){
     configure(library->config());
+    if(cfg_.write_options().codec_dictionaries()) {
+        try {
+            if(auto codec = load_codec_dictionaries(store_))
+                store_->set_codec_opts(*codec);
+        } catch (const std::exception& ex) {
+            // Data compressed with the dictionaries will fail to decode, everything else is unaffected
+            log::version().warn("Failed to load codec dictionaries: {}", ex.what());
+        }
+    }
     ARCTICDB_RUNTIME_DEBUG(log::version(), "Created versioned engine at {} for library path {}  with config {}", uintptr_t(this),
                          library->library_path(), [&cfg=cfg_]{  return util::format(cfg); });
 #ifdef USE_REMOTERY
@@ -164,6 +175,39 @@ FrameAndDescriptor LocalVersionedEngine::read_dataframe_internal(
     const ReadOptions& read_options) {
     ARCTICDB_RUNTIME_SAMPLE(ReadDataFrameInternal, 0)
     ARCTICDB_RUNTIME_DEBUG(log::version(), "Command: read_dataframe");
+    // Whether the clauses so far leave the index values of the rows that are read unchanged
+    bool index_unchanged = true;
+    for (auto& clause: read_query.clauses_) {
+        const auto& clause_type = folly::poly_type(*clause);
+        if (clause_type == typeid(AsOfJoinClause)) {
+            // The index range of the rows that will be read, unless incompletes may extend it
+            IndexRange left_range;
+            if (index_unchanged && std::holds_alternative<VersionedItem>(identifier) && !opt_false(read_options.incompletes_)) {
+                const auto& left_key = std::get<VersionedItem>(identifier).key_;
+                left_range = IndexRange{left_key.start_index(), left_key.end_index()};
+                if (const auto* date_range = std::get_if<IndexRange>(&read_query.row_filter); date_range != nullptr && date_range->specified_) {
+                    left_range.start_ = std::max(left_range.start_, date_range->start_);
+                    left_range.end_ = std::min(left_range.end_, date_range->end_);
+                }
+            }
+
+            auto& as_of_join = folly::poly_cast<AsOfJoinClause>(*clause);
+            VersionQuery version_query;
+            if (as_of_join.right_version_.has_value())
+                version_query.set_version(*as_of_join.right_version_);
+
+            auto right_version = get_version_to_read(as_of_join.right_stream_id_, version_query, ReadOptions{});
+            missing_data::check<ErrorCode::E_NO_SUCH_VERSION>(
+                right_version.has_value(),
+                "read_dataframe_internal: version matching query '{}' not found for as-of join symbol '{}'",
+                version_query, as_of_join.right_stream_id_);
+            as_of_join.set_right(read_as_of_join_right(
+                store(), *right_version, as_of_join.by_, left_range, as_of_join.tolerance_, read_options));
+        } else if (clause_type != typeid(FilterClause) && clause_type != typeid(ProjectClause) &&
+                   clause_type != typeid(RowRangeClause) && clause_type != typeid(DateRangeClause)) {
+            index_unchanged = false;
+        }
+    }
     return read_dataframe_impl(
         store(),
         identifier,
@@ -338,7 +382,11 @@ ReadVersionOutput LocalVersionedEngine::read_dataframe_version_internal(
     const VersionQuery& version_query,
     ReadQuery& read_query,
     const ReadOptions& read_options) {
-    auto version = get_version_to_read(stream_id, version_query, ReadOptions{});
+    ScopedProfileTimer profile_timer(read_options.profile_);
+    auto version = [&]() {
+        ScopedProfileTimer version_map_timer(profile_child(read_options.profile_, "version_map"));
+        return get_version_to_read(stream_id, version_query, ReadOptions{});
+    }();
     std::variant<VersionedItem, StreamId> identifier;
     if(!version) {
         if(opt_false(read_options.incompletes_)) {
@@ -1060,10 +1108,15 @@ folly::Future<ReadVersionOutput> async_read_direct(
     const std::shared_ptr<Store>& store,
     const VariantKey& index_key,
     SegmentInMemory&& index_segment,
-    const ReadQuery& read_query,
+    const ReadQuery& query,
     std::shared_ptr<BufferHolder> buffers,
     const ReadOptions& read_options) {
-    auto index_segment_reader = std::make_shared<index::IndexSegmentReader>(std::move(index_segment));
+    // The row filter has to be known before a multi-level index is expanded, so that only the leaves in range are read
+    index::IndexSegmentReader root{std::move(index_segment)};
+    auto read_query = query;
+    read_query.calculate_row_filter(static_cast<int64_t>(root.tsd().proto().total_rows()));
+    auto index_segment_reader = std::make_shared<index::IndexSegmentReader>(
+        index::expand_multi_level_index(std::move(root), store, read_query.row_filter));
 
     check_column_and_date_range_filterable(*index_segment_reader, read_query);
     add_index_columns_to_query(read_query, index_segment_reader->tsd());
@@ -102,6 +102,18 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def("set_skip_compat", &VersionQuery::set_skip_compat)
         .def("set_iterate_on_failure", &VersionQuery::set_iterate_on_failure);
 
+    py::enum_<OutputFormat>(version, "OutputFormat")
+        .value("PANDAS", OutputFormat::PANDAS)
+        .value("ARROW", OutputFormat::ARROW);
+
+    py::class_<ProfileNode>(version, "ReadProfileNode")
+        .def_readonly("name", &ProfileNode::name_)
+        .def_readonly("calls", &ProfileNode::calls_)
+        .def_readonly("wall_ns", &ProfileNode::wall_ns_)
+        .def_readonly("cpu_ns", &ProfileNode::cpu_ns_)
+        .def_readonly("counters", &ProfileNode::counters_)
+        .def_readonly("children", &ProfileNode::children_);
+
     py::class_<ReadOptions>(version, "PythonVersionStoreReadOptions")
         .def(py::init())
         .def("set_force_strings_to_object", &ReadOptions::set_force_strings_to_object)
@@ -111,7 +123,11 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def("set_set_tz", &ReadOptions::set_set_tz)
         .def("set_optimise_string_memory", &ReadOptions::set_optimise_string_memory)
         .def("set_batch_throw_on_error", &ReadOptions::set_batch_throw_on_error)
-        .def_property_readonly("incompletes", &ReadOptions::get_incompletes);
+        .def("set_output_format", &ReadOptions::set_output_format)
+        .def("set_profile", &ReadOptions::set_profile)
+        .def_property_readonly("incompletes", &ReadOptions::get_incompletes)
+        .def_property_readonly("output_format", &ReadOptions::get_output_format)
+        .def_property_readonly("profile", &ReadOptions::get_profile);
 
     using FrameDataWrapper = arcticdb::pipelines::FrameDataWrapper;
     py::class_<FrameDataWrapper, std::shared_ptr<FrameDataWrapper>>(version, "FrameDataWrapper")
@@ -131,7 +147,11 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
             return self.frame().offset();
         })
         .def_property_readonly("names", &PythonOutputFrame::names, py::return_value_policy::reference)
-        .def_property_readonly("index_columns", &PythonOutputFrame::index_columns, py::return_value_policy::reference);
+        .def_property_readonly("index_columns", &PythonOutputFrame::index_columns, py::return_value_policy::reference)
+        .def("export_arrow", [](const PythonOutputFrame& self, uintptr_t array_ptr, uintptr_t schema_ptr) {
+            // Same calling convention as pyarrow's RecordBatch._import_from_c
+            self.arrow().export_frame(reinterpret_cast<ArrowArray*>(array_ptr), reinterpret_cast<ArrowSchema*>(schema_ptr));
+        }, "Export the frame as an Arrow struct array through the C Data Interface, zero-copy where possible");
 
     py::enum_<VersionRequestType>(version, "VersionRequestType", R"pbdoc(
         Enum of possible version request types passed to as_of.
@@ -283,6 +303,18 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
             .def_property_readonly("end", &DateRangeClause::end)
             .def("__str__", &DateRangeClause::to_string);
 
+    py::class_<AsOfJoinClause, std::shared_ptr<AsOfJoinClause>>(version, "AsOfJoinClause")
+            .def(py::init<StreamId, std::optional<SignedVersionId>, std::optional<timestamp>, std::optional<std::string>>())
+            .def("__str__", &AsOfJoinClause::to_string);
+
+    py::class_<RollingClause, std::shared_ptr<RollingClause>>(version, "RollingClause")
+            .def(py::init<std::optional<uint64_t>, std::optional<timestamp>, std::optional<uint64_t>, std::vector<std::tuple<std::string, std::string, std::string>>>())
+            .def("__str__", &RollingClause::to_string);
+
+    py::class_<TopKClause, std::shared_ptr<TopKClause>>(version, "TopKClause")
+            .def(py::init<std::string, uint64_t, bool, std::optional<std::string>>())
+            .def("__str__", &TopKClause::to_string);
+
     py::class_<ReadQuery>(version, "PythonVersionStoreReadQuery")
             .def(py::init())
             .def_readwrite("columns",&ReadQuery::columns)
@@ -296,7 +328,10 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
                                 std::shared_ptr<GroupByClause>,
                                 std::shared_ptr<AggregationClause>,
                                 std::shared_ptr<RowRangeClause>,
-                                std::shared_ptr<DateRangeClause>>> clauses) {
+                                std::shared_ptr<DateRangeClause>,
+                                std::shared_ptr<AsOfJoinClause>,
+                                std::shared_ptr<RollingClause>,
+                                std::shared_ptr<TopKClause>>> clauses) {
                 std::vector<std::shared_ptr<Clause>> _clauses;
                 for (auto&& clause: clauses) {
                     util::variant_match(
@@ -312,6 +347,9 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
             .value("NEG", OperationType::NEG)
             .value("IDENTITY", OperationType::IDENTITY)
             .value("NOT", OperationType::NOT)
+            .value("LOWER", OperationType::LOWER)
+            .value("UPPER", OperationType::UPPER)
+            .value("LEN", OperationType::LEN)
             .value("ADD", OperationType::ADD)
             .value("SUB", OperationType::SUB)
             .value("MUL", OperationType::MUL)
@@ -326,7 +364,11 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
             .value("ISNOTIN", OperationType::ISNOTIN)
             .value("AND", OperationType::AND)
             .value("OR", OperationType::OR)
-            .value("XOR", OperationType::XOR);
+            .value("XOR", OperationType::XOR)
+            .value("STARTSWITH", OperationType::STARTSWITH)
+            .value("ENDSWITH", OperationType::ENDSWITH)
+            .value("CONTAINS", OperationType::CONTAINS)
+            .value("REGEX_MATCH", OperationType::REGEX_MATCH);
 
     py::enum_<SortedValue>(version, "SortedValue")
             .value("UNKNOWN", SortedValue::UNKNOWN)
@@ -411,6 +453,9 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def("append",
              &PythonVersionStore::append,
              py::call_guard<SingleThreadMutexHolder>(), "Append a dataframe to the most recent version")
+        .def("append_arrow",
+             &PythonVersionStore::append_arrow,
+             py::call_guard<SingleThreadMutexHolder>(), "Append an Arrow record batch, passed through the C Data Interface, to the most recent version")
         .def("append_incomplete",
              &PythonVersionStore::append_incomplete,
              py::call_guard<SingleThreadMutexHolder>(), "Append a partial dataframe to the most recent version")
@@ -462,6 +507,11 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def("compact_library",
              &PythonVersionStore::compact_library,
              py::call_guard<SingleThreadMutexHolder>(), "Compact the whole library wherever necessary")
+        .def("train_codec_dictionaries",
+             &PythonVersionStore::train_codec_dictionaries,
+             py::arg("max_segments") = 100,
+             py::arg("dictionary_bytes") = 112640,
+             py::call_guard<SingleThreadMutexHolder>(), "Train zstd dictionaries per column type on the library's data and compress new data with them, if the library has codec_dictionaries enabled")
         .def("is_symbol_fragmented",
              &PythonVersionStore::is_symbol_fragmented,
              py::call_guard<SingleThreadMutexHolder>(), "Check if there are enough small data segments which can be compacted")
@@ -510,6 +560,9 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def("write_versioned_dataframe",
              &PythonVersionStore::write_versioned_dataframe,
              py::call_guard<SingleThreadMutexHolder>(), "Write the most recent version of this dataframe to the store")
+        .def("write_versioned_arrow",
+             &PythonVersionStore::write_versioned_arrow,
+             py::call_guard<SingleThreadMutexHolder>(), "Write an Arrow record batch, passed through the C Data Interface, as the most recent version")
         .def("write_versioned_composite_data",
              &PythonVersionStore::write_versioned_composite_data,
              py::call_guard<SingleThreadMutexHolder>(), "Allows the user to write multiple dataframes in a batch with one version entity")
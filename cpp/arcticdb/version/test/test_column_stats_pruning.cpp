@@ -0,0 +1,92 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+#include <util/test/gtest_utils.hpp>
+
+#include <arcticdb/stream/index.hpp>
+#include <arcticdb/stream/test/stream_test_common.hpp>
+#include <arcticdb/pipeline/column_stats.hpp>
+#include <arcticdb/processing/clause.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+struct ColumnStatsPruningTestStore : arcticdb::TestStore {
+protected:
+    std::string get_name() override {
+        return "test.column_stats_pruning";
+    }
+
+    static constexpr size_t rows_per_slice = 100;
+    static constexpr size_t row_slices = 4;
+
+    // Each write or append is one row slice, where row slice i holds the values [100 * i, 100 * i + 99] in every column
+    void write_row_slices() {
+        using namespace arcticdb;
+        std::vector<FieldRef> fields{scalar_field(DataType::UINT64, "thing1")};
+        for (size_t row_slice = 0; row_slice < row_slices; ++row_slice) {
+            auto test_frame = get_test_frame<stream::TimeseriesIndex>(symbol_, fields, rows_per_slice, row_slice * rows_per_slice);
+            if (row_slice == 0)
+                test_store_->write_versioned_dataframe_internal(symbol_, std::move(test_frame.frame_), false, false, false);
+            else
+                test_store_->append_internal(symbol_, std::move(test_frame.frame_), false, false, false);
+        }
+    }
+
+    void create_column_stats() {
+        using namespace arcticdb;
+        std::unordered_map<std::string, std::unordered_set<std::string>> stats_to_create{{"thing1", {"MINMAX"}}};
+        ColumnStats column_stats{stats_to_create};
+        test_store_->create_column_stats_version_internal(symbol_, column_stats, pipelines::VersionQuery{}, ReadOptions{});
+    }
+
+    // Reads the rows where thing1 >= value, and returns the number of segments fetched from storage
+    uint64_t read_and_count_fetches(uint64_t value) {
+        using namespace arcticdb;
+        ExpressionContext expression_context;
+        expression_context.add_value("value", std::make_shared<Value>(value, DataType::UINT64));
+        expression_context.add_expression_node("root",
+            std::make_shared<ExpressionNode>(ColumnName("thing1"), ValueName("value"), OperationType::GE));
+        expression_context.root_node_name_ = ExpressionName("root");
+        pipelines::ReadQuery read_query({std::make_shared<Clause>(FilterClause{{"thing1"}, std::move(expression_context), {}})});
+
+        ReadOptions read_options;
+        read_options.set_profile(true);
+        auto read_result = test_store_->read_dataframe_version(symbol_, pipelines::VersionQuery{}, read_query, read_options);
+        const auto& frame = read_result.frame_data.frame();
+        EXPECT_EQ(frame.row_count(), row_slices * rows_per_slice - value);
+        EXPECT_EQ(frame.scalar_at<uint64_t>(0, 1).value(), value);
+
+        const auto profile = read_options.get_profile();
+        for (const auto& child : profile->children_) {
+            if (child.name_ == "storage_read")
+                return child.calls_;
+        }
+        return 0;
+    }
+
+    const arcticdb::StreamId symbol_{"pruned"};
+};
+
+TEST_F(ColumnStatsPruningTestStore, FetchesOnlyMatchingSlices) {
+    write_row_slices();
+    create_column_stats();
+    ASSERT_EQ(read_and_count_fetches(250), 2);
+    ASSERT_EQ(read_and_count_fetches(399), 1);
+    ASSERT_EQ(read_and_count_fetches(0), row_slices);
+}
+
+TEST_F(ColumnStatsPruningTestStore, FetchesAllWithoutColumnStats) {
+    write_row_slices();
+    ASSERT_EQ(read_and_count_fetches(250), row_slices);
+}
+
+TEST_F(ColumnStatsPruningTestStore, FetchesAllWhenDisabled) {
+    arcticdb::ScopedConfig disable("VersionStore.PruneWithColumnStats", 0);
+    write_row_slices();
+    create_column_stats();
+    ASSERT_EQ(read_and_count_fetches(250), row_slices);
+}
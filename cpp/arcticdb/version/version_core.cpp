@@ -103,7 +103,7 @@ folly::Future<entity::AtomKey> async_write_dataframe_impl(
     auto partial_key = IndexPartialKey{frame.desc.id(), version_id};
     sorting::check<ErrorCode::E_UNSORTED_DATA>(!validate_index || frame.desc.get_sorted() == SortedValue::ASCENDING || !std::holds_alternative<stream::TimeseriesIndex>(frame.index),
                 "When calling write with validate_index enabled, input data must be sorted.");
-    return write_frame(std::move(partial_key), std::move(frame), slicing_arg, store, de_dup_map, sparsify_floats);
+    return write_frame(std::move(partial_key), std::move(frame), slicing_arg, store, de_dup_map, sparsify_floats, options.index_leaf_size);
 }
 
 namespace {
@@ -142,7 +142,18 @@ folly::Future<AtomKey> async_append_impl(
     util::check(update_info.previous_index_key_.has_value(), "Cannot append as there is no previous index key to append to");
     const StreamId stream_id = frame.desc.id();
     ARCTICDB_DEBUG(log::version(), "append stream_id: {} , version_id: {}", stream_id, update_info.next_version_id_);
-    auto index_segment_reader = index::get_index_reader(*(update_info.previous_index_key_), store);
+    auto [_, index_segment] = store->read_sync(*(update_info.previous_index_key_));
+    index::IndexSegmentReader index_segment_reader{std::move(index_segment)};
+    if(index_segment_reader.is_multi_level()) {
+        // Only the last leaf of a multi-level index is rewritten by an append, so it is the only one that is read,
+        // unless the library no longer writes multi-level indexes, in which case the whole index is rewritten
+        const auto total_rows = index_segment_reader.tsd().proto().total_rows();
+        FilterRange leaves_to_read;
+        if(options.index_leaf_size != 0)
+            leaves_to_read = RowRange{total_rows - 1, total_rows};
+
+        index_segment_reader = index::expand_multi_level_index(std::move(index_segment_reader), store, leaves_to_read);
+    }
     bool bucketize_dynamic = index_segment_reader.bucketize_dynamic();
     auto row_offset = index_segment_reader.tsd().proto().total_rows();
     util::check_rte(!index_segment_reader.is_pickled(), "Cannot append to pickled data");
@@ -152,7 +163,7 @@ folly::Future<AtomKey> async_append_impl(
 
     frame.set_bucketize_dynamic(bucketize_dynamic);
     auto slicing_arg = get_slicing_policy(options, frame);
-    return append_frame(IndexPartialKey{stream_id, update_info.next_version_id_}, std::move(frame), slicing_arg, index_segment_reader, store, options.dynamic_schema, options.ignore_sort_order);
+    return append_frame(IndexPartialKey{stream_id, update_info.next_version_id_}, std::move(frame), slicing_arg, index_segment_reader, store, options.dynamic_schema, options.ignore_sort_order, options.index_leaf_size);
 }
 
 VersionedItem append_impl(
@@ -421,7 +432,14 @@ Composite<EntityIds> process_clauses(
         std::shared_ptr<ComponentManager> component_manager,
         std::vector<folly::Future<pipelines::SegmentAndSlice>>&& segment_and_slice_futures,
         const std::vector<std::vector<size_t>>& processing_unit_indexes,
-        std::vector<std::shared_ptr<Clause>> clauses ) { // pass by copy deliberately as we don't want to modify read_query
+        std::vector<std::shared_ptr<Clause>> clauses, // pass by copy deliberately as we don't want to modify read_query
+        const std::shared_ptr<ProfileStage>& profile) {
+    // Erased from the front in step with clauses
+    std::vector<std::shared_ptr<ProfileStage>> profile_stages;
+    if (profile) {
+        for (const auto& [idx, clause]: folly::enumerate(clauses))
+            profile_stages.emplace_back(profile->child(fmt::format("clause {}: {}", idx, clause->to_string())));
+    }
     std::vector<folly::FutureSplitter<pipelines::SegmentAndSlice>> segment_and_slice_future_splitters;
     segment_and_slice_future_splitters.reserve(segment_and_slice_futures.size());
     for (auto&& future: segment_and_slice_futures) {
@@ -477,6 +495,7 @@ Composite<EntityIds> process_clauses(
                                            &entity_added_mtx,
                                            &entity_added,
                                            &clauses,
+                                           &profile_stages,
                                            comp_entity_ids = std::move(comp_entity_ids)](std::vector<pipelines::SegmentAndSlice>&& segment_and_slices) mutable {
                             auto entity_ids = std::get<EntityIds>(comp_entity_ids[0]);
                             for (auto&& [idx, segment_and_slice]: folly::enumerate(segment_and_slices)) {
@@ -497,13 +516,14 @@ Composite<EntityIds> process_clauses(
                                     entity_added[entity_ids[idx]] = true;
                                 }
                             }
-                            return async::submit_cpu_task(async::MemSegmentProcessingTask(clauses, std::move(comp_entity_ids)));
+                            return async::submit_cpu_task(async::MemSegmentProcessingTask(clauses, std::move(comp_entity_ids), profile_stages));
                         }));
             } else {
                 futures.emplace_back(
                         async::submit_cpu_task(
                                 async::MemSegmentProcessingTask(clauses,
-                                                                std::move(comp_entity_ids))
+                                                                std::move(comp_entity_ids),
+                                                                profile_stages)
                         )
                 );
             }
@@ -512,12 +532,20 @@ Composite<EntityIds> process_clauses(
         vec_comp_entity_ids = folly::collect(futures).get();
         futures.clear();
         // Erasing from front of vector not ideal, but they're just shared_ptr and there shouldn't be loads of clauses
-        while (clauses.size() > 0 && !clauses[0]->clause_info().requires_repartition_) {
+        auto erase_front_clause = [&clauses, &profile_stages]() {
             clauses.erase(clauses.begin());
+            if (!profile_stages.empty())
+                profile_stages.erase(profile_stages.begin());
+        };
+        while (clauses.size() > 0 && !clauses[0]->clause_info().requires_repartition_) {
+            erase_front_clause();
         }
         if (clauses.size() > 0 && clauses[0]->clause_info().requires_repartition_) {
-            vec_comp_entity_ids = clauses[0]->repartition(std::move(vec_comp_entity_ids)).value();
-            clauses.erase(clauses.begin());
+            {
+                ScopedProfileTimer profile_timer(profile_child(profile, "repartition"));
+                vec_comp_entity_ids = clauses[0]->repartition(std::move(vec_comp_entity_ids)).value();
+            }
+            erase_front_clause();
         }
     }
     return merge_composites(std::move(vec_comp_entity_ids));
@@ -630,7 +658,10 @@ std::vector<SliceAndKey> read_and_process(
     const ReadOptions& read_options,
     size_t start_from
     ) {
-    auto component_manager = std::make_shared<ComponentManager>();
+    const auto memory_budget_bytes = configured_memory_budget_bytes();
+    auto component_manager = memory_budget_bytes == 0 ?
+            std::make_shared<ComponentManager>() :
+            std::make_shared<ComponentManager>(memory_budget_bytes, configured_spill_path());
     ProcessingConfig processing_config{opt_false(read_options.dynamic_schema_), pipeline_context->rows_};
     for (auto& clause: read_query.clauses_) {
         clause->set_processing_config(processing_config);
@@ -647,13 +678,21 @@ std::vector<SliceAndKey> read_and_process(
         component_manager->set_next_entity_id(ranges_and_keys.size());
 
     // Start reading as early as possible
-    auto segment_and_slice_futures = store->batch_read_uncompressed(std::move(ranges_and_keys), columns_to_decode(pipeline_context));
+    auto segment_and_slice_futures = store->batch_read_uncompressed(std::move(ranges_and_keys), columns_to_decode(pipeline_context), read_options.profile_);
 
     auto processed_entity_ids = process_clauses(component_manager,
                                                 std::move(segment_and_slice_futures),
                                                 processing_unit_indexes,
-                                                read_query.clauses_);
+                                                read_query.clauses_,
+                                                read_options.profile_);
     auto comp_processing_units = gather_entities(component_manager, std::move(processed_entity_ids));
+    profile_add(read_options.profile_, "segments_spilled", component_manager->segments_spilled());
+    if (component_manager->segments_spilled() > 0) {
+        log::version().info("Read spilled {} intermediate segments to disk, with a peak of {} bytes in memory for a budget of {} bytes",
+                            component_manager->segments_spilled(),
+                            component_manager->memory_budget()->peak_bytes(),
+                            component_manager->memory_budget()->limit_bytes());
+    }
 
     if (std::any_of(read_query.clauses_.begin(), read_query.clauses_.end(), [](const std::shared_ptr<Clause>& clause) {
         return clause->clause_info().modifies_output_descriptor_;
@@ -673,7 +712,7 @@ SegmentInMemory read_direct(const std::shared_ptr<Store>& store,
     util::print_total_mem_usage(__FILE__, __LINE__, __FUNCTION__);
 
     ARCTICDB_DEBUG(log::version(), "Fetching frame data");
-    fetch_data(frame, pipeline_context, store, opt_false(read_options.dynamic_schema_), buffers).get();
+    fetch_data(frame, pipeline_context, store, opt_false(read_options.dynamic_schema_), buffers, read_options.profile_).get();
     util::print_total_mem_usage(__FILE__, __LINE__, __FUNCTION__);
     return frame;
 }
@@ -743,8 +782,10 @@ void read_indexed_keys_to_pipeline(
 
     add_index_columns_to_query(read_query, index_segment_reader.tsd());
 
+    read_query.calculate_row_filter(static_cast<int64_t>(index_segment_reader.tsd().proto().total_rows()));
+    // Only the leaves of a multi-level index that can hold rows in the requested range are read
+    index_segment_reader = index::expand_multi_level_index(std::move(index_segment_reader), store, read_query.row_filter);
     const auto& tsd = index_segment_reader.tsd();
-    read_query.calculate_row_filter(static_cast<int64_t>(tsd.proto().total_rows()));
     bool bucketize_dynamic = index_segment_reader.bucketize_dynamic();
     pipeline_context->desc_ = tsd.as_stream_descriptor();
 
@@ -756,6 +797,10 @@ void read_indexed_keys_to_pipeline(
         bucketize_dynamic);
 
     pipeline_context->slice_and_keys_ = filter_index(index_segment_reader, combine_filter_functions(queries));
+    if (auto index_stage = profile_child(read_options.profile_, "index")) {
+        index_stage->add("segments_in_index", index_segment_reader.size());
+        index_stage->add("segments_pruned", index_segment_reader.size() - pipeline_context->slice_and_keys_.size());
+    }
     pipeline_context->total_rows_ = pipeline_context->calc_rows();
     pipeline_context->rows_ = index_segment_reader.tsd().proto().total_rows();
     pipeline_context->norm_meta_ = std::make_unique<arcticdb::proto::descriptors::NormalizationMetadata>(std::move(*index_segment_reader.mutable_tsd().mutable_proto().mutable_normalization()));
@@ -1051,6 +1096,108 @@ ColumnStats get_column_stats_info_impl(
     }
 }
 
+namespace {
+
+// Left rows in left_range can only match right rows at or before its end and, with a tolerance, no more than the
+// tolerance before its start
+IndexRange as_of_join_right_range(const IndexRange& left_range, std::optional<timestamp> tolerance) {
+    if (!left_range.specified_ || !std::holds_alternative<NumericIndex>(left_range.start_) ||
+        !std::holds_alternative<NumericIndex>(left_range.end_))
+        return {};
+
+    auto start = std::numeric_limits<timestamp>::min();
+    const auto left_start = std::get<NumericIndex>(left_range.start_);
+    if (tolerance.has_value() && left_start >= start + *tolerance)
+        start = left_start - *tolerance;
+
+    return IndexRange{NumericIndex{start}, left_range.end_};
+}
+
+} // namespace
+
+std::shared_ptr<AsOfJoinRight> read_as_of_join_right(
+    const std::shared_ptr<Store>& store,
+    const VersionedItem& versioned_item,
+    const std::optional<std::string>& by,
+    const IndexRange& left_range,
+    std::optional<timestamp> tolerance,
+    const ReadOptions& read_options) {
+    using namespace arcticdb::pipelines;
+    ReadQuery read_query({std::make_shared<Clause>(PassthroughClause{})});
+    // Only whole row slices are skipped, the rows outside the range in the others are never matched
+    read_query.row_filter = as_of_join_right_range(left_range, tolerance);
+    auto pipeline_context = std::make_shared<PipelineContext>();
+    pipeline_context->stream_id_ = versioned_item.key_.id();
+    read_indexed_keys_to_pipeline(store, pipeline_context, versioned_item, read_query, read_options);
+
+    schema::check<ErrorCode::E_UNSUPPORTED_INDEX_TYPE>(
+            !pipeline_context->multi_key_ && pipeline_context->descriptor().index().type() == IndexDescriptor::TIMESTAMP,
+            "As-of join requires {} to have a timestamp index",
+            pipeline_context->stream_id_);
+    schema::check<ErrorCode::E_OPERATION_NOT_SUPPORTED_WITH_PICKLED_DATA>(
+            !pipeline_context->is_pickled(),
+            "Cannot as-of join pickled data in {}",
+            pipeline_context->stream_id_);
+
+    const auto& descriptor = pipeline_context->descriptor();
+    std::vector<std::pair<std::string, TypeDescriptor>> columns;
+    for (auto idx = descriptor.index().field_count(); idx < descriptor.field_count(); ++idx) {
+        const auto& field = descriptor.field(idx);
+        if (!by.has_value() || field.name() != *by)
+            columns.emplace_back(std::string{field.name()}, field.type());
+    }
+    auto right = std::make_shared<AsOfJoinRight>(std::move(columns), by);
+    if (pipeline_context->slice_and_keys_.empty())
+        return right;
+
+    auto segs = read_and_process(store, pipeline_context, read_query, read_options, 0u);
+    std::sort(std::begin(segs), std::end(segs), [] (const auto& left, const auto& right) {
+        return std::tie(left.slice_.row_range, left.slice_.col_range) < std::tie(right.slice_.row_range, right.slice_.col_range);
+    });
+    std::vector<SegmentInMemory> row_slice;
+    for (auto it = segs.begin(); it != segs.end(); ++it) {
+        row_slice.emplace_back(it->release_segment(store));
+        if (std::next(it) == segs.end() || std::next(it)->slice_.row_range != it->slice_.row_range)
+            right->add_row_slice(std::exchange(row_slice, {}));
+    }
+    ARCTICDB_DEBUG(log::version(), "Read {} rows of {} for as-of join", right->row_count(), pipeline_context->stream_id_);
+    return right;
+}
+
+namespace {
+
+// Drops the row slices that the version's column stats show cannot pass a leading filter, before anything is fetched.
+// Symbols without column stats are read as before, at the cost of one failed read of the key.
+void prune_slices_with_column_stats(
+    const std::shared_ptr<Store>& store,
+    const std::shared_ptr<PipelineContext>& pipeline_context,
+    const VersionedItem& versioned_item,
+    const ReadQuery& read_query,
+    const std::shared_ptr<ProfileStage>& profile) {
+    if (pipeline_context->incompletes_after_ || pipeline_context->slice_and_keys_.empty() ||
+        ConfigsMap::instance()->get_int("VersionStore.PruneWithColumnStats", 1) == 0)
+        return;
+
+    const auto& first_clause = *read_query.clauses_[0];
+    if (folly::poly_type(first_clause) != typeid(FilterClause))
+        return;
+
+    ScopedProfileTimer profile_timer(profile);
+    SegmentInMemory column_stats_segment;
+    try {
+        column_stats_segment = store->read(index_key_to_column_stats_key(versioned_item.key_)).get().second;
+    } catch (const storage::KeyNotFoundException&) {
+        return;
+    }
+    const auto& expression_context = *folly::poly_cast<FilterClause>(first_clause).expression_context_;
+    const auto pruned = prune_with_column_stats(column_stats_segment, expression_context, pipeline_context->slice_and_keys_);
+    profile_add(profile, "segments_pruned", pruned);
+    ARCTICDB_DEBUG(log::version(), "Column stats ruled out {} of {} segments for {}",
+                   pruned, pruned + pipeline_context->slice_and_keys_.size(), pipeline_context->stream_id_);
+}
+
+} // namespace
+
 FrameAndDescriptor read_dataframe_impl(
     const std::shared_ptr<Store>& store,
     const std::variant<VersionedItem, StreamId>& version_info,
@@ -1064,6 +1211,7 @@ FrameAndDescriptor read_dataframe_impl(
         pipeline_context->stream_id_ = std::get<StreamId>(version_info);
     } else {
         pipeline_context->stream_id_ = std::get<VersionedItem>(version_info).key_.id();
+        ScopedProfileTimer profile_timer(profile_child(read_options.profile_, "index"));
         read_indexed_keys_to_pipeline(store, pipeline_context, std::get<VersionedItem>(version_info), read_query, read_options);
     }
 
@@ -1091,8 +1239,13 @@ FrameAndDescriptor read_dataframe_impl(
     if(!read_query.clauses_.empty()) {
         ARCTICDB_SAMPLE(RunPipelineAndOutput, 0)
         util::check_rte(!pipeline_context->is_pickled(),"Cannot filter pickled data");
+        if(std::holds_alternative<VersionedItem>(version_info))
+            prune_slices_with_column_stats(store, pipeline_context, std::get<VersionedItem>(version_info), read_query,
+                                           profile_child(read_options.profile_, "column_stats"));
+
         auto segs = read_and_process(store, pipeline_context, read_query, read_options, 0u);
 
+        ScopedProfileTimer profile_timer(profile_child(read_options.profile_, "output"));
         frame = prepare_output_frame(std::move(segs), pipeline_context, store, read_options);
     } else {
         ARCTICDB_SAMPLE(MarkAndReadDirect, 0)
@@ -1102,7 +1255,12 @@ FrameAndDescriptor read_dataframe_impl(
     }
 
     ARCTICDB_DEBUG(log::version(), "Reduce and fix columns");
-    reduce_and_fix_columns(pipeline_context, frame, read_options);
+    {
+        ScopedProfileTimer profile_timer(profile_child(read_options.profile_, "reduce_and_fix_columns"));
+        reduce_and_fix_columns(pipeline_context, frame, read_options);
+    }
+    if (auto profile = read_options.profile_)
+        profile->add("rows", frame.row_count());
     return {frame, timeseries_descriptor_from_pipeline_context(pipeline_context, {}, pipeline_context->bucketize_dynamic_), {}, buffers};
 }
 
@@ -99,6 +99,14 @@ ColumnStats get_column_stats_info_impl(
     const std::shared_ptr<Store>& store,
     const VersionedItem& versioned_item);
 
+std::shared_ptr<AsOfJoinRight> read_as_of_join_right(
+    const std::shared_ptr<Store>& store,
+    const VersionedItem& versioned_item,
+    const std::optional<std::string>& by,
+    const IndexRange& left_range,
+    std::optional<timestamp> tolerance,
+    const ReadOptions& read_options);
+
 FrameAndDescriptor read_multi_key(
     const std::shared_ptr<Store>& store,
     const SegmentInMemory& index_key_seg);
@@ -9,6 +9,7 @@
 
 #include <arcticdb/python/python_utils.hpp>
 #include <arcticdb/async/async_store.hpp>
+#include <arcticdb/async/scheduler_lanes.hpp>
 #include <arcticdb/version/version_map.hpp>
 #include <arcticdb/entity/protobufs.hpp>
 #include <arcticdb/util/timer.hpp>
@@ -29,6 +30,7 @@
 #include <arcticdb/pipeline/pipeline_utils.hpp>
 #include <arcticdb/pipeline/frame_utils.hpp>
 #include <arcticdb/version/snapshot.hpp>
+#include <arcticdb/version/codec_dictionaries.hpp>
 
 #include <regex>
 
@@ -109,6 +111,8 @@ std::vector<std::variant<VersionedItem, DataError>> PythonVersionStore::batch_wr
     bool prune_previous_versions,
     bool validate_index,
     bool throw_on_error) {
+    async::ScopedTaskPriority priority{async::TaskPriority::BATCH};
+    async::ScopedTaskOperation operation;
 
     auto frames = create_input_tensor_frames(stream_ids, items, norms, user_metas);
     return batch_write_versioned_dataframe_internal(stream_ids, std::move(frames), prune_previous_versions, validate_index, throw_on_error);
@@ -123,6 +127,8 @@ std::vector<std::variant<VersionedItem, DataError>> PythonVersionStore::batch_ap
     bool validate_index,
     bool upsert,
     bool throw_on_error) {
+    async::ScopedTaskPriority priority{async::TaskPriority::BATCH};
+    async::ScopedTaskOperation operation;
     auto frames = create_input_tensor_frames(stream_ids, items, norms, user_metas);
     return batch_append_internal(stream_ids, std::move(frames), prune_previous_versions, validate_index, upsert, throw_on_error);
 }
@@ -600,12 +606,25 @@ VersionedItem PythonVersionStore::write_versioned_dataframe(
     bool sparsify_floats,
     bool validate_index) {
     ARCTICDB_SAMPLE(WriteVersionedDataframe, 0)
+    async::ScopedTaskOperation operation;
     auto frame = convert::py_ndf_to_frame(stream_id, item, norm, user_meta);
     auto versioned_item = write_versioned_dataframe_internal(stream_id, std::move(frame), prune_previous_versions, sparsify_floats, validate_index);
 
     return versioned_item;
 }
 
+VersionedItem PythonVersionStore::write_versioned_arrow(
+    const StreamId& stream_id,
+    uintptr_t array_ptr,
+    uintptr_t schema_ptr,
+    const py::object& user_meta,
+    bool prune_previous_versions,
+    bool validate_index) {
+    ARCTICDB_SAMPLE(WriteVersionedArrow, 0)
+    auto frame = convert::py_arrow_to_frame(stream_id, array_ptr, schema_ptr, user_meta);
+    return write_versioned_dataframe_internal(stream_id, std::move(frame), prune_previous_versions, false, validate_index);
+}
+
 VersionedItem PythonVersionStore::append(
     const StreamId& stream_id,
     const py::tuple &item,
@@ -614,10 +633,23 @@ VersionedItem PythonVersionStore::append(
     bool upsert,
     bool prune_previous_versions,
     bool validate_index) {
+    async::ScopedTaskOperation operation;
     return append_internal(stream_id, convert::py_ndf_to_frame(stream_id, item, norm, user_meta), upsert,
                            prune_previous_versions, validate_index);
 }
 
+VersionedItem PythonVersionStore::append_arrow(
+    const StreamId& stream_id,
+    uintptr_t array_ptr,
+    uintptr_t schema_ptr,
+    const py::object & user_meta,
+    bool upsert,
+    bool prune_previous_versions,
+    bool validate_index) {
+    return append_internal(stream_id, convert::py_arrow_to_frame(stream_id, array_ptr, schema_ptr, user_meta), upsert,
+                           prune_previous_versions, validate_index);
+}
+
 VersionedItem PythonVersionStore::update(
         const StreamId &stream_id,
         const UpdateQuery &query,
@@ -627,6 +659,7 @@ VersionedItem PythonVersionStore::update(
         bool upsert,
         bool dynamic_schema,
         bool prune_previous_versions) {
+    async::ScopedTaskOperation operation;
     return update_internal(stream_id, query,
                            convert::py_ndf_to_frame(stream_id, item, norm, user_meta), upsert,
                            dynamic_schema, prune_previous_versions);
@@ -702,6 +735,8 @@ VersionedItem PythonVersionStore::compact_incomplete(
         bool sparsify /*= false */,
         const std::optional<py::object>& user_meta /* = std::nullopt */,
         bool prune_previous_versions) {
+    async::ScopedTaskPriority priority{async::TaskPriority::BACKGROUND};
+    async::ScopedTaskOperation operation;
     std::optional<arcticdb::proto::descriptors::UserDefinedMetadata> meta;
     if (user_meta && !user_meta->is_none()) {
         meta = std::make_optional<arcticdb::proto::descriptors::UserDefinedMetadata>();
@@ -719,6 +754,8 @@ VersionedItem PythonVersionStore::sort_merge(
         bool via_iteration,
         bool sparsify
 ) {
+    async::ScopedTaskPriority priority{async::TaskPriority::BACKGROUND};
+    async::ScopedTaskOperation operation;
     std::optional<arcticdb::proto::descriptors::UserDefinedMetadata> meta;
     if (!user_meta.is_none()) {
         meta = std::make_optional<arcticdb::proto::descriptors::UserDefinedMetadata>();
@@ -733,6 +770,8 @@ void PythonVersionStore::write_parallel(
     const py::object &norm,
     const py::object & user_meta) const {
     using namespace arcticdb::entity;
+    async::ScopedTaskPriority priority{async::TaskPriority::BATCH};
+    async::ScopedTaskOperation operation;
     using namespace arcticdb::stream;
     using namespace arcticdb::pipelines;
 
@@ -759,6 +798,7 @@ ReadResult PythonVersionStore::read_dataframe_merged(
     const VersionQuery&, // TODO batch_get_specific_version
     const ReadQuery &query,
     const ReadOptions& read_options) {
+    async::ScopedTaskOperation operation;
     if (stream_ids.empty())
         util::raise_rte("No symbols given");
 
@@ -798,6 +838,7 @@ std::vector<std::variant<ReadResult, DataError>> PythonVersionStore::batch_read(
     std::vector<ReadQuery>& read_queries,
     const ReadOptions& read_options) {
     
+    async::ScopedTaskOperation operation;
     auto read_versions_or_errors = batch_read_internal(stream_ids, version_queries, read_queries, read_options);
     std::vector<std::variant<ReadResult, DataError>> res;
     for (auto&& [idx, read_version_or_error]: folly::enumerate(read_versions_or_errors)) {
@@ -821,6 +862,7 @@ ReadResult PythonVersionStore::read_dataframe_version(
     ReadQuery& read_query,
     const ReadOptions& read_options) {
 
+    async::ScopedTaskOperation operation;
     auto opt_version_and_frame = read_dataframe_version_internal(stream_id, version_query, read_query, read_options);
     return create_python_read_result(opt_version_and_frame.versioned_item_, std::move(opt_version_and_frame.frame_and_descriptor_));
 }
@@ -1119,9 +1161,24 @@ void PythonVersionStore::_compact_version_map(const StreamId& id) {
 }
 
 void PythonVersionStore::compact_library(size_t batch_size) {
+    async::ScopedTaskPriority priority{async::TaskPriority::BACKGROUND};
+    async::ScopedTaskOperation operation;
     version_map()->compact_if_necessary_stand_alone(store(), batch_size);
 }
 
+bool PythonVersionStore::train_codec_dictionaries(size_t max_segments, size_t dictionary_bytes) {
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(cfg().write_options().codec_dictionaries(),
+        "Codec dictionaries are not enabled for this library, set codec_dictionaries in its write options to train them");
+    async::ScopedTaskPriority priority{async::TaskPriority::BACKGROUND};
+    async::ScopedTaskOperation operation;
+    auto codec = arcticdb::train_codec_dictionaries(store(), max_segments, dictionary_bytes);
+    if(!codec)
+        return false;
+
+    store()->set_codec_opts(*codec);
+    return true;
+}
+
 std::vector<SliceAndKey> PythonVersionStore::list_incompletes(const StreamId& stream_id) {
     return get_incomplete(store(), stream_id, unspecified_range(), 0u, true, false);
 }
@@ -72,6 +72,14 @@ class PythonVersionStore : public LocalVersionedEngine {
         bool allow_sparse,
         bool validate_index);
 
+    VersionedItem write_versioned_arrow(
+        const StreamId& stream_id,
+        uintptr_t array_ptr,
+        uintptr_t schema_ptr,
+        const py::object & user_meta,
+        bool prune_previous_versions,
+        bool validate_index);
+
     VersionedItem write_versioned_composite_data(
         const StreamId& stream_id,
         const py::object &metastruct,
@@ -101,6 +109,15 @@ class PythonVersionStore : public LocalVersionedEngine {
         bool prune_previous_versions,
         bool validate_index);
 
+    VersionedItem append_arrow(
+        const StreamId& stream_id,
+        uintptr_t array_ptr,
+        uintptr_t schema_ptr,
+        const py::object & user_meta,
+        bool upsert,
+        bool prune_previous_versions,
+        bool validate_index);
+
     VersionedItem update(
         const StreamId& stream_id,
         const UpdateQuery & query,
@@ -323,6 +340,14 @@ class PythonVersionStore : public LocalVersionedEngine {
     void _compact_version_map(const StreamId& id);
     void compact_library(size_t batch_size);
 
+    /**
+     * Train zstd dictionaries per column type on a sample of the library's data and compress data written from
+     * this process with them. Other processes pick them up when they next open the library. Only libraries with
+     * codec_dictionaries set in their write options can be trained, as older clients cannot read the data.
+     * @return false if there was too little data to train any dictionaries, in which case nothing is changed.
+     */
+    bool train_codec_dictionaries(size_t max_segments, size_t dictionary_bytes);
+
     void fix_symbol_trees(const std::vector<StreamId>& symbols);
 
     /**
@@ -30,6 +30,7 @@ from arcticc.pb2.storage_pb2 import LibraryDescriptor, VersionStoreConfig
 from arcticdb.version_store.helper import ArcticFileConfig
 from arcticdb.config import _DEFAULT_ENVS_PATH
 from arcticdb_ext import set_config_int, get_config_int, unset_config_int
+from arcticdb_ext import set_config_string, get_config_string, unset_config_string
 
 
 def maybe_not_check_freq(f):
@@ -154,6 +155,19 @@ def config_context(name, value):
             unset_config_int(name)
 
 
+@contextmanager
+def config_context_string(name, value):
+    try:
+        initial = get_config_string(name)
+        set_config_string(name, value)
+        yield
+    finally:
+        if initial is not None:
+            set_config_string(name, initial)
+        else:
+            unset_config_string(name)
+
+
 def param_dict(fields, cases=None, xfail=None):
     _cases = deepcopy(cases) if cases else dict()
     if _cases:
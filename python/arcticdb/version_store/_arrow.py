@@ -0,0 +1,60 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import ctypes
+
+from arcticdb.exceptions import ArcticNativeException
+
+# Sizes of the ArrowSchema and ArrowArray structs of the Arrow C Data Interface, which are fixed by its ABI
+_ARROW_SCHEMA_BYTES = 72
+_ARROW_ARRAY_BYTES = 80
+
+
+def import_pyarrow():
+    try:
+        import pyarrow
+    except ImportError as e:
+        raise ImportError("pyarrow is required to read or write Arrow data with ArcticDB") from e
+    return pyarrow
+
+
+def arrow_table_from_frame(frame):
+    """
+    Builds a pyarrow Table from a frame read with OutputFormat.ARROW, without copying its numeric columns.
+    """
+    pa = import_pyarrow()
+    c_array = ctypes.create_string_buffer(_ARROW_ARRAY_BYTES)
+    c_schema = ctypes.create_string_buffer(_ARROW_SCHEMA_BYTES)
+    frame.export_arrow(ctypes.addressof(c_array), ctypes.addressof(c_schema))
+    # Importing moves the exported structs into pyarrow, which calls their release callbacks once it is done
+    batch = pa.RecordBatch._import_from_c(ctypes.addressof(c_array), ctypes.addressof(c_schema))
+    return pa.Table.from_batches([batch])
+
+
+def _single_batch(pa, data):
+    if isinstance(data, pa.RecordBatch):
+        return data
+    if not isinstance(data, pa.Table):
+        raise ArcticNativeException(f"Expected a pyarrow Table or RecordBatch, got {type(data)}")
+    batches = data.combine_chunks().to_batches()
+    if len(batches) == 1:
+        return batches[0]
+    # An empty table has no batches
+    return pa.RecordBatch.from_arrays([pa.array([], type=field.type) for field in data.schema], schema=data.schema)
+
+
+def call_with_exported_batch(data, func):
+    """
+    Exports a pyarrow Table or RecordBatch as a single record batch through the Arrow C Data Interface, and calls func
+    with the addresses of the exported ArrowArray and ArrowSchema structs, which func must take ownership of.
+    """
+    pa = import_pyarrow()
+    batch = _single_batch(pa, data)
+    c_array = ctypes.create_string_buffer(_ARROW_ARRAY_BYTES)
+    c_schema = ctypes.create_string_buffer(_ARROW_SCHEMA_BYTES)
+    batch._export_to_c(ctypes.addressof(c_array), ctypes.addressof(c_schema))
+    return func(ctypes.addressof(c_array), ctypes.addressof(c_schema))
@@ -8,6 +8,7 @@ As of the Change Date specified in that file, in accordance with the Business So
 import datetime
 import os
 import sys
+import time
 import pandas as pd
 import pytz
 import re
@@ -35,6 +36,7 @@ from arcticdb_ext.storage import (
     Library as _Library,
 )
 from arcticdb.version_store.read_result import ReadResult
+from arcticdb.version_store._arrow import arrow_table_from_frame, call_with_exported_batch
 from arcticdb_ext.version_store import IndexRange as _IndexRange
 from arcticdb_ext.version_store import RowRange as _RowRange
 from arcticdb_ext.version_store import SignedRowRange as _SignedRowRange
@@ -42,6 +44,7 @@ from arcticdb_ext.version_store import PythonVersionStore as _PythonVersionStore
 from arcticdb_ext.version_store import PythonVersionStoreReadQuery as _PythonVersionStoreReadQuery
 from arcticdb_ext.version_store import PythonVersionStoreUpdateQuery as _PythonVersionStoreUpdateQuery
 from arcticdb_ext.version_store import PythonVersionStoreReadOptions as _PythonVersionStoreReadOptions
+from arcticdb_ext.version_store import OutputFormat as _OutputFormat
 from arcticdb_ext.version_store import PythonVersionStoreVersionQuery as _PythonVersionStoreVersionQuery
 from arcticdb_ext.version_store import ColumnStats as _ColumnStats
 from arcticdb_ext.version_store import StreamDescriptorMismatch
@@ -100,6 +103,8 @@ class VersionedItem:
         Availability depends on the method used and may be different from that of `data`.
     host: Optional[str]
         Informational / for backwards compatibility.
+    profile: Optional[Dict]
+        For reads made with profile=True, how long each stage of the read took and what it did, as a tree of dicts.
     """
 
     symbol: str = attr.ib()
@@ -108,10 +113,12 @@ class VersionedItem:
     version: int = attr.ib()
     metadata: Any = attr.ib(default=None)
     host: Optional[str] = attr.ib(default=None)
+    profile: Optional[Dict] = attr.ib(default=None, repr=False)
 
     def __iter__(self):  # Backwards compatible with the old NamedTuple implementation
         warnings.warn("Don't iterate VersionedItem. Use attrs.astuple() explicitly", SyntaxWarning, stacklevel=2)
-        return iter(attr.astuple(self))
+        # The profile is left out, so that unpacking still yields the fields the NamedTuple had
+        return iter(attr.astuple(self, filter=attr.filters.exclude(attr.fields(VersionedItem).profile)))
 
 
 def _env_config_from_lib_config(lib_cfg, env):
@@ -202,6 +209,41 @@ def _assume_false(name, kwargs):
         return True
 
 
+def _get_output_format(kwargs) -> _OutputFormat:
+    output_format = kwargs.get("output_format", "pandas")
+    if output_format == "pandas":
+        return _OutputFormat.PANDAS
+    if output_format == "arrow":
+        return _OutputFormat.ARROW
+    raise ArcticNativeException(f"output_format must be 'pandas' or 'arrow', got {output_format}")
+
+
+def _row_filter_bounds(row_filter, offset, get_ts_index):
+    start_idx = end_idx = None
+    if isinstance(row_filter, _RowRange):
+        start_idx = row_filter.start - offset
+        end_idx = row_filter.end - offset
+    elif isinstance(row_filter, _IndexRange):
+        ts_idx = get_ts_index()
+        if len(ts_idx) != 0:
+            start_idx = ts_idx.searchsorted(datetime64(row_filter.start_ts, "ns"), side="left")
+            end_idx = ts_idx.searchsorted(datetime64(row_filter.end_ts, "ns"), side="right")
+    else:
+        raise ArcticNativeException("Unrecognised row_filter type: {}".format(type(row_filter)))
+    return start_idx, end_idx
+
+
+def _read_profile_to_dict(node) -> Dict:
+    return {
+        "name": node.name,
+        "calls": node.calls,
+        "wall_ns": node.wall_ns,
+        "cpu_ns": node.cpu_ns,
+        "counters": dict(node.counters),
+        "children": [_read_profile_to_dict(child) for child in node.children],
+    }
+
+
 class NativeVersionStore:
     """
     NativeVersionStore objects provide access to ArcticDB libraries, enabling fundamental library operations
@@ -584,6 +626,63 @@ class NativeVersionStore:
                 host=self.env,
             )
 
+    def write_arrow(
+        self,
+        symbol: str,
+        data: Any,
+        metadata: Optional[Any] = None,
+        prune_previous_version: Optional[bool] = None,
+        validate_index: bool = False,
+        **kwargs,
+    ) -> VersionedItem:
+        """
+        Write a pyarrow Table or RecordBatch to the specified `symbol`, without converting it to pandas. The data is
+        stored as the equivalent pandas DataFrame would be, so can be read with either output format.
+
+        If the first column has a timestamp type it becomes the index, otherwise the data gets a RangeIndex. Nulls in
+        string columns are stored as None and nulls in floating point columns as NaN. Nulls in other columns have no
+        equivalent in pandas and are rejected.
+
+        Parameters
+        ----------
+        symbol : `str`
+            Symbol name.
+        data : `pyarrow.Table` or `pyarrow.RecordBatch`
+            Data to be written. Tables with several chunks are combined into one batch first.
+        metadata : `Optional[Any]`, default=None
+            Optional metadata to persist along with the symbol.
+        prune_previous_version : `Optional[bool]`, default=None
+            Removes previous (non-snapshotted) versions from the database.
+        validate_index: bool, default=False
+            If True, verifies that the index is sorted in ascending order, as for `write`.
+
+        Returns
+        -------
+        VersionedItem
+            Structure containing metadata and version number of the written symbol in the store.
+            The data attribute will not be populated.
+        """
+        self.check_symbol_validity(symbol)
+        proto_cfg = self._lib_cfg.lib_desc.version.write_options
+        prune_previous_version = self.resolve_defaults(
+            "prune_previous_version", proto_cfg, global_default=False, existing_value=prune_previous_version, **kwargs
+        )
+        udm = normalize_metadata(metadata) if metadata is not None else None
+        vit = call_with_exported_batch(
+            data,
+            lambda array_ptr, schema_ptr: self.version_store.write_versioned_arrow(
+                symbol, array_ptr, schema_ptr, udm, prune_previous_version, validate_index
+            ),
+        )
+        return VersionedItem(
+            symbol=vit.symbol,
+            library=self._library.library_path,
+            version=vit.version,
+            metadata=metadata,
+            data=None,
+            host=self.env,
+        )
+
     def _resolve_dynamic_strings(self, kwargs):
         proto_cfg = self._lib_cfg.lib_desc.version.write_options
         if IS_WINDOWS:
@@ -704,6 +803,57 @@ class NativeVersionStore:
                         host=self.env,
                     )
 
+    def append_arrow(
+        self,
+        symbol: str,
+        data: Any,
+        metadata: Optional[Any] = None,
+        prune_previous_version: bool = False,
+        validate_index: bool = False,
+        **kwargs,
+    ) -> VersionedItem:
+        """
+        Appends a pyarrow Table or RecordBatch to the existing data, as `append` does for pandas data. The columns are
+        converted as they are by `write_arrow`.
+
+        Parameters
+        ----------
+        symbol : `str`
+            Symbol name.
+        data : `pyarrow.Table` or `pyarrow.RecordBatch`
+            Data to be appended.
+        metadata : `Optional[Any]`, default=None
+            Optional metadata to persist along with the new symbol version.
+        prune_previous_version
+            Removes previous (non-snapshotted) versions from the database.
+        validate_index: bool, default=False
+            If True, verifies that the resulting symbol is sorted in ascending order, as for `append`.
+
+        Returns
+        -------
+        VersionedItem
+            Structure containing metadata and version number of the written symbol in the store.
+            The data attribute will not be populated.
+        """
+        self.check_symbol_validity(symbol)
+        udm = normalize_metadata(metadata) if metadata is not None else None
+        write_if_missing = kwargs.get("write_if_missing", True)
+        with _diff_long_stream_descriptor_mismatch(self):
+            vit = call_with_exported_batch(
+                data,
+                lambda array_ptr, schema_ptr: self.version_store.append_arrow(
+                    symbol, array_ptr, schema_ptr, udm, write_if_missing, prune_previous_version, validate_index
+                ),
+            )
+        return VersionedItem(
+            symbol=vit.symbol,
+            library=self._library.library_path,
+            version=vit.version,
+            metadata=metadata,
+            data=None,
+            host=self.env,
+        )
+
     def update(
         self,
         symbol: str,
@@ -999,7 +1149,7 @@ class NativeVersionStore:
                 query = None
                 if query_builder is not None:
                     query = query_builder if isinstance(query_builder, QueryBuilder) else query_builder[i]
-                vitem = self._post_process_dataframe(read_result, read_query, query)
+                vitem = self._post_process_dataframe(read_result, read_query, query, read_options)
                 versioned_items.append(vitem)
         return versioned_items
 
@@ -1600,6 +1750,8 @@ class NativeVersionStore:
         read_options.set_set_tz(self.resolve_defaults("set_tz", proto_cfg, global_default=False, **kwargs))
         read_options.set_allow_sparse(self.resolve_defaults("allow_sparse", proto_cfg, global_default=False, **kwargs))
         read_options.set_incompletes(self.resolve_defaults("incomplete", proto_cfg, global_default=False, **kwargs))
+        read_options.set_profile(_assume_false("profile", kwargs))
+        read_options.set_output_format(_get_output_format(kwargs))
         return read_options
 
     def _get_queries(self, symbol, as_of, date_range, row_range, columns, query_builder, **kwargs):
@@ -1651,7 +1803,16 @@ class NativeVersionStore:
         query_builder: 'Optional[QueryBuilder]', default=None
             A QueryBuilder object to apply to the dataframe before it is returned.
             For more information see the documentation for the QueryBuilder class.
-
+        profile: `bool`, default=False
+            Passed as a keyword argument. If True, the returned item's `profile` attribute holds the wall and CPU
+            time of each stage of the read, from the version map and index through storage reads, decoding and each
+            clause of the query_builder to building the Python objects, along with what each stage did, such as the
+            bytes fetched and the rows in and out.
+        output_format: `str`, default="pandas"
+            Passed as a keyword argument. Either "pandas", or "arrow" to return the data as a pyarrow Table, which
+            requires pyarrow to be installed. Contiguous numeric columns of an Arrow read are not copied, and string
+            columns are built from the stored strings without creating any Python objects.
+            Only dataframes and series can be read as Arrow.
 
         Returns
         -------
@@ -1675,7 +1836,20 @@ class NativeVersionStore:
             **kwargs,
         )
         read_result = self._read_dataframe(symbol, version_query, read_query, read_options)
-        return self._post_process_dataframe(read_result, read_query, query_builder)
+        if not _assume_false("profile", kwargs):
+            return self._post_process_dataframe(read_result, read_query, query_builder, read_options)
+
+        wall_start, cpu_start = time.perf_counter_ns(), time.thread_time_ns()
+        vitem = self._post_process_dataframe(read_result, read_query, query_builder, read_options)
+        wall_ns, cpu_ns = time.perf_counter_ns() - wall_start, time.thread_time_ns() - cpu_start
+        profile = _read_profile_to_dict(read_options.profile)
+        profile["children"].append(
+            {"name": "python_output", "calls": 1, "wall_ns": wall_ns, "cpu_ns": cpu_ns, "counters": {}, "children": []}
+        )
+        profile["wall_ns"] += wall_ns
+        profile["cpu_ns"] += cpu_ns
+        vitem.profile = profile
+        return vitem
 
     def head(
         self,
@@ -1711,7 +1885,7 @@ class NativeVersionStore:
             symbol=symbol, as_of=as_of, date_range=None, row_range=None, columns=columns, query_builder=q, **kwargs
         )
         read_result = self._read_dataframe(symbol, version_query, read_query, read_options)
-        return self._post_process_dataframe(read_result, read_query, q)
+        return self._post_process_dataframe(read_result, read_query, q, read_options)
 
     def tail(
         self, symbol: str, n: int = 5, as_of: VersionQueryInput = None, columns: Optional[List[str]] = None, **kwargs
@@ -1742,25 +1916,20 @@ class NativeVersionStore:
             symbol=symbol, as_of=as_of, date_range=None, row_range=None, columns=columns, query_builder=q, **kwargs
         )
         read_result = self._read_dataframe(symbol, version_query, read_query, read_options)
-        return self._post_process_dataframe(read_result, read_query, q)
+        return self._post_process_dataframe(read_result, read_query, q, read_options)
 
     def _read_dataframe(self, symbol, version_query, read_query, read_options):
         return ReadResult(*self.version_store.read_dataframe_version(symbol, version_query, read_query, read_options))
 
-    def _post_process_dataframe(self, read_result, read_query, query_builder):
+    def _post_process_dataframe(self, read_result, read_query, query_builder, read_options=None):
+        if read_options is not None and read_options.output_format == _OutputFormat.ARROW:
+            return self._post_process_arrow(read_result, read_query, query_builder)
+
         if read_query.row_filter is not None and (query_builder is None or query_builder.needs_post_processing()):
             # post filter
-            start_idx = end_idx = None
-            if isinstance(read_query.row_filter, _RowRange):
-                start_idx = read_query.row_filter.start - read_result.frame_data.offset
-                end_idx = read_query.row_filter.end - read_result.frame_data.offset
-            elif isinstance(read_query.row_filter, _IndexRange):
-                ts_idx = read_result.frame_data.value.data[0]
-                if len(ts_idx) != 0:
-                    start_idx = ts_idx.searchsorted(datetime64(read_query.row_filter.start_ts, "ns"), side="left")
-                    end_idx = ts_idx.searchsorted(datetime64(read_query.row_filter.end_ts, "ns"), side="right")
-            else:
-                raise ArcticNativeException("Unrecognised row_filter type: {}".format(type(read_query.row_filter)))
+            start_idx, end_idx = _row_filter_bounds(
+                read_query.row_filter, read_result.frame_data.offset, lambda: read_result.frame_data.value.data[0]
+            )
             data = []
             for c in read_result.frame_data.value.data:
                 data.append(c[start_idx:end_idx])
@@ -1786,6 +1955,30 @@ class NativeVersionStore:
 
         return vitem
 
+    def _post_process_arrow(self, read_result, read_query, query_builder):
+        if len(read_result.keys) > 0 or read_result.norm.HasField("custom") or read_result.norm.HasField("msg_pack_frame"):
+            raise ArcticDbNotYetImplemented(
+                "output_format='arrow' is only supported for dataframes and series, not for pickled, recursively "
+                "normalized or custom normalized data"
+            )
+
+        data = arrow_table_from_frame(read_result.frame_data)
+        if read_query.row_filter is not None and (query_builder is None or query_builder.needs_post_processing()):
+            start_idx, end_idx = _row_filter_bounds(
+                read_query.row_filter, read_result.frame_data.offset, lambda: data.column(0).to_numpy()
+            )
+            rows = range(data.num_rows)[start_idx:end_idx]
+            data = data.slice(rows.start, len(rows))
+
+        return VersionedItem(
+            symbol=read_result.version.symbol,
+            library=self._library.library_path,
+            data=data,
+            version=read_result.version.version,
+            metadata=denormalize_user_metadata(read_result.udm, self._normalizer),
+            host=self.env,
+        )
+
     def _find_version(
         self, symbol: str, as_of: Optional[VersionQueryInput] = None, raise_on_missing: Optional[bool] = False, **kwargs
     ) -> Optional[VersionedItem]:
@@ -12,7 +12,7 @@ from math import inf
 import numpy as np
 import pandas as pd
 
-from typing import Dict, NamedTuple
+from typing import Dict, NamedTuple, Optional, Tuple, Union
 
 from arcticdb.exceptions import ArcticNativeException, UserInputException
 from arcticdb.version_store._normalization import normalize_dt_range_to_ts
@@ -27,6 +27,9 @@ from arcticdb_ext.version_store import GroupByClause as _GroupByClause
 from arcticdb_ext.version_store import AggregationClause as _AggregationClause
 from arcticdb_ext.version_store import RowRangeClause as _RowRangeClause
 from arcticdb_ext.version_store import DateRangeClause as _DateRangeClause
+from arcticdb_ext.version_store import AsOfJoinClause as _AsOfJoinClause
+from arcticdb_ext.version_store import RollingClause as _RollingClause
+from arcticdb_ext.version_store import TopKClause as _TopKClause
 from arcticdb_ext.version_store import RowRangeType as _RowRangeType
 from arcticdb_ext.version_store import ExpressionName as _ExpressionName
 from arcticdb_ext.version_store import ColumnName as _ColumnName
@@ -204,6 +207,10 @@ class ExpressionNode:
         value_list = value_list_from_args(*args)
         return self._apply(value_list, _OperationType.ISNOTIN)
 
+    @property
+    def str(self):
+        return StringMethods(self)
+
     def __str__(self):
         return self.get_name()
 
@@ -211,7 +218,14 @@ class ExpressionNode:
         if not self.name:
             if self.operator == COLUMN:
                 self.name = 'Column["{}"]'.format(self.left)
-            elif self.operator in [_OperationType.ABS, _OperationType.NEG, _OperationType.NOT]:
+            elif self.operator in [
+                _OperationType.ABS,
+                _OperationType.NEG,
+                _OperationType.NOT,
+                _OperationType.LOWER,
+                _OperationType.UPPER,
+                _OperationType.LEN,
+            ]:
                 self.name = "{}({})".format(self.operator.name, self.left)
             else:
                 if isinstance(self.left, ExpressionNode):
@@ -226,6 +240,51 @@ class ExpressionNode:
         return self.name
 
 
+class StringMethods:
+    """
+    String operations on a column, accessed like pandas Series.str, e.g.
+
+        >>> q = q[q["ticker"].str.startswith("AB") | q["venue"].str.lower().isin(["xlon", "xpar"])]
+
+    Each operation is evaluated once per distinct string in a segment rather than once per row, so is cheap on columns
+    with few distinct values however many rows they have. Regexes are matched with an automaton rather than by
+    backtracking, so the time taken is linear in the length of the string, but backreferences are not supported.
+    Case mapping only changes ASCII characters.
+    """
+
+    def __init__(self, node):
+        self._node = node
+
+    def _predicate(self, pat, operator):
+        if not isinstance(pat, str):
+            raise UserInputException(f"String operation expects a str argument, not {type(pat).__name__}")
+        return self._node._apply(pat, operator)
+
+    def lower(self):
+        return ExpressionNode.compose(self._node, _OperationType.LOWER, None)
+
+    def upper(self):
+        return ExpressionNode.compose(self._node, _OperationType.UPPER, None)
+
+    def len(self):
+        """
+        Lengths in bytes, as floats with NaN for missing strings.
+        """
+        return ExpressionNode.compose(self._node, _OperationType.LEN, None)
+
+    def startswith(self, pat):
+        return self._predicate(pat, _OperationType.STARTSWITH)
+
+    def endswith(self, pat):
+        return self._predicate(pat, _OperationType.ENDSWITH)
+
+    def contains(self, pat, regex=True):
+        """
+        Whether pat matches anywhere in each string, as a regex unless regex is False.
+        """
+        return self._predicate(pat, _OperationType.REGEX_MATCH if regex else _OperationType.CONTAINS)
+
+
 def is_supported_sequence(obj):
     return isinstance(obj, (list, set, frozenset, tuple, np.ndarray))
 
@@ -267,6 +326,9 @@ PythonProjectionClause = namedtuple("PythonProjectionClause", ["name", "expr"])
 PythonGroupByClause = namedtuple("PythonGroupByClause", ["name"])
 PythonAggregationClause = namedtuple("PythonAggregationClause", ["aggregations"])
 PythonDateRangeClause = namedtuple("PythonDateRangeClause", ["start", "end"])
+PythonAsOfJoinClause = namedtuple("PythonAsOfJoinClause", ["symbol", "as_of", "tolerance", "by"])
+PythonRollingClause = namedtuple("PythonRollingClause", ["rows", "span", "min_periods", "aggregations"])
+PythonTopKClause = namedtuple("PythonTopKClause", ["column", "k", "largest", "by"])
 
 
 class PythonRowRangeClause(NamedTuple):
@@ -303,6 +365,12 @@ class QueryBuilder:
 
     * List membership: isin, isnotin (also accessible with == and !=)
 
+    * String predicates: str.startswith, str.endswith, str.contains (a regex unless regex=False)
+
+    Supported string transformations, which can be projected or filtered on further:
+
+    * str.lower, str.upper, str.len
+
     isin/isnotin accept lists, sets, frozensets, 1D ndarrays, or *args unpacking. For example:
 
         >>> l = [1, 2, 3]
@@ -405,13 +473,19 @@ class QueryBuilder:
 
     def groupby(self, name: str):
         """
-        Group symbol by column name. GroupBy operations must be followed by an aggregation operator. Currently the following five aggregation
+        Group symbol by column name. GroupBy operations must be followed by an aggregation operator. Currently the following aggregation
         operators are supported:
             * "mean" - compute the mean of the group
             * "sum" - compute the sum of the group
             * "min" - compute the min of the group
             * "max" - compute the max of the group
             * "count" - compute the count of group
+            * "approx_nunique" - estimate the number of distinct values in the group, to within a few percent, with a
+              HyperLogLog sketch
+            * "approx_quantile(q)" - estimate the q quantile of the group, for q between 0 and 1, with a t-digest.
+              "approx_median" is short for "approx_quantile(0.5)"
+
+        The approximate aggregations use a fixed amount of memory per group however many values it holds.
 
         For usage examples, see below.
 
@@ -493,6 +567,133 @@ class QueryBuilder:
         self._python_clauses.append(PythonAggregationClause(aggregations))
         return self
 
+    def as_of_join(
+        self,
+        symbol: str,
+        as_of: Optional[int] = None,
+        tolerance: Optional[Union[pd.Timedelta, datetime.timedelta, str]] = None,
+        by: Optional[str] = None,
+    ):
+        """
+        Add the columns of another symbol to each row, taken from the last row of that symbol whose index is at or
+        before the row's index. This is equivalent to pandas.merge_asof with direction="backward", but runs entirely
+        in C++ without materialising the other symbol as a dataframe.
+
+        Both symbols must be timestamp-indexed and sorted. Rows without a match get NaN in added float columns, None in
+        added string columns and zero in added integer and bool columns. Column names other than the by column must not
+        appear in both symbols. Only the rows of symbol that can match the rows being read are fetched.
+
+        Parameters
+        ----------
+        symbol: `str`
+            Symbol to take the added columns from.
+        as_of: `Optional[int]`, default=None
+            Version of symbol to use. The latest version is used if not given.
+        tolerance: `Optional[Union[pandas.Timedelta, datetime.timedelta, str]]`, default=None
+            Only match rows whose index is no more than this before the row's index.
+        by: `Optional[str]`, default=None
+            Only match rows with the same value in this column, which must be in both symbols and hold strings in
+            both or numbers in both.
+
+        Examples
+        --------
+        >>> lib.write("quotes", quotes)
+        >>> q = QueryBuilder()
+        >>> q = q.as_of_join("quotes", tolerance=pd.Timedelta("2ms"), by="ticker")
+        >>> lib.read("trades", query_builder=q).data
+
+        Returns
+        -------
+        QueryBuilder
+            Modified QueryBuilder object.
+        """
+        tolerance_ns = None if tolerance is None else pd.Timedelta(tolerance).value
+        self.clauses.append(_AsOfJoinClause(symbol, as_of, tolerance_ns, by))
+        self._python_clauses.append(PythonAsOfJoinClause(symbol, as_of, tolerance_ns, by))
+        return self
+
+    def rolling(
+        self,
+        window: Union[int, pd.Timedelta, datetime.timedelta, str],
+        aggregations: Dict[str, Tuple[str, str]],
+        min_periods: Optional[int] = None,
+    ):
+        """
+        Add columns holding rolling window aggregations of other columns, as pandas.DataFrame.rolling would. The
+        windows are computed in C++ as the row slices are processed, so the symbol is never materialised in full as a
+        dataframe to roll over it.
+
+        The added columns are always float64, and rows with fewer than min_periods non-NaN values in their window get
+        NaN.
+
+        Parameters
+        ----------
+        window: `Union[int, pandas.Timedelta, datetime.timedelta, str]`
+            Either a number of rows, ending at each row, or a time span. A time span requires a sorted timestamp index,
+            and the window of a row with index t is then the rows with an index in (t - window, t].
+        aggregations: `Dict[str, Tuple[str, str]]`
+            Maps the name of each column to add to the column it aggregates and the aggregation operator, one of
+            "sum", "mean", "min", "max" or "count".
+        min_periods: `Optional[int]`, default=None
+            The number of non-NaN values a window needs for its output to be given. As in pandas, defaults to the
+            window for a number of rows and to 1 for a time span.
+
+        Examples
+        --------
+        >>> q = QueryBuilder()
+        >>> q = q.rolling("5min", {"price_mean": ("price", "mean"), "price_max": ("price", "max")})
+        >>> lib.read("trades", query_builder=q).data
+
+        Returns
+        -------
+        QueryBuilder
+            Modified QueryBuilder object.
+        """
+        if isinstance(window, (int, np.integer)):
+            rows, span = int(window), None
+        else:
+            rows, span = None, pd.Timedelta(window).value
+        aggregations = [(output, column, operator.lower()) for output, (column, operator) in aggregations.items()]
+        self.clauses.append(_RollingClause(rows, span, min_periods, aggregations))
+        self._python_clauses.append(PythonRollingClause(rows, span, min_periods, aggregations))
+        return self
+
+    def top_k(self, column: str, k: int, largest: bool = True, by: Optional[str] = None):
+        """
+        Keep only the k rows with the largest (or smallest) values in a numeric column, as pandas.DataFrame.nlargest
+        and nsmallest would with keep="first". Each row slice only keeps its own best k rows, so at most k rows per row
+        slice are ever merged to pick the final ones.
+
+        The rows are returned best first, with ties in the order they appear in the symbol. Rows with NaN or missing
+        values in the column are never selected.
+
+        Parameters
+        ----------
+        column: `str`
+            Numeric or bool column to rank the rows by.
+        k: `int`
+            Number of rows to keep, must be positive.
+        largest: `bool`, default=True
+            Keep the rows with the largest values if True, or the smallest if False.
+        by: `Optional[str]`, default=None
+            Keep the best k rows for each value in this column instead, as
+            df.sort_values(column).groupby(by, sort=False).head(k) would. Rows with a NaN or None in it are dropped.
+
+        Examples
+        --------
+        >>> q = QueryBuilder()
+        >>> q = q.top_k("notional", 10, by="ticker")
+        >>> lib.read("trades", query_builder=q).data
+
+        Returns
+        -------
+        QueryBuilder
+            Modified QueryBuilder object.
+        """
+        self.clauses.append(_TopKClause(column, k, largest, by))
+        self._python_clauses.append(PythonTopKClause(column, k, largest, by))
+        return self
+
     # TODO: specify type of other must be QueryBuilder with from __future__ import annotations once only Python 3.7+
     # supported
     def then(self, other):
@@ -615,6 +816,20 @@ class QueryBuilder:
                     self.clauses.append(_RowRangeClause(python_clause.row_range_type, python_clause.n))
             elif isinstance(python_clause, PythonDateRangeClause):
                 self.clauses.append(_DateRangeClause(python_clause.start, python_clause.end))
+            elif isinstance(python_clause, PythonAsOfJoinClause):
+                self.clauses.append(
+                    _AsOfJoinClause(python_clause.symbol, python_clause.as_of, python_clause.tolerance, python_clause.by)
+                )
+            elif isinstance(python_clause, PythonRollingClause):
+                self.clauses.append(
+                    _RollingClause(
+                        python_clause.rows, python_clause.span, python_clause.min_periods, python_clause.aggregations
+                    )
+                )
+            elif isinstance(python_clause, PythonTopKClause):
+                self.clauses.append(
+                    _TopKClause(python_clause.column, python_clause.k, python_clause.largest, python_clause.by)
+                )
             else:
                 raise ArcticNativeException(
                     f"Unrecognised clause type {type(python_clause)} when unpickling QueryBuilder"
@@ -25,7 +25,7 @@ from arcticdb.storage_fixtures.s3 import MotoS3StorageFixtureFactory, real_s3_fr
 from arcticdb.storage_fixtures.mongo import auto_detect_server
 from arcticdb.storage_fixtures.in_memory import InMemoryStorageFixture
 from arcticdb.version_store._normalization import MsgPackNormalizer
-from arcticdb.util.test import configure_test_logger
+from arcticdb.util.test import configure_test_logger, config_context, config_context_string
 from tests.util.mark import (
     AZURE_TESTS_MARK,
     MONGO_TESTS_MARK,
@@ -76,6 +76,15 @@ def get_stderr(capfd):
     return _get
 
 
+@pytest.fixture
+def tiny_memory_budget(tmp_path_factory):
+    """Makes reads spill every intermediate segment, as none fit in the budget, to the directory yielded"""
+    spill_directory = tmp_path_factory.mktemp("spill")
+    with config_context("Processing.MemoryBudgetBytes", 1):
+        with config_context_string("Processing.SpillDirectory", str(spill_directory)):
+            yield spill_directory
+
+
 @enum.unique
 class EncodingVersion(enum.IntEnum):
     V1 = 0
@@ -1066,6 +1066,34 @@ def test_azure_sas_token(azurite_storage_factory: StorageFixtureFactory):
             ac.create_library("x")
 
 
+@AZURE_TESTS_MARK
+def test_azure_chunked_transfers(azurite_storage: StorageFixture):
+    from arcticdb_ext import set_config_int, unset_config_int
+
+    # Thresholds well below the size of the segments so that they are staged as blocks and downloaded in ranges
+    configs = {
+        "AzureStorage.SingleUploadThresholdBytes": 64 * 1024,
+        "AzureStorage.UploadChunkBytes": 64 * 1024,
+        "AzureStorage.DownloadInitialChunkBytes": 64 * 1024,
+        "AzureStorage.DownloadChunkBytes": 64 * 1024,
+    }
+    for name, value in configs.items():
+        set_config_int(name, value)
+    try:
+        ac = azurite_storage.create_arctic()
+        lib = ac.create_library("chunked")
+        df = pd.DataFrame({"a": np.arange(200_000), "b": np.random.rand(200_000)})
+        lib.write("df", df)
+        assert_frame_equal(lib.read("df").data, df)
+
+        data = {"blob": np.random.bytes(1024 * 1024)}
+        lib.write_pickle("pickled", data)
+        assert lib.read("pickled").data == data
+    finally:
+        for name in configs:
+            unset_config_int(name)
+
+
 def test_s3_force_uri_lib_config_handling(s3_storage):
     # force_uri_lib_config is a obsolete configuration. However, user still includes this option in their setup.
     # For backward compatibility, we need to make sure such setup will still work
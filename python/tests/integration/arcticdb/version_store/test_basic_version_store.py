@@ -2447,3 +2447,72 @@ def test_use_previous_on_failure_batch(basic_store):
     vits = lib.batch_read(symbols, read_previous_on_failure=True, as_ofs=write_times)
     for x in range(num_items):
         assert_frame_equal(vits[symbols[x]].data, expected[x])
+
+
+def test_mongo_missing_data_key(mongo_version_store):
+    lib = mongo_version_store
+    lib.write("sym", pd.DataFrame({"a": np.arange(10)}))
+    lib.write("other", pd.DataFrame({"a": np.arange(5)}))
+    lib_tool = lib.library_tool()
+    lib_tool.remove(lib_tool.find_keys_for_id(KeyType.TABLE_DATA, "sym")[0])
+
+    with pytest.raises(StorageException):
+        lib.read("sym")
+    assert_frame_equal(lib.read("other").data, pd.DataFrame({"a": np.arange(5)}))
+
+
+def test_mongo_batched_reads_and_writes(mongo_storage, mongo_store_factory):
+    def command_count(command):
+        return mongo_storage.client.admin.command("serverStatus")["metrics"]["commands"][command]["total"]
+
+    num_segments = 100
+    df = pd.DataFrame({"a": np.arange(num_segments * 10)})
+
+    def finds_and_inserts(lib):
+        inserts = command_count("insert")
+        lib.write("sym", df)
+        inserts = command_count("insert") - inserts
+        finds = command_count("find")
+        assert_frame_equal(lib.read("sym").data, df)
+        finds = command_count("find") - finds
+        return finds, inserts
+
+    # The batch size is read when the library is opened
+    with config_context("MongoClient.BatchSize", 1):
+        unbatched = finds_and_inserts(mongo_store_factory(name="unbatched", segment_row_size=10))
+    batched = finds_and_inserts(mongo_store_factory(name="batched", segment_row_size=10))
+
+    # Without batching each data key takes a round trip of its own, with it they all share one
+    for with_batching, without_batching in zip(batched, unbatched):
+        assert without_batching >= num_segments
+        assert without_batching - with_batching >= num_segments - 1
+
+
+def test_s3_multipart_upload_and_ranged_get(s3_storage, lib_name):
+    from arcticc.pb2.s3_storage_pb2 import Config as S3Config
+    from arcticdb.config import Defaults
+    from arcticdb.version_store.helper import ArcticMemoryConfig
+
+    # Thresholds small enough that the segments below are uploaded in parts and read back in ranges
+    cfg = s3_storage.create_test_cfg(lib_name)
+    for storage in cfg.env_by_id[Defaults.ENV].storage_by_id.values():
+        s3_config = S3Config()
+        storage.config.Unpack(s3_config)
+        s3_config.multipart_upload_threshold = 6 * 1024 * 1024
+        s3_config.multipart_part_size = 5 * 1024 * 1024
+        s3_config.ranged_get_size = 1024 * 1024
+        s3_config.transfer_concurrency = 3
+        storage.config.Pack(s3_config)
+    lib = ArcticMemoryConfig(cfg, Defaults.ENV)[lib_name]
+
+    df = pd.DataFrame({"a": np.arange(2_000_000), "b": np.random.rand(2_000_000)})
+    lib.write("large", df, segment_row_size=2_000_000)
+    assert_frame_equal(lib.read("large").data, df)
+
+    small = pd.DataFrame({"a": np.arange(10)})
+    lib.write("small", small)
+    assert_frame_equal(lib.read("small").data, small)
+
+    data = {"blob": np.random.bytes(12 * 1024 * 1024)}
+    lib.write("pickled", data)
+    assert lib.read("pickled").data == data
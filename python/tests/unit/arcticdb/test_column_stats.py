@@ -2,6 +2,7 @@ import numpy as np
 import pandas as pd
 import pytest
 
+from arcticdb.version_store.processing import QueryBuilder
 from arcticdb_ext.exceptions import SchemaException, StorageException, UserInputException
 from arcticdb_ext.storage import KeyType, NoDataFoundException
 from arcticdb_ext.version_store import NoSuchVersionException
@@ -641,3 +642,36 @@ def test_column_stats_object_deleted_with_index_key_batch_methods(lmdb_version_s
     for test in [test_prune_previous_kwarg_batch_methods]:
         test()
         clear()
+
+
+def test_column_stats_prune_filtered_read(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    sym = "test_column_stats_prune_filtered_read"
+    df = pd.DataFrame(
+        {
+            "col_1": np.arange(20, dtype=np.int64),
+            "col_2": np.arange(20, dtype=np.float64)[::-1],
+        },
+        index=pd.date_range("2000-01-01", periods=20),
+    )
+    df.loc[df.index[5], "col_2"] = np.nan
+    lib.write(sym, df)
+    lib.create_column_stats(sym, {"col_1": {"MINMAX"}, "col_2": {"MINMAX"}})
+
+    filters = [
+        lambda x: x["col_1"] > 12,
+        lambda x: x["col_1"] == 3,
+        lambda x: (x["col_1"] < 2) | (x["col_2"] < 1.5),
+        lambda x: (x["col_1"] < 2) & (x["col_2"] < 1.5),
+        lambda x: x["col_2"] != 4,
+        lambda x: x["col_1"] > 100,
+    ]
+    for f in filters:
+        q = QueryBuilder()
+        q = q[f(q)]
+        received = lib.read(sym, query_builder=q).data
+        expected = df[f(df)]
+        if expected.empty:
+            assert received.empty
+        else:
+            pd.testing.assert_frame_equal(received, expected)
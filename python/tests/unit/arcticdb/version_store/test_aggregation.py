@@ -11,7 +11,7 @@ import pandas as pd
 from pandas import DataFrame
 
 from arcticdb.version_store.processing import QueryBuilder
-from arcticdb_ext.exceptions import InternalException, SchemaException
+from arcticdb_ext.exceptions import InternalException, SchemaException, UserInputException
 from arcticdb.util.test import assert_frame_equal
 from arcticdb.util.hypothesis import (
     use_of_function_scoped_fixtures_in_hypothesis_checked,
@@ -490,3 +490,97 @@ def test_docstring_example_query_builder_groupby_max_and_mean(lmdb_version_store
     df = pd.DataFrame({"to_mean": (1.1 + 1.4 + 2.5) / 3, "to_max": [2.5]}, index=["group_1"])
     df.index.rename("grouping_column", inplace=True)
     assert_frame_equal(res.data, df)
+
+
+def approx_df(rows=20000):
+    rng = np.random.default_rng(0)
+    latency = rng.lognormal(3.0, 1.0, rows)
+    latency[rng.uniform(size=rows) < 0.05] = np.nan
+    return pd.DataFrame(
+        {
+            "desk": rng.choice(["rates", "credit", "fx"], rows),
+            # Many more counterparties in some desks than others
+            "counterparty": [f"cp_{int(x)}" for x in rng.pareto(1.0, rows) * 100],
+            "latency": latency,
+        },
+        index=np.arange(rows),
+    )
+
+
+def test_approx_nunique(lmdb_version_store_tiny_segment_dynamic):
+    lib = lmdb_version_store_tiny_segment_dynamic
+    df = approx_df(500)
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q.groupby("desk").agg({"counterparty": "approx_nunique"})
+    received = lib.read("sym", query_builder=q).data.sort_index()
+    expected = df.groupby("desk").agg({"counterparty": "nunique"}).sort_index()
+    assert received["counterparty"].dtype == np.uint64
+    np.testing.assert_allclose(received["counterparty"], expected["counterparty"], rtol=0.065, atol=2)
+
+
+def test_approx_quantile(lmdb_version_store):
+    lib = lmdb_version_store
+    df = approx_df()
+    lib.write("sym", df)
+
+    for operator, q in [("approx_median", 0.5), ("approx_quantile(0.99)", 0.99), ("approx_quantile(0)", 0.0)]:
+        query = QueryBuilder()
+        query = query.groupby("desk").agg({"latency": operator})
+        received = lib.read("sym", query_builder=query).data.sort_index()
+        for desk, estimate in received["latency"].items():
+            values = np.sort(df.loc[df["desk"] == desk, "latency"].dropna().to_numpy())
+            rank = np.searchsorted(values, estimate, side="left") / len(values)
+            rank_right = np.searchsorted(values, estimate, side="right") / len(values)
+            assert rank - 0.02 <= q <= rank_right + 0.02
+
+
+def test_approx_quantile_few_values_exact(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = approx_df(40)
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q.groupby("desk").agg({"latency": "approx_quantile(0.25)"})
+    received = lib.read("sym", query_builder=q).data.sort_index()
+    expected = df.groupby("desk").agg({"latency": lambda x: x.quantile(0.25)}).sort_index()
+    assert_frame_equal(expected, received)
+
+
+@pytest.mark.parametrize("operator", ["approx_quantile(1.5)", "approx_quantile(abc)", "approx_quantile()"])
+def test_approx_quantile_invalid(operator):
+    with pytest.raises(UserInputException):
+        QueryBuilder().groupby("desk").agg({"latency": operator})
+
+
+def test_approx_quantile_of_strings(lmdb_version_store):
+    lib = lmdb_version_store
+    lib.write("sym", approx_df(100))
+
+    q = QueryBuilder()
+    q = q.groupby("desk").agg({"counterparty": "approx_median"})
+    with pytest.raises(SchemaException):
+        lib.read("sym", query_builder=q)
+
+
+def test_groupby_over_memory_budget(lmdb_version_store_tiny_segment, tiny_memory_budget):
+    lib = lmdb_version_store_tiny_segment
+    rng = np.random.default_rng(0)
+    df = pd.DataFrame(
+        {
+            "grouping_column": rng.integers(0, 1000, 500),
+            "to_sum": rng.integers(0, 100, 500),
+            "to_mean": rng.random(500),
+        }
+    )
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q.groupby("grouping_column").agg({"to_sum": "sum", "to_mean": "mean"})
+    expected = df.groupby("grouping_column").agg({"to_sum": "sum", "to_mean": "mean"})
+    # Each bucket is also larger than the budget, so it is split further before it is aggregated
+    received = lib.read("sym", query_builder=q).data
+    assert_frame_equal(expected, received.sort_index())
+    # The spill files are removed once the read is finished
+    assert not any(tiny_memory_budget.iterdir())
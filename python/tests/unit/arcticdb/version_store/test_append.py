@@ -10,6 +10,7 @@ from pandas import MultiIndex
 from arcticdb.version_store import NativeVersionStore
 from arcticdb_ext.exceptions import InternalException, NormalizationException, SortingException
 from arcticdb_ext import set_config_int
+from arcticdb_ext.storage import KeyType
 from arcticdb.util.test import random_integers, assert_frame_equal
 from arcticdb.config import set_log_level
 
@@ -547,3 +548,58 @@ def test_defragment_no_work_to_do(sym, lmdb_version_store):
     assert list(lmdb_version_store.list_versions(sym))[0]["version"] == 0
     with pytest.raises(InternalException):
         lmdb_version_store.defragment_symbol_data(sym)
+
+
+def test_append_multi_level_index(version_store_factory):
+    # Each row slice has two column slices, so each leaf holds two row slices
+    lib = version_store_factory(segment_row_size=2, column_group_size=2, index_leaf_size=4)
+    lib_tool = lib.library_tool()
+    symbol = "test_append_multi_level_index"
+    index = pd.date_range("2024-01-01", periods=26, freq="h")
+    df = pd.DataFrame({"a": np.arange(26), "b": np.arange(26, dtype=np.float64), "c": np.arange(26)}, index=index)
+
+    lib.write(symbol, df.iloc[:20])
+    assert len(lib_tool.find_keys_for_id(KeyType.TABLE_INDEX, symbol)) == 1
+    assert len(lib_tool.find_keys_for_id(KeyType.TABLE_INDEX_LEAF, symbol)) == 5
+    assert len(lib.read_index(symbol)) == 5
+    assert_frame_equal(lib.read(symbol).data, df.iloc[:20])
+
+    # Only the last leaf is rewritten, into three leaves, along with the root
+    lib.append(symbol, df.iloc[20:])
+    assert len(lib_tool.find_keys_for_id(KeyType.TABLE_INDEX, symbol)) == 2
+    assert len(lib_tool.find_keys_for_id(KeyType.TABLE_INDEX_LEAF, symbol)) == 5 + 3
+    assert_frame_equal(lib.read(symbol).data, df)
+    assert_frame_equal(lib.read(symbol, as_of=0).data, df.iloc[:20])
+    assert [v["version"] for v in lib.list_versions(symbol)] == [1, 0]
+
+    date_range = (index[7], index[12])
+    assert_frame_equal(lib.read(symbol, date_range=date_range).data, df.loc[date_range[0]:date_range[1]])
+    assert_frame_equal(lib.head(symbol, 3).data, df.iloc[:3])
+    assert_frame_equal(lib.tail(symbol, 3).data, df.iloc[-3:])
+    assert_frame_equal(lib.batch_read([symbol], row_ranges=[(5, 9)])[symbol].data, df.iloc[5:9])
+
+    # The leaves shared with the latest version survive pruning the first
+    lib.prune_previous_versions(symbol)
+    assert len(lib_tool.find_keys_for_id(KeyType.TABLE_INDEX_LEAF, symbol)) == 4 + 3
+    assert_frame_equal(lib.read(symbol).data, df)
+    assert_frame_equal(lib.read(symbol, date_range=date_range).data, df.loc[date_range[0]:date_range[1]])
+
+    lib.delete(symbol)
+    assert not lib_tool.find_keys_for_id(KeyType.TABLE_INDEX_LEAF, symbol)
+
+
+def test_append_multi_level_index_without_opt_in(version_store_factory):
+    lib = version_store_factory(name="multi_level", segment_row_size=2, column_group_size=2, index_leaf_size=4)
+    symbol = "test_append_multi_level_index_without_opt_in"
+    index = pd.date_range("2024-01-01", periods=26, freq="h")
+    df = pd.DataFrame({"a": np.arange(26), "b": np.arange(26, dtype=np.float64), "c": np.arange(26)}, index=index)
+    lib.write(symbol, df.iloc[:20])
+    assert len(lib.read_index(symbol)) == 5
+
+    # Once the library stops writing multi-level indexes, an append rewrites the index as a single-level one that
+    # clients without multi-level index support can read
+    lib = version_store_factory(name="multi_level", reuse_name=True, segment_row_size=2, column_group_size=2)
+    lib.append(symbol, df.iloc[20:])
+    assert len(lib.read_index(symbol)) == 26
+    assert_frame_equal(lib.read(symbol).data, df)
+    assert_frame_equal(lib.read(symbol, as_of=0).data, df.iloc[:20])
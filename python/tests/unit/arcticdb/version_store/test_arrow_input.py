@@ -0,0 +1,87 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pytest
+
+from arcticdb.exceptions import ArcticNativeException, UserInputException
+from arcticdb.util.test import assert_frame_equal
+
+pa = pytest.importorskip("pyarrow")
+
+
+def test_write_arrow_timeseries(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    index = pd.date_range("2024-01-01", periods=5)
+    table = pa.table(
+        {
+            "time": pa.array(index.values, type=pa.timestamp("ns")),
+            "int": pa.array(np.arange(5, dtype=np.int64)),
+            "float": pa.array([0.5, None, 2.5, None, 4.5]),
+            "bool": pa.array([True, False, True, True, False]),
+            "str": pa.array(["a", None, "ccc", "a", ""], type=pa.large_string()),
+        }
+    )
+    vit = lib.write_arrow("sym", table, metadata={"source": "arrow"})
+    assert vit.version == 0
+
+    result = lib.read("sym")
+    assert result.metadata == {"source": "arrow"}
+    expected = pd.DataFrame(
+        {
+            "int": np.arange(5, dtype=np.int64),
+            "float": [0.5, np.nan, 2.5, np.nan, 4.5],
+            "bool": [True, False, True, True, False],
+            "str": ["a", None, "ccc", "a", ""],
+        },
+        index=pd.DatetimeIndex(index, name="time"),
+    )
+    assert_frame_equal(expected, result.data)
+
+
+def test_write_arrow_range_index_and_append(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    lib.write_arrow("sym", pa.record_batch([pa.array([1, 2, 3])], names=["col"]))
+    lib.append_arrow("sym", pa.table({"col": [4, 5]}))
+    assert_frame_equal(pd.DataFrame({"col": [1, 2, 3, 4, 5]}), lib.read("sym").data)
+    # Arrow and pandas appends can be mixed
+    lib.append("sym", pd.DataFrame({"col": [6]}, index=pd.RangeIndex(5, 6)))
+    assert lib.read("sym").data["col"].tolist() == [1, 2, 3, 4, 5, 6]
+
+
+def test_write_arrow_chunked_table_with_timezone(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    index = pd.date_range("2024-01-01", periods=6, tz="America/New_York")
+    first = pa.table({"ts": pa.array(index[:3]), "col": [0, 1, 2]})
+    second = pa.table({"ts": pa.array(index[3:]), "col": [3, 4, 5]})
+    lib.write_arrow("sym", pa.concat_tables([first, second]))
+    expected = pd.DataFrame({"col": np.arange(6)}, index=pd.DatetimeIndex(index, name="ts"))
+    assert_frame_equal(expected, lib.read("sym").data)
+
+
+def test_write_arrow_round_trip(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    table = pa.table({"int": pa.array(np.arange(7, dtype=np.int32)), "str": ["x", "y", None, "x", "z", "y", "x"]})
+    lib.write_arrow("sym", table)
+    result = lib.read("sym", output_format="arrow").data
+    assert result.column("int").to_pylist() == table.column("int").to_pylist()
+    assert result.column("str").to_pylist() == table.column("str").to_pylist()
+
+
+@pytest.mark.parametrize("values", [[1, None, 3], [True, None, False]])
+def test_write_arrow_rejects_nulls_without_pandas_equivalent(lmdb_version_store_tiny_segment, values):
+    lib = lmdb_version_store_tiny_segment
+    with pytest.raises(UserInputException):
+        lib.write_arrow("sym", pa.table({"col": values}))
+    assert not lib.has_symbol("sym")
+
+
+def test_write_arrow_rejects_other_types(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    with pytest.raises(ArcticNativeException):
+        lib.write_arrow("sym", pd.DataFrame({"col": [1]}))
@@ -0,0 +1,94 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pytest
+
+from arcticdb.exceptions import ArcticNativeException
+from arcticdb.version_store.processing import QueryBuilder
+
+pa = pytest.importorskip("pyarrow")
+
+
+def test_read_arrow_numeric(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = pd.DataFrame(
+        {"int": np.arange(10, dtype=np.int64), "float": np.arange(10, dtype=np.float64), "uint": np.arange(10, dtype=np.uint8)},
+        index=pd.date_range("2024-01-01", periods=10),
+    )
+    lib.write("sym", df)
+    table = lib.read("sym", output_format="arrow").data
+    assert isinstance(table, pa.Table)
+    assert table.num_rows == len(df)
+    assert table.column(0).type == pa.timestamp("ns")
+    np.testing.assert_array_equal(table.column(0).to_numpy(), df.index.values)
+    for name in df.columns:
+        np.testing.assert_array_equal(table.column(name).to_numpy(), df[name].values)
+    assert table.column("uint").type == pa.uint8()
+
+
+def test_read_arrow_strings_across_segments(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    # Each two-row segment has its own string pool, so the values have to be remapped into a single pool on read
+    strings = ["a", "b", "a", None, "c", "b", "a", None, "dd", "a"]
+    df = pd.DataFrame({"str": strings, "other": ["x"] * 5 + ["y"] * 5, "int": np.arange(10)})
+    lib.write("sym", df, dynamic_strings=True)
+    table = lib.read("sym", output_format="arrow").data
+    assert table.column("str").to_pylist() == strings
+    assert table.column("other").to_pylist() == df["other"].tolist()
+    assert table.column("str").null_count == 2
+
+
+def test_read_arrow_string_column_missing_from_some_segments(lmdb_version_store_tiny_segment_dynamic):
+    lib = lmdb_version_store_tiny_segment_dynamic
+    lib.write("sym", pd.DataFrame({"int": np.arange(4)}))
+    lib.append("sym", pd.DataFrame({"int": np.arange(4, 8), "str": ["e", "f", "e", "g"]}), dynamic_strings=True)
+    table = lib.read("sym", output_format="arrow").data
+    assert table.column("int").to_pylist() == list(range(8))
+    assert table.column("str").to_pylist() == [None] * 4 + ["e", "f", "e", "g"]
+
+
+def test_read_arrow_date_range(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = pd.DataFrame({"col": np.arange(10), "str": [str(i) for i in range(10)]}, index=pd.date_range("2024-01-01", periods=10))
+    lib.write("sym", df, dynamic_strings=True)
+    date_range = (pd.Timestamp("2024-01-02"), pd.Timestamp("2024-01-06"))
+    table = lib.read("sym", date_range=date_range, output_format="arrow").data
+    expected = df.loc[date_range[0] : date_range[1]]
+    np.testing.assert_array_equal(table.column(0).to_numpy(), expected.index.values)
+    assert table.column("col").to_pylist() == expected["col"].tolist()
+    assert table.column("str").to_pylist() == expected["str"].tolist()
+
+
+def test_read_arrow_row_range(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = pd.DataFrame({"col": np.arange(10)})
+    lib.write("sym", df)
+    table = lib.read("sym", row_range=(3, 7), output_format="arrow").data
+    assert table.column("col").to_pylist() == [3, 4, 5, 6]
+
+
+def test_read_arrow_query_builder(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = pd.DataFrame({"col": np.arange(10), "str": ["a", "b"] * 5})
+    lib.write("sym", df, dynamic_strings=True)
+    q = QueryBuilder()
+    q = q[q["col"] % 3 == 0]
+    table = lib.read("sym", query_builder=q, output_format="arrow").data
+    assert table.column("col").to_pylist() == [0, 3, 6, 9]
+    assert table.column("str").to_pylist() == ["a", "b", "a", "b"]
+
+
+def test_read_arrow_pandas_is_default(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = pd.DataFrame({"col": np.arange(4)})
+    lib.write("sym", df)
+    assert isinstance(lib.read("sym").data, pd.DataFrame)
+    assert isinstance(lib.read("sym", output_format="pandas").data, pd.DataFrame)
+    with pytest.raises(ArcticNativeException):
+        lib.read("sym", output_format="polars")
@@ -0,0 +1,174 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pickle
+import pytest
+
+from arcticdb.version_store.processing import QueryBuilder
+from arcticdb.util.test import assert_frame_equal
+from arcticdb_ext.exceptions import InternalException, UserInputException
+
+
+def trades_and_quotes():
+    trades = pd.DataFrame(
+        {"price": np.arange(10, dtype=np.float64), "qty": np.arange(10, 20, dtype=np.int64)},
+        index=pd.date_range("2024-01-01 00:00:00.5", periods=10, freq="s"),
+    )
+    quotes = pd.DataFrame(
+        {"bid": np.arange(20, dtype=np.float64), "ask": np.arange(100, 120, dtype=np.float64)},
+        index=pd.date_range("2024-01-01", periods=20, freq="500ms"),
+    )
+    return trades, quotes
+
+
+def test_as_of_join(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    trades, quotes = trades_and_quotes()
+    lib.write("trades", trades)
+    lib.write("quotes", quotes)
+
+    q = QueryBuilder()
+    q = q.as_of_join("quotes")
+    received = lib.read("trades", query_builder=q).data
+    expected = pd.merge_asof(trades, quotes, left_index=True, right_index=True)
+    assert_frame_equal(expected, received)
+
+
+def test_as_of_join_tolerance(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    trades, quotes = trades_and_quotes()
+    # Quotes every 2 seconds, so only every other trade has one within the tolerance
+    quotes = quotes.iloc[::4]
+    lib.write("trades", trades)
+    lib.write("quotes", quotes)
+
+    q = QueryBuilder()
+    q = q.as_of_join("quotes", tolerance=pd.Timedelta("700ms"))
+    received = lib.read("trades", query_builder=q).data
+    expected = pd.merge_asof(trades, quotes, left_index=True, right_index=True, tolerance=pd.Timedelta("700ms"))
+    assert expected["bid"].isna().any() and expected["bid"].notna().any()
+    assert_frame_equal(expected, received)
+
+
+def test_as_of_join_by(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    trades, quotes = trades_and_quotes()
+    trades["ticker"] = ["A", "B"] * 5
+    quotes["ticker"] = ["A", "A", "B", "A"] * 5
+    lib.write("trades", trades)
+    lib.write("quotes", quotes)
+
+    q = QueryBuilder()
+    q = q.as_of_join("quotes", by="ticker")
+    received = lib.read("trades", query_builder=q).data
+    expected = pd.merge_asof(trades, quotes, left_index=True, right_index=True, by="ticker")
+    assert_frame_equal(expected, received)
+
+
+def test_as_of_join_by_integer_column(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    trades, quotes = trades_and_quotes()
+    trades["ticker"] = np.array([1, 2] * 5, dtype=np.int64)
+    quotes["ticker"] = np.array([1, 1, 2, 1] * 5, dtype=np.int64)
+    expected = pd.merge_asof(trades, quotes, left_index=True, right_index=True, by="ticker")
+    lib.write("trades", trades)
+    # By values are matched by value rather than by type
+    lib.write("quotes", quotes.astype({"ticker": np.uint8}))
+
+    q = QueryBuilder()
+    q = q.as_of_join("quotes", by="ticker")
+    received = lib.read("trades", query_builder=q).data
+    assert_frame_equal(expected, received)
+
+
+def test_as_of_join_unmatched_rows(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    trades = pd.DataFrame({"price": np.arange(8, dtype=np.float64)}, index=pd.date_range("2024-01-01", periods=8, freq="s"))
+    # The first two trades are before any quote, and the quote at 5s is too old for the trade at 7s
+    quotes = pd.DataFrame(
+        {
+            "bid": [1.5, 2.5, 3.5],
+            "size": np.array([10, 20, 30], dtype=np.int64),
+            "small": np.array([1, 2, 3], dtype=np.int16),
+            "firm": [True, False, True],
+            "venue": ["x", "y", "z"],
+        },
+        index=pd.DatetimeIndex([pd.Timestamp("2024-01-01 00:00:02"), pd.Timestamp("2024-01-01 00:00:03"), pd.Timestamp("2024-01-01 00:00:05")]),
+    )
+    lib.write("trades", trades)
+    lib.write("quotes", quotes, dynamic_strings=True)
+
+    q = QueryBuilder()
+    q = q.as_of_join("quotes", tolerance=pd.Timedelta("1s"))
+    received = lib.read("trades", query_builder=q).data
+
+    expected = pd.merge_asof(trades, quotes, left_index=True, right_index=True, tolerance=pd.Timedelta("1s"))
+    unmatched = expected["bid"].isna()
+    assert unmatched.tolist() == [True, True, False, False, False, False, False, True]
+    # Unmatched rows are NaN in float columns, None in string columns and zero in integer and bool columns
+    expected["size"] = expected["size"].fillna(0).astype(np.int64)
+    expected["small"] = expected["small"].fillna(0).astype(np.int16)
+    expected["firm"] = expected["firm"].fillna(False).astype(bool)
+    expected["venue"] = expected["venue"].astype(object).where(~unmatched, None)
+    assert_frame_equal(expected, received)
+
+
+def test_as_of_join_reads_only_the_right_rows_in_range(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    # A quote every second for 100 seconds in 50 segments, and 10 trades from 50.5s in 5 segments
+    quotes = pd.DataFrame({"bid": np.arange(100, dtype=np.float64)}, index=pd.date_range("2024-01-01", periods=100, freq="s"))
+    trades = pd.DataFrame(
+        {"price": np.arange(10, dtype=np.float64)}, index=pd.date_range("2024-01-01 00:00:50.5", periods=10, freq="s")
+    )
+    lib.write("trades", trades)
+    lib.write("quotes", quotes)
+
+    def segments_read(tolerance):
+        q = QueryBuilder()
+        q = q.as_of_join("quotes", tolerance=tolerance)
+        vit = lib.read("trades", query_builder=q, profile=True)
+        expected = pd.merge_asof(trades, quotes, left_index=True, right_index=True, tolerance=tolerance)
+        assert_frame_equal(expected, vit.data)
+        (storage_read,) = [c for c in vit.profile["children"] if c["name"] == "storage_read"]
+        return storage_read["calls"] - 5
+
+    # The quotes after the last trade are never read
+    assert segments_read(None) == 30
+    # Nor, with a tolerance, those more than the tolerance before the first trade
+    assert segments_read(pd.Timedelta("2s")) == 6
+
+
+def test_as_of_join_version_and_filter(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    trades, quotes = trades_and_quotes()
+    lib.write("trades", trades)
+    lib.write("quotes", quotes)
+    lib.write("quotes", quotes * 2)
+
+    q = QueryBuilder()
+    q = q[q["price"] > 3.5].as_of_join("quotes", as_of=0)
+    received = lib.read("trades", query_builder=q).data
+    expected = pd.merge_asof(trades[trades["price"] > 3.5], quotes, left_index=True, right_index=True)
+    assert_frame_equal(expected, received)
+
+    # The clause survives pickling
+    received = lib.read("trades", query_builder=pickle.loads(pickle.dumps(q))).data
+    assert_frame_equal(expected, received)
+
+
+def test_as_of_join_column_clash(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    trades, quotes = trades_and_quotes()
+    lib.write("trades", trades)
+    lib.write("quotes", quotes.rename(columns={"bid": "price"}))
+
+    q = QueryBuilder()
+    q = q.as_of_join("quotes")
+    with pytest.raises((UserInputException, InternalException)):
+        lib.read("trades", query_builder=q)
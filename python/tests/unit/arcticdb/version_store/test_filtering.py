@@ -949,6 +949,32 @@ def test_filter_numeric_isin_hashing_overflows(lmdb_version_store, df_col, isin_
     assert_frame_equal(expected, result)
 
 
+# Sets of these sizes and densities are probed as a sorted array, a bitmap and a hash set respectively
+@pytest.mark.parametrize(
+    "vals",
+    [
+        np.array([-7, 3, 1000003], dtype=np.int64),
+        np.arange(-5000, 5000, 3, dtype=np.int64),
+        np.arange(-50000, 50000, 7, dtype=np.int64) * 1000003,
+        np.arange(0, 20000, 7, dtype=np.float64) / 4,
+    ],
+)
+@pytest.mark.parametrize("negate", [False, True])
+def test_filter_numeric_isin_large_sets(lmdb_version_store, vals, negate):
+    rng = np.random.default_rng(0)
+    a = np.concatenate([rng.choice(vals, 500), rng.integers(-(2**40), 2**40, 500)]).astype(vals.dtype)
+    df = pd.DataFrame({"a": a})
+    lmdb_version_store.write("test_filter_numeric_isin_large_sets", df)
+
+    q = QueryBuilder()
+    q = q[q["a"].isnotin(vals)] if negate else q[q["a"].isin(vals)]
+    result = lmdb_version_store.read("test_filter_numeric_isin_large_sets", query_builder=q).data
+
+    mask = df["a"].isin(vals)
+    expected = df[~mask if negate else mask]
+    assert np.array_equal(expected, result)
+
+
 def test_filter_numeric_isin_unsigned(lmdb_version_store):
     df = pd.DataFrame({"a": [0, 1, 2**64 - 1]})
     lmdb_version_store.write("test_filter_numeric_isin_unsigned", df)
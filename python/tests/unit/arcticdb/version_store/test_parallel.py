@@ -158,6 +158,20 @@ def test_sort_merge_write(basic_store):
     assert_frame_equal(vit.data, df)
 
 
+def test_sort_merge_over_memory_budget(lmdb_version_store, tiny_memory_budget):
+    lib = lmdb_version_store
+    symbol = "test_sort_merge_over_memory_budget"
+    index = pd.date_range("2024-01-01", periods=200, freq="s")
+    df = pd.DataFrame({"col": np.arange(200, dtype=np.int64)}, index=index)
+    # Interleaved so that the merge takes rows from every staged segment in turn
+    for offset in [2, 0, 3, 1]:
+        lib.write(symbol, df.iloc[offset::4], parallel=True)
+
+    lib.version_store.sort_merge(symbol)
+    assert_frame_equal(df, lib.read(symbol).data)
+    assert not any(tiny_memory_budget.iterdir())
+
+
 def test_sort_merge_append(basic_store_dynamic_schema):
     lib = basic_store_dynamic_schema
     num_rows_per_day = 10
@@ -0,0 +1,93 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import attr
+import numpy as np
+import pandas as pd
+
+from arcticdb.version_store.processing import QueryBuilder
+from arcticdb.util.test import assert_frame_equal
+
+
+def child(node, name):
+    matches = [c for c in node["children"] if c["name"].startswith(name)]
+    assert len(matches) == 1, f"Expected one stage named {name} in {[c['name'] for c in node['children']]}"
+    return matches[0]
+
+
+def test_read_without_profile(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    lib.write("sym", pd.DataFrame({"col": np.arange(10)}))
+    vit = lib.read("sym")
+    assert vit.profile is None
+    # Unpacking is unchanged by the profile attribute
+    assert len(attr.astuple(vit)) == 7
+    assert len(list(iter(vit))) == 6
+
+
+def test_read_profile_direct(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = pd.DataFrame({"col1": np.arange(10), "col2": np.arange(10.0), "col3": np.arange(10)})
+    lib.write("sym", df)
+    vit = lib.read("sym", profile=True)
+    assert_frame_equal(df, vit.data)
+
+    profile = vit.profile
+    assert profile["name"] == "read"
+    assert profile["calls"] == 1
+    assert profile["wall_ns"] > 0
+    assert profile["counters"]["rows"] == len(df)
+    for name in ["version_map", "index", "python_output"]:
+        assert child(profile, name)["calls"] == 1
+
+    num_segments = child(profile, "index")["counters"]["segments_in_index"]
+    assert num_segments > 1
+    storage_read = child(profile, "storage_read")
+    assert storage_read["calls"] == num_segments
+    assert storage_read["counters"]["bytes_fetched"] > 0
+    decode = child(profile, "decode")
+    assert decode["calls"] == num_segments
+    # Each row is decoded once per column slice
+    assert decode["counters"]["rows"] % len(df) == 0
+
+
+def test_read_profile_prunes_with_date_range(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = pd.DataFrame({"col": np.arange(10)}, index=pd.date_range("2024-01-01", periods=10))
+    lib.write("sym", df)
+    vit = lib.read("sym", date_range=(pd.Timestamp("2024-01-01"), pd.Timestamp("2024-01-02")), profile=True)
+    assert_frame_equal(df.iloc[:2], vit.data)
+
+    index = child(vit.profile, "index")
+    assert index["counters"]["segments_pruned"] > 0
+    assert child(vit.profile, "storage_read")["calls"] == index["counters"]["segments_in_index"] - index["counters"]["segments_pruned"]
+
+
+def test_read_profile_clauses(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = pd.DataFrame({"col": np.arange(100), "grouping_column": np.arange(100) % 5})
+    lib.write("sym", df)
+    q = QueryBuilder()
+    q = q[q["col"] < 30].groupby("grouping_column").agg({"col": "sum"})
+    vit = lib.read("sym", query_builder=q, profile=True)
+    expected = df[df["col"] < 30].groupby("grouping_column").agg({"col": "sum"})
+    assert_frame_equal(expected, vit.data.sort_index())
+
+    profile = vit.profile
+    assert child(profile, "decode")["counters"]["bytes_decompressed"] > 0
+
+    filter_stage = child(profile, "clause 0: WHERE")
+    assert filter_stage["calls"] > 0
+    assert filter_stage["counters"]["rows_in"] == len(df)
+    assert filter_stage["counters"]["rows_out"] == 30
+
+    partition_stage = child(profile, "clause 1: GROUPBY")
+    assert partition_stage["counters"]["rows_in"] == 30
+
+    aggregation_stage = child(profile, "clause 2: AGGREGATE")
+    assert aggregation_stage["counters"]["rows_out"] == len(expected)
+    assert child(profile, "output")["calls"] == 1
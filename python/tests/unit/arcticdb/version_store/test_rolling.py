@@ -0,0 +1,112 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pickle
+import pytest
+
+from arcticdb.version_store.processing import QueryBuilder
+from arcticdb.util.test import assert_frame_equal
+from arcticdb_ext.exceptions import InternalException, UserInputException
+
+
+def ticks(rows=50):
+    rng = np.random.default_rng(0)
+    price = rng.uniform(90, 110, rows)
+    price[rng.uniform(size=rows) < 0.1] = np.nan
+    # Irregular index with repeated timestamps, so time windows hold varying numbers of rows
+    index = pd.Timestamp("2024-01-01") + pd.to_timedelta(np.cumsum(rng.integers(0, 3, rows)), unit="s")
+    return pd.DataFrame({"price": price, "qty": rng.integers(1, 100, rows)}, index=index)
+
+
+def expected_rolling(df, window, aggregations, min_periods=None):
+    expected = df.copy()
+    for output, (column, operator) in aggregations.items():
+        rolling = df[column].astype(np.float64).rolling(window, min_periods=min_periods)
+        expected[output] = getattr(rolling, operator)()
+    return expected
+
+
+aggregations = {
+    "price_sum": ("price", "sum"),
+    "price_mean": ("price", "mean"),
+    "price_min": ("price", "min"),
+    "price_max": ("price", "max"),
+    "qty_mean": ("qty", "mean"),
+}
+
+
+# The tiny segment fixture has two rows per row slice, so most windows span several row slices
+@pytest.mark.parametrize("window", [1, 3, 7])
+@pytest.mark.parametrize("min_periods", [None, 1])
+def test_rolling_rows(lmdb_version_store_tiny_segment, window, min_periods):
+    lib = lmdb_version_store_tiny_segment
+    df = ticks()
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q.rolling(window, aggregations, min_periods=min_periods)
+    received = lib.read("sym", query_builder=q).data
+    assert_frame_equal(expected_rolling(df, window, aggregations, min_periods), received)
+
+
+@pytest.mark.parametrize("window", ["1s", "5s", pd.Timedelta("20s")])
+def test_rolling_time(lmdb_version_store_tiny_segment, window):
+    lib = lmdb_version_store_tiny_segment
+    df = ticks()
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q.rolling(window, aggregations)
+    received = lib.read("sym", query_builder=q).data
+    assert_frame_equal(expected_rolling(df, window, aggregations), received)
+
+
+def test_rolling_count(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = ticks()
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q.rolling(4, {"price_count": ("price", "count")}, min_periods=0)
+    received = lib.read("sym", query_builder=q).data
+    expected = df.copy()
+    expected["price_count"] = df["price"].rolling(4, min_periods=0).count()
+    assert_frame_equal(expected, received)
+
+
+def test_rolling_after_filter(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = ticks()
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q[q["qty"] > 30].rolling(3, aggregations)
+    received = lib.read("sym", query_builder=q).data
+    assert_frame_equal(expected_rolling(df[df["qty"] > 30], 3, aggregations), received)
+
+    # The clause survives pickling
+    received = lib.read("sym", query_builder=pickle.loads(pickle.dumps(q))).data
+    assert_frame_equal(expected_rolling(df[df["qty"] > 30], 3, aggregations), received)
+
+
+def test_rolling_invalid(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    lib.write("sym", ticks())
+
+    with pytest.raises(UserInputException):
+        QueryBuilder().rolling(0, aggregations)
+    with pytest.raises(UserInputException):
+        QueryBuilder().rolling(3, aggregations, min_periods=4)
+    with pytest.raises(UserInputException):
+        QueryBuilder().rolling(3, {"price_median": ("price", "median")})
+
+    q = QueryBuilder()
+    q = q.rolling(3, {"qty": ("price", "mean")})
+    with pytest.raises((UserInputException, InternalException)):
+        lib.read("sym", query_builder=q)
@@ -0,0 +1,100 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pickle
+import pytest
+
+from arcticdb.version_store.processing import QueryBuilder
+from arcticdb.util.test import assert_frame_equal
+from arcticdb_ext.exceptions import SchemaException, UserInputException
+
+
+def tickers(rows=60):
+    rng = np.random.default_rng(0)
+    return pd.DataFrame(
+        {
+            "ticker": rng.choice(["AAPL", "aapl", "ABNB", "MSFT", "msft.L", "BRK-B", ""], rows),
+            "venue": rng.choice(["XLON", "XPAR", None], rows),
+            "qty": rng.integers(0, 100, rows),
+        },
+        index=pd.date_range("2024-01-01", periods=rows, freq="s"),
+    )
+
+
+@pytest.mark.parametrize(
+    "build_filter, pandas_filter",
+    [
+        (lambda c: c.str.startswith("AB"), lambda s: s.str.startswith("AB")),
+        (lambda c: c.str.endswith("FT"), lambda s: s.str.endswith("FT")),
+        (lambda c: c.str.contains(".", regex=False), lambda s: s.str.contains(".", regex=False)),
+        (lambda c: c.str.contains("^[A-Z]+(-[A-Z])?$"), lambda s: s.str.contains("^[A-Z]+(-[A-Z])?$")),
+        (lambda c: c.str.lower() == "aapl", lambda s: s.str.lower() == "aapl"),
+        (lambda c: c.str.upper().isin(["MSFT", "ABNB"]), lambda s: s.str.upper().isin(["MSFT", "ABNB"])),
+        (lambda c: c.str.len() > 4, lambda s: s.str.len() > 4),
+    ],
+)
+def test_filter_string_operations(lmdb_version_store_tiny_segment, build_filter, pandas_filter):
+    lib = lmdb_version_store_tiny_segment
+    df = tickers()
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q[build_filter(q["ticker"])]
+    received = lib.read("sym", query_builder=q).data
+    assert_frame_equal(df[pandas_filter(df["ticker"])], received)
+
+
+def test_filter_string_operations_missing_values(lmdb_version_store):
+    lib = lmdb_version_store
+    df = tickers()
+    lib.write("sym", df)
+
+    # Missing strings never match, as pandas gives NaN for them which does not select the row
+    q = QueryBuilder()
+    q = q[q["venue"].str.startswith("X") & ~q["venue"].str.contains("LON")]
+    received = lib.read("sym", query_builder=q).data
+    assert_frame_equal(df[df["venue"] == "XPAR"], received)
+
+    # The clause survives pickling
+    received = lib.read("sym", query_builder=pickle.loads(pickle.dumps(q))).data
+    assert_frame_equal(df[df["venue"] == "XPAR"], received)
+
+
+def test_project_string_operations(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = tickers()
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q.apply("lower", q["ticker"].str.lower())
+    q = q.apply("venue_len", q["venue"].str.len())
+    received = lib.read("sym", query_builder=q).data
+    expected = df.copy()
+    expected["lower"] = expected["ticker"].str.lower()
+    expected["venue_len"] = expected["venue"].str.len().astype(np.float64)
+    assert_frame_equal(expected, received)
+
+
+def test_string_operations_invalid(lmdb_version_store):
+    lib = lmdb_version_store
+    lib.write("sym", tickers())
+
+    with pytest.raises(UserInputException):
+        QueryBuilder()["ticker"].str.startswith(1)
+
+    q = QueryBuilder()
+    q = q[q["qty"].str.startswith("1")]
+    with pytest.raises(SchemaException):
+        lib.read("sym", query_builder=q)
+
+    # Backreferences cannot be matched without backtracking
+    q = QueryBuilder()
+    q = q[q["ticker"].str.contains(r"(A)\1")]
+    with pytest.raises(UserInputException):
+        lib.read("sym", query_builder=q)
@@ -0,0 +1,146 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pickle
+import pytest
+
+from arcticdb.version_store.processing import QueryBuilder
+from arcticdb.util.test import assert_frame_equal
+from arcticdb_ext.exceptions import SchemaException, UserInputException
+
+
+def frame(data):
+    rows = len(next(iter(data.values())))
+    return pd.DataFrame(data, index=pd.date_range("2024-01-01", periods=rows, freq="s"))
+
+
+def read_top_k(lib, column, k, largest=True, by=None):
+    q = QueryBuilder()
+    q = q.top_k(column, k, largest=largest, by=by)
+    return lib.read("sym", query_builder=q).data
+
+
+# The tiny segment fixture has two rows per row slice, so rows are picked from many row slices in every test
+def test_top_k_descending_and_ascending(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = frame({"col": np.array([5, 9, 1, 7, 3, 8, 2], dtype=np.int64)})
+    lib.write("sym", df)
+
+    assert read_top_k(lib, "col", 3)["col"].tolist() == [9, 8, 7]
+    assert read_top_k(lib, "col", 3, largest=False)["col"].tolist() == [1, 2, 3]
+    assert_frame_equal(df.nlargest(3, "col"), read_top_k(lib, "col", 3))
+    assert_frame_equal(df.nsmallest(3, "col"), read_top_k(lib, "col", 3, largest=False))
+
+
+def test_top_k_ties_keep_the_earliest_rows(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    # Every tied row is in a different row slice
+    df = frame({"col": [1.0, 4.0, 2.0, 4.0, 4.0, 2.0, 4.0, 0.0], "row": np.arange(8)})
+    lib.write("sym", df)
+
+    received = read_top_k(lib, "col", 3)
+    assert received["row"].tolist() == [1, 3, 4]
+    assert_frame_equal(df.nlargest(3, "col", keep="first"), received)
+
+    received = read_top_k(lib, "col", 2, largest=False)
+    assert received["row"].tolist() == [7, 0]
+    received = read_top_k(lib, "col", 3, largest=False)
+    assert received["row"].tolist() == [7, 0, 2]
+
+
+def test_top_k_larger_than_the_data(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = frame({"col": [3, 1, 2], "ticker": ["a", "b", "a"]})
+    lib.write("sym", df)
+
+    assert_frame_equal(df.sort_values("col", ascending=False, kind="stable"), read_top_k(lib, "col", 10))
+    # Each group has fewer than k rows, so all of its rows are kept
+    received = read_top_k(lib, "col", 5, largest=False, by="ticker")
+    assert received["col"].tolist() == [1, 2, 3]
+    assert received["ticker"].tolist() == ["b", "a", "a"]
+
+
+def test_top_k_nan_is_never_selected(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = frame({"col": [np.nan, 2.0, np.nan, -np.inf, np.inf, 1.0, np.nan]})
+    lib.write("sym", df)
+
+    # Unlike NaN, infinities are ordered
+    assert read_top_k(lib, "col", 2)["col"].tolist() == [np.inf, 2.0]
+    assert read_top_k(lib, "col", 2, largest=False)["col"].tolist() == [-np.inf, 1.0]
+    # Fewer than k rows are returned rather than any NaN
+    assert read_top_k(lib, "col", 6)["col"].tolist() == [np.inf, 2.0, 1.0, -np.inf]
+
+    lib.write("sym", frame({"col": [np.nan] * 4}))
+    assert read_top_k(lib, "col", 3).empty
+
+
+def test_top_k_by(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = frame(
+        {
+            "col": [5.0, 1.0, 5.0, np.nan, 3.0, 4.0, 1.0, 6.0],
+            "ticker": ["a", "b", "b", "a", None, "a", "b", "b"],
+            "row": np.arange(8),
+        }
+    )
+    lib.write("sym", df, dynamic_strings=True)
+
+    # Rows without a group are dropped, and the rows kept for all the groups are ordered together best first
+    received = read_top_k(lib, "col", 2, by="ticker")
+    assert received["col"].tolist() == [6.0, 5.0, 5.0, 4.0]
+    assert received["ticker"].tolist() == ["b", "a", "b", "a"]
+    assert received["row"].tolist() == [7, 0, 2, 5]
+
+    received = read_top_k(lib, "col", 1, largest=False, by="ticker")
+    assert received["row"].tolist() == [1, 5]
+
+
+def test_top_k_by_many_groups(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    rng = np.random.default_rng(0)
+    rows = 2000
+    df = frame({"col": rng.permutation(rows), "group": np.repeat(np.arange(rows // 2, dtype=np.int64) * 7919, 2)})
+    lib.write("sym", df)
+
+    # Distinct group values are never merged, so every group keeps its own row
+    received = read_top_k(lib, "col", 1, by="group")
+    assert len(received) == rows // 2
+    assert received["group"].is_unique
+    expected = df.sort_values("col", ascending=False, kind="stable").groupby("group", sort=False).head(1)
+    assert_frame_equal(expected, received)
+
+
+def test_top_k_after_filter(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = frame({"col": np.arange(10), "ticker": ["a", "b"] * 5})
+    lib.write("sym", df)
+
+    q = QueryBuilder()
+    q = q[q["ticker"] != "b"].top_k("col", 2)
+    received = lib.read("sym", query_builder=q).data
+    assert received["col"].tolist() == [8, 6]
+
+    # The clause survives pickling
+    received = lib.read("sym", query_builder=pickle.loads(pickle.dumps(q))).data
+    assert received["col"].tolist() == [8, 6]
+
+
+def test_top_k_invalid(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    lib.write("sym", frame({"col": [1, 2], "ticker": ["a", "b"]}))
+
+    with pytest.raises(UserInputException):
+        QueryBuilder().top_k("col", 0)
+
+    with pytest.raises(SchemaException):
+        read_top_k(lib, "ticker", 3)
+
+    with pytest.raises(SchemaException):
+        read_top_k(lib, "missing", 3)